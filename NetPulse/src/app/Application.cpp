@@ -1,5 +1,6 @@
 #include "app/Application.hpp"
 
+#include "infrastructure/network/BlockingExecutor.hpp"
 #include "ui/resources/AppIcon.hpp"
 #include "ui/windows/MainWindow.hpp"
 
@@ -41,6 +42,20 @@ Application::~Application() {
         dashboardViewModel_->stopMonitoring();
     }
 
+    // Scans stay resumable across the restart. Their final checkpoints are
+    // saved here, since the workers that would send them stop with the
+    // io_context below.
+    if (portScanner_ && scanCheckpoints_) {
+        for (const auto& checkpoint : portScanner_->cancelWithCheckpoints()) {
+            try {
+                scanCheckpoints_->save(checkpoint);
+            } catch (const std::exception& e) {
+                spdlog::warn("Failed to save final checkpoint of scan {}: {}", checkpoint.key,
+                             e.what());
+            }
+        }
+    }
+
     if (asioContext_) {
         asioContext_->stop();
     }
@@ -84,12 +99,60 @@ void Application::initializeComponents() {
     database_->runMigrations();
 
     // Asio context
-    asioContext_ = std::make_unique<infra::AsioContext>(4);
+    const auto& appConfig = config_->config();
+    auto ioThreads = appConfig.ioThreads > 0 ? static_cast<size_t>(appConfig.ioThreads)
+                                             : std::thread::hardware_concurrency();
+    asioContext_ = std::make_unique<infra::AsioContext>(
+        ioThreads, infra::AsioContext::topologyFromString(appConfig.ioTopology),
+        appConfig.pinIoThreads);
+    asioContext_->blockingExecutor().configure(
+        static_cast<size_t>(std::max(appConfig.blockingThreads, 1)),
+        static_cast<size_t>(std::max(appConfig.blockingQueueCapacity, 1)));
     asioContext_->start();
 
     // Network services
     pingService_ = std::make_shared<infra::PingService>(*asioContext_);
+    pingService_->setSpreadPolicy(
+        infra::PingService::spreadPolicyFromString(config_->config().probeSpreadPolicy));
+    pingService_->setKernelTimestamps(config_->config().kernelTimestamps);
+    pingService_->setTimeoutPolicy(
+        {config_->config().adaptiveTimeouts,
+         std::chrono::milliseconds(config_->config().probeTimeoutFloorMs),
+         std::chrono::milliseconds(config_->config().probeTimeoutCeilingMs)});
+    pingService_->setMaxInFlight(config_->config().maxInFlightProbes);
     portScanner_ = std::make_unique<infra::PortScanner>(*asioContext_);
+    portScanner_->setConnectionBudget(
+        static_cast<size_t>(std::max(config_->config().portScanMaxConnections, 1)));
+    portScanner_->setSynRateLimit(
+        static_cast<size_t>(std::max(config_->config().portScanSynRate, 0)));
+
+    // Scan checkpoints are written on the blocking pool; if it is saturated
+    // or stops first they are written inline rather than dropped, since each
+    // carries the only copy of its new results
+    scanCheckpoints_ = std::make_shared<infra::ScanCheckpointRepository>(database_);
+    if (config_->config().portScanCheckpointSeconds > 0) {
+        portScanner_->setCheckpointHandler(
+            std::chrono::seconds(config_->config().portScanCheckpointSeconds),
+            [repository = scanCheckpoints_,
+             context = asioContext_.get()](const core::ScanCheckpoint& checkpoint) {
+                auto save = [repository, checkpoint]() {
+                    try {
+                        repository->save(checkpoint);
+                    } catch (const std::exception& e) {
+                        // The repository keeps its results for the scan's next save
+                        spdlog::warn("Failed to save checkpoint of scan {}: {}", checkpoint.key,
+                                     e.what());
+                    }
+                };
+                if (!context->blockingExecutor().tryPost(save, save)) {
+                    save();
+                }
+            });
+    }
+
+    hostSweeper_ = std::make_unique<infra::HostSweeper>(*asioContext_);
+    hostSweeper_->setSynRateLimit(
+        static_cast<size_t>(std::max(config_->config().portScanSynRate, 0)));
 
     // Notification service
     notificationService_ = std::make_shared<infra::NotificationService>(database_);
@@ -169,6 +232,7 @@ void Application::performCleanup() {
     metricsRepo.cleanupOldPingResults(maxAge);
     metricsRepo.cleanupOldAlerts(maxAge);
     metricsRepo.cleanupOldPortScans(maxAge);
+    scanCheckpoints_->cleanupOld(maxAge);
 
     spdlog::info("Performed data cleanup");
 }
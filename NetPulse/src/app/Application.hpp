@@ -3,7 +3,9 @@
 #include "infrastructure/api/RestApiServer.hpp"
 #include "infrastructure/config/ConfigManager.hpp"
 #include "infrastructure/database/Database.hpp"
+#include "infrastructure/database/ScanCheckpointRepository.hpp"
 #include "infrastructure/network/AsioContext.hpp"
+#include "infrastructure/network/HostSweeper.hpp"
 #include "infrastructure/network/PingService.hpp"
 #include "infrastructure/network/PortScanner.hpp"
 #include "infrastructure/notifications/NotificationService.hpp"
@@ -31,6 +33,8 @@ public:
     infra::AsioContext& asioContext() { return *asioContext_; }
     infra::PingService& pingService() { return *pingService_; }
     infra::PortScanner& portScanner() { return *portScanner_; }
+    infra::ScanCheckpointRepository& scanCheckpoints() { return *scanCheckpoints_; }
+    infra::HostSweeper& hostSweeper() { return *hostSweeper_; }
 
     viewmodels::DashboardViewModel& dashboardViewModel() { return *dashboardViewModel_; }
     viewmodels::HostMonitorViewModel& hostMonitorViewModel() { return *hostMonitorViewModel_; }
@@ -54,6 +58,8 @@ private:
     std::unique_ptr<infra::AsioContext> asioContext_;
     std::shared_ptr<infra::PingService> pingService_;
     std::unique_ptr<infra::PortScanner> portScanner_;
+    std::shared_ptr<infra::ScanCheckpointRepository> scanCheckpoints_;
+    std::unique_ptr<infra::HostSweeper> hostSweeper_;
 
     std::unique_ptr<viewmodels::DashboardViewModel> dashboardViewModel_;
     std::unique_ptr<viewmodels::HostMonitorViewModel> hostMonitorViewModel_;
@@ -14,6 +14,9 @@
 #include <functional>
 #include <future>
 #include <memory>
+#include <span>
+#include <string>
+#include <vector>
 
 namespace netpulse::core {
 
@@ -33,6 +36,12 @@ public:
      */
     using PingCallback = std::function<void(const PingResult&)>;
 
+    /**
+     * @brief Callback function type for batch ping results.
+     * @param results One result per requested address, in request order.
+     */
+    using BatchPingCallback = std::function<void(const std::vector<PingResult>&)>;
+
     virtual ~IPingService() = default;
 
     /**
@@ -44,6 +53,19 @@ public:
     virtual std::future<PingResult> pingAsync(const std::string& address,
                                               std::chrono::milliseconds timeout) = 0;
 
+    /**
+     * @brief Pings many addresses as one batch.
+     *
+     * Intended for subnet sweeps and other bursts of probes. The callback is
+     * invoked once after every address has either replied, timed out or failed.
+     *
+     * @param addresses IP addresses or hostnames to ping.
+     * @param timeout Maximum time to wait for each response.
+     * @param callback Function to call with all results.
+     */
+    virtual void pingMany(std::span<const std::string> addresses,
+                          std::chrono::milliseconds timeout, BatchPingCallback callback) = 0;
+
     /**
      * @brief Starts periodic monitoring of a host.
      * @param host The host configuration to monitor.
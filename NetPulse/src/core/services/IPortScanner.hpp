@@ -10,8 +10,10 @@
 
 #include "core/types/PortScanResult.hpp"
 
+#include <cstdint>
 #include <functional>
 #include <future>
+#include <string>
 #include <vector>
 
 namespace netpulse::core {
@@ -24,6 +26,9 @@ struct PortScanProgress {
     int scannedPorts{0};  ///< Number of ports scanned so far
     int openPorts{0};     ///< Number of open ports found
     bool cancelled{false}; ///< Whether the scan was cancelled
+    double probesPerSecond{0.0}; ///< Probes sent per second so far, retries included
+    int concurrency{0};   ///< Probes currently allowed in flight
+    std::vector<std::string> unresolvedTargets; ///< Names that did not resolve (not scanned)
 
     /**
      * @brief Calculates the completion percentage.
@@ -38,10 +43,14 @@ struct PortScanProgress {
  * @brief Interface for port scanning service.
  *
  * Provides methods for scanning TCP ports on remote hosts with progress
- * reporting and cancellation support.
+ * reporting and cancellation support. Several scans may run at once; each is
+ * identified by the ScanId returned when it starts.
  */
 class IPortScanner {
 public:
+    /// Identifies one running scan; never 0.
+    using ScanId = uint64_t;
+
     /**
      * @brief Callback function type for progress updates.
      * @param progress Current scan progress information.
@@ -65,20 +74,27 @@ public:
     /**
      * @brief Starts an asynchronous port scan.
      * @param config Configuration specifying target and ports to scan.
-     * @param onResult Callback for each individual port result.
+     * @param onResult Callback for each open port (each port with reportAllStates).
      * @param onProgress Callback for progress updates.
      * @param onComplete Callback when scan finishes with all results.
+     * @return Identifier of the started scan.
      */
-    virtual void scanAsync(const PortScanConfig& config, ResultCallback onResult,
-                           ProgressCallback onProgress, CompletionCallback onComplete) = 0;
+    virtual ScanId scanAsync(const PortScanConfig& config, ResultCallback onResult,
+                             ProgressCallback onProgress, CompletionCallback onComplete) = 0;
 
     /**
-     * @brief Cancels the current scan operation.
+     * @brief Cancels every running scan.
      */
     virtual void cancel() = 0;
 
     /**
-     * @brief Checks if a scan is currently in progress.
+     * @brief Cancels one scan. Has no effect if it already finished.
+     * @param scanId Identifier returned by scanAsync().
+     */
+    virtual void cancel(ScanId scanId) = 0;
+
+    /**
+     * @brief Checks if any scan is currently in progress.
      * @return True if a scan is running.
      */
     virtual bool isScanning() const = 0;
@@ -0,0 +1,179 @@
+#include "core/types/BannerMatcher.hpp"
+
+#include <deque>
+
+namespace netpulse::core {
+
+namespace {
+
+constexpr size_t MAX_VERSION_LENGTH = 32;
+
+unsigned char fold(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c - 'A' + 'a') : c;
+}
+
+bool isVersionChar(char c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+           c == '.' || c == '-' || c == '_' || c == '+' || c == '~';
+}
+
+// Versions start with a digit, so "ProFTPD Server" does not yield "Server"
+std::string versionAt(std::string_view banner, size_t pos) {
+    if (pos >= banner.size() || banner[pos] < '0' || banner[pos] > '9') {
+        return {};
+    }
+    size_t end = pos;
+    while (end < banner.size() && end - pos < MAX_VERSION_LENGTH && isVersionChar(banner[end])) {
+        ++end;
+    }
+    while (end > pos && (banner[end - 1] == '.' || banner[end - 1] == '-')) {
+        --end;
+    }
+    return std::string(banner.substr(pos, end - pos));
+}
+
+} // namespace
+
+std::string ServiceMatch::describe() const {
+    if (product.empty()) {
+        return version;
+    }
+    return version.empty() ? product : product + " " + version;
+}
+
+BannerMatcher::BannerMatcher(std::vector<ServiceSignature> signatures)
+    : signatures_(std::move(signatures)) {
+    nodes_.emplace_back();
+
+    // Trie of folded patterns; 0 doubles as "no child" since the root is never a child
+    for (size_t index = 0; index < signatures_.size(); ++index) {
+        uint32_t state = 0;
+        for (char c : signatures_[index].pattern) {
+            auto byte = fold(static_cast<unsigned char>(c));
+            if (nodes_[state].next[byte] == 0) {
+                nodes_[state].next[byte] = static_cast<uint32_t>(nodes_.size());
+                nodes_.emplace_back();
+            }
+            state = nodes_[state].next[byte];
+        }
+        if (state != 0 && nodes_[state].match == NO_MATCH) {
+            nodes_[state].match = static_cast<uint32_t>(index);
+        }
+    }
+
+    // Breadth-first pass turning the trie into a DFA: missing transitions
+    // follow the failure link, and each node inherits its suffix's match
+    std::vector<uint32_t> failure(nodes_.size(), 0);
+    std::deque<uint32_t> queue;
+    for (auto child : nodes_[0].next) {
+        if (child != 0) {
+            queue.push_back(child);
+        }
+    }
+    while (!queue.empty()) {
+        auto state = queue.front();
+        queue.pop_front();
+        auto fallback = failure[state];
+        if (nodes_[fallback].match < nodes_[state].match) {
+            nodes_[state].match = nodes_[fallback].match;
+        }
+        for (size_t byte = 0; byte < 256; ++byte) {
+            auto& child = nodes_[state].next[byte];
+            if (child != 0) {
+                failure[child] = nodes_[fallback].next[byte];
+                queue.push_back(child);
+            } else {
+                child = nodes_[fallback].next[byte];
+            }
+        }
+    }
+}
+
+std::optional<ServiceMatch> BannerMatcher::match(std::string_view banner) const {
+    uint32_t state = 0;
+    uint32_t best = NO_MATCH;
+    size_t bestEnd = 0;
+
+    for (size_t i = 0; i < banner.size(); ++i) {
+        state = nodes_[state].next[fold(static_cast<unsigned char>(banner[i]))];
+        auto found = nodes_[state].match;
+        if (found < best) {
+            best = found;
+            bestEnd = i + 1;
+            if (best == 0) {
+                break;
+            }
+        }
+    }
+
+    if (best == NO_MATCH) {
+        return std::nullopt;
+    }
+
+    const auto& signature = signatures_[best];
+    ServiceMatch result{signature.service, signature.product, {}};
+    if (signature.captureVersion) {
+        result.version = versionAt(banner, bestEnd);
+    }
+    return result;
+}
+
+const BannerMatcher& BannerMatcher::defaults() {
+    // Specific products first, generic protocol markers last
+    static const BannerMatcher matcher({
+        {"openssh_", "ssh", "OpenSSH", true},
+        {"dropbear_", "ssh", "Dropbear", true},
+        {"ssh-", "ssh", "", false},
+        {"server: nginx/", "http", "nginx", true},
+        {"server: apache/", "http", "Apache httpd", true},
+        {"server: microsoft-iis/", "http", "Microsoft IIS", true},
+        {"server: lighttpd/", "http", "lighttpd", true},
+        {"server: caddy", "http", "Caddy", false},
+        {"x-elastic-product: elasticsearch", "elasticsearch", "Elasticsearch", false},
+        {"http/1.", "http", "", false},
+        {"vsftpd ", "ftp", "vsftpd", true},
+        {"proftpd ", "ftp", "ProFTPD", true},
+        {"filezilla server ", "ftp", "FileZilla Server", true},
+        {"pure-ftpd", "ftp", "Pure-FTPd", false},
+        {"microsoft ftp service", "ftp", "Microsoft FTP", false},
+        {"esmtp postfix", "smtp", "Postfix", false},
+        {"esmtp exim ", "smtp", "Exim", true},
+        {"esmtp sendmail ", "smtp", "Sendmail", true},
+        {"esmtp", "smtp", "", false},
+        {"+ok dovecot", "pop3", "Dovecot", false},
+        {"] dovecot ready", "imap", "Dovecot", false},
+        {"imap4rev1", "imap", "", false},
+        {"* ok ", "imap", "", false},
+        {"+ok", "pop3", "", false},
+        {"-err unknown command", "redis", "Redis", false},
+        {"-mariadb", "mysql", "MariaDB", false},
+        {"mysql_native_password", "mysql", "MySQL", false},
+        {"caching_sha2_password", "mysql", "MySQL", false},
+        {"rfb 003.", "vnc", "", false},
+        {"\xff\xfd", "telnet", "", false},
+        {"\xff\xfb", "telnet", "", false},
+    });
+    return matcher;
+}
+
+std::string BannerMatcher::firstLine(std::string_view banner, size_t maxLength) {
+    std::string line;
+    for (char c : banner) {
+        if (c == '\r' || c == '\n') {
+            if (!line.empty()) {
+                break;
+            }
+            continue;
+        }
+        if (line.size() >= maxLength) {
+            break;
+        }
+        line.push_back((c >= 0x20 && c < 0x7f) ? c : '.');
+    }
+    while (!line.empty() && line.back() == ' ') {
+        line.pop_back();
+    }
+    return line;
+}
+
+} // namespace netpulse::core
@@ -0,0 +1,108 @@
+/**
+ * @file BannerMatcher.hpp
+ * @brief Service identification from banners sent by open ports.
+ *
+ * This file defines the signatures used to fingerprint a service from the
+ * first bytes it sends, and a matcher that tests all of them in one pass.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace netpulse::core {
+
+/**
+ * @brief A byte pattern that identifies a service in a banner.
+ *
+ * Patterns match ASCII case-insensitively anywhere in the banner. With
+ * captureVersion, the token that directly follows the pattern (letters,
+ * digits and ".-_+~") is taken as the version.
+ */
+struct ServiceSignature {
+    std::string pattern;         ///< Bytes to look for
+    std::string service;         ///< Service name, e.g. "ssh"
+    std::string product;         ///< Implementation, e.g. "OpenSSH" (may be empty)
+    bool captureVersion{false};  ///< Read the version right after the pattern
+};
+
+/**
+ * @brief Service identified from a banner.
+ */
+struct ServiceMatch {
+    std::string service;  ///< Service name
+    std::string product;  ///< Implementation (may be empty)
+    std::string version;  ///< Version string (may be empty)
+
+    /**
+     * @brief Formats product and version for display.
+     * @return e.g. "OpenSSH 9.6p1", or empty if neither is known.
+     */
+    [[nodiscard]] std::string describe() const;
+
+    bool operator==(const ServiceMatch& other) const = default;
+};
+
+/**
+ * @brief Multi-pattern banner matcher (Aho-Corasick).
+ *
+ * Compiles a signature set into a deterministic automaton, so a banner is
+ * matched against every signature in a single pass over its bytes, no matter
+ * how many signatures there are. When several signatures match, the one
+ * listed first wins; list specific patterns before generic ones.
+ *
+ * Immutable after construction and safe to share between threads.
+ */
+class BannerMatcher {
+public:
+    /**
+     * @brief Compiles a signature set.
+     * @param signatures Signatures in priority order; empty patterns are ignored.
+     */
+    explicit BannerMatcher(std::vector<ServiceSignature> signatures);
+
+    /**
+     * @brief Identifies the service that sent a banner.
+     * @param banner Bytes read from the service.
+     * @return The highest-priority match, or nullopt if none matched.
+     */
+    [[nodiscard]] std::optional<ServiceMatch> match(std::string_view banner) const;
+
+    /**
+     * @brief Returns the number of compiled signatures.
+     * @return Signature count.
+     */
+    [[nodiscard]] size_t size() const { return signatures_.size(); }
+
+    /**
+     * @brief Returns the matcher for the built-in signature set.
+     * @return Shared matcher covering common SSH, HTTP, FTP, mail and database banners.
+     */
+    static const BannerMatcher& defaults();
+
+    /**
+     * @brief Reduces a banner to its first line of printable ASCII.
+     * @param banner Raw bytes.
+     * @param maxLength Longest result.
+     * @return The cleaned line.
+     */
+    static std::string firstLine(std::string_view banner, size_t maxLength = 128);
+
+private:
+    static constexpr uint32_t NO_MATCH = UINT32_MAX;
+
+    struct Node {
+        std::array<uint32_t, 256> next{}; // Full DFA transition table
+        uint32_t match{NO_MATCH};         // Best signature ending here or at a suffix
+    };
+
+    std::vector<ServiceSignature> signatures_;
+    std::vector<Node> nodes_;
+};
+
+} // namespace netpulse::core
@@ -0,0 +1,52 @@
+#include "core/types/DiscoveryResult.hpp"
+
+#include "core/types/Ipv4Range.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+namespace netpulse::core {
+
+std::vector<uint32_t> DiscoveryConfig::getAddresses() const {
+    std::vector<Ipv4Range> ranges;
+    std::string list = targetAddress;
+    std::replace(list.begin(), list.end(), ',', ' ');
+    std::istringstream stream(list);
+    std::string spec;
+    while (stream >> spec) {
+        if (auto range = Ipv4Range::parse(spec)) {
+            ranges.push_back(*range);
+        }
+    }
+
+    // Merge overlapping ranges first, so a /8 is never expanded only to be cut
+    std::sort(ranges.begin(), ranges.end(),
+              [](const Ipv4Range& a, const Ipv4Range& b) { return a.first < b.first; });
+    std::vector<uint32_t> addresses;
+    uint64_t next = 0; // Lowest address not yet added
+    for (const auto& range : ranges) {
+        for (uint64_t address = std::max<uint64_t>(range.first, next);
+             address <= range.last && addresses.size() < MAX_ADDRESSES; ++address) {
+            addresses.push_back(static_cast<uint32_t>(address));
+        }
+        next = std::max<uint64_t>(next, uint64_t{range.last} + 1);
+        if (addresses.size() >= MAX_ADDRESSES) {
+            break;
+        }
+    }
+    return addresses;
+}
+
+std::string DiscoveredHost::methodToString(DiscoveryMethod method) {
+    switch (method) {
+    case DiscoveryMethod::Icmp:
+        return "ICMP";
+    case DiscoveryMethod::Tcp:
+        return "TCP";
+    case DiscoveryMethod::Arp:
+        return "ARP";
+    }
+    return "ICMP";
+}
+
+} // namespace netpulse::core
@@ -0,0 +1,96 @@
+/**
+ * @file DiscoveryResult.hpp
+ * @brief Host discovery sweep types, results, and configuration structures.
+ *
+ * This file defines the configuration of a sweep that finds live hosts in
+ * IPv4 ranges, the hosts it reports and its progress.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace netpulse::core {
+
+/**
+ * @brief How a discovered host answered.
+ */
+enum class DiscoveryMethod : int {
+    Icmp = 0, ///< ICMP echo reply
+    Tcp = 1,  ///< TCP handshake completed or refused on one of the probe ports
+    Arp = 2   ///< ARP reply on a directly attached segment
+};
+
+/**
+ * @brief Configuration for a host discovery sweep.
+ *
+ * targetAddress lists IPv4 addresses and CIDR ranges separated by commas or
+ * spaces, such as "10.0.0.0/16, 192.168.1.10".
+ */
+struct DiscoveryConfig {
+    /// Upper bound on the addresses one sweep covers (a /16)
+    static constexpr size_t MAX_ADDRESSES = 65536;
+
+    std::string targetAddress;                ///< Addresses and CIDR ranges to sweep
+    bool useIcmp{true};                       ///< Send ICMP echo requests
+    std::vector<uint16_t> tcpPorts{22, 80, 443, 445, 3389}; ///< Ports tried by TCP probes
+    bool useArp{true};                        ///< ARP for addresses on local segments
+    int maxInFlight{512};                     ///< Addresses probed at once
+    std::chrono::milliseconds timeout{1000};  ///< Time allowed for an address to answer
+
+    /**
+     * @brief Expands targetAddress into individual IPv4 addresses.
+     *
+     * Invalid entries are skipped, duplicates and overlaps are dropped and the
+     * list is truncated at MAX_ADDRESSES.
+     *
+     * @return Addresses in host byte order, ascending.
+     */
+    [[nodiscard]] std::vector<uint32_t> getAddresses() const;
+};
+
+/**
+ * @brief A live host found by a discovery sweep.
+ */
+struct DiscoveredHost {
+    std::string address;                    ///< IPv4 address that answered
+    DiscoveryMethod method{DiscoveryMethod::Icmp}; ///< Probe that got the first answer
+    std::chrono::microseconds latency{0};   ///< Time from probe to answer
+    std::string macAddress;                 ///< Link-layer address (ARP answers only)
+    uint16_t port{0};                       ///< Port that answered (TCP answers only)
+    bool portOpen{false};                   ///< Whether that port accepted the handshake
+
+    /**
+     * @brief Converts a DiscoveryMethod enum to a string.
+     * @param method The method to convert.
+     * @return "ICMP", "TCP" or "ARP".
+     */
+    static std::string methodToString(DiscoveryMethod method);
+
+    bool operator==(const DiscoveredHost& other) const = default;
+};
+
+/**
+ * @brief Progress information during a discovery sweep.
+ */
+struct DiscoveryProgress {
+    uint64_t totalAddresses{0};  ///< Addresses the sweep covers
+    uint64_t probedAddresses{0}; ///< Addresses answered or given up on
+    size_t hostsFound{0};        ///< Live hosts found so far
+    bool cancelled{false};       ///< Whether the sweep was cancelled
+
+    /**
+     * @brief Calculates the completion percentage.
+     * @return Percentage of addresses probed (0-100).
+     */
+    [[nodiscard]] double percentComplete() const {
+        return totalAddresses > 0 ? (static_cast<double>(probedAddresses) /
+                                     static_cast<double>(totalAddresses)) * 100.0
+                                  : 0.0;
+    }
+};
+
+} // namespace netpulse::core
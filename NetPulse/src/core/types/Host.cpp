@@ -4,7 +4,26 @@ namespace netpulse::core {
 
 bool Host::isValid() const {
     return !name.empty() && !address.empty() && pingIntervalSeconds > 0 &&
-           warningThresholdMs > 0 && criticalThresholdMs > warningThresholdMs;
+           warningThresholdMs > 0 && criticalThresholdMs > warningThresholdMs &&
+           burstCount >= 1 && burstCount <= MAX_BURST_COUNT && burstSpacingMs >= 0 &&
+           probePort >= 0 && probePort <= 65535;
+}
+
+int Host::effectiveProbePort() const {
+    if (probePort > 0) {
+        return probePort;
+    }
+    switch (probeType) {
+    case ProbeType::Icmp:
+        return 0;
+    case ProbeType::Tcp:
+        return 80;
+    case ProbeType::Udp:
+        return 7;
+    case ProbeType::Dns:
+        return 53;
+    }
+    return 0;
 }
 
 std::string Host::statusToString() const {
@@ -31,4 +50,48 @@ HostStatus Host::statusFromString(const std::string& str) {
     return HostStatus::Unknown;
 }
 
+std::string Host::addressFamilyToString(AddressFamily family) {
+    switch (family) {
+    case AddressFamily::Any:
+        return "any";
+    case AddressFamily::IPv4:
+        return "ipv4";
+    case AddressFamily::IPv6:
+        return "ipv6";
+    }
+    return "any";
+}
+
+AddressFamily Host::addressFamilyFromString(const std::string& str) {
+    if (str == "ipv4")
+        return AddressFamily::IPv4;
+    if (str == "ipv6")
+        return AddressFamily::IPv6;
+    return AddressFamily::Any;
+}
+
+std::string Host::probeTypeToString(ProbeType type) {
+    switch (type) {
+    case ProbeType::Icmp:
+        return "icmp";
+    case ProbeType::Tcp:
+        return "tcp";
+    case ProbeType::Udp:
+        return "udp";
+    case ProbeType::Dns:
+        return "dns";
+    }
+    return "icmp";
+}
+
+ProbeType Host::probeTypeFromString(const std::string& str) {
+    if (str == "tcp")
+        return ProbeType::Tcp;
+    if (str == "udp")
+        return ProbeType::Udp;
+    if (str == "dns")
+        return ProbeType::Dns;
+    return ProbeType::Icmp;
+}
+
 } // namespace netpulse::core
@@ -25,6 +25,25 @@ enum class HostStatus : int {
     Down = 3     ///< Host is unreachable
 };
 
+/**
+ * @brief IP address family used to reach a host.
+ */
+enum class AddressFamily : int {
+    Any = 0,  ///< Use the first address the resolver returns
+    IPv4 = 4, ///< ICMPv4 over an IPv4 address
+    IPv6 = 6  ///< ICMPv6 over an IPv6 address
+};
+
+/**
+ * @brief How a host's reachability is checked.
+ */
+enum class ProbeType : int {
+    Icmp = 0, ///< ICMP echo request
+    Tcp = 1,  ///< TCP connect to probePort; latency is the handshake time
+    Udp = 2,  ///< UDP datagram to probePort; any reply counts (echo-style services)
+    Dns = 3   ///< DNS query over UDP to probePort; any matching response counts
+};
+
 /**
  * @brief Represents a monitored network host.
  *
@@ -32,6 +51,8 @@ enum class HostStatus : int {
  * being monitored by the ping service.
  */
 struct Host {
+    static constexpr int MAX_BURST_COUNT = 100; ///< Upper bound on probes per check
+
     int64_t id{0};                    ///< Unique identifier for the host
     std::string name;                 ///< Human-readable name for the host
     std::string address;              ///< IP address or hostname to monitor
@@ -41,15 +62,29 @@ struct Host {
     HostStatus status{HostStatus::Unknown}; ///< Current status of the host
     bool enabled{true};               ///< Whether monitoring is enabled for this host
     std::optional<int64_t> groupId;   ///< Optional group ID for organizing hosts
+    AddressFamily addressFamily{AddressFamily::Any}; ///< IP family used for probes
+    int burstCount{1};                ///< Echo requests sent per check (1 disables bursts)
+    int burstSpacingMs{10};           ///< Delay between probes of a burst in milliseconds
+    ProbeType probeType{ProbeType::Icmp}; ///< Probe used to check reachability
+    int probePort{0};                 ///< Port for TCP/UDP/DNS probes (0 uses the default)
     std::chrono::system_clock::time_point createdAt; ///< When the host was created
     std::optional<std::chrono::system_clock::time_point> lastChecked; ///< Last successful check time
 
     /**
      * @brief Validates the host configuration.
-     * @return True if the host has valid configuration (non-empty name and address).
+     * @return True if the host has valid configuration (non-empty name and address,
+     *         positive interval, ordered thresholds, a sane burst setup and
+     *         a valid probe port).
      */
     [[nodiscard]] bool isValid() const;
 
+    /**
+     * @brief Returns the port the configured probe targets.
+     * @return probePort if set, otherwise the probe type's default
+     *         (TCP 80, UDP 7, DNS 53); 0 for ICMP.
+     */
+    [[nodiscard]] int effectiveProbePort() const;
+
     /**
      * @brief Converts the host status to a human-readable string.
      * @return String representation of the status (e.g., "Up", "Down").
@@ -63,6 +98,34 @@ struct Host {
      */
     static HostStatus statusFromString(const std::string& str);
 
+    /**
+     * @brief Converts an address family to its string form.
+     * @param family The family to convert.
+     * @return "any", "ipv4" or "ipv6".
+     */
+    static std::string addressFamilyToString(AddressFamily family);
+
+    /**
+     * @brief Parses a string to get the corresponding AddressFamily.
+     * @param str The string to parse (e.g., "ipv4", "ipv6").
+     * @return The corresponding family, or AddressFamily::Any if unrecognized.
+     */
+    static AddressFamily addressFamilyFromString(const std::string& str);
+
+    /**
+     * @brief Converts a probe type to its string form.
+     * @param type The probe type to convert.
+     * @return "icmp", "tcp", "udp" or "dns".
+     */
+    static std::string probeTypeToString(ProbeType type);
+
+    /**
+     * @brief Parses a string to get the corresponding ProbeType.
+     * @param str The string to parse (e.g., "tcp", "dns").
+     * @return The corresponding probe type, or ProbeType::Icmp if unrecognized.
+     */
+    static ProbeType probeTypeFromString(const std::string& str);
+
     bool operator==(const Host& other) const = default;
 };
 
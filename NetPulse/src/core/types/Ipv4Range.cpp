@@ -0,0 +1,76 @@
+#include "core/types/Ipv4Range.hpp"
+
+#include <charconv>
+
+namespace netpulse::core {
+
+namespace {
+
+// Parses a decimal number in [0, max] that spans the whole of text
+std::optional<uint32_t> parseNumber(std::string_view text, uint32_t max) {
+    if (text.empty() || text.size() > 3) {
+        return std::nullopt;
+    }
+    uint32_t value = 0;
+    auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc() || end != text.data() + text.size() || value > max) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+} // namespace
+
+std::optional<uint32_t> Ipv4Range::parseAddress(const std::string& text) {
+    std::string_view rest(text);
+    uint32_t address = 0;
+    for (int octet = 0; octet < 4; ++octet) {
+        auto dot = rest.find('.');
+        if ((octet < 3) == (dot == std::string_view::npos)) {
+            return std::nullopt;
+        }
+        auto value = parseNumber(rest.substr(0, dot), 255);
+        if (!value) {
+            return std::nullopt;
+        }
+        address = (address << 8) | *value;
+        rest = octet < 3 ? rest.substr(dot + 1) : std::string_view{};
+    }
+    return address;
+}
+
+std::string Ipv4Range::formatAddress(uint32_t address) {
+    return std::to_string(address >> 24) + "." + std::to_string((address >> 16) & 0xFF) + "." +
+           std::to_string((address >> 8) & 0xFF) + "." + std::to_string(address & 0xFF);
+}
+
+std::optional<Ipv4Range> Ipv4Range::parse(const std::string& spec) {
+    auto slash = spec.find('/');
+    auto address = parseAddress(spec.substr(0, slash));
+    if (!address) {
+        return std::nullopt;
+    }
+    if (slash == std::string::npos) {
+        return Ipv4Range{*address, *address};
+    }
+
+    auto prefix = parseNumber(std::string_view(spec).substr(slash + 1), 32);
+    if (!prefix) {
+        return std::nullopt;
+    }
+
+    uint32_t hostMask = *prefix == 0 ? 0xFFFFFFFFu : (uint32_t{1} << (32 - *prefix)) - 1;
+    Ipv4Range range{*address & ~hostMask, *address | hostMask};
+    if (*prefix <= 30) {
+        // Skip the network and broadcast addresses
+        ++range.first;
+        --range.last;
+    }
+    return range;
+}
+
+std::string Ipv4Range::addressAt(uint64_t index) const {
+    return formatAddress(static_cast<uint32_t>(first + index));
+}
+
+} // namespace netpulse::core
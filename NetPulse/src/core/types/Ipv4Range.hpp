@@ -0,0 +1,65 @@
+/**
+ * @file Ipv4Range.hpp
+ * @brief IPv4 address ranges parsed from CIDR notation.
+ *
+ * This file defines a small value type used to expand scan and discovery
+ * targets such as "192.168.1.0/24" into individual host addresses.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace netpulse::core {
+
+/**
+ * @brief Inclusive range of IPv4 host addresses.
+ *
+ * Parsed from a single address ("10.0.0.5") or a CIDR block ("10.0.0.0/24").
+ * Blocks of /30 and wider exclude their network and broadcast addresses;
+ * /31 and /32 keep every address.
+ */
+struct Ipv4Range {
+    uint32_t first{0}; ///< First host address (host byte order)
+    uint32_t last{0};  ///< Last host address (host byte order)
+
+    /**
+     * @brief Parses an address or CIDR block.
+     * @param spec Dotted-quad address with an optional "/prefix" (0-32).
+     * @return The range, or nullopt if spec is not IPv4 or CIDR notation.
+     */
+    static std::optional<Ipv4Range> parse(const std::string& spec);
+
+    /**
+     * @brief Parses a dotted-quad IPv4 address.
+     * @param text Address such as "192.168.1.10".
+     * @return The address in host byte order, or nullopt if invalid.
+     */
+    static std::optional<uint32_t> parseAddress(const std::string& text);
+
+    /**
+     * @brief Formats an address as a dotted quad.
+     * @param address Address in host byte order.
+     * @return Dotted-quad string.
+     */
+    static std::string formatAddress(uint32_t address);
+
+    /**
+     * @brief Returns the number of addresses in the range.
+     * @return Address count (at least 1).
+     */
+    [[nodiscard]] uint64_t size() const { return uint64_t{last} - first + 1; }
+
+    /**
+     * @brief Returns the address at an offset from the start of the range.
+     * @param index Offset in [0, size()).
+     * @return Dotted-quad string.
+     */
+    [[nodiscard]] std::string addressAt(uint64_t index) const;
+
+    bool operator==(const Ipv4Range& other) const = default;
+};
+
+} // namespace netpulse::core
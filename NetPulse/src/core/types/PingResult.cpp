@@ -1,8 +1,83 @@
 #include "core/types/PingResult.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 namespace netpulse::core {
 
-// Most functionality is inline in the header
-// This file exists for future extensions and to satisfy the build system
+PingResult PingResult::fromBurst(const std::vector<PingResult>& probes,
+                                 const std::vector<size_t>& arrivalOrder) {
+    PingResult result;
+    BurstSummary summary;
+    summary.probesSent = static_cast<int>(probes.size());
+    if (probes.empty()) {
+        result.burst = summary;
+        return result;
+    }
+
+    result.hostId = probes.front().hostId;
+    result.timestamp = probes.front().timestamp;
+
+    int64_t sum = 0;
+    int64_t minUs = 0;
+    int64_t maxUs = 0;
+    for (const auto& probe : probes) {
+        if (result.family == AddressFamily::Any) {
+            result.family = probe.family;
+        }
+        if (!probe.success) {
+            result.errorMessage = probe.errorMessage;
+            continue;
+        }
+        auto us = probe.latency.count();
+        minUs = summary.probesReceived == 0 ? us : std::min(minUs, us);
+        maxUs = summary.probesReceived == 0 ? us : std::max(maxUs, us);
+        sum += us;
+        if (!result.ttl) {
+            result.ttl = probe.ttl;
+            result.timestampSource = probe.timestampSource;
+        }
+        ++summary.probesReceived;
+    }
+
+    if (summary.probesReceived > 0) {
+        double mean = static_cast<double>(sum) / summary.probesReceived;
+        double variance = 0.0;
+        for (const auto& probe : probes) {
+            if (probe.success) {
+                double delta = static_cast<double>(probe.latency.count()) - mean;
+                variance += delta * delta;
+            }
+        }
+        variance /= summary.probesReceived;
+
+        summary.minLatency = std::chrono::microseconds(minUs);
+        summary.maxLatency = std::chrono::microseconds(maxUs);
+        summary.avgLatency = std::chrono::microseconds(std::llround(mean));
+        summary.stddev = std::chrono::microseconds(std::llround(std::sqrt(variance)));
+
+        result.success = true;
+        result.latency = summary.avgLatency;
+        result.errorMessage.clear();
+    }
+
+    // A reply is out of order if a later probe was answered before it
+    size_t highest = 0;
+    bool any = false;
+    for (size_t index : arrivalOrder) {
+        if (index >= probes.size() || !probes[index].success) {
+            continue;
+        }
+        if (any && index < highest) {
+            ++summary.outOfOrder;
+        } else {
+            highest = index;
+            any = true;
+        }
+    }
+
+    result.burst = summary;
+    return result;
+}
 
 } // namespace netpulse::core
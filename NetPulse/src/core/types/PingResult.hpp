@@ -8,13 +8,52 @@
 
 #pragma once
 
+#include "core/types/Host.hpp"
+
 #include <chrono>
 #include <cstdint>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace netpulse::core {
 
+/**
+ * @brief Clock that produced a ping's round-trip time.
+ */
+enum class TimestampSource : int {
+    Userspace = 0,    ///< Timed by the worker thread around the socket calls
+    Kernel = 1,       ///< Request and reply stamped by the kernel (SO_TIMESTAMPING/NS)
+    KernelReceive = 2 ///< Reply stamped by the kernel; send time taken in userspace
+};
+
+/**
+ * @brief Summary of one multi-probe burst, computed where the probes were sent.
+ *
+ * Latency figures only cover probes that received a reply.
+ */
+struct BurstSummary {
+    int probesSent{0};     ///< Echo requests sent in the burst
+    int probesReceived{0}; ///< Echo replies received before their timeout
+    std::chrono::microseconds minLatency{0}; ///< Fastest reply
+    std::chrono::microseconds avgLatency{0}; ///< Mean round-trip time
+    std::chrono::microseconds maxLatency{0}; ///< Slowest reply
+    std::chrono::microseconds stddev{0};     ///< Population standard deviation of the RTTs
+    int outOfOrder{0};     ///< Replies that arrived after a later probe's reply
+
+    /**
+     * @brief Calculates the share of probes that went unanswered.
+     * @return Loss as a percentage (0-100).
+     */
+    [[nodiscard]] double lossPercent() const {
+        return probesSent > 0
+                   ? (1.0 - static_cast<double>(probesReceived) / probesSent) * 100.0
+                   : 0.0;
+    }
+
+    bool operator==(const BurstSummary& other) const = default;
+};
+
 /**
  * @brief Result of a single ICMP ping operation.
  *
@@ -29,6 +68,11 @@ struct PingResult {
     bool success{false};     ///< Whether the ping received a response
     std::optional<int> ttl;  ///< Time-to-live from the response (if available)
     std::string errorMessage; ///< Error message if the ping failed
+    AddressFamily family{AddressFamily::Any}; ///< Family used for the probe (Any if unsent)
+    std::optional<BurstSummary> burst; ///< Set when this result aggregates a burst
+    TimestampSource timestampSource{TimestampSource::Userspace}; ///< Clock behind latency
+    int missedCycles{0}; ///< Scheduled checks skipped since the previous result (overrun)
+    std::chrono::microseconds scheduleLag{0}; ///< How far past its deadline the check started
 
     /**
      * @brief Converts the latency to milliseconds.
@@ -38,6 +82,19 @@ struct PingResult {
         return static_cast<double>(latency.count()) / 1000.0;
     }
 
+    /**
+     * @brief Aggregates the probes of one burst into a single result.
+     *
+     * The result succeeds if any probe was answered; its latency is the mean
+     * RTT and its burst summary carries the full distribution.
+     *
+     * @param probes Individual probe results, in send order.
+     * @param arrivalOrder Indices into probes in the order their replies completed.
+     * @return The aggregated result.
+     */
+    static PingResult fromBurst(const std::vector<PingResult>& probes,
+                                const std::vector<size_t>& arrivalOrder);
+
     bool operator==(const PingResult& other) const = default;
 };
 
@@ -48,12 +105,13 @@ struct PingResult {
  */
 struct PingStatistics {
     int64_t hostId{0};        ///< ID of the host these statistics are for
-    int totalPings{0};        ///< Total number of ping attempts
+    int totalPings{0};        ///< Probes sent; missed cycles are not counted
     int successfulPings{0};   ///< Number of successful pings
     std::chrono::microseconds minLatency{0}; ///< Minimum observed latency
     std::chrono::microseconds maxLatency{0}; ///< Maximum observed latency
     std::chrono::microseconds avgLatency{0}; ///< Average latency
     std::chrono::microseconds jitter{0};     ///< Latency variation (jitter)
+    int missedCycles{0};      ///< Checks skipped because earlier ones were still running
     double packetLossPercent{0.0}; ///< Percentage of pings that failed
 
     /**
@@ -1,5 +1,11 @@
 #include "core/types/PortScanResult.hpp"
 
+#include "core/types/Ipv4Range.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <unordered_set>
+
 namespace netpulse::core {
 
 std::string PortScanResult::stateToString() const {
@@ -54,6 +60,32 @@ std::vector<uint16_t> PortScanConfig::getPortsToScan() const {
     return {};
 }
 
+std::vector<std::string> PortScanConfig::getTargets() const {
+    std::vector<std::string> targets;
+    std::unordered_set<std::string> seen;
+    auto add = [&](std::string target) {
+        if (targets.size() < MAX_TARGETS && seen.insert(target).second) {
+            targets.push_back(std::move(target));
+        }
+    };
+
+    std::string list = targetAddress;
+    std::replace(list.begin(), list.end(), ',', ' ');
+    std::istringstream stream(list);
+    std::string spec;
+    while (stream >> spec && targets.size() < MAX_TARGETS) {
+        auto cidr = spec.find('/') != std::string::npos ? Ipv4Range::parse(spec) : std::nullopt;
+        if (!cidr) {
+            add(spec);
+            continue;
+        }
+        for (uint64_t i = 0; i < cidr->size() && targets.size() < MAX_TARGETS; ++i) {
+            add(cidr->addressAt(i));
+        }
+    }
+    return targets;
+}
+
 const std::unordered_map<uint16_t, std::string>& ServiceDetector::getKnownServices() {
     static const std::unordered_map<uint16_t, std::string> services = {
         {20, "ftp-data"},   {21, "ftp"},        {22, "ssh"},        {23, "telnet"},
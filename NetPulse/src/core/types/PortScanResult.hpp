@@ -38,6 +38,8 @@ struct PortScanResult {
     PortState state{PortState::Unknown}; ///< Current state of the port
     std::string serviceName;     ///< Name of detected service (if known)
     std::chrono::system_clock::time_point scanTimestamp; ///< When the scan was performed
+    std::string serviceVersion;  ///< Product and version from the banner (if identified)
+    std::string banner;          ///< First line the service sent (if grabbed)
 
     /**
      * @brief Converts this result's port state to a string.
@@ -73,23 +75,53 @@ enum class PortRange {
     Custom    ///< Custom list of ports
 };
 
+/**
+ * @brief How a port scan probes each port.
+ */
+enum class ScanMode {
+    Connect, ///< Full TCP connect through the socket API
+    Syn      ///< Half-open scan with raw SYN segments (needs raw socket access)
+};
+
 /**
  * @brief Configuration for a port scan operation.
  *
- * Specifies the target, ports to scan, and scan parameters.
+ * Specifies the targets, ports to scan, and scan parameters. targetAddress
+ * may list several targets separated by commas or spaces, each an address,
+ * a hostname or an IPv4 CIDR range such as "10.0.0.0/24".
  */
 struct PortScanConfig {
-    std::string targetAddress;            ///< Target IP address or hostname
+    /// Upper bound on the hosts one scan expands to (a /16)
+    static constexpr size_t MAX_TARGETS = 65536;
+
+    std::string targetAddress;            ///< Target address, hostname, CIDR range, or a list
     PortRange range{PortRange::Common};   ///< Predefined port range to scan
     std::vector<uint16_t> customPorts;    ///< Custom ports (used when range is Custom)
-    int maxConcurrency{100};              ///< Maximum concurrent connection attempts
+    int maxConcurrency{100};              ///< Concurrent attempts (initial value if adaptive)
+    int maxPerTarget{0};                  ///< Concurrent attempts per target (0 = no limit)
     std::chrono::milliseconds timeout{1000}; ///< Timeout per port in milliseconds
+    ScanMode mode{ScanMode::Connect};     ///< Probe technique; Syn falls back to Connect
+    int maxRetries{1};                    ///< Extra probes for a port whose probe timed out
+    bool adaptiveRate{true};              ///< Grow or shrink concurrency with responsiveness
+    bool reportAllStates{false};          ///< Stream closed and filtered results too, not only open
+    bool grabBanners{false};              ///< Read open ports' banners to identify the service
+    std::chrono::milliseconds bannerTimeout{500}; ///< Time allowed per banner read
 
     /**
      * @brief Gets the list of ports to scan based on the configuration.
      * @return Vector of port numbers to scan.
      */
     [[nodiscard]] std::vector<uint16_t> getPortsToScan() const;
+
+    /**
+     * @brief Expands targetAddress into individual targets.
+     *
+     * CIDR ranges become one entry per host address; duplicates are dropped
+     * and the list is truncated at MAX_TARGETS.
+     *
+     * @return Targets in the order given.
+     */
+    [[nodiscard]] std::vector<std::string> getTargets() const;
 };
 
 /**
@@ -0,0 +1,61 @@
+#include "core/types/PortStateBitmap.hpp"
+
+namespace netpulse::core {
+
+namespace {
+
+constexpr uint64_t STATE_MASK = 0x3;
+
+} // namespace
+
+void PortStateBitmap::set(uint16_t port, PortState state) {
+    auto& word = words_[port / PORTS_PER_WORD];
+    auto shift = (port % PORTS_PER_WORD) * 2;
+    auto value = static_cast<uint64_t>(static_cast<int>(state)) & STATE_MASK;
+    word = (word & ~(STATE_MASK << shift)) | (value << shift);
+}
+
+PortState PortStateBitmap::get(uint16_t port) const {
+    auto shift = (port % PORTS_PER_WORD) * 2;
+    return static_cast<PortState>((words_[port / PORTS_PER_WORD] >> shift) & STATE_MASK);
+}
+
+size_t PortStateBitmap::count(PortState state) const {
+    // XOR with the state repeated in every field leaves 00 where it matches
+    auto value = static_cast<uint64_t>(static_cast<int>(state)) & STATE_MASK;
+    uint64_t pattern = value * LOW_BITS;
+
+    size_t total = 0;
+    for (auto word : words_) {
+        uint64_t x = word ^ pattern;
+        total += static_cast<size_t>(std::popcount(~(x | (x >> 1)) & LOW_BITS));
+    }
+    return total;
+}
+
+void PortStateBitmap::overlay(const PortStateBitmap& newer) {
+    for (size_t i = 0; i < WORD_COUNT; ++i) {
+        // Both bits of every field that is not Unknown (00) in newer
+        uint64_t known = (newer.words_[i] | (newer.words_[i] >> 1)) & LOW_BITS;
+        uint64_t mask = known | (known << 1);
+        words_[i] = (words_[i] & ~mask) | (newer.words_[i] & mask);
+    }
+}
+
+PortStateBitmap PortStateBitmap::fromResults(const std::vector<PortScanResult>& results) {
+    PortStateBitmap bitmap;
+    for (const auto& result : results) {
+        bitmap.set(result.port, result.state);
+    }
+    return bitmap;
+}
+
+std::vector<uint16_t> PortStateBitmap::differences(const PortStateBitmap& after) const {
+    std::vector<uint16_t> ports;
+    forEachDifference(after, [&ports](uint16_t port, PortState, PortState) {
+        ports.push_back(port);
+    });
+    return ports;
+}
+
+} // namespace netpulse::core
@@ -0,0 +1,131 @@
+/**
+ * @file PortStateBitmap.hpp
+ * @brief Compact record of every TCP port's state on one host.
+ *
+ * This file defines a fixed-size bitmap holding a 2-bit PortState for each of
+ * the 65,536 ports, used to keep scheduled scan results in memory and to diff
+ * consecutive scans without per-port allocations.
+ */
+
+#pragma once
+
+#include "core/types/PortScanResult.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace netpulse::core {
+
+/**
+ * @brief PortState of all 65,536 ports of one host, two bits per port.
+ *
+ * Ports never set read as Unknown. The whole map is 16 KiB, so hundreds of
+ * targets fit comfortably in memory, and comparing two scans is a XOR over
+ * 2,048 words that the compiler vectorizes; only ports that differ are
+ * decoded.
+ */
+class PortStateBitmap {
+public:
+    static constexpr size_t PORT_COUNT = 65536;
+
+    /**
+     * @brief Records the state of a port.
+     * @param port Port number.
+     * @param state New state; Unknown clears the port.
+     */
+    void set(uint16_t port, PortState state);
+
+    /**
+     * @brief Returns the state of a port.
+     * @param port Port number.
+     * @return The recorded state, or Unknown if never set.
+     */
+    [[nodiscard]] PortState get(uint16_t port) const;
+
+    /**
+     * @brief Counts the ports in a state.
+     * @param state State to count.
+     * @return Number of ports with that state.
+     */
+    [[nodiscard]] size_t count(PortState state) const;
+
+    /**
+     * @brief Returns the number of ports with a known state.
+     * @return Ports that are not Unknown.
+     */
+    [[nodiscard]] size_t knownCount() const { return PORT_COUNT - count(PortState::Unknown); }
+
+    /**
+     * @brief Copies every known port of another bitmap over this one.
+     *
+     * Ports Unknown in newer keep their state here, so a partial scan can
+     * update a baseline without erasing the ports it did not reach.
+     *
+     * @param newer Bitmap whose known ports win.
+     */
+    void overlay(const PortStateBitmap& newer);
+
+    /**
+     * @brief Builds a bitmap from scan results, ignoring their target.
+     * @param results Results for one host; later entries win.
+     * @return The bitmap.
+     */
+    static PortStateBitmap fromResults(const std::vector<PortScanResult>& results);
+
+    /**
+     * @brief Visits each port whose state differs in another bitmap.
+     *
+     * Ports are visited in ascending order.
+     *
+     * @param after Bitmap to compare with (typically the newer scan).
+     * @param visit Called as visit(port, stateHere, stateInAfter).
+     */
+    template <typename Visitor>
+    void forEachDifference(const PortStateBitmap& after, Visitor&& visit) const {
+        for (size_t block = 0; block < WORD_COUNT; block += BLOCK_WORDS) {
+            // Branch-free OR of a block's XORs; the common all-equal case
+            // costs a few vector instructions per 512 ports
+            uint64_t any = 0;
+            for (size_t i = block; i < block + BLOCK_WORDS; ++i) {
+                any |= words_[i] ^ after.words_[i];
+            }
+            if (any == 0) {
+                continue;
+            }
+
+            for (size_t i = block; i < block + BLOCK_WORDS; ++i) {
+                uint64_t diff = words_[i] ^ after.words_[i];
+                // Fold each 2-bit field into its low bit
+                diff = (diff | (diff >> 1)) & LOW_BITS;
+                while (diff != 0) {
+                    auto bit = static_cast<size_t>(std::countr_zero(diff));
+                    auto port = static_cast<uint16_t>(i * PORTS_PER_WORD + bit / 2);
+                    visit(port, get(port), after.get(port));
+                    diff &= diff - 1;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Lists the ports whose state differs in another bitmap.
+     * @param after Bitmap to compare with.
+     * @return Differing ports in ascending order.
+     */
+    [[nodiscard]] std::vector<uint16_t> differences(const PortStateBitmap& after) const;
+
+    bool operator==(const PortStateBitmap& other) const = default;
+
+private:
+    static constexpr size_t PORTS_PER_WORD = 32;
+    static constexpr size_t WORD_COUNT = PORT_COUNT / PORTS_PER_WORD;
+    static constexpr size_t BLOCK_WORDS = 8;
+    static constexpr uint64_t LOW_BITS = 0x5555555555555555ULL;
+
+    std::array<uint64_t, WORD_COUNT> words_{};
+};
+
+} // namespace netpulse::core
@@ -0,0 +1,15 @@
+#include "core/types/ScanCheckpoint.hpp"
+
+#include <numeric>
+
+namespace netpulse::core {
+
+size_t ScanCheckpoint::scannedPorts() const {
+    return std::accumulate(portsDone.begin(), portsDone.end(), size_t{0});
+}
+
+size_t ScanCheckpoint::totalPorts() const {
+    return targets.size() * config.getPortsToScan().size();
+}
+
+} // namespace netpulse::core
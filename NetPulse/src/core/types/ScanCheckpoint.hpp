@@ -0,0 +1,49 @@
+/**
+ * @file ScanCheckpoint.hpp
+ * @brief Saved progress of a port scan, for resuming it later.
+ *
+ * This file defines the snapshot a long port scan records periodically so a
+ * cancel, restart or crash does not lose the ports it has already probed.
+ */
+
+#pragma once
+
+#include "core/types/PortScanResult.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace netpulse::core {
+
+/**
+ * @brief Progress of one port scan at a point in time.
+ *
+ * Ports are probed in the order of config.getPortsToScan(), so per target
+ * the progress is a count of leading ports that are done; ports past it are
+ * probed again on resume even if some of them had finished.
+ */
+struct ScanCheckpoint {
+    std::string key;                     ///< Identifies the scan across restarts
+    PortScanConfig config;               ///< Configuration the scan was started with
+    std::vector<std::string> targets;    ///< Targets as expanded when the scan started
+    std::vector<size_t> portsDone;       ///< Per target, leading ports already probed
+    std::vector<PortScanResult> results; ///< Open ports found (only new ones when emitted)
+    bool finished{false};                ///< Ran to completion; nothing left to resume
+    std::chrono::system_clock::time_point updatedAt; ///< When the snapshot was taken
+
+    /**
+     * @brief Counts the ports already probed across all targets.
+     * @return Sum of portsDone.
+     */
+    [[nodiscard]] size_t scannedPorts() const;
+
+    /**
+     * @brief Counts the ports the whole scan probes.
+     * @return Targets times ports per target.
+     */
+    [[nodiscard]] size_t totalPorts() const;
+};
+
+} // namespace netpulse::core
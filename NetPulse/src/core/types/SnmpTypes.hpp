@@ -162,6 +162,23 @@ struct SnmpResult {
     bool operator==(const SnmpResult& other) const = default;
 };
 
+/**
+ * @brief Outcome of a walk whose varbinds were delivered to a callback.
+ *
+ * The varbinds themselves are not kept, so a walk of any size runs in
+ * constant memory.
+ */
+struct SnmpWalkResult {
+    std::chrono::system_clock::time_point timestamp; ///< When the walk started
+    size_t varbindCount{0};          ///< Varbinds delivered across all roots
+    size_t requests{0};              ///< Requests sent, retries included
+    std::chrono::microseconds duration{0}; ///< Time from the first request to the last answer
+    bool success{false};             ///< Whether every root was walked to its end
+    std::string errorMessage;        ///< First failure, prefixed with its root OID
+
+    bool operator==(const SnmpWalkResult& other) const = default;
+};
+
 /**
  * @brief Configuration for SNMP device monitoring.
  *
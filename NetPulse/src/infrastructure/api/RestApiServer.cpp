@@ -1,5 +1,8 @@
 #include "infrastructure/api/RestApiServer.hpp"
 
+#include "infrastructure/network/BlockingExecutor.hpp"
+#include "infrastructure/network/DnsCache.hpp"
+
 #include <algorithm>
 #include <chrono>
 #include <regex>
@@ -26,6 +29,11 @@ nlohmann::json hostToJson(const core::Host& host) {
     j["criticalThresholdMs"] = host.criticalThresholdMs;
     j["status"] = host.statusToString();
     j["enabled"] = host.enabled;
+    j["addressFamily"] = core::Host::addressFamilyToString(host.addressFamily);
+    j["burstCount"] = host.burstCount;
+    j["burstSpacingMs"] = host.burstSpacingMs;
+    j["probeType"] = core::Host::probeTypeToString(host.probeType);
+    j["probePort"] = host.probePort;
     if (host.groupId) {
         j["groupId"] = *host.groupId;
     } else {
@@ -90,6 +98,33 @@ nlohmann::json pingResultToJson(const core::PingResult& result) {
         j["ttl"] = nullptr;
     }
     j["errorMessage"] = result.errorMessage;
+    j["addressFamily"] = core::Host::addressFamilyToString(result.family);
+    switch (result.timestampSource) {
+    case core::TimestampSource::Kernel:
+        j["timestampSource"] = "kernel";
+        break;
+    case core::TimestampSource::KernelReceive:
+        j["timestampSource"] = "kernel-receive";
+        break;
+    default:
+        j["timestampSource"] = "userspace";
+        break;
+    }
+    j["missedCycles"] = result.missedCycles;
+    j["scheduleLagMs"] = static_cast<double>(result.scheduleLag.count()) / 1000.0;
+    if (result.burst) {
+        const auto& burst = *result.burst;
+        j["burst"] = {{"probesSent", burst.probesSent},
+                      {"probesReceived", burst.probesReceived},
+                      {"lossPercent", burst.lossPercent()},
+                      {"minLatencyMs", static_cast<double>(burst.minLatency.count()) / 1000.0},
+                      {"avgLatencyMs", static_cast<double>(burst.avgLatency.count()) / 1000.0},
+                      {"maxLatencyMs", static_cast<double>(burst.maxLatency.count()) / 1000.0},
+                      {"stddevMs", static_cast<double>(burst.stddev.count()) / 1000.0},
+                      {"outOfOrder", burst.outOfOrder}};
+    } else {
+        j["burst"] = nullptr;
+    }
     return j;
 }
 
@@ -102,6 +137,7 @@ nlohmann::json statisticsToJson(const core::PingStatistics& stats) {
     j["maxLatencyMs"] = static_cast<double>(stats.maxLatency.count()) / 1000.0;
     j["avgLatencyMs"] = static_cast<double>(stats.avgLatency.count()) / 1000.0;
     j["jitterMs"] = static_cast<double>(stats.jitter.count()) / 1000.0;
+    j["missedCycles"] = stats.missedCycles;
     j["packetLossPercent"] = stats.packetLossPercent;
     j["successRate"] = stats.successRate();
     return j;
@@ -230,6 +266,12 @@ void RestApiServer::registerRoutes() {
     // Port scan endpoints
     routes_.push_back({HttpMethod::GET, "/api/portscans",
                        [this](auto& req, auto& res) { handleGetPortScans(req, res); }});
+
+    // Diagnostics endpoints
+    routes_.push_back({HttpMethod::GET, "/api/diagnostics/dns",
+                       [this](auto& req, auto& res) { handleDnsDiagnostics(req, res); }});
+    routes_.push_back({HttpMethod::GET, "/api/diagnostics/event-loop",
+                       [this](auto& req, auto& res) { handleEventLoopDiagnostics(req, res); }});
 }
 
 void RestApiServer::start() {
@@ -580,6 +622,12 @@ void RestApiServer::handleCreateHost(const ApiRequest& req, ApiResponse& res) {
         host.warningThresholdMs = json.value("warningThresholdMs", 100);
         host.criticalThresholdMs = json.value("criticalThresholdMs", 500);
         host.enabled = json.value("enabled", true);
+        host.addressFamily =
+            core::Host::addressFamilyFromString(json.value("addressFamily", "any"));
+        host.burstCount = json.value("burstCount", 1);
+        host.burstSpacingMs = json.value("burstSpacingMs", 10);
+        host.probeType = core::Host::probeTypeFromString(json.value("probeType", "icmp"));
+        host.probePort = json.value("probePort", 0);
 
         if (json.contains("groupId") && !json["groupId"].is_null()) {
             host.groupId = json["groupId"].get<int64_t>();
@@ -637,6 +685,18 @@ void RestApiServer::handleUpdateHost(const ApiRequest& req, ApiResponse& res) {
             host.criticalThresholdMs = json["criticalThresholdMs"];
         if (json.contains("enabled"))
             host.enabled = json["enabled"];
+        if (json.contains("addressFamily"))
+            host.addressFamily = core::Host::addressFamilyFromString(
+                json["addressFamily"].get<std::string>());
+        if (json.contains("burstCount"))
+            host.burstCount = json["burstCount"];
+        if (json.contains("burstSpacingMs"))
+            host.burstSpacingMs = json["burstSpacingMs"];
+        if (json.contains("probeType"))
+            host.probeType =
+                core::Host::probeTypeFromString(json["probeType"].get<std::string>());
+        if (json.contains("probePort"))
+            host.probePort = json["probePort"];
         if (json.contains("groupId")) {
             if (json["groupId"].is_null()) {
                 host.groupId = std::nullopt;
@@ -986,6 +1046,70 @@ void RestApiServer::handleGetPortScans(const ApiRequest& req, ApiResponse& res)
     res.setJson(response);
 }
 
+// Diagnostics endpoints
+void RestApiServer::handleDnsDiagnostics(const ApiRequest& /*req*/, ApiResponse& res) {
+    auto stats = asioContext_.dnsCache().stats();
+
+    nlohmann::json dns;
+    dns["hits"] = stats.hits;
+    dns["negativeHits"] = stats.negativeHits;
+    dns["misses"] = stats.misses;
+    dns["staleServes"] = stats.staleServes;
+    dns["failures"] = stats.failures;
+    dns["entries"] = stats.entries;
+    dns["inFlight"] = stats.inFlight;
+
+    auto lookups = stats.hits + stats.negativeHits + stats.misses + stats.staleServes;
+    dns["hitRate"] =
+        lookups > 0 ? static_cast<double>(lookups - stats.misses) / static_cast<double>(lookups)
+                    : 0.0;
+
+    res.setJson(dns);
+}
+
+void RestApiServer::handleEventLoopDiagnostics(const ApiRequest& /*req*/, ApiResponse& res) {
+    auto metrics = asioContext_.loopMetrics();
+    auto blocking = asioContext_.blockingExecutor().stats();
+
+    nlohmann::json loop;
+    loop["topology"] = AsioContext::topologyToString(asioContext_.topology());
+    loop["threads"] = asioContext_.threadCount();
+    loop["samples"] = metrics.samples;
+    loop["handlers"] = metrics.handlers;
+    loop["handlersPerSecond"] = metrics.handlersPerSecond;
+    loop["busyPercent"] = metrics.busyPercent;
+    loop["longestHandlerUs"] = metrics.longestHandler.count();
+    loop["queueLatencyUs"] = metrics.queueLatency.count();
+    loop["queueLatencyAvgUs"] = metrics.queueLatencyAvg.count();
+    loop["queueLatencyMaxUs"] = metrics.queueLatencyMax.count();
+
+    nlohmann::json workers = nlohmann::json::array();
+    for (const auto& worker : metrics.workers) {
+        nlohmann::json entry;
+        entry["index"] = worker.index;
+        entry["handlers"] = worker.handlers;
+        entry["handlersPerSecond"] = worker.handlersPerSecond;
+        entry["busyPercent"] = worker.busyPercent;
+        entry["longestHandlerUs"] = worker.longestHandler.count();
+        workers.push_back(entry);
+    }
+    loop["workers"] = workers;
+
+    nlohmann::json pool;
+    pool["threads"] = blocking.threads;
+    pool["capacity"] = blocking.capacity;
+    pool["queued"] = blocking.queued;
+    pool["peakQueued"] = blocking.peakQueued;
+    pool["active"] = blocking.active;
+    pool["submitted"] = blocking.submitted;
+    pool["completed"] = blocking.completed;
+    pool["rejected"] = blocking.rejected;
+    pool["cancelled"] = blocking.cancelled;
+    loop["blocking"] = pool;
+
+    res.setJson(loop);
+}
+
 // Health endpoint
 void RestApiServer::handleHealth(const ApiRequest& /*req*/, ApiResponse& res) {
     nlohmann::json health;
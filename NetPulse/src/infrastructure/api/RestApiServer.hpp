@@ -174,6 +174,10 @@ private:
     // Port scan endpoints
     void handleGetPortScans(const ApiRequest& req, ApiResponse& res);
 
+    // Diagnostics endpoints
+    void handleDnsDiagnostics(const ApiRequest& req, ApiResponse& res);
+    void handleEventLoopDiagnostics(const ApiRequest& req, ApiResponse& res);
+
     // Health endpoint
     void handleHealth(const ApiRequest& req, ApiResponse& res);
 
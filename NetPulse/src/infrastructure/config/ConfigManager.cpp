@@ -73,6 +73,19 @@ nlohmann::json ConfigManager::toJson() const {
     j["monitoring"]["default_ping_interval_seconds"] = config_.defaultPingIntervalSeconds;
     j["monitoring"]["default_warning_threshold_ms"] = config_.defaultWarningThresholdMs;
     j["monitoring"]["default_critical_threshold_ms"] = config_.defaultCriticalThresholdMs;
+    j["monitoring"]["probe_spread_policy"] = config_.probeSpreadPolicy;
+    j["monitoring"]["kernel_timestamps"] = config_.kernelTimestamps;
+    j["monitoring"]["adaptive_timeouts"] = config_.adaptiveTimeouts;
+    j["monitoring"]["probe_timeout_floor_ms"] = config_.probeTimeoutFloorMs;
+    j["monitoring"]["probe_timeout_ceiling_ms"] = config_.probeTimeoutCeilingMs;
+    j["monitoring"]["max_in_flight_probes"] = config_.maxInFlightProbes;
+
+    // Network engine
+    j["network"]["io_threads"] = config_.ioThreads;
+    j["network"]["io_topology"] = config_.ioTopology;
+    j["network"]["pin_io_threads"] = config_.pinIoThreads;
+    j["network"]["blocking_threads"] = config_.blockingThreads;
+    j["network"]["blocking_queue_capacity"] = config_.blockingQueueCapacity;
 
     // Alerts
     j["alerts"]["latency_warning_ms"] = config_.alertThresholds.latencyWarningMs;
@@ -91,6 +104,14 @@ nlohmann::json ConfigManager::toJson() const {
     // Port scanner
     j["port_scanner"]["concurrency"] = config_.portScanConcurrency;
     j["port_scanner"]["timeout_ms"] = config_.portScanTimeoutMs;
+    j["port_scanner"]["per_target"] = config_.portScanPerTarget;
+    j["port_scanner"]["max_connections"] = config_.portScanMaxConnections;
+    j["port_scanner"]["syn_rate"] = config_.portScanSynRate;
+    j["port_scanner"]["retries"] = config_.portScanRetries;
+    j["port_scanner"]["adaptive"] = config_.portScanAdaptive;
+    j["port_scanner"]["grab_banners"] = config_.portScanBanners;
+    j["port_scanner"]["banner_timeout_ms"] = config_.portScanBannerTimeoutMs;
+    j["port_scanner"]["checkpoint_interval_s"] = config_.portScanCheckpointSeconds;
 
     // Window state
     j["window"]["x"] = config_.windowX;
@@ -144,6 +165,22 @@ void ConfigManager::fromJson(const nlohmann::json& j) {
         config_.defaultPingIntervalSeconds = m.value("default_ping_interval_seconds", 30);
         config_.defaultWarningThresholdMs = m.value("default_warning_threshold_ms", 100);
         config_.defaultCriticalThresholdMs = m.value("default_critical_threshold_ms", 500);
+        config_.probeSpreadPolicy = m.value("probe_spread_policy", "hashed");
+        config_.kernelTimestamps = m.value("kernel_timestamps", true);
+        config_.adaptiveTimeouts = m.value("adaptive_timeouts", true);
+        config_.probeTimeoutFloorMs = m.value("probe_timeout_floor_ms", 200);
+        config_.probeTimeoutCeilingMs = m.value("probe_timeout_ceiling_ms", 5000);
+        config_.maxInFlightProbes = m.value("max_in_flight_probes", 3);
+    }
+
+    // Network engine
+    if (j.contains("network")) {
+        const auto& n = j["network"];
+        config_.ioThreads = n.value("io_threads", 0);
+        config_.ioTopology = n.value("io_topology", "shared");
+        config_.pinIoThreads = n.value("pin_io_threads", false);
+        config_.blockingThreads = n.value("blocking_threads", 4);
+        config_.blockingQueueCapacity = n.value("blocking_queue_capacity", 1024);
     }
 
     // Alerts
@@ -173,6 +210,14 @@ void ConfigManager::fromJson(const nlohmann::json& j) {
         const auto& p = j["port_scanner"];
         config_.portScanConcurrency = p.value("concurrency", 100);
         config_.portScanTimeoutMs = p.value("timeout_ms", 1000);
+        config_.portScanPerTarget = p.value("per_target", 0);
+        config_.portScanMaxConnections = p.value("max_connections", 512);
+        config_.portScanSynRate = p.value("syn_rate", 10000);
+        config_.portScanRetries = p.value("retries", 1);
+        config_.portScanAdaptive = p.value("adaptive", true);
+        config_.portScanBanners = p.value("grab_banners", false);
+        config_.portScanBannerTimeoutMs = p.value("banner_timeout_ms", 500);
+        config_.portScanCheckpointSeconds = p.value("checkpoint_interval_s", 30);
     }
 
     // Window state
@@ -37,6 +37,19 @@ struct AppConfig {
     int defaultPingIntervalSeconds{30};  ///< Default ping interval in seconds.
     int defaultWarningThresholdMs{100};  ///< Warning threshold in milliseconds.
     int defaultCriticalThresholdMs{500}; ///< Critical threshold in milliseconds.
+    std::string probeSpreadPolicy{"hashed"}; ///< Probe phase spreading ("none" or "hashed").
+    bool kernelTimestamps{true}; ///< Prefer kernel receive timestamps for ping RTTs.
+    bool adaptiveTimeouts{true}; ///< Size ping timeouts from each host's RTT history.
+    int probeTimeoutFloorMs{200};    ///< Smallest adaptive ping timeout in milliseconds.
+    int probeTimeoutCeilingMs{5000}; ///< Largest (or fixed) ping timeout in milliseconds.
+    int maxInFlightProbes{3}; ///< Overlapping checks allowed per host before cycles are missed.
+
+    // Network engine
+    int ioThreads{0};                   ///< Asio worker threads (0 = hardware concurrency).
+    std::string ioTopology{"shared"};   ///< io_context layout ("shared" or "per_thread").
+    bool pinIoThreads{false};           ///< Pin each Asio worker thread to one CPU.
+    int blockingThreads{4};             ///< Threads for blocking SNMP calls and scan checkpoints.
+    int blockingQueueCapacity{1024};    ///< Queued blocking tasks before new ones are rejected.
 
     // Alert settings
     core::AlertThresholds alertThresholds; ///< Alert threshold configuration.
@@ -50,6 +63,14 @@ struct AppConfig {
     // Port scanner defaults
     int portScanConcurrency{100};  ///< Maximum concurrent port scans.
     int portScanTimeoutMs{1000};   ///< Port scan timeout in milliseconds.
+    int portScanPerTarget{0};      ///< Concurrent connects per target host (0 = no limit).
+    int portScanMaxConnections{512}; ///< Connects in flight across all scans.
+    int portScanSynRate{10000};    ///< SYN scan packets per second (0 = unpaced).
+    int portScanRetries{1};        ///< Extra probes for ports that time out.
+    bool portScanAdaptive{true};   ///< Adapt scan concurrency to responsiveness.
+    bool portScanBanners{false};   ///< Grab banners from open ports to identify services.
+    int portScanBannerTimeoutMs{500}; ///< Time allowed per banner read in milliseconds.
+    int portScanCheckpointSeconds{30}; ///< Seconds between scan checkpoints (0 = none).
 
     // Window state
     int windowX{100};            ///< Window X position.
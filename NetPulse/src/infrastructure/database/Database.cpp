@@ -359,6 +359,94 @@ void Database::runMigrations() {
         setVersion(4);
     }
 
+    // Migration 5: Add IPv6 address family selection
+    if (currentVersion < 5) {
+        spdlog::info("Applying migration 5: Add address family to hosts and ping results");
+        execute("ALTER TABLE hosts ADD COLUMN address_family INTEGER DEFAULT 0");
+        execute("ALTER TABLE ping_results ADD COLUMN address_family INTEGER DEFAULT 0");
+
+        setVersion(5);
+    }
+
+    // Migration 6: Add multi-probe bursts
+    if (currentVersion < 6) {
+        spdlog::info("Applying migration 6: Add ping bursts");
+        execute("ALTER TABLE hosts ADD COLUMN burst_count INTEGER DEFAULT 1");
+        execute("ALTER TABLE hosts ADD COLUMN burst_spacing_ms INTEGER DEFAULT 10");
+
+        // One row per burst; NULL for single-probe results
+        execute("ALTER TABLE ping_results ADD COLUMN probes_sent INTEGER");
+        execute("ALTER TABLE ping_results ADD COLUMN probes_received INTEGER");
+        execute("ALTER TABLE ping_results ADD COLUMN min_latency_us INTEGER");
+        execute("ALTER TABLE ping_results ADD COLUMN max_latency_us INTEGER");
+        execute("ALTER TABLE ping_results ADD COLUMN stddev_us INTEGER");
+        execute("ALTER TABLE ping_results ADD COLUMN out_of_order INTEGER");
+
+        setVersion(6);
+    }
+
+    // Migration 7: Add TCP/UDP probe types
+    if (currentVersion < 7) {
+        spdlog::info("Applying migration 7: Add TCP/UDP probe types");
+        execute("ALTER TABLE hosts ADD COLUMN probe_type INTEGER DEFAULT 0");
+        execute("ALTER TABLE hosts ADD COLUMN probe_port INTEGER DEFAULT 0");
+
+        setVersion(7);
+    }
+
+    // Migration 8: Add probe schedule overrun accounting
+    if (currentVersion < 8) {
+        spdlog::info("Applying migration 8: Add probe schedule overrun accounting");
+        execute("ALTER TABLE ping_results ADD COLUMN missed_cycles INTEGER DEFAULT 0");
+        execute("ALTER TABLE ping_results ADD COLUMN schedule_lag_us INTEGER DEFAULT 0");
+
+        setVersion(8);
+    }
+
+    // Migration 9: Add port scan checkpoints
+    if (currentVersion < 9) {
+        spdlog::info("Applying migration 9: Add port scan checkpoints");
+        execute(R"(
+            CREATE TABLE IF NOT EXISTS scan_checkpoints (
+                id INTEGER PRIMARY KEY AUTOINCREMENT,
+                scan_key TEXT NOT NULL UNIQUE,
+                target_address TEXT NOT NULL,
+                config_json TEXT NOT NULL,
+                targets_json TEXT NOT NULL,
+                completed INTEGER DEFAULT 0,
+                created_at TEXT DEFAULT CURRENT_TIMESTAMP,
+                updated_at TEXT
+            )
+        )");
+        execute("CREATE INDEX IF NOT EXISTS idx_scan_checkpoints_completed ON scan_checkpoints(completed)");
+
+        // Leading ports done per target; targets without a row have none
+        execute(R"(
+            CREATE TABLE IF NOT EXISTS scan_checkpoint_progress (
+                checkpoint_id INTEGER NOT NULL REFERENCES scan_checkpoints(id) ON DELETE CASCADE,
+                target_index INTEGER NOT NULL,
+                ports_done INTEGER NOT NULL,
+                PRIMARY KEY (checkpoint_id, target_index)
+            )
+        )");
+
+        execute(R"(
+            CREATE TABLE IF NOT EXISTS scan_checkpoint_results (
+                checkpoint_id INTEGER NOT NULL REFERENCES scan_checkpoints(id) ON DELETE CASCADE,
+                target_address TEXT NOT NULL,
+                port INTEGER NOT NULL,
+                state INTEGER,
+                service_name TEXT,
+                service_version TEXT,
+                banner TEXT,
+                scan_timestamp TEXT,
+                PRIMARY KEY (checkpoint_id, target_address, port)
+            )
+        )");
+
+        setVersion(9);
+    }
+
     spdlog::info("Database migrations complete. Version: {}", getCurrentVersion());
 }
 
@@ -2,6 +2,8 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+
 namespace netpulse::infra {
 
 namespace {
@@ -28,8 +30,10 @@ HostRepository::HostRepository(std::shared_ptr<Database> db) : db_(std::move(db)
 int64_t HostRepository::insert(const core::Host& host) {
     auto stmt = db_->prepare(R"(
         INSERT INTO hosts (name, address, ping_interval, warning_threshold_ms,
-                          critical_threshold_ms, status, enabled, group_id, created_at)
-        VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)
+                          critical_threshold_ms, status, enabled, group_id, created_at,
+                          address_family, burst_count, burst_spacing_ms, probe_type,
+                          probe_port)
+        VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
     )");
 
     stmt.bind(1, host.name);
@@ -45,6 +49,11 @@ int64_t HostRepository::insert(const core::Host& host) {
         stmt.bindNull(8);
     }
     stmt.bind(9, timePointToString(host.createdAt));
+    stmt.bind(10, static_cast<int>(host.addressFamily));
+    stmt.bind(11, host.burstCount);
+    stmt.bind(12, host.burstSpacingMs);
+    stmt.bind(13, static_cast<int>(host.probeType));
+    stmt.bind(14, host.probePort);
 
     stmt.step();
     auto id = db_->lastInsertRowId();
@@ -52,11 +61,25 @@ int64_t HostRepository::insert(const core::Host& host) {
     return id;
 }
 
+std::vector<int64_t> HostRepository::insertBatch(const std::vector<core::Host>& hosts) {
+    std::vector<int64_t> ids;
+    ids.reserve(hosts.size());
+    db_->transaction([&]() {
+        for (const auto& host : hosts) {
+            ids.push_back(insert(host));
+        }
+    });
+    spdlog::debug("Inserted {} hosts", ids.size());
+    return ids;
+}
+
 void HostRepository::update(const core::Host& host) {
     auto stmt = db_->prepare(R"(
         UPDATE hosts SET
             name = ?, address = ?, ping_interval = ?, warning_threshold_ms = ?,
-            critical_threshold_ms = ?, status = ?, enabled = ?, group_id = ?
+            critical_threshold_ms = ?, status = ?, enabled = ?, group_id = ?,
+            address_family = ?, burst_count = ?, burst_spacing_ms = ?, probe_type = ?,
+            probe_port = ?
         WHERE id = ?
     )");
 
@@ -72,7 +95,12 @@ void HostRepository::update(const core::Host& host) {
     } else {
         stmt.bindNull(8);
     }
-    stmt.bind(9, host.id);
+    stmt.bind(9, static_cast<int>(host.addressFamily));
+    stmt.bind(10, host.burstCount);
+    stmt.bind(11, host.burstSpacingMs);
+    stmt.bind(12, static_cast<int>(host.probeType));
+    stmt.bind(13, host.probePort);
+    stmt.bind(14, host.id);
 
     stmt.step();
     spdlog::debug("Updated host: {}", host.id);
@@ -105,6 +133,28 @@ std::optional<core::Host> HostRepository::findByAddress(const std::string& addre
     return std::nullopt;
 }
 
+std::unordered_set<std::string>
+HostRepository::findExistingAddresses(const std::vector<std::string>& addresses) {
+    std::unordered_set<std::string> existing;
+    for (size_t first = 0; first < addresses.size(); first += ADDRESS_CHUNK_SIZE) {
+        auto count = std::min(ADDRESS_CHUNK_SIZE, addresses.size() - first);
+        std::string sql = "SELECT address FROM hosts WHERE address IN (?";
+        for (size_t i = 1; i < count; ++i) {
+            sql += ", ?";
+        }
+        sql += ")";
+
+        auto stmt = db_->prepare(sql);
+        for (size_t i = 0; i < count; ++i) {
+            stmt.bind(static_cast<int>(i + 1), addresses[first + i]);
+        }
+        while (stmt.step()) {
+            existing.insert(stmt.columnText(0));
+        }
+    }
+    return existing;
+}
+
 std::vector<core::Host> HostRepository::findAll() {
     std::vector<core::Host> hosts;
     auto stmt = db_->prepare("SELECT * FROM hosts ORDER BY name");
@@ -197,6 +247,17 @@ core::Host HostRepository::rowToHost(Statement& stmt) {
         host.groupId = stmt.columnInt64(10);
     }
 
+    // address_family is column 11 (added via ALTER TABLE)
+    host.addressFamily = static_cast<core::AddressFamily>(stmt.columnInt(11));
+
+    // burst_count and burst_spacing_ms are columns 12 and 13 (added via ALTER TABLE)
+    host.burstCount = stmt.columnInt(12);
+    host.burstSpacingMs = stmt.columnInt(13);
+
+    // probe_type and probe_port are columns 14 and 15 (added via ALTER TABLE)
+    host.probeType = static_cast<core::ProbeType>(stmt.columnInt(14));
+    host.probePort = stmt.columnInt(15);
+
     return host;
 }
 
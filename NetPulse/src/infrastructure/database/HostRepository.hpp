@@ -5,6 +5,8 @@
 
 #include <memory>
 #include <optional>
+#include <string>
+#include <unordered_set>
 #include <vector>
 
 namespace netpulse::infra {
@@ -30,6 +32,16 @@ public:
      */
     int64_t insert(const core::Host& host);
 
+    /**
+     * @brief Inserts many hosts in one transaction.
+     *
+     * Either every host is inserted or, if any insert fails, none is.
+     *
+     * @param hosts Host entities to insert.
+     * @return IDs of the new hosts, in the order given.
+     */
+    std::vector<int64_t> insertBatch(const std::vector<core::Host>& hosts);
+
     /**
      * @brief Updates an existing host in the database.
      * @param host Host entity with updated values (id must be set).
@@ -56,6 +68,18 @@ public:
      */
     std::optional<core::Host> findByAddress(const std::string& address);
 
+    /**
+     * @brief Looks up many addresses at once.
+     *
+     * Queries in chunks of ADDRESS_CHUNK_SIZE addresses instead of one
+     * findByAddress() per address.
+     *
+     * @param addresses Hostnames or IP addresses to look for.
+     * @return The addresses that already belong to a host.
+     */
+    std::unordered_set<std::string> findExistingAddresses(
+        const std::vector<std::string>& addresses);
+
     /**
      * @brief Retrieves all hosts from the database.
      * @return Vector of all Host entities.
@@ -107,6 +131,9 @@ public:
      */
     int count();
 
+    /// Addresses bound to one lookup query (below SQLite's parameter limit)
+    static constexpr size_t ADDRESS_CHUNK_SIZE = 500;
+
 private:
     core::Host rowToHost(Statement& stmt);
     std::shared_ptr<Database> db_;
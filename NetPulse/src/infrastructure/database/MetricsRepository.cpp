@@ -23,14 +23,32 @@ std::chrono::system_clock::time_point stringToTimePoint(const std::string& str)
     return std::chrono::system_clock::from_time_t(timegm(&tm));
 }
 
+// Reads the six burst columns starting at firstColumn; NULL means a single probe
+void readBurst(Statement& stmt, int firstColumn, core::PingResult& result) {
+    if (stmt.columnIsNull(firstColumn)) {
+        return;
+    }
+    core::BurstSummary burst;
+    burst.probesSent = stmt.columnInt(firstColumn);
+    burst.probesReceived = stmt.columnInt(firstColumn + 1);
+    burst.minLatency = std::chrono::microseconds(stmt.columnInt64(firstColumn + 2));
+    burst.maxLatency = std::chrono::microseconds(stmt.columnInt64(firstColumn + 3));
+    burst.stddev = std::chrono::microseconds(stmt.columnInt64(firstColumn + 4));
+    burst.outOfOrder = stmt.columnInt(firstColumn + 5);
+    burst.avgLatency = result.latency;
+    result.burst = burst;
+}
+
 } // namespace
 
 MetricsRepository::MetricsRepository(std::shared_ptr<Database> db) : db_(std::move(db)) {}
 
 int64_t MetricsRepository::insertPingResult(const core::PingResult& result) {
     auto stmt = db_->prepare(R"(
-        INSERT INTO ping_results (host_id, timestamp, latency_us, success, ttl)
-        VALUES (?, ?, ?, ?, ?)
+        INSERT INTO ping_results (host_id, timestamp, latency_us, success, ttl, address_family,
+                                  probes_sent, probes_received, min_latency_us, max_latency_us,
+                                  stddev_us, out_of_order, missed_cycles, schedule_lag_us)
+        VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
     )");
 
     stmt.bind(1, result.hostId);
@@ -42,6 +60,21 @@ int64_t MetricsRepository::insertPingResult(const core::PingResult& result) {
     } else {
         stmt.bindNull(5);
     }
+    stmt.bind(6, static_cast<int>(result.family));
+    if (result.burst) {
+        stmt.bind(7, result.burst->probesSent);
+        stmt.bind(8, result.burst->probesReceived);
+        stmt.bind(9, result.burst->minLatency.count());
+        stmt.bind(10, result.burst->maxLatency.count());
+        stmt.bind(11, result.burst->stddev.count());
+        stmt.bind(12, result.burst->outOfOrder);
+    } else {
+        for (int column = 7; column <= 12; ++column) {
+            stmt.bindNull(column);
+        }
+    }
+    stmt.bind(13, result.missedCycles);
+    stmt.bind(14, result.scheduleLag.count());
 
     stmt.step();
     return db_->lastInsertRowId();
@@ -50,7 +83,9 @@ int64_t MetricsRepository::insertPingResult(const core::PingResult& result) {
 std::vector<core::PingResult> MetricsRepository::getPingResults(int64_t hostId, int limit) {
     std::vector<core::PingResult> results;
     auto stmt = db_->prepare(R"(
-        SELECT id, host_id, timestamp, latency_us, success, ttl
+        SELECT id, host_id, timestamp, latency_us, success, ttl, address_family,
+               probes_sent, probes_received, min_latency_us, max_latency_us, stddev_us,
+               out_of_order, missed_cycles, schedule_lag_us
         FROM ping_results WHERE host_id = ?
         ORDER BY timestamp DESC LIMIT ?
     )");
@@ -68,6 +103,10 @@ std::vector<core::PingResult> MetricsRepository::getPingResults(int64_t hostId,
         if (!stmt.columnIsNull(5)) {
             result.ttl = stmt.columnInt(5);
         }
+        result.family = static_cast<core::AddressFamily>(stmt.columnInt(6));
+        readBurst(stmt, 7, result);
+        result.missedCycles = stmt.columnInt(13);
+        result.scheduleLag = std::chrono::microseconds(stmt.columnInt64(14));
         results.push_back(result);
     }
 
@@ -78,7 +117,9 @@ std::vector<core::PingResult> MetricsRepository::getPingResultsSince(
     int64_t hostId, std::chrono::system_clock::time_point since) {
     std::vector<core::PingResult> results;
     auto stmt = db_->prepare(R"(
-        SELECT id, host_id, timestamp, latency_us, success, ttl
+        SELECT id, host_id, timestamp, latency_us, success, ttl, address_family,
+               probes_sent, probes_received, min_latency_us, max_latency_us, stddev_us,
+               out_of_order, missed_cycles, schedule_lag_us
         FROM ping_results WHERE host_id = ? AND timestamp >= ?
         ORDER BY timestamp ASC
     )");
@@ -96,6 +137,10 @@ std::vector<core::PingResult> MetricsRepository::getPingResultsSince(
         if (!stmt.columnIsNull(5)) {
             result.ttl = stmt.columnInt(5);
         }
+        result.family = static_cast<core::AddressFamily>(stmt.columnInt(6));
+        readBurst(stmt, 7, result);
+        result.missedCycles = stmt.columnInt(13);
+        result.scheduleLag = std::chrono::microseconds(stmt.columnInt64(14));
         results.push_back(result);
     }
 
@@ -108,11 +153,12 @@ core::PingStatistics MetricsRepository::getStatistics(int64_t hostId, int sample
 
     auto stmt = db_->prepare(R"(
         SELECT
-            COUNT(*) as total,
-            SUM(CASE WHEN success = 1 THEN 1 ELSE 0 END) as successful,
-            MIN(CASE WHEN success = 1 THEN latency_us END) as min_lat,
-            MAX(CASE WHEN success = 1 THEN latency_us END) as max_lat,
-            AVG(CASE WHEN success = 1 THEN latency_us END) as avg_lat
+            SUM(COALESCE(probes_sent, 1)) as total,
+            SUM(COALESCE(probes_received, CASE WHEN success = 1 THEN 1 ELSE 0 END)) as successful,
+            MIN(CASE WHEN success = 1 THEN COALESCE(min_latency_us, latency_us) END) as min_lat,
+            MAX(CASE WHEN success = 1 THEN COALESCE(max_latency_us, latency_us) END) as max_lat,
+            AVG(CASE WHEN success = 1 THEN latency_us END) as avg_lat,
+            SUM(COALESCE(missed_cycles, 0)) as missed
         FROM (
             SELECT * FROM ping_results WHERE host_id = ?
             ORDER BY timestamp DESC LIMIT ?
@@ -123,8 +169,11 @@ core::PingStatistics MetricsRepository::getStatistics(int64_t hostId, int sample
     stmt.bind(2, sampleCount);
 
     if (stmt.step()) {
+        // A missed check sent no probe, so it is reported on its own rather
+        // than as loss; a host is not unreachable because the checker fell behind
         stats.totalPings = stmt.columnInt(0);
         stats.successfulPings = stmt.columnInt(1);
+        stats.missedCycles = stmt.columnInt(5);
 
         if (!stmt.columnIsNull(2)) {
             stats.minLatency = std::chrono::microseconds(stmt.columnInt64(2));
@@ -387,6 +436,7 @@ std::string MetricsRepository::exportToJson(int64_t hostId) {
     j["statistics"]["total_pings"] = stats.totalPings;
     j["statistics"]["successful_pings"] = stats.successfulPings;
     j["statistics"]["packet_loss_percent"] = stats.packetLossPercent;
+    j["statistics"]["missed_cycles"] = stats.missedCycles;
     j["statistics"]["min_latency_ms"] = stats.minLatency.count() / 1000.0;
     j["statistics"]["max_latency_ms"] = stats.maxLatency.count() / 1000.0;
     j["statistics"]["avg_latency_ms"] = stats.avgLatency.count() / 1000.0;
@@ -0,0 +1,265 @@
+#include "infrastructure/database/ScanCheckpointRepository.hpp"
+
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+namespace netpulse::infra {
+
+namespace {
+
+std::string timePointToString(const std::chrono::system_clock::time_point& tp) {
+    auto time = std::chrono::system_clock::to_time_t(tp);
+    std::tm tm{};
+    gmtime_r(&time, &tm);
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &tm);
+    return buffer;
+}
+
+std::chrono::system_clock::time_point stringToTimePoint(const std::string& str) {
+    std::tm tm{};
+    strptime(str.c_str(), "%Y-%m-%d %H:%M:%S", &tm);
+    return std::chrono::system_clock::from_time_t(timegm(&tm));
+}
+
+} // namespace
+
+ScanCheckpointRepository::ScanCheckpointRepository(std::shared_ptr<Database> db)
+    : db_(std::move(db)) {}
+
+std::string ScanCheckpointRepository::configToJson(const core::PortScanConfig& config) {
+    nlohmann::json j;
+    j["target_address"] = config.targetAddress;
+    j["range"] = static_cast<int>(config.range);
+    j["custom_ports"] = config.customPorts;
+    j["max_concurrency"] = config.maxConcurrency;
+    j["max_per_target"] = config.maxPerTarget;
+    j["timeout_ms"] = config.timeout.count();
+    j["mode"] = static_cast<int>(config.mode);
+    j["max_retries"] = config.maxRetries;
+    j["adaptive_rate"] = config.adaptiveRate;
+    j["report_all_states"] = config.reportAllStates;
+    j["grab_banners"] = config.grabBanners;
+    j["banner_timeout_ms"] = config.bannerTimeout.count();
+    return j.dump();
+}
+
+core::PortScanConfig ScanCheckpointRepository::configFromJson(const std::string& json) {
+    core::PortScanConfig config;
+    auto j = nlohmann::json::parse(json, nullptr, false);
+    if (j.is_discarded() || !j.is_object()) {
+        return config;
+    }
+
+    config.targetAddress = j.value("target_address", "");
+    config.range = static_cast<core::PortRange>(j.value("range", 0));
+    config.customPorts = j.value("custom_ports", std::vector<uint16_t>{});
+    config.maxConcurrency = j.value("max_concurrency", config.maxConcurrency);
+    config.maxPerTarget = j.value("max_per_target", config.maxPerTarget);
+    config.timeout = std::chrono::milliseconds(j.value("timeout_ms", config.timeout.count()));
+    config.mode = static_cast<core::ScanMode>(j.value("mode", 0));
+    config.maxRetries = j.value("max_retries", config.maxRetries);
+    config.adaptiveRate = j.value("adaptive_rate", config.adaptiveRate);
+    config.reportAllStates = j.value("report_all_states", config.reportAllStates);
+    config.grabBanners = j.value("grab_banners", config.grabBanners);
+    config.bannerTimeout =
+        std::chrono::milliseconds(j.value("banner_timeout_ms", config.bannerTimeout.count()));
+    return config;
+}
+
+void ScanCheckpointRepository::save(const core::ScanCheckpoint& checkpoint) {
+    std::lock_guard lock(saveMutex_);
+
+    // Results of an earlier save that failed go out with this one; the
+    // checkpoint that carried them is past them and will not send them again
+    std::vector<core::PortScanResult> results;
+    auto unsaved = unsaved_.find(checkpoint.key);
+    if (unsaved != unsaved_.end()) {
+        results = std::move(unsaved->second);
+        unsaved_.erase(unsaved);
+    }
+    results.insert(results.end(), checkpoint.results.begin(), checkpoint.results.end());
+
+    try {
+        write(checkpoint, results);
+    } catch (...) {
+        if (!results.empty()) {
+            unsaved_[checkpoint.key] = std::move(results);
+        }
+        throw;
+    }
+
+    spdlog::debug("Saved checkpoint of scan {}: {}/{} ports, {} new results", checkpoint.key,
+                  checkpoint.scannedPorts(), checkpoint.totalPorts(), results.size());
+}
+
+void ScanCheckpointRepository::write(const core::ScanCheckpoint& checkpoint,
+                                     const std::vector<core::PortScanResult>& results) {
+    db_->transaction([&]() {
+        auto upsert = db_->prepare(R"(
+            INSERT INTO scan_checkpoints (scan_key, target_address, config_json, targets_json,
+                                          completed, updated_at)
+            VALUES (?, ?, ?, ?, ?, ?)
+            ON CONFLICT(scan_key) DO UPDATE SET
+                completed = MAX(completed, excluded.completed),
+                updated_at = excluded.updated_at
+            WHERE completed = 0
+        )");
+        upsert.bind(1, checkpoint.key);
+        upsert.bind(2, checkpoint.config.targetAddress);
+        upsert.bind(3, configToJson(checkpoint.config));
+        upsert.bind(4, nlohmann::json(checkpoint.targets).dump());
+        upsert.bind(5, checkpoint.finished ? 1 : 0);
+        upsert.bind(6, timePointToString(checkpoint.updatedAt));
+        upsert.step();
+        if (db_->changes() == 0) {
+            return; // Already completed; a late save must not revive it
+        }
+
+        auto find = db_->prepare("SELECT id FROM scan_checkpoints WHERE scan_key = ?");
+        find.bind(1, checkpoint.key);
+        if (!find.step()) {
+            return;
+        }
+        auto id = find.columnInt64(0);
+
+        // Targets without progress need no row; a missing row reads as zero
+        auto progress = db_->prepare(R"(
+            INSERT INTO scan_checkpoint_progress (checkpoint_id, target_index, ports_done)
+            VALUES (?, ?, ?)
+            ON CONFLICT(checkpoint_id, target_index) DO UPDATE SET
+                ports_done = MAX(ports_done, excluded.ports_done)
+        )");
+        for (size_t i = 0; i < checkpoint.portsDone.size(); ++i) {
+            if (checkpoint.portsDone[i] == 0) {
+                continue;
+            }
+            progress.bind(1, id);
+            progress.bind(2, static_cast<int64_t>(i));
+            progress.bind(3, static_cast<int64_t>(checkpoint.portsDone[i]));
+            progress.step();
+            progress.reset();
+        }
+
+        auto result = db_->prepare(R"(
+            INSERT OR REPLACE INTO scan_checkpoint_results
+                (checkpoint_id, target_address, port, state, service_name, service_version,
+                 banner, scan_timestamp)
+            VALUES (?, ?, ?, ?, ?, ?, ?, ?)
+        )");
+        for (const auto& entry : results) {
+            result.bind(1, id);
+            result.bind(2, entry.targetAddress);
+            result.bind(3, static_cast<int>(entry.port));
+            result.bind(4, static_cast<int>(entry.state));
+            result.bind(5, entry.serviceName);
+            result.bind(6, entry.serviceVersion);
+            result.bind(7, entry.banner);
+            result.bind(8, timePointToString(entry.scanTimestamp));
+            result.step();
+            result.reset();
+        }
+    });
+}
+
+std::vector<core::ScanCheckpoint> ScanCheckpointRepository::readCheckpoints(Statement& stmt) {
+    std::vector<int64_t> ids;
+    std::vector<core::ScanCheckpoint> checkpoints;
+    while (stmt.step()) {
+        core::ScanCheckpoint checkpoint;
+        ids.push_back(stmt.columnInt64(0));
+        checkpoint.key = stmt.columnText(1);
+        checkpoint.config = configFromJson(stmt.columnText(2));
+        auto targets = nlohmann::json::parse(stmt.columnText(3), nullptr, false);
+        if (targets.is_array()) {
+            checkpoint.targets = targets.get<std::vector<std::string>>();
+        }
+        checkpoint.finished = stmt.columnInt(4) != 0;
+        if (!stmt.columnIsNull(5)) {
+            checkpoint.updatedAt = stringToTimePoint(stmt.columnText(5));
+        }
+        checkpoints.push_back(std::move(checkpoint));
+    }
+
+    for (size_t i = 0; i < checkpoints.size(); ++i) {
+        loadProgress(ids[i], checkpoints[i]);
+        loadResults(ids[i], checkpoints[i]);
+    }
+    return checkpoints;
+}
+
+void ScanCheckpointRepository::loadProgress(int64_t id, core::ScanCheckpoint& checkpoint) {
+    checkpoint.portsDone.assign(checkpoint.targets.size(), 0);
+    auto stmt = db_->prepare(
+        "SELECT target_index, ports_done FROM scan_checkpoint_progress WHERE checkpoint_id = ?");
+    stmt.bind(1, id);
+    while (stmt.step()) {
+        auto index = stmt.columnInt64(0);
+        if (index >= 0 && static_cast<size_t>(index) < checkpoint.portsDone.size()) {
+            checkpoint.portsDone[static_cast<size_t>(index)] =
+                static_cast<size_t>(std::max<int64_t>(stmt.columnInt64(1), 0));
+        }
+    }
+}
+
+void ScanCheckpointRepository::loadResults(int64_t id, core::ScanCheckpoint& checkpoint) {
+    auto stmt = db_->prepare(R"(
+        SELECT target_address, port, state, service_name, service_version, banner, scan_timestamp
+        FROM scan_checkpoint_results WHERE checkpoint_id = ?
+        ORDER BY target_address, port
+    )");
+    stmt.bind(1, id);
+    while (stmt.step()) {
+        core::PortScanResult result;
+        result.targetAddress = stmt.columnText(0);
+        result.port = static_cast<uint16_t>(stmt.columnInt(1));
+        result.state = static_cast<core::PortState>(stmt.columnInt(2));
+        result.serviceName = stmt.columnText(3);
+        result.serviceVersion = stmt.columnText(4);
+        result.banner = stmt.columnText(5);
+        result.scanTimestamp = stringToTimePoint(stmt.columnText(6));
+        checkpoint.results.push_back(std::move(result));
+    }
+}
+
+std::optional<core::ScanCheckpoint> ScanCheckpointRepository::findByKey(const std::string& key) {
+    auto stmt = db_->prepare(R"(
+        SELECT id, scan_key, config_json, targets_json, completed, updated_at
+        FROM scan_checkpoints WHERE scan_key = ?
+    )");
+    stmt.bind(1, key);
+
+    auto checkpoints = readCheckpoints(stmt);
+    if (checkpoints.empty()) {
+        return std::nullopt;
+    }
+    return std::move(checkpoints.front());
+}
+
+std::vector<core::ScanCheckpoint> ScanCheckpointRepository::findResumable() {
+    auto stmt = db_->prepare(R"(
+        SELECT id, scan_key, config_json, targets_json, completed, updated_at
+        FROM scan_checkpoints WHERE completed = 0
+        ORDER BY updated_at DESC, id DESC
+    )");
+    return readCheckpoints(stmt);
+}
+
+void ScanCheckpointRepository::remove(const std::string& key) {
+    auto stmt = db_->prepare("DELETE FROM scan_checkpoints WHERE scan_key = ?");
+    stmt.bind(1, key);
+    stmt.step();
+    spdlog::debug("Removed checkpoint of scan {}", key);
+}
+
+void ScanCheckpointRepository::cleanupOld(std::chrono::hours maxAge) {
+    auto cutoff = std::chrono::system_clock::now() - maxAge;
+    auto stmt =
+        db_->prepare("DELETE FROM scan_checkpoints WHERE completed = 1 OR updated_at < ?");
+    stmt.bind(1, timePointToString(cutoff));
+    stmt.step();
+    spdlog::info("Cleaned up completed scan checkpoints and those older than {} hours",
+                 maxAge.count());
+}
+
+} // namespace netpulse::infra
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "core/types/ScanCheckpoint.hpp"
+#include "infrastructure/database/Database.hpp"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace netpulse::infra {
+
+/**
+ * @brief Repository for port scan checkpoints.
+ *
+ * Keeps the progress of long port scans so they can be resumed after a
+ * cancel, restart or crash. Checkpoints of one scan share its key: each save
+ * adds the new results and moves the per-target progress forward, never back,
+ * so saves may arrive out of order. A finished scan is marked completed and
+ * is no longer resumable.
+ *
+ * A save that fails keeps its results and writes them with the next save of
+ * the same scan, since the checkpoint that follows only carries newer ones.
+ */
+class ScanCheckpointRepository {
+public:
+    /**
+     * @brief Constructs a ScanCheckpointRepository with the given database.
+     * @param db Shared pointer to the Database instance.
+     */
+    explicit ScanCheckpointRepository(std::shared_ptr<Database> db);
+
+    /**
+     * @brief Records a checkpoint in one transaction.
+     *
+     * Saves after the scan was marked completed are ignored. If the write
+     * fails, nothing of it is stored and its results are held for the next
+     * save of the scan.
+     *
+     * @param checkpoint Checkpoint whose results are the ones not saved yet.
+     * @throws std::runtime_error if the database write fails.
+     */
+    void save(const core::ScanCheckpoint& checkpoint);
+
+    /**
+     * @brief Finds the checkpoint of a scan.
+     * @param key Key of the scan.
+     * @return Checkpoint with all saved results, or nullopt if not found.
+     */
+    std::optional<core::ScanCheckpoint> findByKey(const std::string& key);
+
+    /**
+     * @brief Retrieves the scans that did not finish.
+     * @return Checkpoints with all saved results, most recently updated first.
+     */
+    std::vector<core::ScanCheckpoint> findResumable();
+
+    /**
+     * @brief Removes a scan's checkpoint and its results.
+     * @param key Key of the scan.
+     */
+    void remove(const std::string& key);
+
+    /**
+     * @brief Removes completed checkpoints and those not updated within maxAge.
+     * @param maxAge Maximum age of unfinished checkpoints to keep.
+     */
+    void cleanupOld(std::chrono::hours maxAge);
+
+private:
+    void write(const core::ScanCheckpoint& checkpoint,
+               const std::vector<core::PortScanResult>& results);
+    std::vector<core::ScanCheckpoint> readCheckpoints(Statement& stmt);
+    void loadProgress(int64_t id, core::ScanCheckpoint& checkpoint);
+    void loadResults(int64_t id, core::ScanCheckpoint& checkpoint);
+
+    static std::string configToJson(const core::PortScanConfig& config);
+    static core::PortScanConfig configFromJson(const std::string& json);
+
+    std::shared_ptr<Database> db_;
+    std::mutex saveMutex_; // One save transaction at a time
+    std::unordered_map<std::string, std::vector<core::PortScanResult>> unsaved_; // By scan key
+};
+
+} // namespace netpulse::infra
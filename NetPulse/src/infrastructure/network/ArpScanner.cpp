@@ -0,0 +1,293 @@
+#include "infrastructure/network/ArpScanner.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <utility>
+
+#if defined(__linux__)
+#include <arpa/inet.h>
+#include <ifaddrs.h>
+#include <linux/if_ether.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <netpacket/packet.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace netpulse::infra {
+
+namespace {
+
+constexpr uint16_t HARDWARE_ETHERNET = 1;
+constexpr uint16_t PROTOCOL_IPV4 = 0x0800;
+constexpr uint16_t OPERATION_REQUEST = 1;
+constexpr uint16_t OPERATION_REPLY = 2;
+constexpr size_t RECV_BUFFER_SIZE = 128;
+constexpr size_t RECV_BATCH_SIZE = 64;
+
+void put16(uint8_t* out, uint16_t value) {
+    out[0] = static_cast<uint8_t>(value >> 8);
+    out[1] = static_cast<uint8_t>(value & 0xFF);
+}
+
+void put32(uint8_t* out, uint32_t value) {
+    put16(out, static_cast<uint16_t>(value >> 16));
+    put16(out + 2, static_cast<uint16_t>(value & 0xFFFF));
+}
+
+uint16_t get16(const uint8_t* in) {
+    return static_cast<uint16_t>((in[0] << 8) | in[1]);
+}
+
+uint32_t get32(const uint8_t* in) {
+    return (uint32_t{get16(in)} << 16) | get16(in + 2);
+}
+
+} // namespace
+
+ArpScanner::ArpScanner(AsioContext& context) : socket_(context.getContext()) {}
+
+ArpScanner::~ArpScanner() {
+    shutdown();
+}
+
+std::vector<ArpScanner::Interface> ArpScanner::interfaces() {
+    std::vector<Interface> result;
+
+#if defined(__linux__)
+    ifaddrs* list = nullptr;
+    if (::getifaddrs(&list) != 0) {
+        spdlog::debug("ArpScanner: getifaddrs failed: {}", std::strerror(errno));
+        return result;
+    }
+
+    // Addresses and hardware addresses come as separate entries per interface
+    std::map<std::string, Interface> ipv4;
+    std::map<std::string, std::pair<int, std::array<uint8_t, 6>>> links;
+    for (auto* entry = list; entry != nullptr; entry = entry->ifa_next) {
+        if (entry->ifa_addr == nullptr || (entry->ifa_flags & IFF_UP) == 0 ||
+            (entry->ifa_flags & (IFF_LOOPBACK | IFF_NOARP)) != 0) {
+            continue;
+        }
+
+        if (entry->ifa_addr->sa_family == AF_INET && entry->ifa_netmask != nullptr &&
+            ipv4.count(entry->ifa_name) == 0) {
+            Interface iface;
+            iface.name = entry->ifa_name;
+            iface.address = ntohl(reinterpret_cast<const sockaddr_in*>(entry->ifa_addr)
+                                      ->sin_addr.s_addr);
+            iface.netmask = ntohl(reinterpret_cast<const sockaddr_in*>(entry->ifa_netmask)
+                                      ->sin_addr.s_addr);
+            ipv4.emplace(iface.name, iface);
+        } else if (entry->ifa_addr->sa_family == AF_PACKET) {
+            const auto* link = reinterpret_cast<const sockaddr_ll*>(entry->ifa_addr);
+            if (link->sll_halen == 6) {
+                std::array<uint8_t, 6> mac{};
+                std::memcpy(mac.data(), link->sll_addr, mac.size());
+                links.emplace(entry->ifa_name, std::make_pair(link->sll_ifindex, mac));
+            }
+        }
+    }
+    ::freeifaddrs(list);
+
+    for (auto& [name, iface] : ipv4) {
+        auto link = links.find(name);
+        // A /32 (point-to-point link) has no segment to sweep
+        if (link == links.end() || iface.netmask == 0xFFFFFFFFu) {
+            continue;
+        }
+        iface.index = link->second.first;
+        iface.mac = link->second.second;
+        result.push_back(iface);
+    }
+#endif
+
+    return result;
+}
+
+bool ArpScanner::start(const Interface& iface) {
+#if defined(__linux__)
+    {
+        std::lock_guard lock(mutex_);
+        if (open_) {
+            return true;
+        }
+
+        auto protocol = static_cast<int>(htons(ETH_P_ARP));
+        int fd = ::socket(AF_PACKET, SOCK_DGRAM, protocol);
+        if (fd < 0) {
+            spdlog::info("ArpScanner: packet socket unavailable: {}", std::strerror(errno));
+            return false;
+        }
+
+        // Only this interface's traffic, so replies on other segments are not seen
+        sockaddr_ll local{};
+        local.sll_family = AF_PACKET;
+        local.sll_protocol = htons(ETH_P_ARP);
+        local.sll_ifindex = iface.index;
+        if (::bind(fd, reinterpret_cast<const sockaddr*>(&local), sizeof(local)) != 0) {
+            spdlog::info("ArpScanner: cannot bind to {}: {}", iface.name, std::strerror(errno));
+            ::close(fd);
+            return false;
+        }
+
+        asio::error_code ec;
+        socket_.assign(asio::generic::raw_protocol(AF_PACKET, protocol), fd, ec);
+        if (!ec) {
+            socket_.non_blocking(true, ec);
+        }
+        if (ec) {
+            spdlog::warn("ArpScanner: failed to register packet socket: {}", ec.message());
+            ::close(fd);
+            return false;
+        }
+
+        interface_ = iface;
+        open_ = true;
+    }
+    spdlog::debug("ArpScanner started on {}", iface.name);
+
+    asio::post(socket_.get_executor(), [self = shared_from_this()]() { self->startReceive(); });
+    return true;
+#else
+    (void)iface;
+    spdlog::info("ArpScanner: packet sockets not supported on this platform");
+    return false;
+#endif
+}
+
+void ArpScanner::shutdown() {
+    std::lock_guard lock(mutex_);
+    if (!open_.exchange(false)) {
+        return;
+    }
+    asio::error_code ignored;
+    socket_.close(ignored);
+    spdlog::debug("ArpScanner stopped on {}", interface_.name);
+}
+
+void ArpScanner::setReplyCallback(ReplyCallback callback) {
+    std::lock_guard lock(mutex_);
+    callback_ = std::move(callback);
+}
+
+bool ArpScanner::request(uint32_t target) {
+#if defined(__linux__)
+    std::lock_guard lock(mutex_);
+    if (!open_) {
+        return false;
+    }
+
+    auto packet = buildRequest(interface_.mac, interface_.address, target);
+    sockaddr_ll destination{};
+    destination.sll_family = AF_PACKET;
+    destination.sll_protocol = htons(ETH_P_ARP);
+    destination.sll_ifindex = interface_.index;
+    destination.sll_halen = 6;
+    std::memset(destination.sll_addr, 0xFF, 6); // Broadcast
+    auto rc = ::sendto(socket_.native_handle(), packet.data(), packet.size(), 0,
+                       reinterpret_cast<const sockaddr*>(&destination), sizeof(destination));
+    return rc == static_cast<ssize_t>(packet.size());
+#else
+    (void)target;
+    return false;
+#endif
+}
+
+std::array<uint8_t, ArpScanner::PACKET_SIZE>
+ArpScanner::buildRequest(const std::array<uint8_t, 6>& senderMac, uint32_t sender,
+                         uint32_t target) {
+    std::array<uint8_t, PACKET_SIZE> packet{};
+    put16(packet.data(), HARDWARE_ETHERNET);
+    put16(packet.data() + 2, PROTOCOL_IPV4);
+    packet[4] = 6; // Hardware address length
+    packet[5] = 4; // Protocol address length
+    put16(packet.data() + 6, OPERATION_REQUEST);
+    std::copy(senderMac.begin(), senderMac.end(), packet.begin() + 8);
+    put32(packet.data() + 14, sender);
+    // Target hardware address stays zero: it is what the request asks for
+    put32(packet.data() + 24, target);
+    return packet;
+}
+
+std::optional<ArpScanner::Reply> ArpScanner::parseReply(const uint8_t* data, size_t length) {
+    if (length < PACKET_SIZE || get16(data) != HARDWARE_ETHERNET ||
+        get16(data + 2) != PROTOCOL_IPV4 || data[4] != 6 || data[5] != 4) {
+        return std::nullopt;
+    }
+
+    Reply reply;
+    reply.operation = get16(data + 6);
+    std::copy(data + 8, data + 14, reply.senderMac.begin());
+    reply.senderAddress = get32(data + 14);
+    reply.targetAddress = get32(data + 24);
+    return reply;
+}
+
+std::string ArpScanner::formatMac(const std::array<uint8_t, 6>& mac) {
+    char buffer[18];
+    std::snprintf(buffer, sizeof(buffer), "%02x:%02x:%02x:%02x:%02x:%02x", mac[0], mac[1],
+                  mac[2], mac[3], mac[4], mac[5]);
+    return buffer;
+}
+
+void ArpScanner::startReceive() {
+    std::lock_guard lock(mutex_);
+    if (!open_) {
+        return;
+    }
+
+    auto self = shared_from_this();
+    socket_.async_wait(asio::socket_base::wait_read, [this, self](const asio::error_code& ec) {
+        if (ec || !open_) {
+            return;
+        }
+        handleReadable();
+        startReceive();
+    });
+}
+
+void ArpScanner::handleReadable() {
+    std::vector<std::pair<uint32_t, std::string>> replies;
+    ReplyCallback callback;
+
+#if defined(__linux__)
+    {
+        std::lock_guard lock(mutex_);
+        if (!open_) {
+            return;
+        }
+        callback = callback_;
+
+        std::array<uint8_t, RECV_BUFFER_SIZE> buffer;
+        for (size_t i = 0; i < RECV_BATCH_SIZE; ++i) {
+            auto received = ::recv(socket_.native_handle(), buffer.data(), buffer.size(),
+                                   MSG_DONTWAIT);
+            if (received <= 0) {
+                break;
+            }
+
+            // Answers to other hosts' requests are visible too; keep ours
+            auto reply = parseReply(buffer.data(), static_cast<size_t>(received));
+            if (reply && reply->operation == OPERATION_REPLY &&
+                reply->targetAddress == interface_.address) {
+                replies.emplace_back(reply->senderAddress, formatMac(reply->senderMac));
+            }
+        }
+    }
+#endif
+
+    if (callback) {
+        for (const auto& [address, mac] : replies) {
+            callback(address, mac);
+        }
+    }
+}
+
+} // namespace netpulse::infra
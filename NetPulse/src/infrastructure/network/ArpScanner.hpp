@@ -0,0 +1,162 @@
+#pragma once
+
+#include "infrastructure/network/AsioContext.hpp"
+
+#include <asio.hpp>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace netpulse::infra {
+
+/**
+ * @brief ARP request sender and reply listener for one Ethernet interface.
+ *
+ * Broadcasts ARP who-has requests from a link-layer packet socket bound to
+ * the interface and reports every reply it sees. On a directly attached
+ * segment every IPv4 host must answer ARP, whatever its firewall does with
+ * ICMP and TCP, so a reply is the most reliable sign of life and comes with
+ * the host's MAC address.
+ *
+ * Requests are sent without pacing; callers spread them out.
+ *
+ * @note Requires a packet socket (CAP_NET_RAW on Linux); start() returns
+ *       false when it cannot be opened so callers can fall back to ICMP and
+ *       TCP probes.
+ */
+class ArpScanner : public std::enable_shared_from_this<ArpScanner> {
+public:
+    /**
+     * @brief An IPv4 Ethernet interface ARP can be sent from.
+     */
+    struct Interface {
+        std::string name;            ///< System name, e.g. "eth0"
+        int index{0};                ///< Kernel interface index
+        uint32_t address{0};         ///< Interface address (host byte order)
+        uint32_t netmask{0};         ///< Subnet mask (host byte order)
+        std::array<uint8_t, 6> mac{}; ///< Hardware address
+
+        /**
+         * @brief Checks whether an address is on this interface's subnet.
+         * @param target Address in host byte order.
+         * @return True if ARP can resolve it from here.
+         */
+        [[nodiscard]] bool contains(uint32_t target) const {
+            return (target & netmask) == (address & netmask);
+        }
+    };
+
+    /**
+     * @brief Fields of an ARP packet that matter to a sweep.
+     */
+    struct Reply {
+        uint16_t operation{0};        ///< 1 = request, 2 = reply
+        std::array<uint8_t, 6> senderMac{};
+        uint32_t senderAddress{0};    ///< Host byte order
+        uint32_t targetAddress{0};    ///< Host byte order
+    };
+
+    /**
+     * @brief Callback invoked for each ARP reply received.
+     * @param address Address that answered (host byte order).
+     * @param mac Its hardware address, formatted "aa:bb:cc:dd:ee:ff".
+     */
+    using ReplyCallback = std::function<void(uint32_t address, const std::string& mac)>;
+
+    static constexpr size_t PACKET_SIZE = 28; ///< ARP for IPv4 over Ethernet
+
+    /**
+     * @brief Constructs a stopped scanner.
+     * @param context AsioContext that runs the socket handlers.
+     */
+    explicit ArpScanner(AsioContext& context);
+
+    /**
+     * @brief Destructor. Closes the socket.
+     */
+    ~ArpScanner();
+
+    ArpScanner(const ArpScanner&) = delete;
+    ArpScanner& operator=(const ArpScanner&) = delete;
+
+    /**
+     * @brief Lists the interfaces ARP can be sent from.
+     * @return Up, non-loopback interfaces with an IPv4 address and an Ethernet address.
+     */
+    static std::vector<Interface> interfaces();
+
+    /**
+     * @brief Opens a packet socket on an interface and starts reading replies.
+     * @param iface Interface to send from, as returned by interfaces().
+     * @return True if requests can be sent.
+     */
+    bool start(const Interface& iface);
+
+    /**
+     * @brief Closes the socket. No reply is reported afterwards.
+     */
+    void shutdown();
+
+    /**
+     * @brief Checks whether the socket is open.
+     * @return True after a successful start().
+     */
+    bool isAvailable() const { return open_.load(); }
+
+    /**
+     * @brief Sets the callback for replies; call before start().
+     * @param callback Invoked on an Asio worker thread for each reply.
+     */
+    void setReplyCallback(ReplyCallback callback);
+
+    /**
+     * @brief Broadcasts a who-has request without blocking.
+     * @param target Address to resolve (host byte order).
+     * @return False if the request could not be sent (send buffer full or socket closed).
+     */
+    bool request(uint32_t target);
+
+    /**
+     * @brief Builds an ARP request packet.
+     * @param senderMac Hardware address of the sending interface.
+     * @param sender Address of the sending interface (host byte order).
+     * @param target Address to resolve (host byte order).
+     * @return Serialized ARP packet, without the Ethernet header.
+     */
+    static std::array<uint8_t, PACKET_SIZE> buildRequest(const std::array<uint8_t, 6>& senderMac,
+                                                         uint32_t sender, uint32_t target);
+
+    /**
+     * @brief Parses an ARP packet.
+     * @param data Packet starting at the ARP header (no Ethernet header).
+     * @param length Packet length.
+     * @return The packet fields, or nullopt if not ARP for IPv4 over Ethernet.
+     */
+    static std::optional<Reply> parseReply(const uint8_t* data, size_t length);
+
+    /**
+     * @brief Formats a hardware address.
+     * @param mac Six address bytes.
+     * @return Lowercase colon-separated hex, e.g. "00:1a:2b:3c:4d:5e".
+     */
+    static std::string formatMac(const std::array<uint8_t, 6>& mac);
+
+private:
+    void startReceive();
+    void handleReadable();
+
+    asio::generic::raw_protocol::socket socket_;
+    std::atomic<bool> open_{false};
+    Interface interface_;
+
+    std::mutex mutex_; // Guards the socket and callback_
+    ReplyCallback callback_;
+};
+
+} // namespace netpulse::infra
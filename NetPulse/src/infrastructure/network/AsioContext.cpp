@@ -1,15 +1,59 @@
 #include "infrastructure/network/AsioContext.hpp"
 
+#include "infrastructure/network/BlockingExecutor.hpp"
+#include "infrastructure/network/DnsCache.hpp"
+#include "infrastructure/network/Hash.hpp"
+#include "infrastructure/network/TimerWheel.hpp"
+
 #include <spdlog/spdlog.h>
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 namespace netpulse::infra {
 
-AsioContext::AsioContext(size_t threadCount)
-    : threadCount_(threadCount > 0 ? threadCount : 1) {
-    spdlog::info("AsioContext created with {} threads", threadCount_);
+namespace {
+
+std::vector<std::unique_ptr<asio::io_context>> makeContexts(AsioContext::Topology topology,
+                                                            size_t threadCount) {
+    std::vector<std::unique_ptr<asio::io_context>> contexts;
+    if (topology == AsioContext::Topology::Shared) {
+        contexts.push_back(std::make_unique<asio::io_context>());
+        return contexts;
+    }
+
+    // Each context is run by exactly one thread, which lets the scheduler
+    // skip waking other threads for every posted handler
+    contexts.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        contexts.push_back(std::make_unique<asio::io_context>(1));
+    }
+    return contexts;
+}
+
+} // namespace
+
+AsioContext::AsioContext(size_t threadCount, Topology topology, bool pinThreads)
+    : topology_(topology), pinThreads_(pinThreads),
+      threadCount_(threadCount > 0 ? threadCount : 1),
+      contexts_(makeContexts(topology_, threadCount_)),
+      loopMonitor_(std::make_unique<EventLoopMonitor>(threadCount_)),
+      dnsCache_(std::make_shared<DnsCache>(getContext())),
+      blockingExecutor_(std::make_unique<BlockingExecutor>()) {
+    timerWheels_.reserve(contexts_.size());
+    for (auto& context : contexts_) {
+        timerWheels_.push_back(std::make_shared<TimerWheel>(*context));
+    }
+    spdlog::info("AsioContext created with {} threads ({} topology)", threadCount_,
+                 topologyToString(topology_));
 }
 
 AsioContext::~AsioContext() {
+    for (auto& wheel : timerWheels_) {
+        wheel->clear();
+    }
     stop();
 }
 
@@ -18,17 +62,32 @@ void AsioContext::start() {
         return;
     }
 
-    workGuard_.emplace(asio::make_work_guard(ioContext_));
+    workGuards_.reserve(contexts_.size());
+    for (auto& context : contexts_) {
+        workGuards_.push_back(asio::make_work_guard(*context));
+    }
 
     threads_.reserve(threadCount_);
     for (size_t i = 0; i < threadCount_; ++i) {
-        threads_.emplace_back([this, i]() {
+        auto& context = *contexts_[i % contexts_.size()];
+        threads_.emplace_back([this, i, &context]() {
+            if (pinThreads_) {
+                pinCurrentThread(i);
+            }
             spdlog::debug("Asio worker thread {} started", i);
-            ioContext_.run();
+            loopMonitor_->runWorker(i, context);
             spdlog::debug("Asio worker thread {} stopped", i);
         });
     }
 
+    std::vector<asio::io_context*> contexts;
+    contexts.reserve(contexts_.size());
+    for (auto& context : contexts_) {
+        contexts.push_back(context.get());
+    }
+    loopMonitor_->start(std::move(contexts), metricsInterval_);
+
+    blockingExecutor_->start();
     spdlog::info("AsioContext started with {} worker threads", threadCount_);
 }
 
@@ -37,8 +96,13 @@ void AsioContext::stop() {
         return;
     }
 
-    workGuard_.reset();
-    ioContext_.stop();
+    blockingExecutor_->stop();
+    loopMonitor_->stop();
+
+    workGuards_.clear();
+    for (auto& context : contexts_) {
+        context->stop();
+    }
 
     for (auto& thread : threads_) {
         if (thread.joinable()) {
@@ -47,13 +111,67 @@ void AsioContext::stop() {
     }
     threads_.clear();
 
-    ioContext_.restart();
+    for (auto& context : contexts_) {
+        context->restart();
+    }
     spdlog::info("AsioContext stopped");
 }
 
+asio::io_context& AsioContext::nextContext() {
+    if (contexts_.size() == 1) {
+        return *contexts_.front();
+    }
+    auto index = nextContext_.fetch_add(1, std::memory_order_relaxed);
+    return *contexts_[index % contexts_.size()];
+}
+
+asio::io_context& AsioContext::contextFor(uint64_t key) {
+    return *contexts_[contextIndexFor(key)];
+}
+
+size_t AsioContext::contextIndexFor(uint64_t key) const {
+    if (contexts_.size() == 1) {
+        return 0;
+    }
+    return mix64(key) % contexts_.size();
+}
+
+void AsioContext::pinCurrentThread(size_t index) const {
+#ifdef __linux__
+    auto cpus = std::thread::hardware_concurrency();
+    if (cpus == 0) {
+        return;
+    }
+    auto cpu = index % cpus;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (rc != 0) {
+        spdlog::warn("Failed to pin Asio worker thread {} to CPU {}: error {}", index, cpu, rc);
+        return;
+    }
+    spdlog::debug("Pinned Asio worker thread {} to CPU {}", index, cpu);
+#else
+    spdlog::debug("CPU pinning not supported on this platform (worker thread {})", index);
+#endif
+}
+
 AsioContext& AsioContext::instance() {
-    static AsioContext instance(4);
+    static AsioContext instance;
     return instance;
 }
 
+AsioContext::Topology AsioContext::topologyFromString(const std::string& name) {
+    if (name == "per_thread") {
+        return Topology::PerThread;
+    }
+    return Topology::Shared;
+}
+
+std::string AsioContext::topologyToString(Topology topology) {
+    return topology == Topology::PerThread ? "per_thread" : "shared";
+}
+
 } // namespace netpulse::infra
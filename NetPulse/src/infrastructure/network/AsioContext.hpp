@@ -1,29 +1,60 @@
 #pragma once
 
+#include "infrastructure/network/EventLoopMonitor.hpp"
+
 #include <asio.hpp>
 #include <atomic>
-#include <optional>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
 #include <thread>
 #include <vector>
 
 namespace netpulse::infra {
 
+class BlockingExecutor;
+class DnsCache;
+class TimerWheel;
+
 /**
- * @brief Manages an Asio I/O context with a thread pool for async operations.
+ * @brief Manages Asio I/O contexts with a thread pool for async operations.
+ *
+ * In the Shared topology one asio::io_context is run by every worker thread.
+ * In the PerThread topology each worker runs its own io_context, so handlers
+ * for a socket always execute on the same thread and never contend with other
+ * threads for the context's queue; sockets are spread over the contexts with
+ * nextContext() (round-robin) or contextFor() (hashed by a stable key).
+ * Worker threads can optionally be pinned to CPUs. Uses executor_work_guard to
+ * keep the contexts running until explicitly stopped.
+ *
+ * Handlers on the I/O threads must not block. Work that does (synchronous
+ * SNMP exchanges, scan checkpoint saves) goes to blockingExecutor(), a separate
+ * bounded pool that starts and stops with the context.
  *
- * Provides a wrapper around asio::io_context that manages a pool of worker threads
- * for executing asynchronous I/O operations. Uses executor_work_guard to keep
- * the context running until explicitly stopped.
+ * Worker threads report handler counts, busy time and queue latency through
+ * loopMetrics(), sampled by an EventLoopMonitor while the context runs.
  *
  * @note This class is non-copyable. Use the singleton instance() for shared access.
  */
 class AsioContext {
 public:
+    /**
+     * @brief How worker threads map onto io_contexts.
+     */
+    enum class Topology {
+        Shared,   ///< One io_context run by all worker threads
+        PerThread ///< One io_context per worker thread
+    };
+
     /**
      * @brief Constructs an AsioContext with the specified number of threads.
-     * @param threadCount Number of worker threads (defaults to hardware concurrency).
+     * @param threadCount Number of worker threads (0 or default: hardware concurrency).
+     * @param topology Thread to io_context mapping.
+     * @param pinThreads Pin worker thread i to CPU i (modulo the CPU count); Linux only.
      */
-    explicit AsioContext(size_t threadCount = std::thread::hardware_concurrency());
+    explicit AsioContext(size_t threadCount = std::thread::hardware_concurrency(),
+                         Topology topology = Topology::Shared, bool pinThreads = false);
 
     /**
      * @brief Destructor. Stops the context and joins all threads.
@@ -49,10 +80,100 @@ public:
     void stop();
 
     /**
-     * @brief Returns a reference to the underlying Asio io_context.
+     * @brief Returns the primary io_context.
+     *
+     * In the Shared topology this is the only context. In the PerThread
+     * topology it is the first worker's context, which also drives the DNS
+     * cache and the timerWheel() shared by keyless jobs.
+     *
      * @return Reference to the asio::io_context.
      */
-    asio::io_context& getContext() { return ioContext_; }
+    asio::io_context& getContext() { return *contexts_.front(); }
+
+    /**
+     * @brief Picks an io_context for a new socket, round-robin.
+     * @return Reference to the chosen asio::io_context.
+     */
+    asio::io_context& nextContext();
+
+    /**
+     * @brief Picks the io_context for a key, so the same key always lands on
+     *        the same context (and thread, in the PerThread topology).
+     * @param key Stable key such as a host id.
+     * @return Reference to the chosen asio::io_context.
+     */
+    asio::io_context& contextFor(uint64_t key);
+
+    /**
+     * @brief Returns the index of the io_context contextFor() picks for a key.
+     * @param key Stable key such as a host id.
+     * @return Index in [0, contextCount()).
+     */
+    size_t contextIndexFor(uint64_t key) const;
+
+    /**
+     * @brief Returns the number of worker threads.
+     * @return Thread count used by start() (at least 1).
+     */
+    size_t threadCount() const { return threadCount_; }
+
+    /**
+     * @brief Returns the number of io_contexts.
+     * @return 1 for the Shared topology, threadCount() for PerThread.
+     */
+    size_t contextCount() const { return contexts_.size(); }
+
+    /**
+     * @brief Returns the thread to io_context mapping.
+     * @return The topology fixed at construction.
+     */
+    Topology topology() const { return topology_; }
+
+    /**
+     * @brief Returns the timer wheel driven by the first io_context.
+     *
+     * Monitors register their recurring jobs on a wheel instead of owning one
+     * steady_timer per item.
+     *
+     * @return Reference to the TimerWheel.
+     */
+    TimerWheel& timerWheel() { return *timerWheels_.front(); }
+
+    /**
+     * @brief Returns the timer wheel driven by contextFor(key).
+     *
+     * Every io_context drives a wheel of its own, so in the PerThread
+     * topology the jobs of one key fire on that key's thread and each thread
+     * only expires its own share of the jobs.
+     *
+     * @param key Stable key such as a host id.
+     * @return Reference to the TimerWheel.
+     */
+    TimerWheel& timerWheelFor(uint64_t key) { return *timerWheels_[contextIndexFor(key)]; }
+
+    /**
+     * @brief Returns the bounded pool for blocking work.
+     * @return Reference to the BlockingExecutor.
+     */
+    BlockingExecutor& blockingExecutor() { return *blockingExecutor_; }
+
+    /**
+     * @brief Returns the shared hostname resolution cache.
+     * @return Reference to the DnsCache.
+     */
+    DnsCache& dnsCache() { return *dnsCache_; }
+
+    /**
+     * @brief Returns the latest event-loop health sample.
+     * @return Handler rates, busy time and queue latency per worker thread.
+     */
+    EventLoopMetrics loopMetrics() const { return loopMonitor_->snapshot(); }
+
+    /**
+     * @brief Sets the event-loop sample window used by the next start().
+     * @param interval Window length (default one second).
+     */
+    void setMetricsInterval(std::chrono::milliseconds interval) { metricsInterval_ = interval; }
 
     /**
      * @brief Posts a handler to be executed asynchronously.
@@ -61,7 +182,7 @@ public:
      */
     template <typename Handler>
     void post(Handler&& handler) {
-        asio::post(ioContext_, std::forward<Handler>(handler));
+        asio::post(nextContext(), std::forward<Handler>(handler));
     }
 
     /**
@@ -70,14 +191,38 @@ public:
      */
     static AsioContext& instance();
 
+    /**
+     * @brief Parses a topology name from configuration.
+     * @param name "per_thread"; anything else selects Shared.
+     * @return The topology.
+     */
+    static Topology topologyFromString(const std::string& name);
+
+    /**
+     * @brief Returns the configuration name of a topology.
+     * @param topology Topology to name.
+     * @return "shared" or "per_thread".
+     */
+    static std::string topologyToString(Topology topology);
+
 private:
     using WorkGuard = asio::executor_work_guard<asio::io_context::executor_type>;
 
-    asio::io_context ioContext_;
-    std::optional<WorkGuard> workGuard_;
+    void pinCurrentThread(size_t index) const;
+
+    Topology topology_;
+    bool pinThreads_;
+    size_t threadCount_;
+    std::vector<std::unique_ptr<asio::io_context>> contexts_;
+    std::unique_ptr<EventLoopMonitor> loopMonitor_; // Destroyed before the contexts
+    std::chrono::milliseconds metricsInterval_{EventLoopMonitor::DEFAULT_SAMPLE_INTERVAL};
+    std::vector<std::shared_ptr<TimerWheel>> timerWheels_; // One per io_context
+    std::shared_ptr<DnsCache> dnsCache_;
+    std::unique_ptr<BlockingExecutor> blockingExecutor_;
+    std::vector<WorkGuard> workGuards_;
     std::vector<std::thread> threads_;
     std::atomic<bool> running_{false};
-    size_t threadCount_;
+    std::atomic<size_t> nextContext_{0};
 };
 
 } // namespace netpulse::infra
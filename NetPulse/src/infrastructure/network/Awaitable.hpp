@@ -0,0 +1,52 @@
+#pragma once
+
+#include <asio.hpp>
+#include <memory>
+#include <utility>
+
+namespace netpulse::infra {
+
+/**
+ * @brief Awaits a callback-style asynchronous operation from a coroutine.
+ *
+ * Bridges the callback APIs used across the network layer (IcmpEngine,
+ * DnsCache, TransportProber) into asio::awaitable without a std::promise.
+ * The coroutine resumes on its own executor, whichever thread the callback
+ * fired on.
+ *
+ * @code
+ * auto start = [engine, address, timeout](auto done) {
+ *     engine->sendEcho(address, timeout, done);
+ * };
+ * auto result = co_await awaitCallback<core::PingResult>(std::move(start));
+ * @endcode
+ *
+ * @note Pass a named callable, not a lambda written inside the co_await
+ *       expression: GCC 12 destroys such lambda temporaries twice.
+ *
+ * @tparam Result Value the operation completes with.
+ * @tparam Start Callable taking a copyable completion callback `void(Result)`;
+ *         it must start the operation and arrange for the callback to be
+ *         invoked exactly once.
+ * @param start Starts the operation.
+ * @return The value passed to the completion callback.
+ */
+template <typename Result, typename Start>
+asio::awaitable<Result> awaitCallback(Start start) {
+    // Not a coroutine itself, so no extra frame: the caller awaits the
+    // operation directly
+    return asio::async_initiate<const asio::use_awaitable_t<>&, void(Result)>(
+        [start = std::move(start)](auto handler) mutable {
+            // Callback APIs take copyable std::functions; the handler is move-only
+            auto shared = std::make_shared<decltype(handler)>(std::move(handler));
+            start([shared](Result result) {
+                auto executor = asio::get_associated_executor(*shared);
+                asio::post(executor, [shared, result = std::move(result)]() mutable {
+                    (*shared)(std::move(result));
+                });
+            });
+        },
+        asio::use_awaitable);
+}
+
+} // namespace netpulse::infra
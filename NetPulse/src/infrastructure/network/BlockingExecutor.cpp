@@ -0,0 +1,142 @@
+#include "infrastructure/network/BlockingExecutor.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+namespace netpulse::infra {
+
+BlockingExecutor::BlockingExecutor(size_t threadCount, size_t capacity)
+    : threadCount_(std::max<size_t>(threadCount, 1)), capacity_(std::max<size_t>(capacity, 1)) {}
+
+BlockingExecutor::~BlockingExecutor() {
+    stop();
+    cancelQueued();
+}
+
+void BlockingExecutor::start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+
+    size_t count;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = false;
+        count = threadCount_;
+    }
+
+    threads_.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        threads_.emplace_back([this]() { run(); });
+    }
+
+    spdlog::info("Blocking executor started with {} threads", count);
+}
+
+void BlockingExecutor::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    available_.notify_all();
+
+    for (auto& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    threads_.clear();
+    cancelQueued();
+    spdlog::info("Blocking executor stopped");
+}
+
+void BlockingExecutor::cancelQueued() {
+    std::deque<Entry> dropped;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        dropped.swap(queue_);
+        cancelled_ += dropped.size();
+    }
+
+    for (auto& entry : dropped) {
+        if (!entry.onCancel) {
+            continue;
+        }
+        try {
+            entry.onCancel();
+        } catch (const std::exception& e) {
+            spdlog::error("Blocking task cancel handler failed: {}", e.what());
+        }
+    }
+}
+
+void BlockingExecutor::configure(size_t threadCount, size_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    threadCount_ = std::max<size_t>(threadCount, 1);
+    capacity_ = std::max<size_t>(capacity, 1);
+}
+
+bool BlockingExecutor::tryPost(Task task, Task onCancel) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Nothing would run a task posted after stop(); the caller falls back
+        if (stopping_ || queue_.size() >= capacity_) {
+            ++rejected_;
+            return false;
+        }
+        queue_.push_back({std::move(task), std::move(onCancel)});
+        ++submitted_;
+        peakQueued_ = std::max(peakQueued_, queue_.size());
+    }
+    available_.notify_one();
+    return true;
+}
+
+BlockingExecutor::Stats BlockingExecutor::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats;
+    stats.threads = threadCount_;
+    stats.capacity = capacity_;
+    stats.queued = queue_.size();
+    stats.peakQueued = peakQueued_;
+    stats.active = active_;
+    stats.submitted = submitted_;
+    stats.completed = completed_;
+    stats.rejected = rejected_;
+    stats.cancelled = cancelled_;
+    return stats;
+}
+
+void BlockingExecutor::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        available_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+        if (stopping_) {
+            return;
+        }
+
+        auto task = std::move(queue_.front().task);
+        queue_.pop_front();
+        ++active_;
+        lock.unlock();
+
+        try {
+            task();
+        } catch (const std::exception& e) {
+            spdlog::error("Blocking task failed: {}", e.what());
+        }
+        // Release captured state before retaking the lock
+        task = nullptr;
+
+        lock.lock();
+        --active_;
+        ++completed_;
+    }
+}
+
+} // namespace netpulse::infra
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace netpulse::infra {
+
+/**
+ * @brief Bounded thread pool for work that blocks.
+ *
+ * Synchronous socket exchanges (SNMP requests and walks) and other legacy
+ * blocking calls run here instead of on the Asio I/O threads, so a handful of
+ * unresponsive devices cannot starve the REST acceptor or probe completions.
+ *
+ * The queue has a fixed capacity. tryPost() never blocks: when the queue is
+ * full it rejects the task and the caller reports the overload, which keeps
+ * back-pressure visible instead of growing an unbounded backlog.
+ *
+ * Tasks still queued when the executor stops are not run; their cancel
+ * handler is called instead, so a caller waiting on a promise gets a clean
+ * rejection rather than std::broken_promise.
+ */
+class BlockingExecutor {
+public:
+    /// Unit of blocking work.
+    using Task = std::function<void()>;
+
+    /**
+     * @brief Snapshot of queue and throughput counters.
+     */
+    struct Stats {
+        size_t threads{0};       ///< Worker threads configured
+        size_t capacity{0};      ///< Maximum queued tasks
+        size_t queued{0};        ///< Tasks waiting for a worker
+        size_t peakQueued{0};    ///< Highest queue depth observed
+        size_t active{0};        ///< Tasks currently running
+        uint64_t submitted{0};   ///< Tasks accepted by tryPost()
+        uint64_t completed{0};   ///< Tasks that finished running
+        uint64_t rejected{0};    ///< Tasks refused because the queue was full or stopped
+        uint64_t cancelled{0};   ///< Queued tasks cancelled by stop()
+    };
+
+    static constexpr size_t DEFAULT_THREADS = 4;
+    static constexpr size_t DEFAULT_CAPACITY = 1024;
+
+    /**
+     * @brief Constructs a stopped executor.
+     * @param threadCount Worker threads started by start() (at least 1).
+     * @param capacity Maximum number of queued tasks (at least 1).
+     */
+    explicit BlockingExecutor(size_t threadCount = DEFAULT_THREADS,
+                              size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief Destructor. Stops the workers and cancels queued tasks.
+     */
+    ~BlockingExecutor();
+
+    BlockingExecutor(const BlockingExecutor&) = delete;
+    BlockingExecutor& operator=(const BlockingExecutor&) = delete;
+
+    /**
+     * @brief Starts the worker threads. Has no effect if already running.
+     */
+    void start();
+
+    /**
+     * @brief Stops the workers after their current task.
+     *
+     * Once the workers have joined, every task still queued is removed and
+     * its cancel handler runs on the calling thread. Tasks posted before the
+     * first start() are kept until then.
+     */
+    void stop();
+
+    /**
+     * @brief Changes the pool size and queue capacity.
+     *
+     * The capacity applies immediately; a new thread count takes effect on
+     * the next start().
+     *
+     * @param threadCount Worker threads (at least 1).
+     * @param capacity Maximum number of queued tasks (at least 1).
+     */
+    void configure(size_t threadCount, size_t capacity);
+
+    /**
+     * @brief Queues a task without blocking the caller.
+     * @param task Work to run on a pool thread.
+     * @param onCancel Called instead of task if the executor stops before running it.
+     * @return False if the queue is full or the executor has stopped and the task was not
+     *         accepted; onCancel is not called.
+     */
+    [[nodiscard]] bool tryPost(Task task, Task onCancel = {});
+
+    /**
+     * @brief Returns the current queue and throughput counters.
+     * @return Stats snapshot.
+     */
+    Stats stats() const;
+
+private:
+    struct Entry {
+        Task task;
+        Task onCancel;
+    };
+
+    void run();
+    void cancelQueued();
+
+    mutable std::mutex mutex_;
+    std::condition_variable available_;
+    std::deque<Entry> queue_;
+    std::vector<std::thread> threads_;
+    size_t threadCount_;
+    size_t capacity_;
+    size_t peakQueued_{0};
+    size_t active_{0};
+    uint64_t submitted_{0};
+    uint64_t completed_{0};
+    uint64_t rejected_{0};
+    uint64_t cancelled_{0};
+    bool stopping_{false};
+    std::atomic<bool> running_{false};
+};
+
+} // namespace netpulse::infra
@@ -0,0 +1,210 @@
+#include "infrastructure/network/DnsCache.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace netpulse::infra {
+
+DnsCache::DnsCache(asio::io_context& ioContext, Options options)
+    : ioContext_(ioContext), options_(options) {}
+
+DnsCache::~DnsCache() {
+    // The lookups' completions can no longer reach this cache
+    std::vector<ResolveCallback> waiters;
+    {
+        std::lock_guard lock(mutex_);
+        for (auto& [host, entry] : entries_) {
+            std::move(entry.waiters.begin(), entry.waiters.end(), std::back_inserter(waiters));
+        }
+    }
+    for (auto& waiter : waiters) {
+        try {
+            waiter(asio::error::operation_aborted, {});
+        } catch (const std::exception& e) {
+            spdlog::error("DnsCache: resolve callback threw: {}", e.what());
+        }
+    }
+}
+
+void DnsCache::resolveAsync(const std::string& host, ResolveCallback callback) {
+    // Literals never touch the resolver or the cache
+    asio::error_code parseError;
+    auto literal = asio::ip::make_address(host, parseError);
+    if (!parseError) {
+        callback({}, Addresses{literal});
+        return;
+    }
+
+    std::unique_lock lock(mutex_);
+    auto now = std::chrono::steady_clock::now();
+
+    auto it = entries_.find(host);
+    if (it != entries_.end() && it->second.resolved) {
+        auto& entry = it->second;
+
+        if (now < entry.expires) {
+            if (entry.error) {
+                ++stats_.negativeHits;
+            } else {
+                ++stats_.hits;
+            }
+            auto error = entry.error;
+            auto addresses = entry.addresses;
+            lock.unlock();
+            callback(error, addresses);
+            return;
+        }
+
+        if (!entry.error && now < entry.expires + options_.maxStale) {
+            ++stats_.staleServes;
+            if (!entry.refreshing) {
+                entry.refreshing = true;
+                startLookup(host);
+            }
+            auto addresses = entry.addresses;
+            lock.unlock();
+            callback({}, addresses);
+            return;
+        }
+    }
+
+    ++stats_.misses;
+    if (it == entries_.end()) {
+        evictLocked(now);
+        it = entries_.emplace(host, Entry{}).first;
+    }
+    it->second.waiters.push_back(std::move(callback));
+    if (!it->second.refreshing) {
+        it->second.refreshing = true;
+        startLookup(host);
+    }
+}
+
+void DnsCache::invalidate(const std::string& host) {
+    std::lock_guard lock(mutex_);
+    auto it = entries_.find(host);
+    if (it != entries_.end() && !it->second.refreshing) {
+        entries_.erase(it);
+    }
+}
+
+void DnsCache::clear() {
+    std::lock_guard lock(mutex_);
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        // Keep entries with a lookup in flight so their waiters get answered
+        if (it->second.refreshing) {
+            ++it;
+        } else {
+            it = entries_.erase(it);
+        }
+    }
+}
+
+DnsCache::Stats DnsCache::stats() const {
+    std::lock_guard lock(mutex_);
+    auto snapshot = stats_;
+    snapshot.entries = 0;
+    snapshot.inFlight = 0;
+    for (const auto& [host, entry] : entries_) {
+        if (entry.resolved) {
+            ++snapshot.entries;
+        }
+        if (entry.refreshing) {
+            ++snapshot.inFlight;
+        }
+    }
+    return snapshot;
+}
+
+void DnsCache::startLookup(const std::string& host) {
+    // Called with mutex_ held; async_resolve never completes inline
+    auto resolver = std::make_shared<asio::ip::udp::resolver>(ioContext_);
+    std::weak_ptr<DnsCache> weak = weak_from_this();
+
+    resolver->async_resolve(
+        host, "",
+        [weak, host, resolver](const asio::error_code& ec,
+                               const asio::ip::udp::resolver::results_type& results) {
+            if (auto self = weak.lock()) {
+                self->onResolved(host, ec, results);
+            }
+        });
+}
+
+void DnsCache::onResolved(const std::string& host, const asio::error_code& ec,
+                          const asio::ip::udp::resolver::results_type& results) {
+    Addresses addresses;
+    if (!ec) {
+        for (const auto& endpoint : results) {
+            auto address = endpoint.endpoint().address();
+            if (std::find(addresses.begin(), addresses.end(), address) == addresses.end()) {
+                addresses.push_back(address);
+            }
+        }
+    }
+
+    std::vector<ResolveCallback> waiters;
+    asio::error_code error;
+    {
+        std::lock_guard lock(mutex_);
+        auto now = std::chrono::steady_clock::now();
+        auto& entry = entries_[host];
+        entry.refreshing = false;
+        waiters.swap(entry.waiters);
+
+        if (!addresses.empty()) {
+            entry.addresses = std::move(addresses);
+            entry.error = {};
+            entry.expires = now + options_.positiveTtl;
+            entry.resolved = true;
+        } else {
+            ++stats_.failures;
+            bool canServeStale = entry.resolved && !entry.error &&
+                                 now < entry.expires + options_.maxStale;
+            if (!canServeStale) {
+                entry.addresses.clear();
+                entry.error = ec ? ec : asio::error::host_not_found;
+                entry.expires = now + options_.negativeTtl;
+                entry.resolved = true;
+            }
+            spdlog::debug("DnsCache: lookup for {} failed: {}", host,
+                          ec ? ec.message() : "no addresses");
+        }
+
+        error = entry.error;
+        addresses = entry.addresses;
+    }
+
+    for (auto& waiter : waiters) {
+        try {
+            waiter(error, addresses);
+        } catch (const std::exception& e) {
+            spdlog::error("DnsCache: resolve callback threw: {}", e.what());
+        }
+    }
+}
+
+void DnsCache::evictLocked(std::chrono::steady_clock::time_point now) {
+    if (entries_.size() < options_.maxEntries) {
+        return;
+    }
+
+    // Drop answers that can no longer be served, even stale
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        const auto& entry = it->second;
+        bool dead = entry.resolved && !entry.refreshing &&
+                    now >= entry.expires + (entry.error ? std::chrono::seconds(0)
+                                                        : options_.maxStale);
+        it = dead ? entries_.erase(it) : std::next(it);
+    }
+
+    // Still full: drop any idle entry rather than grow without bound
+    for (auto it = entries_.begin(); entries_.size() >= options_.maxEntries &&
+                                     it != entries_.end();) {
+        it = it->second.refreshing ? std::next(it) : entries_.erase(it);
+    }
+}
+
+} // namespace netpulse::infra
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <asio.hpp>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace netpulse::infra {
+
+/**
+ * @brief Shared asynchronous hostname resolution cache.
+ *
+ * Lookups go through asio's async_resolve so worker threads never block on
+ * the system resolver, and concurrent lookups for the same name are coalesced
+ * into one query. Successful answers are cached for a positive TTL and failures
+ * for a shorter negative TTL. Once an answer expires it is still served for a
+ * bounded stale window while a background refresh runs, and it is kept if that
+ * refresh fails.
+ *
+ * Numeric IPv4/IPv6 literals bypass the cache entirely.
+ *
+ * @note Create instances with std::make_shared; pending lookups only hold
+ *       weak references to the cache, and destroying it fails their waiters.
+ */
+class DnsCache : public std::enable_shared_from_this<DnsCache> {
+public:
+    /// Resolved addresses for a name, in resolver order.
+    using Addresses = std::vector<asio::ip::address>;
+
+    /**
+     * @brief Callback receiving the outcome of a lookup.
+     * @param error Empty on success; the resolver error (or cached error) otherwise.
+     * @param addresses Resolved addresses, empty on failure.
+     */
+    using ResolveCallback = std::function<void(const asio::error_code& error,
+                                               const Addresses& addresses)>;
+
+    /**
+     * @brief Cache tuning parameters.
+     */
+    struct Options {
+        std::chrono::seconds positiveTtl{300}; ///< Lifetime of a successful answer
+        std::chrono::seconds negativeTtl{30};  ///< Lifetime of a failed lookup
+        std::chrono::seconds maxStale{3600};   ///< How long an expired answer may still be served
+        size_t maxEntries{10000};              ///< Soft cap on cached names
+    };
+
+    /**
+     * @brief Cache counters for diagnostics.
+     */
+    struct Stats {
+        uint64_t hits{0};         ///< Fresh positive answers served from cache
+        uint64_t negativeHits{0}; ///< Fresh cached failures served
+        uint64_t misses{0};       ///< Lookups that had to wait for the resolver
+        uint64_t staleServes{0};  ///< Expired answers served while refreshing
+        uint64_t failures{0};     ///< Resolver queries that failed
+        size_t entries{0};        ///< Names currently cached
+        size_t inFlight{0};       ///< Resolver queries currently running
+    };
+
+    /**
+     * @brief Constructs a cache resolving on the given io_context.
+     * @param ioContext The io_context that runs resolver completions.
+     * @param options Cache tuning parameters.
+     */
+    explicit DnsCache(asio::io_context& ioContext, Options options);
+
+    /**
+     * @brief Constructs a cache with default options.
+     * @param ioContext The io_context that runs resolver completions.
+     */
+    explicit DnsCache(asio::io_context& ioContext) : DnsCache(ioContext, Options{}) {}
+
+    /**
+     * @brief Fails the callbacks still waiting on a lookup.
+     *
+     * They receive asio::error::operation_aborted, so callers that hold
+     * resources until the answer arrives can release them.
+     */
+    ~DnsCache();
+
+    DnsCache(const DnsCache&) = delete;
+    DnsCache& operator=(const DnsCache&) = delete;
+
+    /**
+     * @brief Resolves a hostname, serving from cache when possible.
+     *
+     * The callback runs inline when the answer is a literal or already cached
+     * (fresh or stale), otherwise on an Asio worker thread once the resolver
+     * completes.
+     *
+     * @param host Hostname or numeric address.
+     * @param callback Invoked exactly once with the outcome.
+     */
+    void resolveAsync(const std::string& host, ResolveCallback callback);
+
+    /**
+     * @brief Drops the cached answer for a name.
+     * @param host Hostname to forget.
+     */
+    void invalidate(const std::string& host);
+
+    /**
+     * @brief Drops all cached answers. Lookups in flight still complete.
+     */
+    void clear();
+
+    /**
+     * @brief Returns a snapshot of the cache counters.
+     * @return Current statistics.
+     */
+    Stats stats() const;
+
+private:
+    struct Entry {
+        Addresses addresses;
+        asio::error_code error;
+        std::chrono::steady_clock::time_point expires;
+        bool resolved{false};
+        bool refreshing{false};
+        std::vector<ResolveCallback> waiters;
+    };
+
+    void startLookup(const std::string& host);
+    void onResolved(const std::string& host, const asio::error_code& ec,
+                    const asio::ip::udp::resolver::results_type& results);
+    void evictLocked(std::chrono::steady_clock::time_point now);
+
+    asio::io_context& ioContext_;
+    const Options options_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    Stats stats_;
+};
+
+} // namespace netpulse::infra
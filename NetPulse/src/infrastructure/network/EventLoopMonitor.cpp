@@ -0,0 +1,186 @@
+#include "infrastructure/network/EventLoopMonitor.hpp"
+
+#include <algorithm>
+
+// Handlers are only timed when Asio reports them through HandlerTiming
+#ifndef ASIO_CUSTOM_HANDLER_TRACKING
+#error "ASIO_CUSTOM_HANDLER_TRACKING must name infrastructure/network/HandlerTiming.hpp"
+#endif
+
+namespace netpulse::infra {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::chrono::microseconds toMicros(Clock::duration duration) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration);
+}
+
+} // namespace
+
+EventLoopMonitor::EventLoopMonitor(size_t workerCount)
+    : workers_(std::max<size_t>(workerCount, 1)) {
+    current_.workers.resize(workers_.size());
+    for (size_t i = 0; i < current_.workers.size(); ++i) {
+        current_.workers[i].index = i;
+    }
+}
+
+EventLoopMonitor::~EventLoopMonitor() {
+    stop();
+}
+
+void EventLoopMonitor::runWorker(size_t index, asio::io_context& context) {
+    auto& slot = workers_[index % workers_.size()];
+
+    // Asio reports each handler as it returns, wherever the run loop waited
+    HandlerTiming::setRecorder(&slot);
+    try {
+        context.run();
+    } catch (...) {
+        HandlerTiming::setRecorder(nullptr);
+        throw;
+    }
+    HandlerTiming::setRecorder(nullptr);
+}
+
+void EventLoopMonitor::WorkerSlot::handlerRan(Clock::duration elapsed) noexcept {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    handlers.fetch_add(1, std::memory_order_relaxed);
+    busyNs.fetch_add(ns, std::memory_order_relaxed);
+    if (ns > longestNs.load(std::memory_order_relaxed)) {
+        longestNs.store(ns, std::memory_order_relaxed);
+    }
+}
+
+void EventLoopMonitor::start(std::vector<asio::io_context*> contexts,
+                             std::chrono::milliseconds interval) {
+    if (contexts.empty() || running_.exchange(true)) {
+        return;
+    }
+
+    contexts_ = std::move(contexts);
+    interval_ = std::max(interval, std::chrono::milliseconds{1});
+    timer_ = std::make_unique<asio::steady_timer>(*contexts_.front());
+
+    lastSample_ = Clock::now();
+    for (auto& slot : workers_) {
+        slot.lastHandlers = slot.handlers.load(std::memory_order_relaxed);
+        slot.lastBusyNs = slot.busyNs.load(std::memory_order_relaxed);
+    }
+
+    timer_->expires_at(lastSample_ + interval_);
+    arm();
+}
+
+void EventLoopMonitor::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    if (timer_) {
+        timer_->cancel();
+    }
+}
+
+EventLoopMetrics EventLoopMonitor::snapshot() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return current_;
+}
+
+void EventLoopMonitor::arm() {
+    timer_->async_wait([this](const asio::error_code& ec) {
+        if (ec || !running_) {
+            return;
+        }
+        // A handler blocking the loop delays the timer, so its lateness is
+        // queue latency on the sampler's own context
+        recordLatency(Clock::now() - timer_->expiry());
+        sample();
+        // Rearm from the previous deadline so windows do not drift, skipping
+        // any deadlines missed while the loop was stalled
+        auto next = timer_->expiry() + interval_;
+        auto now = Clock::now();
+        if (next <= now) {
+            next += ((now - next) / interval_ + 1) * interval_;
+        }
+        timer_->expires_at(next);
+        arm();
+    });
+}
+
+void EventLoopMonitor::sample() {
+    auto now = Clock::now();
+    double window = std::chrono::duration<double>(now - lastSample_).count();
+    lastSample_ = now;
+    if (window <= 0.0) {
+        return;
+    }
+
+    std::vector<EventLoopMetrics::Worker> workers(workers_.size());
+    uint64_t totalHandlers = 0;
+    double totalRate = 0.0;
+    double busySum = 0.0;
+    int64_t longestNs = 0;
+
+    for (size_t i = 0; i < workers_.size(); ++i) {
+        auto& slot = workers_[i];
+        auto& worker = workers[i];
+        worker.index = i;
+
+        worker.handlers = slot.handlers.load(std::memory_order_relaxed);
+        worker.handlersPerSecond =
+            static_cast<double>(worker.handlers - slot.lastHandlers) / window;
+        slot.lastHandlers = worker.handlers;
+
+        auto longest = slot.longestNs.load(std::memory_order_relaxed);
+        worker.longestHandler = std::chrono::microseconds{longest / 1000};
+        longestNs = std::max(longestNs, longest);
+
+        // A handler is added when it returns, so one spanning the window
+        // boundary lands in a single window; clamp rather than exceed 100%
+        auto busyNs = slot.busyNs.load(std::memory_order_relaxed);
+        double busy = static_cast<double>(busyNs - slot.lastBusyNs) / 1e9 / window * 100.0;
+        worker.busyPercent = std::clamp(busy, 0.0, 100.0);
+        busySum += worker.busyPercent;
+        slot.lastBusyNs = busyNs;
+
+        totalHandlers += worker.handlers;
+        totalRate += worker.handlersPerSecond;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        current_.workers = std::move(workers);
+        current_.handlers = totalHandlers;
+        current_.handlersPerSecond = totalRate;
+        current_.busyPercent = busySum / static_cast<double>(workers_.size());
+        current_.longestHandler = std::chrono::microseconds{longestNs / 1000};
+        current_.queueLatencyMax = windowMaxLatency_;
+        windowMaxLatency_ = std::chrono::microseconds{0};
+        ++current_.samples;
+    }
+
+    // Probes posted now are reported with the next window
+    for (auto* context : contexts_) {
+        asio::post(*context, [this, posted = Clock::now()]() {
+            recordLatency(Clock::now() - posted);
+        });
+    }
+}
+
+void EventLoopMonitor::recordLatency(Clock::duration latency) {
+    auto micros = toMicros(latency);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    current_.queueLatency = micros;
+    // EWMA with weight 1/8, seeded by the first probe
+    if (current_.queueLatencyAvg.count() == 0) {
+        current_.queueLatencyAvg = micros;
+    } else {
+        current_.queueLatencyAvg += (micros - current_.queueLatencyAvg) / 8;
+    }
+    windowMaxLatency_ = std::max(windowMaxLatency_, micros);
+}
+
+} // namespace netpulse::infra
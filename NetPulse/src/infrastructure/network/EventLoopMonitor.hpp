@@ -0,0 +1,129 @@
+#pragma once
+
+#include "infrastructure/network/HandlerTiming.hpp"
+
+#include <asio.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace netpulse::infra {
+
+/**
+ * @brief Health snapshot of the Asio worker threads.
+ *
+ * Rates and busy time cover the most recent sample window; counters and the
+ * longest handler are cumulative since the context started.
+ */
+struct EventLoopMetrics {
+    /**
+     * @brief Per-thread figures.
+     */
+    struct Worker {
+        size_t index{0};                ///< Worker thread index
+        uint64_t handlers{0};           ///< Handlers run since start
+        double handlersPerSecond{0.0};  ///< Handler rate over the last window
+        double busyPercent{-1.0};       ///< Share of the last window spent in handlers (-1: unknown)
+        std::chrono::microseconds longestHandler{0}; ///< Longest handler since start
+    };
+
+    std::vector<Worker> workers;       ///< One entry per worker thread
+    uint64_t handlers{0};              ///< Handlers run by all workers since start
+    double handlersPerSecond{0.0};     ///< Combined handler rate over the last window
+    double busyPercent{-1.0};          ///< Mean busy share across workers (-1: unknown)
+    std::chrono::microseconds longestHandler{0};  ///< Longest handler on any worker
+    std::chrono::microseconds queueLatency{0};    ///< Latest ready-to-run delay
+    std::chrono::microseconds queueLatencyAvg{0}; ///< Smoothed ready-to-run delay
+    std::chrono::microseconds queueLatencyMax{0}; ///< Worst delay in the last window
+    uint64_t samples{0};               ///< Sample windows completed
+};
+
+/**
+ * @brief Samples event-loop health for AsioContext.
+ *
+ * Workers run their io_context through runWorker(), which registers the
+ * worker with HandlerTiming so every handler it runs is counted and timed,
+ * including the first one after an idle wait. Busy time is the wall time
+ * spent inside handlers, so a handler blocked in a system call counts as
+ * busy just like one burning CPU.
+ *
+ * Every sample interval a timer on the first context computes rates and
+ * posts a probe handler to every context. Queue latency is the delay between
+ * a handler becoming ready and running: how long each probe waited, and how
+ * late the sampler timer itself fired.
+ */
+class EventLoopMonitor {
+public:
+    static constexpr std::chrono::milliseconds DEFAULT_SAMPLE_INTERVAL{1000};
+
+    /**
+     * @brief Constructs a monitor for a fixed number of worker threads.
+     * @param workerCount Number of threads that will call runWorker().
+     */
+    explicit EventLoopMonitor(size_t workerCount);
+
+    ~EventLoopMonitor();
+
+    EventLoopMonitor(const EventLoopMonitor&) = delete;
+    EventLoopMonitor& operator=(const EventLoopMonitor&) = delete;
+
+    /**
+     * @brief Runs an io_context on the calling thread until it is stopped.
+     * @param index Worker index in [0, workerCount).
+     * @param context The io_context this worker runs.
+     */
+    void runWorker(size_t index, asio::io_context& context);
+
+    /**
+     * @brief Starts periodic sampling.
+     * @param contexts Contexts to probe; the first also runs the sampler.
+     * @param interval Sample window length.
+     */
+    void start(std::vector<asio::io_context*> contexts,
+               std::chrono::milliseconds interval = DEFAULT_SAMPLE_INTERVAL);
+
+    /**
+     * @brief Stops periodic sampling. Metrics keep their last values.
+     */
+    void stop();
+
+    /**
+     * @brief Returns the latest metrics.
+     * @return Snapshot of the last completed sample window.
+     */
+    EventLoopMetrics snapshot() const;
+
+private:
+    // Written by its worker thread, read by the sampler
+    struct alignas(64) WorkerSlot final : HandlerTiming::Recorder {
+        void handlerRan(std::chrono::steady_clock::duration elapsed) noexcept override;
+
+        std::atomic<uint64_t> handlers{0};
+        std::atomic<int64_t> busyNs{0};
+        std::atomic<int64_t> longestNs{0};
+
+        // Sampler-only state
+        uint64_t lastHandlers{0};
+        int64_t lastBusyNs{0};
+    };
+
+    void arm();
+    void sample();
+    void recordLatency(std::chrono::steady_clock::duration latency);
+
+    std::vector<WorkerSlot> workers_;
+    std::vector<asio::io_context*> contexts_;
+    std::unique_ptr<asio::steady_timer> timer_;
+    std::chrono::milliseconds interval_{DEFAULT_SAMPLE_INTERVAL};
+    std::chrono::steady_clock::time_point lastSample_;
+    std::atomic<bool> running_{false};
+
+    mutable std::mutex mutex_; // Guards the fields below
+    EventLoopMetrics current_;
+    std::chrono::microseconds windowMaxLatency_{0};
+};
+
+} // namespace netpulse::infra
@@ -0,0 +1,35 @@
+#include "infrastructure/network/HandlerTiming.hpp"
+
+namespace netpulse::infra {
+
+namespace {
+
+thread_local HandlerTiming::Recorder* currentRecorder = nullptr;
+thread_local int depth = 0; // Handlers currently running on this thread
+
+} // namespace
+
+void HandlerTiming::setRecorder(Recorder* recorder) noexcept {
+    currentRecorder = recorder;
+}
+
+void HandlerTiming::Invocation::start() noexcept {
+    if (currentRecorder == nullptr) {
+        return;
+    }
+    active_ = true;
+    outermost_ = depth++ == 0;
+    if (outermost_) {
+        started_ = std::chrono::steady_clock::now();
+    }
+}
+
+void HandlerTiming::Invocation::finish() noexcept {
+    active_ = false;
+    --depth;
+    if (outermost_ && currentRecorder != nullptr) {
+        currentRecorder->handlerRan(std::chrono::steady_clock::now() - started_);
+    }
+}
+
+} // namespace netpulse::infra
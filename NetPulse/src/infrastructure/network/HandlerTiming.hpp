@@ -0,0 +1,98 @@
+#pragma once
+
+#include <chrono>
+
+namespace netpulse::infra {
+
+/**
+ * @brief Times every Asio handler run on a worker thread.
+ *
+ * The build points ASIO_CUSTOM_HANDLER_TRACKING at this header, so Asio wraps
+ * each handler invocation in an Invocation. A thread that registers a
+ * Recorder is told the wall time of every outermost handler it runs,
+ * including the first one after an idle wait; handlers run inline inside
+ * another are part of their caller's time. Threads without a Recorder pay one
+ * thread-local check per handler.
+ *
+ * @note Must not include Asio: Asio includes it while defining its own hooks.
+ */
+class HandlerTiming {
+public:
+    /**
+     * @brief Receives the handlers run by the thread that registered it.
+     */
+    class Recorder {
+    public:
+        /**
+         * @brief Called after each outermost handler returns or throws.
+         * @param elapsed Wall time spent inside the handler.
+         */
+        virtual void handlerRan(std::chrono::steady_clock::duration elapsed) noexcept = 0;
+
+    protected:
+        ~Recorder() = default;
+    };
+
+    /**
+     * @brief Registers the recorder for handlers run by the calling thread.
+     * @param recorder Recorder to notify, or nullptr to stop timing.
+     */
+    static void setRecorder(Recorder* recorder) noexcept;
+
+    // One handler completion, declared by Asio's completion hook
+    class Invocation {
+    public:
+        template <typename Handler>
+        explicit Invocation(const Handler& /*handler*/) noexcept {}
+        ~Invocation() {
+            if (active_) {
+                finish(); // The handler threw
+            }
+        }
+
+        Invocation(const Invocation&) = delete;
+        Invocation& operator=(const Invocation&) = delete;
+
+        template <typename... Args>
+        void begin(const Args&... /*results*/) noexcept {
+            start();
+        }
+        void end() noexcept {
+            if (active_) {
+                finish();
+            }
+        }
+
+    private:
+        void start() noexcept;
+        void finish() noexcept;
+
+        std::chrono::steady_clock::time_point started_;
+        bool active_{false};
+        bool outermost_{false};
+    };
+
+    // Asio's remaining hooks carry nothing we time
+    template <typename... Args>
+    static void ignore(const Args&... /*args*/) noexcept {}
+};
+
+} // namespace netpulse::infra
+
+#define ASIO_INHERIT_TRACKED_HANDLER
+#define ASIO_ALSO_INHERIT_TRACKED_HANDLER
+#define ASIO_HANDLER_TRACKING_INIT (void)0
+#define ASIO_HANDLER_LOCATION(args) (void)0
+#define ASIO_HANDLER_CREATION(args) (void)0
+#define ASIO_HANDLER_COMPLETION(args) \
+    ::netpulse::infra::HandlerTiming::Invocation tracked_completion args
+#define ASIO_HANDLER_INVOCATION_BEGIN(args) tracked_completion.begin args
+#define ASIO_HANDLER_INVOCATION_END tracked_completion.end()
+#define ASIO_HANDLER_OPERATION(args) (void)0
+#define ASIO_HANDLER_REACTOR_REGISTRATION(args) (void)0
+#define ASIO_HANDLER_REACTOR_DEREGISTRATION(args) (void)0
+#define ASIO_HANDLER_REACTOR_READ_EVENT 1
+#define ASIO_HANDLER_REACTOR_WRITE_EVENT 2
+#define ASIO_HANDLER_REACTOR_ERROR_EVENT 4
+#define ASIO_HANDLER_REACTOR_EVENTS(args) ::netpulse::infra::HandlerTiming::ignore args
+#define ASIO_HANDLER_REACTOR_OPERATION(args) (void)0
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+
+namespace netpulse::infra {
+
+/**
+ * @brief SplitMix64 finalizer.
+ *
+ * Cheap, well-distributed 64-bit mixer: sequential inputs (host ids, targets)
+ * map to outputs that differ in about half their bits, so taking the result
+ * modulo a small count spreads them evenly. Not keyed; do not use where the
+ * output must be unpredictable.
+ *
+ * @param x Value to mix.
+ * @return Mixed value.
+ */
+inline uint64_t mix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+/**
+ * @brief SipHash-2-4 of one 64-bit word under a 128-bit key.
+ *
+ * A keyed PRF: without the key, outputs cannot be predicted from inputs. Use
+ * it for values a third party must not guess, such as TCP sequence numbers.
+ * Equals the reference SipHash-2-4 of the word's 8 little-endian bytes.
+ *
+ * @param k0 First key half (key bytes 0-7, little-endian).
+ * @param k1 Second key half (key bytes 8-15, little-endian).
+ * @param message Value to hash.
+ * @return 64-bit tag.
+ */
+inline uint64_t sipHash24(uint64_t k0, uint64_t k1, uint64_t message) {
+    uint64_t v0 = k0 ^ 0x736F6D6570736575ULL;
+    uint64_t v1 = k1 ^ 0x646F72616E646F6DULL;
+    uint64_t v2 = k0 ^ 0x6C7967656E657261ULL;
+    uint64_t v3 = k1 ^ 0x7465646279746573ULL;
+
+    auto round = [&]() {
+        v0 += v1;
+        v1 = std::rotl(v1, 13) ^ v0;
+        v0 = std::rotl(v0, 32);
+        v2 += v3;
+        v3 = std::rotl(v3, 16) ^ v2;
+        v0 += v3;
+        v3 = std::rotl(v3, 21) ^ v0;
+        v2 += v1;
+        v1 = std::rotl(v1, 17) ^ v2;
+        v2 = std::rotl(v2, 32);
+    };
+    auto compress = [&](uint64_t block) {
+        v3 ^= block;
+        round();
+        round();
+        v0 ^= block;
+    };
+
+    compress(message);
+    compress(uint64_t{8} << 56); // Final block: just the message length
+    v2 ^= 0xFF;
+    for (int i = 0; i < 4; ++i) {
+        round();
+    }
+    return v0 ^ v1 ^ v2 ^ v3;
+}
+
+} // namespace netpulse::infra
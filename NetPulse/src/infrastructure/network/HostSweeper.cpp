@@ -0,0 +1,548 @@
+#include "infrastructure/network/HostSweeper.hpp"
+
+#include "core/types/Ipv4Range.hpp"
+#include "infrastructure/network/Awaitable.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+namespace netpulse::infra {
+
+namespace {
+
+constexpr auto ARP_TICK = std::chrono::milliseconds(10);
+constexpr auto CANCEL_POLL = std::chrono::milliseconds(50);
+
+std::chrono::microseconds since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+}
+
+} // namespace
+
+HostSweeper::HostSweeper(AsioContext& context)
+    : context_(context), sweeps_(std::make_shared<SweepTable>()) {}
+
+HostSweeper::~HostSweeper() {
+    cancel();
+
+    std::lock_guard lock(engineMutex_);
+    if (syn_) {
+        syn_->shutdown();
+    }
+    if (icmp_) {
+        icmp_->shutdown();
+    }
+}
+
+HostSweeper::SweepId HostSweeper::sweepAsync(const core::DiscoveryConfig& config,
+                                             HostCallback onHost, ProgressCallback onProgress,
+                                             CompletionCallback onComplete) {
+    auto run = std::make_shared<SweepRun>();
+    run->id = nextSweepId_.fetch_add(1);
+    run->config = config;
+    run->onHost = std::move(onHost);
+    run->onProgress = std::move(onProgress);
+    run->onComplete = std::move(onComplete);
+    run->table = sweeps_;
+
+    auto addresses = config.getAddresses();
+    run->progress.totalAddresses = addresses.size();
+    run->progressStep = std::max<uint64_t>(addresses.size() / PROGRESS_STEPS, 1);
+    run->nextProgress = run->progressStep;
+
+    // Addresses on an attached segment go to ARP when its socket opens
+    std::vector<std::pair<std::shared_ptr<ArpScanner>, std::vector<uint32_t>>> arpSweeps;
+    if (config.useArp && !addresses.empty()) {
+        for (const auto& iface : ArpScanner::interfaces()) {
+            std::vector<uint32_t> local;
+            std::vector<uint32_t> rest;
+            for (auto address : addresses) {
+                // The interface's own address never answers its ARP
+                bool viaArp = iface.contains(address) && address != iface.address;
+                (viaArp ? local : rest).push_back(address);
+            }
+            if (local.empty()) {
+                continue;
+            }
+
+            auto arp = std::make_shared<ArpScanner>(context_);
+            std::weak_ptr<SweepRun> weak = run;
+            arp->setReplyCallback([weak](uint32_t address, const std::string& mac) {
+                auto owner = weak.lock();
+                if (!owner) {
+                    return;
+                }
+                std::optional<core::DiscoveredHost> host;
+                std::optional<core::DiscoveryProgress> progress;
+                {
+                    // Claiming the request and recording the host under one lock
+                    // keeps the sweep's silent count from taking the address too
+                    std::lock_guard lock(owner->mutex);
+                    auto sent = owner->arpSent.find(address);
+                    if (sent == owner->arpSent.end()) {
+                        return; // Not asked for, already answered or counted silent
+                    }
+                    host.emplace();
+                    host->latency = since(sent->second);
+                    host->address = core::Ipv4Range::formatAddress(address);
+                    host->method = core::DiscoveryMethod::Arp;
+                    host->macAddress = mac;
+                    owner->arpSent.erase(sent);
+                    if (!countProbed(*owner, 1, host, progress)) {
+                        return;
+                    }
+                }
+                notifyProbed(*owner, host, progress);
+            });
+            if (!arp->start(iface)) {
+                continue;
+            }
+            arpSweeps.emplace_back(std::move(arp), std::move(local));
+            addresses = std::move(rest);
+        }
+    }
+    run->probeAddresses = std::move(addresses);
+
+    size_t workers = 0;
+    if (!run->probeAddresses.empty()) {
+        if (config.useIcmp) {
+            run->icmp = icmpEngine();
+        }
+        if (!config.tcpPorts.empty()) {
+            run->syn = synScanner();
+        }
+
+        auto limit = std::clamp<size_t>(static_cast<size_t>(std::max(config.maxInFlight, 1)), 1,
+                                        MAX_IN_FLIGHT);
+        if (!config.tcpPorts.empty() && !run->syn) {
+            limit = std::min(limit, std::max<size_t>(CONNECT_BUDGET / config.tcpPorts.size(), 1));
+        }
+        workers = std::min(limit, run->probeAddresses.size());
+    }
+
+    spdlog::info("Starting discovery sweep {} of {}: {} addresses, {} by ARP on {} interfaces, "
+                 "{} probes in flight ({} TCP probes)",
+                 run->id, config.targetAddress, run->progress.totalAddresses,
+                 run->progress.totalAddresses - run->probeAddresses.size(), arpSweeps.size(),
+                 workers, run->syn ? "SYN" : "connect");
+
+    run->workers = workers + arpSweeps.size();
+    if (run->workers == 0) {
+        finishSweep(*run);
+        return run->id;
+    }
+
+    {
+        std::lock_guard lock(sweeps_->mutex);
+        sweeps_->runs.emplace(run->id, run);
+    }
+
+    for (auto& [arp, local] : arpSweeps) {
+        asio::co_spawn(asio::make_strand(context_.nextContext()),
+                       arpSweep(run, std::move(arp), std::move(local)), asio::detached);
+    }
+    for (size_t i = 0; i < workers; ++i) {
+        asio::co_spawn(asio::make_strand(context_.nextContext()), sweepWorker(run),
+                       asio::detached);
+    }
+    return run->id;
+}
+
+asio::awaitable<void> HostSweeper::sweepWorker(std::shared_ptr<SweepRun> run) {
+    auto executor = co_await asio::this_coro::executor;
+
+    while (!run->cancelled) {
+        auto index = run->nextAddress.fetch_add(1);
+        if (index >= run->probeAddresses.size()) {
+            break;
+        }
+
+        auto address = run->probeAddresses[index];
+        auto start = [run, address, executor](auto done) {
+            startProbe(run, address, executor,
+                       [done](std::optional<core::DiscoveredHost> host) { done(host); });
+        };
+        auto host =
+            co_await awaitCallback<std::optional<core::DiscoveredHost>>(std::move(start));
+        if (run->cancelled) {
+            break; // Probes abandoned by the cancel are not results
+        }
+        recordProbed(*run, 1, std::move(host));
+    }
+
+    if (--run->workers == 0) {
+        finishSweep(*run);
+    }
+}
+
+asio::awaitable<void> HostSweeper::arpSweep(std::shared_ptr<SweepRun> run,
+                                            std::shared_ptr<ArpScanner> arp,
+                                            std::vector<uint32_t> addresses) {
+    auto executor = co_await asio::this_coro::executor;
+    asio::steady_timer timer(executor);
+    asio::error_code ec;
+
+    auto perTick = ARP_REQUESTS_PER_SECOND * static_cast<size_t>(ARP_TICK.count()) / 1000;
+    auto batch = std::max<size_t>(perTick, 1);
+    size_t failed = 0;
+    for (size_t next = 0; next < addresses.size() && !run->cancelled;) {
+        auto end = std::min(next + batch, addresses.size());
+        {
+            std::lock_guard lock(run->mutex);
+            auto now = std::chrono::steady_clock::now();
+            for (auto i = next; i < end; ++i) {
+                run->arpSent[addresses[i]] = now;
+            }
+        }
+        for (; next < end; ++next) {
+            if (!arp->request(addresses[next])) {
+                ++failed;
+            }
+        }
+        timer.expires_after(ARP_TICK);
+        co_await timer.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+    }
+
+    // Replies to the last requests
+    auto deadline = std::chrono::steady_clock::now() + run->config.timeout;
+    while (!run->cancelled && std::chrono::steady_clock::now() < deadline) {
+        timer.expires_after(std::min<std::chrono::steady_clock::duration>(
+            CANCEL_POLL, deadline - std::chrono::steady_clock::now()));
+        co_await timer.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+    }
+    arp->shutdown();
+
+    if (failed > 0) {
+        spdlog::debug("Discovery sweep {}: {} ARP requests could not be sent", run->id, failed);
+    }
+
+    // Whatever did not answer is not on the segment; a reply still in flight
+    // finds its request claimed and is dropped
+    if (!run->cancelled) {
+        std::optional<core::DiscoveryProgress> progress;
+        {
+            std::lock_guard lock(run->mutex);
+            uint64_t silent = 0;
+            for (auto address : addresses) {
+                silent += run->arpSent.erase(address);
+            }
+            countProbed(*run, silent, std::nullopt, progress);
+        }
+        notifyProbed(*run, std::nullopt, progress);
+    }
+
+    if (--run->workers == 0) {
+        finishSweep(*run);
+    }
+}
+
+void HostSweeper::startProbe(const std::shared_ptr<SweepRun>& run, uint32_t address,
+                             const asio::any_io_executor& executor,
+                             std::function<void(std::optional<core::DiscoveredHost>)> done) {
+    const auto& config = run->config;
+    bool icmp = run->icmp && run->icmp->isAvailable(core::AddressFamily::IPv4);
+
+    auto probe = std::make_shared<AliveProbe>();
+    probe->done = std::move(done);
+    probe->executor = executor;
+    probe->pending = (icmp ? 1 : 0) + config.tcpPorts.size();
+    if (probe->pending == 0) {
+        probe->done(std::nullopt);
+        return;
+    }
+    auto text = core::Ipv4Range::formatAddress(address);
+    auto sentAt = std::chrono::steady_clock::now();
+
+    // Registered before anything is sent, so a cancel reaches every probe
+    if (!run->syn) {
+        for (size_t i = 0; i < config.tcpPorts.size(); ++i) {
+            probe->sockets.push_back(std::make_shared<asio::ip::tcp::socket>(executor));
+        }
+        if (!probe->sockets.empty()) {
+            probe->timer = std::make_shared<asio::steady_timer>(executor);
+        }
+    }
+    {
+        std::lock_guard lock(run->mutex);
+        if (run->cancelled) {
+            probe->done(std::nullopt);
+            return;
+        }
+        run->probes.insert(probe);
+    }
+
+    if (icmp) {
+        run->icmp->sendEcho(
+            text, config.timeout,
+            [run, probe, text](const core::PingResult& result) {
+                if (!result.success) {
+                    failProbe(run, probe);
+                    return;
+                }
+                core::DiscoveredHost host;
+                host.address = text;
+                host.method = core::DiscoveryMethod::Icmp;
+                host.latency =
+                    std::chrono::duration_cast<std::chrono::microseconds>(result.latency);
+                finishProbe(run, probe, std::move(host));
+            },
+            core::AddressFamily::IPv4);
+    }
+
+    // A completed or refused handshake both prove the address is in use, but
+    // only an open port can be monitored afterwards
+    auto answered = [run, probe, text, sentAt](uint16_t port, bool open) {
+        core::DiscoveredHost host;
+        host.address = text;
+        host.method = core::DiscoveryMethod::Tcp;
+        host.latency = since(sentAt);
+        host.port = port;
+        host.portOpen = open;
+        finishProbe(run, probe, std::move(host));
+    };
+
+    if (run->syn) {
+        for (auto port : config.tcpPorts) {
+            run->syn->probe(text, port, config.timeout,
+                            [run, probe, answered](const core::PortScanResult& result) {
+                                if (result.state == core::PortState::Open ||
+                                    result.state == core::PortState::Closed) {
+                                    answered(result.port,
+                                             result.state == core::PortState::Open);
+                                } else {
+                                    failProbe(run, probe);
+                                }
+                            });
+        }
+        return;
+    }
+
+    // Connect probes: the timer closes whatever is still connecting
+    probe->timer->expires_after(config.timeout);
+    probe->timer->async_wait([probe](const asio::error_code& ec) {
+        if (ec) {
+            return;
+        }
+        for (const auto& socket : probe->sockets) {
+            asio::error_code ignored;
+            socket->close(ignored);
+        }
+    });
+    asio::ip::address_v4 target(address);
+    for (size_t i = 0; i < config.tcpPorts.size(); ++i) {
+        auto socket = probe->sockets[i];
+        auto port = config.tcpPorts[i];
+        socket->async_connect(asio::ip::tcp::endpoint(target, port),
+                              [run, probe, answered, socket, port](const asio::error_code& ec) {
+                                  asio::error_code ignored;
+                                  socket->close(ignored);
+                                  if (!ec || ec == asio::error::connection_refused) {
+                                      answered(port, !ec);
+                                  } else {
+                                      failProbe(run, probe);
+                                  }
+                              });
+    }
+}
+
+void HostSweeper::failProbe(const std::shared_ptr<SweepRun>& run,
+                            const std::shared_ptr<AliveProbe>& probe) {
+    {
+        std::lock_guard lock(probe->mutex);
+        if (probe->finished || --probe->pending > 0) {
+            return;
+        }
+    }
+    finishProbe(run, probe, std::nullopt);
+}
+
+void HostSweeper::finishProbe(const std::shared_ptr<SweepRun>& run,
+                              const std::shared_ptr<AliveProbe>& probe,
+                              std::optional<core::DiscoveredHost> host) {
+    std::function<void(std::optional<core::DiscoveredHost>)> done;
+    {
+        std::lock_guard lock(probe->mutex);
+        if (probe->finished) {
+            return;
+        }
+        probe->finished = true;
+        done = std::move(probe->done);
+    }
+    {
+        std::lock_guard lock(run->mutex);
+        run->probes.erase(probe);
+    }
+
+    // Sockets and timer belong to the worker's strand; release them there
+    if (probe->timer) {
+        asio::post(probe->executor, [probe]() {
+            probe->timer->cancel();
+            for (const auto& socket : probe->sockets) {
+                asio::error_code ignored;
+                socket->close(ignored);
+            }
+        });
+    }
+    done(std::move(host));
+}
+
+void HostSweeper::recordProbed(SweepRun& run, uint64_t count,
+                               std::optional<core::DiscoveredHost> host) {
+    std::optional<core::DiscoveryProgress> progress;
+    {
+        std::lock_guard lock(run.mutex);
+        if (!countProbed(run, count, host, progress)) {
+            return;
+        }
+    }
+    notifyProbed(run, host, progress);
+}
+
+bool HostSweeper::countProbed(SweepRun& run, uint64_t count,
+                              const std::optional<core::DiscoveredHost>& host,
+                              std::optional<core::DiscoveryProgress>& progress) {
+    if (host) {
+        auto address = core::Ipv4Range::parseAddress(host->address);
+        if (!address || !run.hosts.emplace(*address, *host).second) {
+            return false;
+        }
+        run.progress.hostsFound = run.hosts.size();
+    }
+    run.progress.probedAddresses += count;
+    if (run.progress.probedAddresses >= run.nextProgress) {
+        run.nextProgress = run.progress.probedAddresses + run.progressStep;
+        progress = run.progress;
+    }
+    return true;
+}
+
+void HostSweeper::notifyProbed(SweepRun& run, const std::optional<core::DiscoveredHost>& host,
+                               const std::optional<core::DiscoveryProgress>& progress) {
+    if (host && run.onHost) {
+        run.onHost(*host);
+    }
+    if (progress && run.onProgress) {
+        run.onProgress(*progress);
+    }
+}
+
+void HostSweeper::finishSweep(SweepRun& run) {
+    if (auto table = run.table.lock()) {
+        std::lock_guard lock(table->mutex);
+        table->runs.erase(run.id);
+    }
+
+    std::vector<core::DiscoveredHost> hosts;
+    core::DiscoveryProgress progress;
+    {
+        std::lock_guard lock(run.mutex);
+        run.progress.cancelled = run.cancelled.load();
+        progress = run.progress;
+        hosts.reserve(run.hosts.size());
+        for (const auto& [address, host] : run.hosts) {
+            hosts.push_back(host);
+        }
+    }
+    spdlog::info("Discovery sweep {} {}: {} live hosts in {} of {} addresses", run.id,
+                 progress.cancelled ? "cancelled" : "complete", hosts.size(),
+                 progress.probedAddresses, progress.totalAddresses);
+
+    if (run.onProgress) {
+        run.onProgress(progress);
+    }
+    if (run.onComplete) {
+        run.onComplete(hosts);
+    }
+}
+
+void HostSweeper::cancelRun(const std::shared_ptr<SweepRun>& run) {
+    if (run->cancelled.exchange(true)) {
+        return;
+    }
+    spdlog::info("Cancelling discovery sweep {}", run->id);
+
+    // Ending the probes resumes their workers, which then see the cancel
+    std::vector<std::shared_ptr<AliveProbe>> probes;
+    {
+        std::lock_guard lock(run->mutex);
+        probes.assign(run->probes.begin(), run->probes.end());
+    }
+    for (const auto& probe : probes) {
+        finishProbe(run, probe, std::nullopt);
+    }
+}
+
+void HostSweeper::cancel() {
+    std::vector<std::shared_ptr<SweepRun>> runs;
+    {
+        std::lock_guard lock(sweeps_->mutex);
+        for (const auto& [id, run] : sweeps_->runs) {
+            runs.push_back(run);
+        }
+    }
+    for (const auto& run : runs) {
+        cancelRun(run);
+    }
+}
+
+void HostSweeper::cancel(SweepId sweepId) {
+    std::shared_ptr<SweepRun> run;
+    {
+        std::lock_guard lock(sweeps_->mutex);
+        auto it = sweeps_->runs.find(sweepId);
+        if (it == sweeps_->runs.end()) {
+            return;
+        }
+        run = it->second;
+    }
+    cancelRun(run);
+}
+
+bool HostSweeper::isSweeping() const {
+    return activeSweeps() > 0;
+}
+
+size_t HostSweeper::activeSweeps() const {
+    std::lock_guard lock(sweeps_->mutex);
+    return sweeps_->runs.size();
+}
+
+void HostSweeper::setSynRateLimit(size_t packetsPerSecond) {
+    std::lock_guard lock(engineMutex_);
+    synRateLimit_ = packetsPerSecond;
+    if (syn_) {
+        syn_->setRateLimit(packetsPerSecond);
+    }
+}
+
+std::shared_ptr<IcmpEngine> HostSweeper::icmpEngine() {
+    std::lock_guard lock(engineMutex_);
+    if (!icmp_) {
+        // Its own engine, so a sweep's thousands of echoes never crowd the
+        // sequence space of the monitoring probes
+        icmp_ = std::make_shared<IcmpEngine>(context_);
+        icmp_->start();
+    }
+    return icmp_->isAvailable() ? icmp_ : nullptr;
+}
+
+std::shared_ptr<SynScanner> HostSweeper::synScanner() {
+    std::lock_guard lock(engineMutex_);
+    if (syn_ || synUnavailable_) {
+        return syn_;
+    }
+
+    auto syn = std::make_shared<SynScanner>(context_);
+    syn->setRateLimit(synRateLimit_);
+    if (!syn->start()) {
+        spdlog::info("Discovery sweeps use TCP connects (raw sockets need CAP_NET_RAW)");
+        synUnavailable_ = true;
+        return nullptr;
+    }
+    syn_ = syn;
+    return syn_;
+}
+
+} // namespace netpulse::infra
@@ -0,0 +1,227 @@
+#pragma once
+
+#include "core/types/DiscoveryResult.hpp"
+#include "infrastructure/network/ArpScanner.hpp"
+#include "infrastructure/network/AsioContext.hpp"
+#include "infrastructure/network/IcmpEngine.hpp"
+#include "infrastructure/network/SynScanner.hpp"
+
+#include <asio.hpp>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace netpulse::infra {
+
+/**
+ * @brief Finds live hosts in IPv4 ranges (ping/ARP sweep).
+ *
+ * A sweep covers every address of core::DiscoveryConfig::getAddresses().
+ * Addresses on a directly attached Ethernet segment are resolved with ARP
+ * (see ArpScanner): requests are paced per interface and an address that
+ * does not answer is settled as down, since every IPv4 host on the segment
+ * must answer ARP. All other addresses, and every address when ARP is not
+ * permitted, are probed by worker coroutines.
+ *
+ * Each probe sends an ICMP echo and TCP probes to every configured port at
+ * once and ends at the first answer: an echo reply, or a TCP handshake that
+ * completes or is refused (either way something is there). TCP probes are
+ * SYNs through a shared SynScanner when raw sockets are permitted, and
+ * connects otherwise; connect probes use a socket each, so far fewer
+ * addresses are probed at once in that mode (CONNECT_BUDGET).
+ *
+ * No thread waits on a probe, the number of probes in flight is bounded,
+ * and progress is reported in steps rather than per address, so a /16 is
+ * swept in minutes without flooding the event loop or the UI.
+ */
+class HostSweeper {
+public:
+    /// Identifies one running sweep; never 0.
+    using SweepId = uint64_t;
+
+    /**
+     * @brief Callback invoked for each live host, as soon as it answers.
+     * @param host The host and how it answered.
+     */
+    using HostCallback = std::function<void(const core::DiscoveredHost&)>;
+
+    /**
+     * @brief Callback invoked as the sweep progresses.
+     * @param progress Addresses probed and hosts found so far.
+     */
+    using ProgressCallback = std::function<void(const core::DiscoveryProgress&)>;
+
+    /**
+     * @brief Callback invoked once when the sweep completes or is cancelled.
+     * @param hosts Every live host found, in address order.
+     */
+    using CompletionCallback = std::function<void(const std::vector<core::DiscoveredHost>&)>;
+
+    /// Upper bound on addresses one sweep probes at once
+    static constexpr size_t MAX_IN_FLIGHT = 4096;
+
+    /// Sockets one sweep may have open for connect probes
+    static constexpr size_t CONNECT_BUDGET = 512;
+
+    /// ARP requests sent per second on each interface
+    static constexpr size_t ARP_REQUESTS_PER_SECOND = 2000;
+
+    /// Progress reports per sweep, at most (plus a final one)
+    static constexpr uint64_t PROGRESS_STEPS = 200;
+
+    /**
+     * @brief Constructs a HostSweeper with the given Asio context.
+     * @param context Reference to the AsioContext for async operations.
+     */
+    explicit HostSweeper(AsioContext& context);
+
+    /**
+     * @brief Destructor. Cancels all active sweeps.
+     */
+    ~HostSweeper();
+
+    HostSweeper(const HostSweeper&) = delete;
+    HostSweeper& operator=(const HostSweeper&) = delete;
+
+    /**
+     * @brief Starts an asynchronous discovery sweep.
+     * @param config Ranges to sweep and probes to use.
+     * @param onHost Callback invoked for each live host.
+     * @param onProgress Callback invoked to report sweep progress.
+     * @param onComplete Callback invoked when the sweep completes or is cancelled.
+     * @return Identifier for cancel(SweepId).
+     */
+    SweepId sweepAsync(const core::DiscoveryConfig& config, HostCallback onHost,
+                       ProgressCallback onProgress, CompletionCallback onComplete);
+
+    /**
+     * @brief Cancels every running sweep.
+     *
+     * Probes in flight are abandoned; each sweep's completion callback then
+     * receives the hosts found so far.
+     */
+    void cancel();
+
+    /**
+     * @brief Cancels one sweep, as cancel() does for all of them.
+     * @param sweepId Identifier returned by sweepAsync().
+     */
+    void cancel(SweepId sweepId);
+
+    /**
+     * @brief Checks if any sweep is currently in progress.
+     * @return True if sweeping, false otherwise.
+     */
+    bool isSweeping() const;
+
+    /**
+     * @brief Returns the number of sweeps in progress.
+     * @return Active sweep count.
+     */
+    size_t activeSweeps() const;
+
+    /**
+     * @brief Limits SYN probes sent per second by TCP probes.
+     * @param packetsPerSecond Send rate; 0 sends without pacing.
+     */
+    void setSynRateLimit(size_t packetsPerSecond);
+
+private:
+    struct SweepTable;
+
+    // One address's probes; the first answer, or the last failure, ends it
+    struct AliveProbe {
+        std::mutex mutex;
+        bool finished{false};
+        size_t pending{0};
+        std::function<void(std::optional<core::DiscoveredHost>)> done;
+        std::vector<std::shared_ptr<asio::ip::tcp::socket>> sockets;
+        std::shared_ptr<asio::steady_timer> timer; // Closes the sockets at the timeout
+        asio::any_io_executor executor;            // Owns the sockets and the timer
+    };
+
+    // State shared by the workers and ARP coroutines of one sweep
+    struct SweepRun {
+        SweepId id{0};
+        core::DiscoveryConfig config;
+        std::vector<uint32_t> probeAddresses; // Addresses left for ICMP/TCP probes
+        HostCallback onHost;
+        ProgressCallback onProgress;
+        CompletionCallback onComplete;
+        std::weak_ptr<SweepTable> table;
+        std::shared_ptr<IcmpEngine> icmp; // Null without ICMP
+        std::shared_ptr<SynScanner> syn;  // Null for connect probes
+        std::atomic<size_t> nextAddress{0};
+        std::atomic<size_t> workers{0}; // Probe workers and ARP sweeps still running
+        std::atomic<bool> cancelled{false};
+
+        std::mutex mutex; // Guards everything below
+        std::map<uint32_t, core::DiscoveredHost> hosts;
+        // ARP requests not yet answered or counted silent; each address leaves once
+        std::unordered_map<uint32_t, std::chrono::steady_clock::time_point> arpSent;
+        std::unordered_set<std::shared_ptr<AliveProbe>> probes;
+        core::DiscoveryProgress progress;
+        uint64_t progressStep{1};
+        uint64_t nextProgress{0};
+    };
+
+    // Sweeps in progress; outlives the sweeper while workers finish
+    struct SweepTable {
+        mutable std::mutex mutex;
+        std::unordered_map<SweepId, std::shared_ptr<SweepRun>> runs;
+    };
+
+    // Probe addresses until none are left or the sweep is cancelled
+    static asio::awaitable<void> sweepWorker(std::shared_ptr<SweepRun> run);
+
+    // Pace ARP requests for one interface's addresses, then wait for late replies
+    static asio::awaitable<void> arpSweep(std::shared_ptr<SweepRun> run,
+                                          std::shared_ptr<ArpScanner> arp,
+                                          std::vector<uint32_t> addresses);
+
+    static void startProbe(const std::shared_ptr<SweepRun>& run, uint32_t address,
+                           const asio::any_io_executor& executor,
+                           std::function<void(std::optional<core::DiscoveredHost>)> done);
+    static void failProbe(const std::shared_ptr<SweepRun>& run,
+                          const std::shared_ptr<AliveProbe>& probe);
+    static void finishProbe(const std::shared_ptr<SweepRun>& run,
+                            const std::shared_ptr<AliveProbe>& probe,
+                            std::optional<core::DiscoveredHost> host);
+
+    // Count addresses as probed, recording a live host if there is one
+    static void recordProbed(SweepRun& run, uint64_t count,
+                             std::optional<core::DiscoveredHost> host);
+    // recordProbed() in two steps, for callers that hold SweepRun::mutex for
+    // more: the first requires the lock and is false for a host already
+    // recorded; the second runs the handlers and must be called without it
+    static bool countProbed(SweepRun& run, uint64_t count,
+                            const std::optional<core::DiscoveredHost>& host,
+                            std::optional<core::DiscoveryProgress>& progress);
+    static void notifyProbed(SweepRun& run, const std::optional<core::DiscoveredHost>& host,
+                             const std::optional<core::DiscoveryProgress>& progress);
+    static void finishSweep(SweepRun& run);
+    static void cancelRun(const std::shared_ptr<SweepRun>& run);
+
+    // Start the engines on first use; null if unavailable
+    std::shared_ptr<IcmpEngine> icmpEngine();
+    std::shared_ptr<SynScanner> synScanner();
+
+    AsioContext& context_;
+    std::shared_ptr<SweepTable> sweeps_;
+    std::atomic<SweepId> nextSweepId_{1};
+
+    mutable std::mutex engineMutex_;
+    std::shared_ptr<IcmpEngine> icmp_;
+    std::shared_ptr<SynScanner> syn_;
+    bool synUnavailable_{false};
+    size_t synRateLimit_{SynScanner::DEFAULT_RATE_LIMIT};
+};
+
+} // namespace netpulse::infra
@@ -0,0 +1,1101 @@
+#include "infrastructure/network/IcmpEngine.hpp"
+
+#include "infrastructure/network/DnsCache.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <cerrno>
+#include <cstring>
+#include <optional>
+#include <random>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+#endif
+
+namespace netpulse::infra {
+
+namespace {
+
+constexpr uint8_t ICMP_ECHO_REQUEST_TYPE = 8;
+constexpr uint8_t ICMP_ECHO_REPLY_TYPE = 0;
+constexpr uint8_t ICMPV6_ECHO_REQUEST_TYPE = 128;
+constexpr uint8_t ICMPV6_ECHO_REPLY_TYPE = 129;
+constexpr size_t ICMP_HEADER_SIZE = 8;
+constexpr size_t IPV4_MIN_HEADER_SIZE = 20;
+constexpr size_t ECHO_PACKET_SIZE = 64;
+constexpr size_t RECV_BATCH_SIZE = 32;
+constexpr size_t RECV_BUFFER_SIZE = 1024;
+constexpr size_t MAX_TX_KEYS = 4096; // Sent requests still awaiting a transmit stamp
+
+void writeEchoRequest(uint8_t* packet, uint16_t identifier, uint16_t sequence,
+                      core::AddressFamily family) {
+    const bool v6 = family == core::AddressFamily::IPv6;
+    std::memset(packet, 0, ECHO_PACKET_SIZE);
+
+    // ICMP header
+    packet[0] = v6 ? ICMPV6_ECHO_REQUEST_TYPE : ICMP_ECHO_REQUEST_TYPE; // Type
+    packet[1] = 0;                        // Code
+    packet[2] = 0;                        // Checksum (high byte)
+    packet[3] = 0;                        // Checksum (low byte)
+    packet[4] = static_cast<uint8_t>(identifier >> 8);
+    packet[5] = static_cast<uint8_t>(identifier & 0xFF);
+    packet[6] = static_cast<uint8_t>(sequence >> 8);
+    packet[7] = static_cast<uint8_t>(sequence & 0xFF);
+
+    // Timestamp as payload
+    auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+    std::memcpy(&packet[8], &now, sizeof(now));
+
+    // The ICMPv6 checksum covers the IPv6 pseudo-header; the kernel fills it in
+    if (v6) {
+        return;
+    }
+
+    // Calculate and set checksum
+    uint16_t checksum = IcmpEngine::calculateChecksum(packet, ECHO_PACKET_SIZE);
+    packet[2] = static_cast<uint8_t>(checksum >> 8);
+    packet[3] = static_cast<uint8_t>(checksum & 0xFF);
+}
+
+core::PingResult errorResult(const std::string& message,
+                             core::AddressFamily family = core::AddressFamily::Any) {
+    core::PingResult result;
+    result.timestamp = std::chrono::system_clock::now();
+    result.success = false;
+    result.errorMessage = message;
+    result.family = family;
+    return result;
+}
+
+core::AddressFamily familyOf(const asio::ip::address& address) {
+    return address.is_v6() ? core::AddressFamily::IPv6 : core::AddressFamily::IPv4;
+}
+
+const char* familyName(core::AddressFamily family) {
+    return family == core::AddressFamily::IPv6 ? "ICMPv6" : "ICMPv4";
+}
+
+// Resolvers may hand back IPv4 addresses in v4-mapped IPv6 form
+asio::ip::address unmapped(const asio::ip::address& address) {
+    if (address.is_v6() && address.to_v6().is_v4_mapped()) {
+        return asio::ip::make_address_v4(asio::ip::v4_mapped, address.to_v6());
+    }
+    return address;
+}
+
+// Replies carry the kernel's view of the scope id, so compare IPv6 by bytes
+bool sameAddress(const asio::ip::address& a, const asio::ip::address& b) {
+    if (a.is_v6() && b.is_v6()) {
+        return a.to_v6().to_bytes() == b.to_v6().to_bytes();
+    }
+    return a == b;
+}
+
+#if defined(__linux__) || defined(__APPLE__)
+socklen_t toSockaddr(const asio::ip::address& address, sockaddr_storage& storage) {
+    storage = {};
+    if (address.is_v6()) {
+        auto* sin6 = reinterpret_cast<sockaddr_in6*>(&storage);
+        auto bytes = address.to_v6().to_bytes();
+        sin6->sin6_family = AF_INET6;
+        std::memcpy(&sin6->sin6_addr, bytes.data(), bytes.size());
+        sin6->sin6_scope_id = static_cast<uint32_t>(address.to_v6().scope_id());
+        return sizeof(sockaddr_in6);
+    }
+    auto* sin = reinterpret_cast<sockaddr_in*>(&storage);
+    sin->sin_family = AF_INET;
+    sin->sin_addr.s_addr = htonl(address.to_v4().to_uint());
+    return sizeof(sockaddr_in);
+}
+
+std::chrono::system_clock::time_point fromTimespec(const struct timespec& stamp) {
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::seconds(stamp.tv_sec) + std::chrono::nanoseconds(stamp.tv_nsec)));
+}
+
+asio::ip::address fromSockaddr(const sockaddr_storage& storage) {
+    if (storage.ss_family == AF_INET6) {
+        const auto* sin6 = reinterpret_cast<const sockaddr_in6*>(&storage);
+        asio::ip::address_v6::bytes_type bytes;
+        std::memcpy(bytes.data(), &sin6->sin6_addr, bytes.size());
+        return asio::ip::address_v6(bytes, sin6->sin6_scope_id);
+    }
+    const auto* sin = reinterpret_cast<const sockaddr_in*>(&storage);
+    return asio::ip::address_v4(ntohl(sin->sin_addr.s_addr));
+}
+#endif
+
+#if defined(__linux__) && defined(SO_TIMESTAMPING)
+// Software transmit stamps, reported on the error queue without the packet
+// and keyed by a per-socket datagram counter that enabling resets to zero
+bool setTxTimestamping(int fd, bool enabled) {
+    int flags = enabled ? SOF_TIMESTAMPING_TX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE |
+                              SOF_TIMESTAMPING_OPT_ID | SOF_TIMESTAMPING_OPT_TSONLY
+                        : 0;
+    return setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) == 0;
+}
+#endif
+
+} // namespace
+
+IcmpEngine::IcmpEngine(AsioContext& context)
+    : context_(context), v4_(context.getContext(), core::AddressFamily::IPv4),
+      v6_(context.getContext(), core::AddressFamily::IPv6), wheelTimer_(context.getContext()) {
+    std::random_device rd;
+    identifier_ = static_cast<uint16_t>(rd() & 0xFFFF);
+    nextSequence_ = static_cast<uint16_t>(rd() & 0xFFFF);
+}
+
+IcmpEngine::~IcmpEngine() {
+    shutdown();
+}
+
+void IcmpEngine::start() {
+    if (started_.exchange(true)) {
+        return;
+    }
+
+#if defined(__linux__) || defined(__APPLE__)
+    openChannel(v4_);
+    openChannel(v6_);
+    spdlog::info("IcmpEngine started (ICMPv4: {}, ICMPv6: {}, identifier {})",
+                 v4_.open ? (v4_.raw ? "raw" : "datagram") : "unavailable",
+                 v6_.open ? (v6_.raw ? "raw" : "datagram") : "unavailable", identifier_);
+    startReceive(v4_);
+    startReceive(v6_);
+#else
+    spdlog::warn("IcmpEngine: ICMP ping not implemented for this platform");
+#endif
+}
+
+void IcmpEngine::openChannel(Channel& channel) {
+#if defined(__linux__) || defined(__APPLE__)
+    const bool v6 = channel.family == core::AddressFamily::IPv6;
+    const int domain = v6 ? AF_INET6 : AF_INET;
+    const int protocol = v6 ? int{IPPROTO_ICMPV6} : int{IPPROTO_ICMP};
+
+    channel.raw = false;
+    int fd = ::socket(domain, SOCK_DGRAM, protocol);
+    if (fd < 0) {
+        // Try raw socket (requires privileges)
+        channel.raw = true;
+        fd = ::socket(domain, SOCK_RAW, protocol);
+    }
+    if (fd < 0) {
+        spdlog::warn("IcmpEngine: failed to create {} socket: {}", familyName(channel.family),
+                     std::strerror(errno));
+        return;
+    }
+
+    // Datagram sockets strip the IP header, so ask for the TTL / hop limit as
+    // ancillary data (IPv6 never delivers the header, even on raw sockets)
+    int enable = 1;
+    if (v6) {
+#ifdef IPV6_RECVHOPLIMIT
+        setsockopt(fd, IPPROTO_IPV6, IPV6_RECVHOPLIMIT, &enable, sizeof(enable));
+#endif
+    } else {
+#ifdef IP_RECVTTL
+        setsockopt(fd, IPPROTO_IP, IP_RECVTTL, &enable, sizeof(enable));
+#endif
+    }
+#ifdef SO_TIMESTAMPNS
+    // Kernel receive timestamps; RTTs fall back to userspace timing without them
+    if (setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable)) < 0) {
+        spdlog::debug("IcmpEngine: kernel timestamps unavailable on {} socket: {}",
+                      familyName(channel.family), std::strerror(errno));
+    }
+#endif
+#if defined(__linux__) && defined(SO_TIMESTAMPING)
+    // Kernel transmit timestamps; RTTs start at the userspace send time without them
+    channel.txTimestamps = setTxTimestamping(fd, true);
+    channel.nextTxKey = 0;
+    channel.txKeys.clear();
+    if (!channel.txTimestamps) {
+        spdlog::debug("IcmpEngine: transmit timestamps unavailable on {} socket: {}",
+                      familyName(channel.family), std::strerror(errno));
+    }
+#endif
+
+    // The socket type only matters to the kernel; Asio merely waits for readiness
+    asio::error_code ec;
+    channel.socket.assign(asio::generic::raw_protocol(domain, protocol), fd, ec);
+    if (!ec) {
+        channel.socket.non_blocking(true, ec);
+    }
+    if (ec) {
+        spdlog::warn("IcmpEngine: failed to register {} socket: {}", familyName(channel.family),
+                     ec.message());
+        ::close(fd);
+        return;
+    }
+
+    std::lock_guard lock(mutex_);
+    channel.open = true;
+#else
+    (void)channel;
+#endif
+}
+
+void IcmpEngine::shutdown() {
+    std::vector<Completion> completions;
+    {
+        std::lock_guard lock(mutex_);
+        for (auto* channel : {&v4_, &v6_}) {
+            if (channel->open.exchange(false)) {
+                asio::error_code ec;
+                channel->socket.close(ec);
+            }
+            channel->backlog.clear();
+        }
+        wheelTimer_.cancel();
+        wheelArmed_ = false;
+
+        for (auto& [sequence, request] : pending_) {
+            core::PingResult result;
+            result.timestamp = request.timestamp;
+            result.success = false;
+            result.errorMessage = "Ping engine shut down";
+            result.family = familyOf(request.destination);
+            completions.push_back(takeCompletion(request, std::move(result)));
+        }
+        pending_.clear();
+        for (auto& slot : wheel_) {
+            slot.clear();
+        }
+    }
+    invokeAll(completions);
+}
+
+size_t IcmpEngine::outstandingCount() const {
+    std::lock_guard lock(mutex_);
+    return pending_.size();
+}
+
+uint16_t IcmpEngine::calculateChecksum(const uint8_t* data, size_t length) {
+    uint32_t sum = 0;
+
+    while (length > 1) {
+        sum += static_cast<uint32_t>((static_cast<uint16_t>(data[0]) << 8) | data[1]);
+        data += 2;
+        length -= 2;
+    }
+
+    if (length == 1) {
+        sum += static_cast<uint32_t>(static_cast<uint16_t>(data[0]) << 8);
+    }
+
+    while (sum >> 16) {
+        sum = (sum & 0xFFFF) + (sum >> 16);
+    }
+
+    return static_cast<uint16_t>(~sum);
+}
+
+std::vector<uint8_t> IcmpEngine::buildEchoRequest(uint16_t identifier, uint16_t sequence,
+                                                  core::AddressFamily family) {
+    std::vector<uint8_t> packet(ECHO_PACKET_SIZE, 0);
+    writeEchoRequest(packet.data(), identifier, sequence, family);
+    return packet;
+}
+
+void IcmpEngine::sendEcho(const std::string& address, std::chrono::milliseconds timeout,
+                          EchoCallback callback, core::AddressFamily family) {
+    std::vector<Outgoing> outgoing(1);
+    outgoing[0].address = address;
+    outgoing[0].family = family;
+    outgoing[0].callback = std::move(callback);
+    sendBatch(outgoing, timeout);
+}
+
+void IcmpEngine::sendEchoBatch(std::vector<EchoRequest> requests,
+                               std::chrono::milliseconds timeout) {
+    std::vector<Outgoing> outgoing(requests.size());
+    for (size_t i = 0; i < requests.size(); ++i) {
+        outgoing[i].address = std::move(requests[i].address);
+        outgoing[i].family = requests[i].family;
+        outgoing[i].timeout = requests[i].timeout;
+        outgoing[i].callback = std::move(requests[i].callback);
+    }
+    sendBatch(outgoing, timeout);
+}
+
+void IcmpEngine::sendEchoBatch(std::span<const std::string> addresses,
+                               std::chrono::milliseconds timeout, BatchCallback callback) {
+    auto batch = std::make_shared<BatchState>();
+    batch->results.resize(addresses.size());
+    batch->remaining = addresses.size();
+    batch->callback = std::move(callback);
+
+    if (addresses.empty()) {
+        context_.post([batch]() {
+            if (batch->callback) {
+                batch->callback(batch->results);
+            }
+        });
+        return;
+    }
+
+    std::vector<Outgoing> outgoing(addresses.size());
+    for (size_t i = 0; i < addresses.size(); ++i) {
+        outgoing[i].address = addresses[i];
+        outgoing[i].batch = batch;
+        outgoing[i].batchIndex = i;
+    }
+    sendBatch(outgoing, timeout);
+}
+
+void IcmpEngine::sendBatch(std::vector<Outgoing>& outgoing, std::chrono::milliseconds timeout) {
+    if (outgoing.empty()) {
+        return;
+    }
+    for (auto& request : outgoing) {
+        if (request.timeout.count() <= 0) {
+            request.timeout = timeout;
+        }
+    }
+
+#if defined(__linux__) || defined(__APPLE__)
+    if (!isAvailable()) {
+        std::vector<Completion> failures;
+        for (auto& request : outgoing) {
+            failures.push_back(Completion{std::move(request.callback), std::move(request.batch),
+                                          request.batchIndex,
+                                          errorResult("Failed to create ICMP socket")});
+        }
+        postAll(std::move(failures));
+        return;
+    }
+
+    // Resolve through the shared cache. Literals and cached names answer
+    // inline and are transmitted together before this call returns; a name
+    // that has to wait for the resolver is transmitted once its own lookup
+    // completes, so a slow lookup never holds back the rest of the batch.
+    auto self = shared_from_this();
+    auto collected = std::make_shared<InlineBatch>();
+    for (auto& request : outgoing) {
+        auto shared = std::make_shared<Outgoing>(std::move(request));
+        context_.dnsCache().resolveAsync(
+            shared->address, [self, collected, shared](const asio::error_code& ec,
+                                                       const DnsCache::Addresses& addresses) {
+                auto destination = self->selectDestination(*shared, ec, addresses);
+                {
+                    std::lock_guard lock(collected->mutex);
+                    if (collected->collecting) {
+                        collected->resolved.outgoing.push_back(std::move(*shared));
+                        collected->resolved.destinations.push_back(std::move(destination));
+                        return;
+                    }
+                }
+                ResolvedBatch single;
+                single.outgoing.push_back(std::move(*shared));
+                single.destinations.push_back(std::move(destination));
+                self->transmitBatch(single);
+            });
+    }
+
+    ResolvedBatch ready;
+    {
+        std::lock_guard lock(collected->mutex);
+        collected->collecting = false;
+        ready = std::move(collected->resolved);
+    }
+    if (!ready.outgoing.empty()) {
+        transmitBatch(ready);
+    }
+#else
+    std::vector<Completion> failures;
+    for (auto& request : outgoing) {
+        failures.push_back(Completion{std::move(request.callback), std::move(request.batch),
+                                      request.batchIndex,
+                                      errorResult("ICMP ping not implemented for this platform")});
+    }
+    (void)timeout;
+    postAll(std::move(failures));
+#endif
+}
+
+IcmpEngine::Destination IcmpEngine::selectDestination(const Outgoing& request,
+                                                      const asio::error_code& ec,
+                                                      const DnsCache::Addresses& addresses) const {
+    Destination destination;
+    if (ec || addresses.empty()) {
+        destination.error = "Failed to resolve address: " + request.address;
+        return destination;
+    }
+
+    // The preference only applies to names; a literal is its own family
+    asio::error_code parseError;
+    asio::ip::make_address(request.address, parseError);
+    auto preference = parseError ? request.family : core::AddressFamily::Any;
+
+    std::optional<asio::ip::address> fallback;
+    for (const auto& candidate : addresses) {
+        auto address = unmapped(candidate);
+        auto family = familyOf(address);
+        if (preference != core::AddressFamily::Any && family != preference) {
+            continue;
+        }
+        // With no preference, skip past families we cannot send on
+        if (isAvailable(family)) {
+            destination.address = address;
+            return destination;
+        }
+        if (!fallback) {
+            fallback = address;
+        }
+    }
+
+    if (fallback) {
+        destination.address = fallback; // Fails at send time with a socket error
+    } else {
+        destination.error = std::string("No ") +
+                            (preference == core::AddressFamily::IPv6 ? "IPv6" : "IPv4") +
+                            " address for " + request.address;
+    }
+    return destination;
+}
+
+void IcmpEngine::transmitBatch(ResolvedBatch& resolved) {
+    auto& outgoing = resolved.outgoing;
+
+    std::vector<Completion> failures;
+    auto fail = [&failures](Outgoing& request, const std::string& message) {
+        spdlog::debug("Ping to {} failed: {}", request.address, message);
+        failures.push_back(Completion{std::move(request.callback), std::move(request.batch),
+                                      request.batchIndex, errorResult(message)});
+    };
+
+#if defined(__linux__) || defined(__APPLE__)
+    std::unique_lock lock(mutex_);
+    if (!isAvailable()) {
+        lock.unlock();
+        for (auto& request : outgoing) {
+            fail(request, "Ping engine shut down");
+        }
+        postAll(std::move(failures));
+        return;
+    }
+
+    // Register the requests up front; replies cannot be processed before we
+    // release the lock.
+    std::array<std::vector<uint16_t>, 2> byChannel; // Sequences for v4_, v6_
+    auto timestamp = std::chrono::system_clock::now();
+    auto sendTime = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < outgoing.size(); ++i) {
+        auto& request = outgoing[i];
+        const auto& destination = resolved.destinations[i];
+        if (!destination.address) {
+            fail(request, destination.error);
+            continue;
+        }
+
+        auto family = familyOf(*destination.address);
+        if (!channelFor(family).open) {
+            fail(request, std::string("Failed to create ") + familyName(family) + " socket");
+            continue;
+        }
+
+        // Skip sequence numbers that still have a request in flight
+        uint16_t sequence = nextSequence_++;
+        for (size_t attempts = 0; pending_.contains(sequence) && attempts < 0xFFFF; ++attempts) {
+            sequence = nextSequence_++;
+        }
+        if (pending_.contains(sequence)) {
+            fail(request, "Too many outstanding ICMP requests");
+            continue;
+        }
+
+        PendingRequest pendingRequest;
+        pendingRequest.address = std::move(request.address);
+        pendingRequest.destination = *destination.address;
+        pendingRequest.timestamp = timestamp;
+        pendingRequest.sendTime = sendTime;
+        pendingRequest.deadline = sendTime + request.timeout;
+        pendingRequest.callback = std::move(request.callback);
+        pendingRequest.batch = std::move(request.batch);
+        pendingRequest.batchIndex = request.batchIndex;
+        pending_.emplace(sequence, std::move(pendingRequest));
+
+        byChannel[family == core::AddressFamily::IPv6 ? 1 : 0].push_back(sequence);
+    }
+
+    // Queue behind anything still waiting for send buffer space, so requests
+    // leave in order, then send as much as each socket takes
+    for (size_t c = 0; c < byChannel.size(); ++c) {
+        if (byChannel[c].empty()) {
+            continue;
+        }
+        auto& channel = c == 0 ? v4_ : v6_;
+        channel.backlog.insert(channel.backlog.end(), byChannel[c].begin(), byChannel[c].end());
+        flushBacklog(channel, failures);
+    }
+    lock.unlock();
+#else
+    (void)outgoing;
+    (void)fail;
+#endif
+
+    // Never invoke callbacks re-entrantly from the send path
+    postAll(std::move(failures));
+}
+
+void IcmpEngine::flushBacklog(Channel& channel, std::vector<Completion>& failures) {
+#if defined(__linux__) || defined(__APPLE__)
+    // The pending write wait resumes the backlog once the socket drains
+    if (channel.awaitingWrite) {
+        return;
+    }
+
+    // Requests completed since they were queued (shutdown) are skipped
+    std::vector<uint16_t> sequences;
+    sequences.reserve(channel.backlog.size());
+    for (auto sequence : channel.backlog) {
+        if (pending_.contains(sequence)) {
+            sequences.push_back(sequence);
+        }
+    }
+    channel.backlog.clear();
+    if (sequences.empty()) {
+        return;
+    }
+
+    // Build every packet into one contiguous buffer
+    const size_t count = sequences.size();
+    std::vector<uint8_t> packets(count * ECHO_PACKET_SIZE);
+    std::vector<sockaddr_storage> targets(count);
+    std::vector<socklen_t> targetLengths(count);
+    for (size_t i = 0; i < count; ++i) {
+        writeEchoRequest(&packets[i * ECHO_PACKET_SIZE], identifier_, sequences[i],
+                         channel.family);
+        targetLengths[i] = toSockaddr(pending_.at(sequences[i]).destination, targets[i]);
+    }
+
+    auto failSent = [this, &failures](uint16_t sequence, const std::string& message) {
+        auto it = pending_.find(sequence);
+        spdlog::debug("Ping to {} failed: {}", it->second.address, message);
+        failures.push_back(
+            takeCompletion(it->second, errorResult(message, familyOf(it->second.destination))));
+        pending_.erase(it);
+    };
+
+    // Stamp the requests as late as possible so building the batch, or
+    // waiting for buffer space, does not count towards the round-trip time
+    auto wallSend = std::chrono::system_clock::now();
+    auto steadySend = std::chrono::steady_clock::now();
+    for (auto sequence : sequences) {
+        auto& pendingRequest = pending_.at(sequence);
+        pendingRequest.deadline += steadySend - pendingRequest.sendTime;
+        pendingRequest.timestamp = wallSend;
+        pendingRequest.sendTime = steadySend;
+    }
+
+    const int fd = channel.socket.native_handle();
+    std::vector<bool> sent(count, false);
+    size_t offset = 0;
+    bool blocked = false;
+    bool sendFailed = false; // Transmit stamp keys may have been skipped
+
+#if defined(__linux__)
+    // One syscall for the whole backlog; a short count means the kernel
+    // stopped at a failing entry, which is skipped before resuming.
+    std::vector<struct iovec> iovs(count);
+    std::vector<struct mmsghdr> messages(count);
+    for (size_t i = 0; i < count; ++i) {
+        iovs[i].iov_base = &packets[i * ECHO_PACKET_SIZE];
+        iovs[i].iov_len = ECHO_PACKET_SIZE;
+        messages[i] = {};
+        messages[i].msg_hdr.msg_name = &targets[i];
+        messages[i].msg_hdr.msg_namelen = targetLengths[i];
+        messages[i].msg_hdr.msg_iov = &iovs[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    while (offset < count) {
+        int result = ::sendmmsg(fd, &messages[offset], static_cast<unsigned int>(count - offset),
+                                MSG_DONTWAIT);
+        if (result > 0) {
+            for (size_t m = 0; m < static_cast<size_t>(result); ++m) {
+                sent[offset + m] = true;
+            }
+            offset += static_cast<size_t>(result);
+        } else if (result < 0 && errno == EINTR) {
+            continue;
+        } else if (result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS)) {
+            blocked = true;
+            sendFailed = true;
+            break;
+        } else {
+            sendFailed = true;
+            failSent(sequences[offset],
+                     std::string("Failed to send ICMP packet: ") + std::strerror(errno));
+            ++offset;
+        }
+    }
+#else
+    for (; offset < count; ++offset) {
+        ssize_t result = ::sendto(fd, &packets[offset * ECHO_PACKET_SIZE], ECHO_PACKET_SIZE,
+                                  MSG_DONTWAIT,
+                                  reinterpret_cast<const struct sockaddr*>(&targets[offset]),
+                                  targetLengths[offset]);
+        if (result >= 0) {
+            sent[offset] = true;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS) {
+            blocked = true;
+            sendFailed = true;
+            break;
+        } else {
+            sendFailed = true;
+            failSent(sequences[offset],
+                     std::string("Failed to send ICMP packet: ") + std::strerror(errno));
+        }
+    }
+#endif
+
+    if (!wheelArmed_) {
+        wheelTime_ = steadySend;
+    }
+    for (size_t i = 0; i < offset; ++i) {
+        if (sent[i]) {
+            insertIntoWheel(sequences[i], pending_.at(sequences[i]).deadline);
+            if (channel.txTimestamps && !sendFailed) {
+                channel.txKeys.emplace_back(channel.nextTxKey++, sequences[i]);
+            }
+        }
+    }
+    if (channel.txTimestamps && sendFailed) {
+        resetTxKeys(channel);
+    }
+    while (channel.txKeys.size() > MAX_TX_KEYS) {
+        channel.txKeys.pop_front();
+    }
+    armWheelTimer();
+
+    if (blocked) {
+        // Send buffer full: keep the rest queued, in order, and resume once
+        // the socket is writable again instead of failing them
+        channel.backlog.assign(sequences.begin() + static_cast<std::ptrdiff_t>(offset),
+                               sequences.end());
+        awaitWritable(channel);
+    }
+#else
+    (void)channel;
+    (void)failures;
+#endif
+}
+
+void IcmpEngine::awaitWritable(Channel& channel) {
+    channel.awaitingWrite = true;
+
+    auto self = shared_from_this();
+    channel.socket.async_wait(
+        asio::socket_base::wait_write, [this, self, &channel](const asio::error_code& ec) {
+            std::vector<Completion> failures;
+            {
+                std::lock_guard lock(mutex_);
+                channel.awaitingWrite = false;
+                // Closed by shutdown(), which already failed every pending request
+                if (ec == asio::error::operation_aborted || !channel.open) {
+                    return;
+                }
+                flushBacklog(channel, failures);
+            }
+            invokeAll(failures);
+        });
+}
+
+IcmpEngine::Completion IcmpEngine::takeCompletion(PendingRequest& request,
+                                                  core::PingResult result) {
+    return Completion{std::move(request.callback), std::move(request.batch), request.batchIndex,
+                      std::move(result)};
+}
+
+void IcmpEngine::postAll(std::vector<Completion> completions) {
+    if (completions.empty()) {
+        return;
+    }
+    context_.post([completions = std::move(completions)]() mutable { invokeAll(completions); });
+}
+
+void IcmpEngine::invokeAll(std::vector<Completion>& completions) {
+    for (auto& completion : completions) {
+        try {
+            if (completion.batch) {
+                auto& batch = *completion.batch;
+                batch.results[completion.batchIndex] = std::move(completion.result);
+                if (batch.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1 &&
+                    batch.callback) {
+                    batch.callback(batch.results);
+                }
+            } else if (completion.callback) {
+                completion.callback(completion.result);
+            }
+        } catch (const std::exception& e) {
+            spdlog::error("IcmpEngine: ping callback threw: {}", e.what());
+        }
+    }
+}
+
+void IcmpEngine::resetTxKeys(Channel& channel) {
+#if defined(__linux__) && defined(SO_TIMESTAMPING)
+    // A failed send may or may not have used a key, so restart the counter
+    // rather than guess; this flush's requests are timed from userspace
+    const int fd = channel.socket.native_handle();
+    channel.txTimestamps = setTxTimestamping(fd, false) && setTxTimestamping(fd, true);
+    channel.nextTxKey = 0;
+    channel.txKeys.clear();
+#else
+    (void)channel;
+#endif
+}
+
+void IcmpEngine::readTxTimestamps(Channel& channel) {
+#if defined(__linux__) && defined(SO_TIMESTAMPING)
+    // Queued stamps keep the socket signalling an error, so always drain them
+    while (true) {
+        struct ControlBuffer {
+            alignas(struct cmsghdr) char data[256];
+        } control;
+        uint8_t payload[64];
+        struct iovec iov {};
+        iov.iov_base = payload;
+        iov.iov_len = sizeof(payload);
+        struct msghdr msg {};
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control.data;
+        msg.msg_controllen = sizeof(control.data);
+
+        if (::recvmsg(channel.socket.native_handle(), &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        std::optional<std::chrono::system_clock::time_point> stamp;
+        std::optional<uint32_t> key;
+        for (auto* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+            if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPING) {
+                struct scm_timestamping stamps {};
+                std::memcpy(&stamps, CMSG_DATA(cmsg), sizeof(stamps));
+                if (stamps.ts[0].tv_sec != 0 || stamps.ts[0].tv_nsec != 0) {
+                    stamp = fromTimespec(stamps.ts[0]);
+                }
+            } else if ((cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) ||
+                       (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR)) {
+                struct sock_extended_err error {};
+                std::memcpy(&error, CMSG_DATA(cmsg), sizeof(error));
+                if (error.ee_errno == ENOMSG && error.ee_origin == SO_EE_ORIGIN_TIMESTAMPING) {
+                    key = error.ee_data;
+                }
+            }
+        }
+        if (!stamp || !key) {
+            continue;
+        }
+
+        // Stamps come back in send order; earlier keys never got one
+        while (!channel.txKeys.empty() && channel.txKeys.front().first < *key) {
+            channel.txKeys.pop_front();
+        }
+        if (channel.txKeys.empty() || channel.txKeys.front().first != *key) {
+            continue;
+        }
+        auto sequence = channel.txKeys.front().second;
+        channel.txKeys.pop_front();
+
+        // A stamp older than the request belongs to a datagram sent before
+        // the counter was last reset
+        auto it = pending_.find(sequence);
+        if (it != pending_.end() && *stamp >= it->second.timestamp) {
+            it->second.kernelSendTime = stamp;
+        }
+    }
+#else
+    (void)channel;
+#endif
+}
+
+void IcmpEngine::startReceive(Channel& channel) {
+    std::lock_guard lock(mutex_);
+    if (!channel.open) {
+        return;
+    }
+
+    auto self = shared_from_this();
+    channel.socket.async_wait(asio::socket_base::wait_read,
+                              [this, self, &channel](const asio::error_code& ec) {
+                                  if (ec || !channel.open) {
+                                      return;
+                                  }
+                                  handleReadable(channel);
+                                  startReceive(channel);
+                              });
+}
+
+void IcmpEngine::handleReadable(Channel& channel) {
+    std::vector<Completion> completions;
+
+#if defined(__linux__) || defined(__APPLE__)
+    {
+        std::lock_guard lock(mutex_);
+        if (!channel.open) {
+            return;
+        }
+
+        // Transmit stamps first: a reply is never read before its request's
+        readTxTimestamps(channel);
+
+        // Drain every queued datagram before going back to the event loop
+        struct ControlBuffer {
+            alignas(struct cmsghdr) char data[256];
+        };
+        std::array<std::array<uint8_t, RECV_BUFFER_SIZE>, RECV_BATCH_SIZE> buffers;
+        std::array<ControlBuffer, RECV_BATCH_SIZE> controls{};
+        std::array<sockaddr_storage, RECV_BATCH_SIZE> sources{};
+        std::array<struct iovec, RECV_BATCH_SIZE> iovs{};
+
+        auto parseControl = [](struct msghdr& msg,
+                               std::chrono::steady_clock::time_point recvTime) {
+            ReceiveInfo info;
+            info.recvTime = recvTime;
+            for (auto* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+#ifdef IP_TTL
+                if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_TTL) {
+                    std::memcpy(&info.ttl, CMSG_DATA(cmsg), sizeof(info.ttl));
+                }
+#endif
+#ifdef IPV6_HOPLIMIT
+                if (cmsg->cmsg_level == IPPROTO_IPV6 && cmsg->cmsg_type == IPV6_HOPLIMIT) {
+                    std::memcpy(&info.ttl, CMSG_DATA(cmsg), sizeof(info.ttl));
+                }
+#endif
+#ifdef SCM_TIMESTAMPNS
+                if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+                    struct timespec stamp {};
+                    std::memcpy(&stamp, CMSG_DATA(cmsg), sizeof(stamp));
+                    info.kernelTime = fromTimespec(stamp);
+                }
+#endif
+            }
+            return info;
+        };
+
+        auto prepare = [&](size_t i, struct msghdr& msg) {
+            sources[i] = {};
+            iovs[i].iov_base = buffers[i].data();
+            iovs[i].iov_len = buffers[i].size();
+            msg = {};
+            msg.msg_name = &sources[i];
+            msg.msg_namelen = sizeof(sources[i]);
+            msg.msg_iov = &iovs[i];
+            msg.msg_iovlen = 1;
+            msg.msg_control = controls[i].data;
+            msg.msg_controllen = sizeof(controls[i].data);
+        };
+
+#if defined(__linux__)
+        // Pull up to RECV_BATCH_SIZE replies per syscall
+        std::array<struct mmsghdr, RECV_BATCH_SIZE> messages{};
+        while (true) {
+            for (size_t i = 0; i < RECV_BATCH_SIZE; ++i) {
+                prepare(i, messages[i].msg_hdr);
+                messages[i].msg_len = 0;
+            }
+
+            int received = ::recvmmsg(channel.socket.native_handle(), messages.data(),
+                                      static_cast<unsigned int>(RECV_BATCH_SIZE), MSG_DONTWAIT,
+                                      nullptr);
+            if (received <= 0) {
+                if (received < 0 && errno != EAGAIN && errno != EINTR) {
+                    spdlog::debug("IcmpEngine: receive error: {}", std::strerror(errno));
+                }
+                break;
+            }
+            auto recvTime = std::chrono::steady_clock::now();
+
+            for (size_t i = 0; i < static_cast<size_t>(received); ++i) {
+                handleReply(channel, buffers[i].data(), messages[i].msg_len,
+                            fromSockaddr(sources[i]), parseControl(messages[i].msg_hdr, recvTime),
+                            completions);
+            }
+            if (static_cast<size_t>(received) < RECV_BATCH_SIZE) {
+                break;
+            }
+        }
+#else
+        while (true) {
+            struct msghdr msg {};
+            prepare(0, msg);
+
+            ssize_t received = ::recvmsg(channel.socket.native_handle(), &msg, MSG_DONTWAIT);
+            if (received < 0) {
+                if (errno != EAGAIN && errno != EINTR) {
+                    spdlog::debug("IcmpEngine: receive error: {}", std::strerror(errno));
+                }
+                break;
+            }
+            auto recvTime = std::chrono::steady_clock::now();
+
+            handleReply(channel, buffers[0].data(), static_cast<size_t>(received),
+                        fromSockaddr(sources[0]), parseControl(msg, recvTime), completions);
+        }
+#endif
+    }
+#else
+    (void)channel;
+#endif
+
+    invokeAll(completions);
+}
+
+void IcmpEngine::handleReply(const Channel& channel, const uint8_t* data, size_t length,
+                             const asio::ip::address& source, const ReceiveInfo& info,
+                             std::vector<Completion>& completions) {
+    const bool v6 = channel.family == core::AddressFamily::IPv6;
+    int ttl = info.ttl;
+
+    // IPv4 raw sockets (and datagram sockets on macOS) deliver the IP header too
+    size_t offset = 0;
+    if (!v6 && length >= IPV4_MIN_HEADER_SIZE && (data[0] >> 4) == 4) {
+        offset = static_cast<size_t>((data[0] & 0x0F) * 4);
+        ttl = data[8]; // TTL field in IP header
+    }
+    if (length < offset + ICMP_HEADER_SIZE) {
+        return;
+    }
+
+    const uint8_t* icmpHeader = data + offset;
+    if (icmpHeader[0] != (v6 ? ICMPV6_ECHO_REPLY_TYPE : ICMP_ECHO_REPLY_TYPE)) {
+        return;
+    }
+
+    uint16_t recvId =
+        static_cast<uint16_t>((static_cast<uint16_t>(icmpHeader[4]) << 8) | icmpHeader[5]);
+    uint16_t recvSeq =
+        static_cast<uint16_t>((static_cast<uint16_t>(icmpHeader[6]) << 8) | icmpHeader[7]);
+
+    // Datagram sockets have their identifier rewritten by the kernel, which
+    // already filters replies per socket; raw sockets see everyone's traffic.
+    if (channel.raw && recvId != identifier_) {
+        return;
+    }
+
+    auto it = pending_.find(recvSeq);
+    if (it == pending_.end() || !sameAddress(it->second.destination, source)) {
+        return;
+    }
+
+    core::PingResult result;
+    result.timestamp = it->second.timestamp;
+    result.success = true;
+    result.family = channel.family;
+    auto elapsed = info.recvTime - it->second.sendTime;
+    result.latency = std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+    result.timestampSource = core::TimestampSource::Userspace;
+
+    // Both stamps are wall-clock; a kernel stamp before the send means the
+    // clock stepped, so keep the monotonic userspace measurement instead.
+    // The send side is the kernel's transmit stamp when it reported one.
+    const auto& sendStamp = it->second.kernelSendTime;
+    auto sentAt = sendStamp.value_or(it->second.timestamp);
+    if (kernelTimestamps_ && info.kernelTime && *info.kernelTime >= sentAt) {
+        result.latency =
+            std::chrono::duration_cast<std::chrono::microseconds>(*info.kernelTime - sentAt);
+        result.timestampSource = sendStamp ? core::TimestampSource::Kernel
+                                           : core::TimestampSource::KernelReceive;
+    }
+    if (ttl >= 0) {
+        result.ttl = ttl;
+    }
+
+    spdlog::debug("Ping to {} successful: {:.2f}ms", it->second.address, result.latencyMs());
+
+    completions.push_back(takeCompletion(it->second, std::move(result)));
+    pending_.erase(it);
+}
+
+void IcmpEngine::insertIntoWheel(uint16_t sequence,
+                                 std::chrono::steady_clock::time_point deadline) {
+    auto delta = deadline > wheelTime_ ? deadline - wheelTime_ : std::chrono::nanoseconds(0);
+    auto ticks = static_cast<size_t>(delta / kWheelTick) + 1;
+    wheel_[(wheelCursor_ + ticks) % kWheelSlots].push_back(sequence);
+}
+
+void IcmpEngine::armWheelTimer() {
+    if (wheelArmed_ || pending_.empty()) {
+        return;
+    }
+    wheelArmed_ = true;
+
+    auto self = shared_from_this();
+    wheelTimer_.expires_at(wheelTime_ + kWheelTick);
+    wheelTimer_.async_wait([this, self](const asio::error_code& ec) {
+        if (ec) {
+            return;
+        }
+        advanceWheel();
+    });
+}
+
+void IcmpEngine::advanceWheel() {
+    std::vector<Completion> completions;
+    {
+        std::lock_guard lock(mutex_);
+        wheelArmed_ = false;
+
+        auto now = std::chrono::steady_clock::now();
+        auto elapsedTicks = static_cast<size_t>((now - wheelTime_) / kWheelTick);
+        auto steps = std::min(elapsedTicks, kWheelSlots);
+
+        for (size_t step = 0; step < steps; ++step) {
+            wheelCursor_ = (wheelCursor_ + 1) % kWheelSlots;
+            wheelTime_ += kWheelTick;
+
+            auto due = std::move(wheel_[wheelCursor_]);
+            wheel_[wheelCursor_].clear();
+
+            for (uint16_t sequence : due) {
+                auto it = pending_.find(sequence);
+                if (it == pending_.end()) {
+                    continue; // Already answered
+                }
+                if (it->second.deadline > now) {
+                    insertIntoWheel(sequence, it->second.deadline); // Later revolution
+                    continue;
+                }
+
+                core::PingResult result;
+                result.timestamp = it->second.timestamp;
+                result.success = false;
+                result.errorMessage = "Request timed out";
+                result.family = familyOf(it->second.destination);
+                completions.push_back(takeCompletion(it->second, std::move(result)));
+                pending_.erase(it);
+            }
+        }
+
+        // Catch up after a long stall without replaying every skipped slot
+        if (elapsedTicks > steps) {
+            wheelTime_ += kWheelTick * (elapsedTicks - steps);
+        }
+
+        armWheelTimer();
+    }
+
+    invokeAll(completions);
+}
+
+} // namespace netpulse::infra
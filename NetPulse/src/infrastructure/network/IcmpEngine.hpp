@@ -0,0 +1,321 @@
+#pragma once
+
+#include "core/types/PingResult.hpp"
+#include "infrastructure/network/AsioContext.hpp"
+#include "infrastructure/network/DnsCache.hpp"
+
+#include <asio.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace netpulse::infra {
+
+/**
+ * @brief Shared ICMP echo engine with asynchronous reply demultiplexing.
+ *
+ * Owns one long-lived ICMP socket per address family (ICMPv4 and ICMPv6),
+ * both registered with the Asio event loop. Echo requests are sent
+ * non-blocking and tracked in an outstanding-request table keyed by sequence
+ * number; replies are matched back to their request when either socket
+ * becomes readable. Per-request timeouts are driven by a hashed timing wheel
+ * advanced by one Asio timer, so no worker thread ever blocks waiting for a
+ * reply.
+ *
+ * @note Prefers unprivileged SOCK_DGRAM ICMP sockets and falls back to
+ *       SOCK_RAW (requires CAP_NET_RAW on Linux). Each family is opened
+ *       independently, so a host without IPv6 still pings over IPv4.
+ */
+class IcmpEngine : public std::enable_shared_from_this<IcmpEngine> {
+public:
+    /**
+     * @brief Callback invoked exactly once per echo request.
+     * @param result The completed ping result (success, timeout or error).
+     */
+    using EchoCallback = std::function<void(const core::PingResult&)>;
+
+    /**
+     * @brief Callback invoked once when every request of a batch has completed.
+     * @param results One result per requested address, in request order.
+     */
+    using BatchCallback = std::function<void(const std::vector<core::PingResult>&)>;
+
+    /**
+     * @brief A single echo request submitted as part of a batch.
+     */
+    struct EchoRequest {
+        std::string address;  ///< Target hostname, IPv4 or IPv6 address
+        EchoCallback callback; ///< Invoked once with this request's result
+        core::AddressFamily family{core::AddressFamily::Any}; ///< Family to use for names
+        std::chrono::milliseconds timeout{0}; ///< Overrides the batch timeout when positive
+    };
+
+    /**
+     * @brief Constructs an IcmpEngine bound to the given Asio context.
+     * @param context Reference to the AsioContext that runs socket and timer handlers.
+     */
+    explicit IcmpEngine(AsioContext& context);
+
+    /**
+     * @brief Destructor. Closes the sockets if still open.
+     */
+    ~IcmpEngine();
+
+    IcmpEngine(const IcmpEngine&) = delete;
+    IcmpEngine& operator=(const IcmpEngine&) = delete;
+
+    /**
+     * @brief Opens the ICMPv4 and ICMPv6 sockets and starts waiting for replies.
+     *
+     * Has no effect if already started. Requests for a family whose socket
+     * cannot be created complete with an error; the engine stays usable.
+     */
+    void start();
+
+    /**
+     * @brief Closes the sockets and fails all outstanding requests.
+     *
+     * Outstanding callbacks are invoked synchronously with an error result.
+     */
+    void shutdown();
+
+    /**
+     * @brief Sends an ICMP echo request without blocking.
+     *
+     * Literal addresses always use their own family. Hostnames use the first
+     * resolved address of the requested family; with AddressFamily::Any the
+     * resolver order decides, skipping families whose socket is unavailable.
+     *
+     * @param address Target hostname, IPv4 or IPv6 address.
+     * @param timeout Maximum time to wait for the matching reply.
+     * @param callback Invoked once with the result on an Asio worker thread.
+     * @param family Address family to use for hostnames.
+     */
+    void sendEcho(const std::string& address, std::chrono::milliseconds timeout,
+                  EchoCallback callback,
+                  core::AddressFamily family = core::AddressFamily::Any);
+
+    /**
+     * @brief Sends many echo requests with per-request callbacks.
+     *
+     * All packets are built into one contiguous buffer and transmitted with a
+     * single sendmmsg() call per address family where available. When the
+     * socket's send buffer is full the rest stay queued and go out once it
+     * is writable again.
+     *
+     * @param requests Addresses and their callbacks.
+     * @param timeout Maximum time to wait for each reply without its own timeout.
+     */
+    void sendEchoBatch(std::vector<EchoRequest> requests, std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Sends many echo requests and reports all results at once.
+     * @param addresses Target hostnames, IPv4 or IPv6 addresses.
+     * @param timeout Maximum time to wait for each reply.
+     * @param callback Invoked once, on an Asio worker thread, with all results.
+     */
+    void sendEchoBatch(std::span<const std::string> addresses, std::chrono::milliseconds timeout,
+                       BatchCallback callback);
+
+    /**
+     * @brief Checks whether any ICMP socket could be opened.
+     * @return True if echo requests can be sent over at least one family.
+     */
+    bool isAvailable() const { return v4_.open.load() || v6_.open.load(); }
+
+    /**
+     * @brief Checks whether the socket for one address family could be opened.
+     * @param family AddressFamily::IPv4 or AddressFamily::IPv6.
+     * @return True if echo requests can be sent over that family.
+     */
+    bool isAvailable(core::AddressFamily family) const {
+        return family == core::AddressFamily::IPv6 ? v6_.open.load() : v4_.open.load();
+    }
+
+    /**
+     * @brief Chooses how round-trip times are measured.
+     *
+     * When enabled (the default) replies are timed with the receive timestamp
+     * the kernel attached on arrival, measured from the transmit timestamp it
+     * reported on the socket's error queue (Linux SO_TIMESTAMPING), so
+     * scheduler delay on busy worker threads does not inflate RTTs. A request
+     * without a transmit stamp is measured from the userspace send time, and
+     * a reply without a receive stamp falls back to userspace timing;
+     * PingResult::timestampSource records which clocks were used.
+     *
+     * @param enabled True to prefer kernel receive timestamps.
+     */
+    void setKernelTimestamps(bool enabled) { kernelTimestamps_ = enabled; }
+
+    /**
+     * @brief Returns the number of requests currently awaiting a reply.
+     * @return Size of the outstanding-request table.
+     */
+    size_t outstandingCount() const;
+
+    /**
+     * @brief Computes the RFC 1071 Internet checksum.
+     * @param data Pointer to the bytes to checksum.
+     * @param length Number of bytes.
+     * @return One's complement checksum in host byte order.
+     */
+    static uint16_t calculateChecksum(const uint8_t* data, size_t length);
+
+    /**
+     * @brief Builds a 64-byte ICMP echo request packet.
+     *
+     * ICMPv6 packets leave the checksum zero: it covers the IPv6 pseudo-header,
+     * so the kernel fills it in on send.
+     *
+     * @param identifier ICMP identifier field.
+     * @param sequence ICMP sequence number field.
+     * @param family AddressFamily::IPv6 for an ICMPv6 echo request, ICMPv4 otherwise.
+     * @return Serialized packet.
+     */
+    static std::vector<uint8_t> buildEchoRequest(
+        uint16_t identifier, uint16_t sequence,
+        core::AddressFamily family = core::AddressFamily::IPv4);
+
+private:
+    // Shared by every request of a pingMany-style batch; the last completion
+    // hands the collected results to the batch callback.
+    struct BatchState {
+        std::vector<core::PingResult> results;
+        std::atomic<size_t> remaining{0};
+        BatchCallback callback;
+    };
+
+    // Where a result is delivered: a per-request callback or a batch slot
+    struct Completion {
+        EchoCallback callback;
+        std::shared_ptr<BatchState> batch;
+        size_t batchIndex{0};
+        core::PingResult result;
+    };
+
+    struct Outgoing {
+        std::string address;
+        core::AddressFamily family{core::AddressFamily::Any};
+        std::chrono::milliseconds timeout{0};
+        EchoCallback callback;
+        std::shared_ptr<BatchState> batch;
+        size_t batchIndex{0};
+    };
+
+    // Address picked for one request; error is set when none was usable
+    struct Destination {
+        std::optional<asio::ip::address> address;
+        std::string error;
+    };
+
+    // Requests with their resolved destinations, ready to transmit
+    struct ResolvedBatch {
+        std::vector<Outgoing> outgoing;
+        std::vector<Destination> destinations;
+    };
+
+    // Requests resolved while sendBatch() is still issuing lookups; they go
+    // out together, and anything resolved after that goes out on its own
+    struct InlineBatch {
+        std::mutex mutex;
+        bool collecting{true};
+        ResolvedBatch resolved;
+    };
+
+    // Per-datagram metadata pulled from the receive control messages
+    struct ReceiveInfo {
+        int ttl{-1};
+        std::optional<std::chrono::system_clock::time_point> kernelTime;
+        std::chrono::steady_clock::time_point recvTime;
+    };
+
+    struct PendingRequest {
+        std::string address;
+        asio::ip::address destination;
+        std::chrono::system_clock::time_point timestamp;
+        std::chrono::steady_clock::time_point sendTime;
+        std::chrono::steady_clock::time_point deadline;
+        std::optional<std::chrono::system_clock::time_point> kernelSendTime; // TX stamp
+        EchoCallback callback;
+        std::shared_ptr<BatchState> batch;
+        size_t batchIndex{0};
+    };
+
+    // Timing wheel geometry: 1024 slots of 10 ms cover ~10 s per revolution.
+    // Longer timeouts simply stay in their slot for extra revolutions.
+    static constexpr std::chrono::milliseconds kWheelTick{10};
+    static constexpr size_t kWheelSlots = 1024;
+
+    // One ICMP socket and how it was opened
+    struct Channel {
+        Channel(asio::io_context& ioContext, core::AddressFamily channelFamily)
+            : socket(ioContext), family(channelFamily) {}
+
+        asio::generic::raw_protocol::socket socket;
+        const core::AddressFamily family;
+        std::atomic<bool> open{false};
+        bool raw{false};
+
+        // Registered requests not yet handed to the kernel, in send order;
+        // guarded by mutex_ like the pending table
+        std::deque<uint16_t> backlog;
+        bool awaitingWrite{false}; // A wait_write is resuming the backlog
+
+        // Kernel transmit stamps come back keyed by a per-socket datagram
+        // counter; the key each sent request was given, in send order
+        bool txTimestamps{false};
+        uint32_t nextTxKey{0};
+        std::deque<std::pair<uint32_t, uint16_t>> txKeys; // Key, sequence
+    };
+
+    Channel& channelFor(core::AddressFamily family) {
+        return family == core::AddressFamily::IPv6 ? v6_ : v4_;
+    }
+    void openChannel(Channel& channel);
+    void sendBatch(std::vector<Outgoing>& outgoing, std::chrono::milliseconds timeout);
+    Destination selectDestination(const Outgoing& request, const asio::error_code& ec,
+                                  const DnsCache::Addresses& addresses) const;
+    void transmitBatch(ResolvedBatch& resolved);
+    void flushBacklog(Channel& channel, std::vector<Completion>& failures);
+    void awaitWritable(Channel& channel);
+    void resetTxKeys(Channel& channel);
+    void readTxTimestamps(Channel& channel);
+    void startReceive(Channel& channel);
+    void handleReadable(Channel& channel);
+    void handleReply(const Channel& channel, const uint8_t* data, size_t length,
+                     const asio::ip::address& source, const ReceiveInfo& info,
+                     std::vector<Completion>& completions);
+    void insertIntoWheel(uint16_t sequence, std::chrono::steady_clock::time_point deadline);
+    void armWheelTimer();
+    void advanceWheel();
+    static Completion takeCompletion(PendingRequest& request, core::PingResult result);
+    static void invokeAll(std::vector<Completion>& completions);
+    void postAll(std::vector<Completion> completions);
+
+    AsioContext& context_;
+    Channel v4_;
+    Channel v6_;
+    asio::steady_timer wheelTimer_;
+    std::atomic<bool> started_{false};
+    std::atomic<bool> kernelTimestamps_{true};
+    uint16_t identifier_;
+    uint16_t nextSequence_{0};
+
+    mutable std::mutex mutex_;
+    std::unordered_map<uint16_t, PendingRequest> pending_;
+    std::array<std::vector<uint16_t>, kWheelSlots> wheel_;
+    size_t wheelCursor_{0};
+    std::chrono::steady_clock::time_point wheelTime_;
+    bool wheelArmed_{false};
+};
+
+} // namespace netpulse::infra
@@ -1,285 +1,435 @@
 #include "infrastructure/network/PingService.hpp"
 
-#include <spdlog/spdlog.h>
+#include "infrastructure/network/Awaitable.hpp"
+#include "infrastructure/network/Hash.hpp"
 
-#include <array>
-#include <cstring>
-#include <random>
+#include <spdlog/spdlog.h>
 
-#if defined(__linux__) || defined(__APPLE__)
-#include <arpa/inet.h>
-#include <netdb.h>
-#include <netinet/ip.h>
-#include <netinet/ip_icmp.h>
-#include <sys/socket.h>
-#include <unistd.h>
-#endif
+#include <algorithm>
 
 namespace netpulse::infra {
 
-namespace {
-
-constexpr uint8_t ICMP_ECHO_REQUEST_TYPE = 8;
-constexpr uint8_t ICMP_ECHO_REPLY_TYPE = 0;
+PingService::PingService(AsioContext& context)
+    : context_(context), engine_(std::make_shared<IcmpEngine>(context)),
+      prober_(std::make_shared<TransportProber>(context)),
+      monitoredHosts_(context.threadCount()) {
+    queues_.reserve(context.contextCount());
+    for (size_t i = 0; i < context.contextCount(); ++i) {
+        queues_.push_back(std::make_shared<ProbeQueue>());
+    }
+    engine_->start();
+    spdlog::debug("PingService initialized (ICMP engine available: {})", engine_->isAvailable());
+}
 
-#if defined(__linux__) || defined(__APPLE__)
-std::string resolveHostname(const std::string& hostname) {
-    struct addrinfo hints {};
-    hints.ai_family = AF_INET;
-    hints.ai_socktype = SOCK_RAW;
+PingService::~PingService() {
+    stopAllMonitoring();
+    engine_->shutdown();
+}
 
-    struct addrinfo* result = nullptr;
-    if (getaddrinfo(hostname.c_str(), nullptr, &hints, &result) != 0) {
-        return hostname;
-    }
+std::future<core::PingResult> PingService::pingAsync(const std::string& address,
+                                                     std::chrono::milliseconds timeout) {
+    auto promise = std::make_shared<std::promise<core::PingResult>>();
+    auto future = promise->get_future();
 
-    char ipStr[INET_ADDRSTRLEN];
-    auto* addr = reinterpret_cast<struct sockaddr_in*>(result->ai_addr);
-    inet_ntop(AF_INET, &addr->sin_addr, ipStr, INET_ADDRSTRLEN);
-    freeaddrinfo(result);
+    engine_->sendEcho(address, timeout,
+                      [promise](const core::PingResult& result) { promise->set_value(result); });
 
-    return ipStr;
+    return future;
 }
-#endif
-
-} // namespace
 
-PingService::PingService(AsioContext& context) : context_(context) {
-    std::random_device rd;
-    identifier_ = static_cast<uint16_t>(rd() & 0xFFFF);
-    spdlog::debug("PingService initialized with identifier: {}", identifier_);
+// Coroutine parameters are taken by value: they must outlive the caller's frame
+asio::awaitable<core::PingResult> PingService::ping(std::string address,
+                                                    std::chrono::milliseconds timeout) {
+    auto start = [engine = engine_, address, timeout](auto done) {
+        engine->sendEcho(address, timeout, done);
+    };
+    co_return co_await awaitCallback<core::PingResult>(std::move(start));
 }
 
-PingService::~PingService() {
-    stopAllMonitoring();
+void PingService::pingMany(std::span<const std::string> addresses,
+                           std::chrono::milliseconds timeout, BatchPingCallback callback) {
+    engine_->sendEchoBatch(addresses, timeout, std::move(callback));
 }
 
-uint16_t PingService::calculateChecksum(const uint8_t* data, size_t length) {
-    uint32_t sum = 0;
+void PingService::startMonitoring(const core::Host& host, PingCallback callback) {
+    auto monitored = std::make_shared<MonitoredHost>();
+    monitored->host = host;
+    monitored->callback = std::move(callback);
+    monitored->active = true;
 
-    while (length > 1) {
-        sum += static_cast<uint32_t>((static_cast<uint16_t>(data[0]) << 8) | data[1]);
-        data += 2;
-        length -= 2;
+    SpreadPolicy spread;
+    {
+        std::lock_guard lock(mutex_);
+        monitored->adaptive = timeoutPolicy_.adaptive;
+        monitored->rtt.setBounds(timeoutPolicy_.floor, timeoutPolicy_.ceiling);
+        monitored->maxInFlight = maxInFlight_;
+        spread = spreadPolicy_;
     }
 
-    if (length == 1) {
-        sum += static_cast<uint32_t>(static_cast<uint16_t>(data[0]) << 8);
+    // Scheduled before it is published, so a concurrent replace always has a
+    // job to cancel
+    schedulePings(monitored, spread);
+    if (auto previous = monitoredHosts_.insertOrReplace(host.id, monitored)) {
+        retire(*previous);
     }
 
-    while (sum >> 16) {
-        sum = (sum & 0xFFFF) + (sum >> 16);
+    spdlog::info("Started monitoring host: {} ({})", host.name, host.address);
+}
+
+void PingService::stopMonitoring(int64_t hostId) {
+    if (auto monitored = monitoredHosts_.erase(hostId)) {
+        retire(*monitored);
+        spdlog::info("Stopped monitoring host: {}", hostId);
+    }
+}
+
+void PingService::stopAllMonitoring() {
+    for (auto& monitored : monitoredHosts_.takeAll()) {
+        retire(*monitored);
     }
+    spdlog::info("Stopped all host monitoring");
+}
 
-    return static_cast<uint16_t>(~sum);
+bool PingService::isMonitoring(int64_t hostId) const {
+    return monitoredHosts_.contains(hostId);
 }
 
-std::vector<uint8_t> PingService::buildIcmpEchoRequest(uint16_t identifier, uint16_t sequence) {
-    std::vector<uint8_t> packet(64, 0);
-
-    // ICMP header
-    packet[0] = ICMP_ECHO_REQUEST_TYPE;  // Type
-    packet[1] = 0;                        // Code
-    packet[2] = 0;                        // Checksum (high byte)
-    packet[3] = 0;                        // Checksum (low byte)
-    packet[4] = static_cast<uint8_t>(identifier >> 8);
-    packet[5] = static_cast<uint8_t>(identifier & 0xFF);
-    packet[6] = static_cast<uint8_t>(sequence >> 8);
-    packet[7] = static_cast<uint8_t>(sequence & 0xFF);
-
-    // Timestamp as payload
-    auto now = std::chrono::steady_clock::now().time_since_epoch().count();
-    std::memcpy(&packet[8], &now, sizeof(now));
-
-    // Calculate and set checksum
-    uint16_t checksum = calculateChecksum(packet.data(), packet.size());
-    packet[2] = static_cast<uint8_t>(checksum >> 8);
-    packet[3] = static_cast<uint8_t>(checksum & 0xFF);
-
-    return packet;
+void PingService::retire(MonitoredHost& monitored) {
+    monitored.active = false;
+    context_.timerWheelFor(static_cast<uint64_t>(monitored.host.id)).cancel(monitored.job);
 }
 
-core::PingResult PingService::performPing(const std::string& address,
-                                          std::chrono::milliseconds timeout) {
-    core::PingResult result;
-    result.timestamp = std::chrono::system_clock::now();
-    result.success = false;
-
-#if defined(__linux__) || defined(__APPLE__)
-    std::string resolvedAddress = resolveHostname(address);
-
-    int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_ICMP);
-    if (sock < 0) {
-        // Try raw socket (requires privileges)
-        sock = socket(AF_INET, SOCK_RAW, IPPROTO_ICMP);
-        if (sock < 0) {
-            result.errorMessage = "Failed to create ICMP socket";
-            spdlog::warn("Ping to {} failed: {}", address, result.errorMessage);
-            return result;
-        }
-    }
+void PingService::setSpreadPolicy(SpreadPolicy policy) {
+    std::lock_guard lock(mutex_);
+    spreadPolicy_ = policy;
+}
+
+PingService::SpreadPolicy PingService::spreadPolicy() const {
+    std::lock_guard lock(mutex_);
+    return spreadPolicy_;
+}
 
-    // Set receive timeout
-    struct timeval tv {};
-    tv.tv_sec = static_cast<time_t>(timeout.count() / 1000);
-    tv.tv_usec = static_cast<suseconds_t>((timeout.count() % 1000) * 1000);
-    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+void PingService::setTimeoutPolicy(const TimeoutPolicy& policy) {
+    std::lock_guard lock(mutex_);
+    timeoutPolicy_ = policy;
+    timeoutPolicy_.floor = std::max(policy.floor, std::chrono::milliseconds(1));
+    timeoutPolicy_.ceiling = std::max(policy.ceiling, timeoutPolicy_.floor);
+
+    monitoredHosts_.forEach([this](int64_t, const std::shared_ptr<MonitoredHost>& monitored) {
+        std::lock_guard rttLock(monitored->rttMutex);
+        monitored->adaptive = timeoutPolicy_.adaptive;
+        monitored->rtt.setBounds(timeoutPolicy_.floor, timeoutPolicy_.ceiling);
+    });
+}
 
-    struct sockaddr_in dest {};
-    dest.sin_family = AF_INET;
-    inet_pton(AF_INET, resolvedAddress.c_str(), &dest.sin_addr);
+PingService::TimeoutPolicy PingService::timeoutPolicy() const {
+    std::lock_guard lock(mutex_);
+    return timeoutPolicy_;
+}
 
-    uint16_t seq = sequenceNumber_++;
-    auto packet = buildIcmpEchoRequest(identifier_, seq);
+std::optional<std::chrono::milliseconds> PingService::probeTimeout(int64_t hostId) const {
+    auto monitored = monitoredHosts_.find(hostId);
+    if (!monitored) {
+        return std::nullopt;
+    }
+    return nextTimeout(*monitored);
+}
 
-    auto sendTime = std::chrono::steady_clock::now();
+void PingService::setMaxInFlight(int limit) {
+    std::lock_guard lock(mutex_);
+    maxInFlight_ = std::max(limit, 1);
+    monitoredHosts_.forEach([this](int64_t, const std::shared_ptr<MonitoredHost>& monitored) {
+        monitored->maxInFlight = maxInFlight_;
+    });
+}
 
-    ssize_t sent = sendto(sock, packet.data(), packet.size(), 0,
-                          reinterpret_cast<struct sockaddr*>(&dest), sizeof(dest));
+int PingService::maxInFlight() const {
+    std::lock_guard lock(mutex_);
+    return maxInFlight_;
+}
 
-    if (sent < 0) {
-        result.errorMessage = "Failed to send ICMP packet";
-        close(sock);
-        return result;
+std::optional<PingService::ScheduleStats> PingService::scheduleStats(int64_t hostId) const {
+    auto monitored = monitoredHosts_.find(hostId);
+    if (!monitored) {
+        return std::nullopt;
     }
 
-    std::array<uint8_t, 1024> recvBuffer{};
-    struct sockaddr_in from {};
-    socklen_t fromLen = sizeof(from);
+    ScheduleStats stats;
+    stats.cycles = monitored->cycles.load();
+    stats.missedCycles = monitored->missedCycles.load();
+    stats.lateCycles = monitored->lateCycles.load();
+    stats.inFlight = monitored->inFlight.load();
+    return stats;
+}
 
-    ssize_t received = recvfrom(sock, recvBuffer.data(), recvBuffer.size(), 0,
-                                reinterpret_cast<struct sockaddr*>(&from), &fromLen);
+std::chrono::milliseconds PingService::nextTimeout(MonitoredHost& monitored) {
+    std::lock_guard lock(monitored.rttMutex);
+    // The ceiling doubles as the fixed timeout when adaptive mode is off
+    return monitored.adaptive ? monitored.rtt.timeout() : monitored.rtt.ceiling();
+}
 
-    auto recvTime = std::chrono::steady_clock::now();
-    close(sock);
+void PingService::recordOutcome(MonitoredHost& monitored, const core::PingResult& result) {
+    std::lock_guard lock(monitored.rttMutex);
+    if (result.success) {
+        monitored.rtt.addSample(result.latency);
+    } else {
+        monitored.rtt.onTimeout(); // Back off like TCP after an unanswered probe
+    }
+}
 
-    if (received < 0) {
-        result.errorMessage = "Timeout or receive error";
-        return result;
+PingService::SpreadPolicy PingService::spreadPolicyFromString(const std::string& name) {
+    if (name == "none") {
+        return SpreadPolicy::None;
     }
+    return SpreadPolicy::Hashed;
+}
 
-    // Parse IP header and ICMP reply
-    if (received >= 28) { // Minimum IP header (20) + ICMP header (8)
-        auto* ipHeader = recvBuffer.data();
-        size_t ipHeaderLen = static_cast<size_t>((ipHeader[0] & 0x0F) * 4);
-        auto* icmpHeader = recvBuffer.data() + ipHeaderLen;
-
-        if (icmpHeader[0] == ICMP_ECHO_REPLY_TYPE) {
-            uint16_t recvId = static_cast<uint16_t>(
-                (static_cast<uint16_t>(icmpHeader[4]) << 8) | icmpHeader[5]);
-            uint16_t recvSeq = static_cast<uint16_t>(
-                (static_cast<uint16_t>(icmpHeader[6]) << 8) | icmpHeader[7]);
-
-            if (recvId == identifier_ && recvSeq == seq) {
-                result.success = true;
-                result.latency = std::chrono::duration_cast<std::chrono::microseconds>(
-                    recvTime - sendTime);
-                result.ttl = ipHeader[8]; // TTL field in IP header
-
-                spdlog::debug("Ping to {} successful: {:.2f}ms TTL={}", address,
-                              result.latencyMs(), *result.ttl);
-            }
-        }
+std::chrono::milliseconds PingService::phaseOffset(int64_t hostId,
+                                                   std::chrono::milliseconds interval) {
+    if (interval.count() <= 0) {
+        return std::chrono::milliseconds(0);
     }
-#else
-    (void)address;
-    (void)timeout;
-    result.errorMessage = "ICMP ping not implemented for this platform";
-#endif
 
-    return result;
+    auto x = mix64(static_cast<uint64_t>(hostId));
+    return std::chrono::milliseconds(
+        static_cast<int64_t>(x % static_cast<uint64_t>(interval.count())));
 }
 
-std::future<core::PingResult> PingService::pingAsync(const std::string& address,
-                                                     std::chrono::milliseconds timeout) {
-    auto promise = std::make_shared<std::promise<core::PingResult>>();
-    auto future = promise->get_future();
-
-    context_.post([this, address, timeout, promise]() {
-        try {
-            auto result = performPing(address, timeout);
-            promise->set_value(result);
-        } catch (const std::exception& e) {
-            core::PingResult result;
-            result.timestamp = std::chrono::system_clock::now();
-            result.success = false;
-            result.errorMessage = e.what();
-            promise->set_value(result);
-        }
-    });
+void PingService::schedulePings(const std::shared_ptr<MonitoredHost>& monitored,
+                                SpreadPolicy spread) {
+    auto interval = std::chrono::milliseconds(
+        std::chrono::seconds(std::max(monitored->host.pingIntervalSeconds, 1)));
+
+    auto firstDelay = interval;
+    if (spread == SpreadPolicy::Hashed) {
+        // Align the first probe to the host's phase slot on the steady clock, so
+        // the slot is stable across restarts of monitoring and hosts stay spread.
+        auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch());
+        auto phase = phaseOffset(monitored->host.id, interval);
+        firstDelay = (phase - now % interval + interval) % interval;
+    }
 
-    return future;
+    // The wheel derives every later deadline from the previous one, so the
+    // phase is kept without drift and cycles never wait for earlier probes.
+    monitored->interval = interval;
+    monitored->nextDeadline = std::chrono::steady_clock::now() + firstDelay;
+    // The job owns what it touches: a batch already collected by the wheel may
+    // still run it after the service is destroyed
+    auto key = static_cast<uint64_t>(monitored->host.id);
+    auto& wheel = context_.timerWheelFor(key);
+    monitored->job = wheel.scheduleEvery(
+        interval,
+        [&context = context_, engine = engine_, prober = prober_,
+         queue = queues_[context_.contextIndexFor(key)], monitored]() {
+            sendMonitoringPing(context, engine, prober, queue, monitored);
+        },
+        firstDelay);
 }
 
-void PingService::startMonitoring(const core::Host& host, PingCallback callback) {
-    std::lock_guard lock(mutex_);
-
-    auto it = monitoredHosts_.find(host.id);
-    if (it != monitoredHosts_.end()) {
-        it->second->active = false;
-        it->second->timer->cancel();
+void PingService::sendMonitoringPing(AsioContext& context,
+                                     const std::shared_ptr<IcmpEngine>& engine,
+                                     const std::shared_ptr<TransportProber>& prober,
+                                     const std::shared_ptr<ProbeQueue>& queue,
+                                     const std::shared_ptr<MonitoredHost>& monitored) {
+    if (!monitored->active) {
+        return;
     }
 
-    auto monitored = std::make_shared<MonitoredHost>();
-    monitored->host = host;
-    monitored->callback = std::move(callback);
-    monitored->timer = std::make_shared<asio::steady_timer>(context_.getContext());
-    monitored->active = true;
+    auto now = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point deadline;
+    {
+        std::lock_guard lock(monitored->scheduleMutex);
+        deadline = monitored->nextDeadline;
+        monitored->nextDeadline += monitored->interval;
+    }
+    ++monitored->cycles;
 
-    monitoredHosts_[host.id] = monitored;
+    auto lag = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::max(now - deadline, std::chrono::steady_clock::duration::zero()));
+    if (lag > LATE_TOLERANCE) {
+        ++monitored->lateCycles;
+    }
 
-    spdlog::info("Started monitoring host: {} ({})", host.name, host.address);
-    scheduleNextPing(monitored);
+    // Earlier probes may still be waiting for their timeout; overlap up to the
+    // limit, then count the cycle as missed so results can account for it.
+    int inFlight = monitored->inFlight.load();
+    do {
+        if (inFlight >= monitored->maxInFlight) {
+            ++monitored->missedCycles;
+            ++monitored->unreportedMisses;
+            return;
+        }
+    } while (!monitored->inFlight.compare_exchange_weak(inFlight, inFlight + 1));
+
+    // Hosts of this shard due in the same wheel tick are coalesced into one
+    // batched send from the shard's own context
+    bool flushScheduled;
+    {
+        std::lock_guard lock(queue->mutex);
+        flushScheduled = !queue->checks.empty();
+        queue->checks.push_back({monitored, lag});
+    }
+    if (!flushScheduled) {
+        // Owns everything it touches: the service may be gone when it runs
+        asio::post(context.contextFor(static_cast<uint64_t>(monitored->host.id)),
+                   [&context, engine, prober, queue]() {
+                       flushMonitoringPings(context, engine, prober, *queue);
+                   });
+    }
 }
 
-void PingService::stopMonitoring(int64_t hostId) {
-    std::lock_guard lock(mutex_);
+void PingService::flushMonitoringPings(AsioContext& context,
+                                       const std::shared_ptr<IcmpEngine>& engine,
+                                       const std::shared_ptr<TransportProber>& prober,
+                                       ProbeQueue& queue) {
+    std::vector<QueuedCheck> probes;
+    {
+        std::lock_guard lock(queue.mutex);
+        probes.swap(queue.checks);
+    }
 
-    auto it = monitoredHosts_.find(hostId);
-    if (it != monitoredHosts_.end()) {
-        it->second->active = false;
-        it->second->timer->cancel();
-        monitoredHosts_.erase(it);
-        spdlog::info("Stopped monitoring host: {}", hostId);
+    std::vector<IcmpEngine::EchoRequest> requests;
+    requests.reserve(probes.size());
+    for (auto& [monitored, lag] : probes) {
+        if (!monitored->active) {
+            --monitored->inFlight;
+            continue;
+        }
+        if (monitored->host.burstCount > 1) {
+            startBurst(context, engine, prober, monitored, lag);
+            continue;
+        }
+
+        auto onResult = [monitored, lag](const core::PingResult& probeResult) {
+            recordOutcome(*monitored, probeResult);
+            completeCheck(*monitored, probeResult, lag);
+        };
+
+        // TCP/UDP probes each own a socket, so only ICMP echoes are batched
+        if (monitored->host.probeType != core::ProbeType::Icmp) {
+            prober->probe(monitored->host, nextTimeout(*monitored), std::move(onResult));
+            continue;
+        }
+        requests.push_back({monitored->host.address, std::move(onResult),
+                            monitored->host.addressFamily, nextTimeout(*monitored)});
+    }
+
+    if (!requests.empty()) {
+        // Every request carries its own timeout; the batch default is unused
+        engine->sendEchoBatch(std::move(requests), TimeoutPolicy{}.ceiling);
     }
 }
 
-void PingService::stopAllMonitoring() {
-    std::lock_guard lock(mutex_);
+void PingService::completeCheck(MonitoredHost& monitored, core::PingResult result,
+                                std::chrono::microseconds lag) {
+    --monitored.inFlight;
+    if (!monitored.active) {
+        return;
+    }
+
+    result.hostId = monitored.host.id;
+    result.scheduleLag = lag;
+    result.missedCycles = monitored.unreportedMisses.exchange(0);
 
-    for (auto& [id, monitored] : monitoredHosts_) {
-        monitored->active = false;
-        monitored->timer->cancel();
+    if (monitored.callback) {
+        monitored.callback(result);
     }
-    monitoredHosts_.clear();
-    spdlog::info("Stopped all host monitoring");
 }
 
-bool PingService::isMonitoring(int64_t hostId) const {
-    std::lock_guard lock(mutex_);
-    return monitoredHosts_.contains(hostId);
+void PingService::startBurst(AsioContext& context, const std::shared_ptr<IcmpEngine>& engine,
+                             const std::shared_ptr<TransportProber>& prober,
+                             const std::shared_ptr<MonitoredHost>& monitored,
+                             std::chrono::microseconds lag) {
+    auto count = static_cast<size_t>(monitored->host.burstCount);
+
+    auto burst = std::make_shared<BurstState>(
+        context.contextFor(static_cast<uint64_t>(monitored->host.id)));
+    burst->monitored = monitored;
+    burst->scheduleLag = lag;
+    burst->probes.resize(count);
+    burst->arrivalOrder.reserve(count);
+    burst->remaining = count;
+
+    sendBurstProbe(engine, prober, burst);
+}
+
+void PingService::sendProbe(const std::shared_ptr<IcmpEngine>& engine,
+                            const std::shared_ptr<TransportProber>& prober,
+                            const core::Host& host, std::chrono::milliseconds timeout,
+                            IcmpEngine::EchoCallback callback) {
+    if (host.probeType == core::ProbeType::Icmp) {
+        engine->sendEcho(host.address, timeout, std::move(callback), host.addressFamily);
+    } else {
+        prober->probe(host, timeout, std::move(callback));
+    }
 }
 
-void PingService::scheduleNextPing(std::shared_ptr<MonitoredHost> monitored) {
+void PingService::sendBurstProbe(const std::shared_ptr<IcmpEngine>& engine,
+                                 const std::shared_ptr<TransportProber>& prober,
+                                 const std::shared_ptr<BurstState>& burst) {
+    const auto& monitored = burst->monitored;
     if (!monitored->active) {
+        abandonBurst(burst, "Monitoring stopped");
         return;
     }
 
-    monitored->timer->expires_after(std::chrono::seconds(monitored->host.pingIntervalSeconds));
-    monitored->timer->async_wait([this, monitored](const asio::error_code& ec) {
-        if (ec || !monitored->active) {
-            return;
-        }
+    size_t index = burst->nextProbe++;
+    sendProbe(
+        engine, prober, monitored->host, nextTimeout(*monitored),
+        [burst, index](const core::PingResult& probe) {
+            recordOutcome(*burst->monitored, probe);
+            {
+                std::lock_guard lock(burst->mutex);
+                burst->probes[index] = probe;
+                burst->arrivalOrder.push_back(index);
+                if (--burst->remaining > 0) {
+                    return;
+                }
+            }
 
-        auto result = performPing(monitored->host.address, std::chrono::milliseconds(5000));
-        result.hostId = monitored->host.id;
+            // Aggregated here so the caller gets one result (and one stored row) per check
+            completeCheck(*burst->monitored,
+                          core::PingResult::fromBurst(burst->probes, burst->arrivalOrder),
+                          burst->scheduleLag);
+        });
+
+    if (burst->nextProbe < burst->probes.size()) {
+        burst->timer.expires_after(
+            std::chrono::milliseconds(std::max(monitored->host.burstSpacingMs, 0)));
+        burst->timer.async_wait([engine, prober, burst](const asio::error_code& ec) {
+            if (ec) {
+                abandonBurst(burst, "Burst interrupted: " + ec.message());
+                return;
+            }
+            sendBurstProbe(engine, prober, burst);
+        });
+    }
+}
 
-        if (monitored->callback && monitored->active) {
-            monitored->callback(result);
+void PingService::abandonBurst(const std::shared_ptr<BurstState>& burst,
+                               const std::string& reason) {
+    // Unsent probes count as lost, so the check still completes (and frees
+    // its in-flight slot) once the probes already sent have come back
+    {
+        std::lock_guard lock(burst->mutex);
+        auto now = std::chrono::system_clock::now();
+        for (size_t i = burst->nextProbe; i < burst->probes.size(); ++i) {
+            auto& probe = burst->probes[i];
+            probe.timestamp = now;
+            probe.success = false;
+            probe.errorMessage = reason;
+            --burst->remaining;
         }
+        burst->nextProbe = burst->probes.size();
+        if (burst->remaining > 0) {
+            return;
+        }
+    }
 
-        scheduleNextPing(monitored);
-    });
+    completeCheck(*burst->monitored,
+                  core::PingResult::fromBurst(burst->probes, burst->arrivalOrder),
+                  burst->scheduleLag);
 }
 
 } // namespace netpulse::infra
@@ -2,26 +2,86 @@
 
 #include "core/services/IPingService.hpp"
 #include "infrastructure/network/AsioContext.hpp"
+#include "infrastructure/network/IcmpEngine.hpp"
+#include "infrastructure/network/RttEstimator.hpp"
+#include "infrastructure/network/ShardedRegistry.hpp"
+#include "infrastructure/network/TimerWheel.hpp"
+#include "infrastructure/network/TransportProber.hpp"
 
 #include <asio.hpp>
 #include <atomic>
-#include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
 
 namespace netpulse::infra {
 
 /**
  * @brief ICMP ping service for network host reachability testing.
  *
- * Provides asynchronous ping operations and continuous host monitoring using
- * raw ICMP sockets. Implements the core::IPingService interface.
+ * Provides asynchronous ping operations and continuous host monitoring on top
+ * of a shared IcmpEngine, so no worker thread blocks waiting for replies.
+ * Monitored hosts whose ProbeType is TCP, UDP or DNS are checked through a
+ * TransportProber instead and report the same PingResult.
+ * Hosts configured with a burst send several spaced probes per check and
+ * report one aggregated result (min/avg/max/stddev, loss, reordering).
+ * Monitoring probes size their timeouts from each host's RTT history.
+ *
+ * Checks run on fixed absolute deadlines regardless of how long earlier probes
+ * take. Up to maxInFlight() checks per host may overlap; cycles beyond that are
+ * counted as missed and reported on the next result, so stored statistics
+ * show the skipped checks instead of silently omitting them.
+ *
+ * Monitored hosts are sharded by id over the AsioContext's io_contexts. A
+ * host's checks run on the timer wheel of AsioContext::contextFor(id), and the
+ * checks one shard has due together are batched and sent from that shard's
+ * context, so in the PerThread topology each thread schedules and sends for
+ * its own hosts only. The IcmpEngine is shared by every shard: a raw ICMP
+ * socket receives every echo reply on the machine, so one socket per shard
+ * would multiply the receive work instead of splitting it.
+ *
+ * Implements the core::IPingService interface.
  *
  * @note On Linux, requires CAP_NET_RAW capability or root privileges.
  *       On macOS, uses SOCK_DGRAM for non-privileged ICMP.
  */
 class PingService : public core::IPingService {
 public:
+    /**
+     * @brief How monitored hosts sharing an interval are placed within it.
+     */
+    enum class SpreadPolicy {
+        None,  ///< First probe one full interval after monitoring starts
+        Hashed ///< Deterministic per-host phase offset derived from the host id
+    };
+
+    /**
+     * @brief How monitoring probes size their reply timeout.
+     */
+    struct TimeoutPolicy {
+        bool adaptive{true}; ///< Derive timeouts from each host's SRTT/RTTVAR
+        std::chrono::milliseconds floor{200};    ///< Smallest adaptive timeout
+        std::chrono::milliseconds ceiling{5000}; ///< Largest timeout; the fixed one if not adaptive
+    };
+
+    /**
+     * @brief Per-host scheduling counters.
+     */
+    struct ScheduleStats {
+        uint64_t cycles{0};       ///< Scheduled checks that came due
+        uint64_t missedCycles{0}; ///< Checks skipped because the in-flight limit was reached
+        uint64_t lateCycles{0};   ///< Checks that started more than LATE_TOLERANCE late
+        int inFlight{0};          ///< Checks currently awaiting a result
+    };
+
+    /// Default number of overlapping checks allowed per host.
+    static constexpr int DEFAULT_MAX_IN_FLIGHT = 3;
+
+    /// Start delay beyond which a check counts as late.
+    static constexpr std::chrono::milliseconds LATE_TOLERANCE{50};
+
     /**
      * @brief Constructs a PingService with the given Asio context.
      * @param context Reference to the AsioContext for async operations.
@@ -42,6 +102,27 @@ public:
     std::future<core::PingResult> pingAsync(const std::string& address,
                                             std::chrono::milliseconds timeout) override;
 
+    /**
+     * @brief Pings an address from a coroutine.
+     *
+     * Same as pingAsync() without the promise/future pair: the calling
+     * coroutine resumes on its own executor when the reply or timeout arrives.
+     *
+     * @param address Target hostname or IP address to ping.
+     * @param timeout Maximum time to wait for a response.
+     * @return Awaitable yielding the PingResult.
+     */
+    asio::awaitable<core::PingResult> ping(std::string address, std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Pings many addresses with a single batched send.
+     * @param addresses Target hostnames or IP addresses.
+     * @param timeout Maximum time to wait for each response.
+     * @param callback Called once with all results, in address order.
+     */
+    void pingMany(std::span<const std::string> addresses, std::chrono::milliseconds timeout,
+                  BatchPingCallback callback) override;
+
     /**
      * @brief Starts continuous monitoring of a host with periodic pings.
      * @param host The host to monitor (includes ping interval settings).
@@ -67,26 +148,182 @@ public:
      */
     bool isMonitoring(int64_t hostId) const override;
 
+    /**
+     * @brief Sets the phase spreading policy for subsequently monitored hosts.
+     * @param policy The spread policy to apply.
+     */
+    void setSpreadPolicy(SpreadPolicy policy);
+
+    /**
+     * @brief Returns the current phase spreading policy.
+     * @return The active spread policy.
+     */
+    SpreadPolicy spreadPolicy() const;
+
+    /**
+     * @brief Parses a spread policy name as stored in AppConfig.
+     * @param name "none" or "hashed"; unknown names map to Hashed.
+     * @return The corresponding spread policy.
+     */
+    static SpreadPolicy spreadPolicyFromString(const std::string& name);
+
+    /**
+     * @brief Sets how monitoring probes size their timeouts.
+     *
+     * Applies to hosts already being monitored; their RTT history is kept.
+     *
+     * @param policy The timeout policy to apply.
+     */
+    void setTimeoutPolicy(const TimeoutPolicy& policy);
+
+    /**
+     * @brief Returns the current timeout policy.
+     * @return The active timeout policy.
+     */
+    TimeoutPolicy timeoutPolicy() const;
+
+    /**
+     * @brief Returns the timeout the next monitoring probe of a host will use.
+     * @param hostId Unique identifier of the host.
+     * @return The timeout, or std::nullopt if the host is not monitored.
+     */
+    std::optional<std::chrono::milliseconds> probeTimeout(int64_t hostId) const;
+
+    /**
+     * @brief Sets how many checks of one host may be outstanding at once.
+     *
+     * Applies to hosts already being monitored.
+     *
+     * @param limit Maximum overlapping checks per host (at least 1).
+     */
+    void setMaxInFlight(int limit);
+
+    /**
+     * @brief Returns the per-host limit on outstanding checks.
+     * @return The active limit.
+     */
+    int maxInFlight() const;
+
+    /**
+     * @brief Returns the scheduling counters of a monitored host.
+     * @param hostId Unique identifier of the host.
+     * @return The counters, or std::nullopt if the host is not monitored.
+     */
+    std::optional<ScheduleStats> scheduleStats(int64_t hostId) const;
+
+    /**
+     * @brief Chooses between kernel and userspace reply timestamps.
+     * @param enabled True to prefer kernel receive timestamps where available.
+     */
+    void setKernelTimestamps(bool enabled) { engine_->setKernelTimestamps(enabled); }
+
+    /**
+     * @brief Computes a host's deterministic phase offset within its interval.
+     *
+     * Hosts are spread uniformly across the interval by hashing their id, so
+     * probes for thousands of hosts with the same interval do not fire together.
+     *
+     * @param hostId Unique identifier of the host.
+     * @param interval The host's probe interval.
+     * @return Offset in [0, interval) relative to the interval boundary.
+     */
+    static std::chrono::milliseconds phaseOffset(int64_t hostId,
+                                                 std::chrono::milliseconds interval);
+
 private:
     struct MonitoredHost {
         core::Host host;
         PingCallback callback;
-        std::shared_ptr<asio::steady_timer> timer;
+        TimerWheel::JobId job{0};
         std::atomic<bool> active{true};
+        std::atomic<int> inFlight{0};
+        std::atomic<int> maxInFlight{DEFAULT_MAX_IN_FLIGHT};
+
+        // Absolute schedule. The wheel re-arms a job before running it, so on a
+        // shared multi-thread context two runs of the job can overlap.
+        std::chrono::milliseconds interval{0};
+        std::mutex scheduleMutex; // Guards nextDeadline
+        std::chrono::steady_clock::time_point nextDeadline;
+
+        std::atomic<uint64_t> cycles{0};
+        std::atomic<uint64_t> missedCycles{0};
+        std::atomic<uint64_t> lateCycles{0};
+        std::atomic<int> unreportedMisses{0}; // Attached to the next result
+
+        // Guards rtt; burst probes complete concurrently
+        std::mutex rttMutex;
+        RttEstimator rtt{std::chrono::milliseconds(200), std::chrono::milliseconds(5000)};
+        bool adaptive{true};
+    };
+
+    // Probes of one burst; the last completion reports the aggregate
+    struct BurstState {
+        explicit BurstState(asio::io_context& ioContext) : timer(ioContext) {}
+
+        std::shared_ptr<MonitoredHost> monitored;
+        std::chrono::microseconds scheduleLag{0};
+        asio::steady_timer timer;
+        std::mutex mutex;
+        std::vector<core::PingResult> probes;
+        std::vector<size_t> arrivalOrder;
+        size_t nextProbe{0};
+        size_t remaining{0};
     };
 
-    void scheduleNextPing(std::shared_ptr<MonitoredHost> monitored);
-    core::PingResult performPing(const std::string& address, std::chrono::milliseconds timeout);
+    // A check waiting for the next batched flush
+    struct QueuedCheck {
+        std::shared_ptr<MonitoredHost> monitored;
+        std::chrono::microseconds scheduleLag{0};
+    };
+
+    // Checks due in the same wheel tick; shared with the posted flush, which
+    // may still be queued on the io_context after the service is destroyed
+    struct ProbeQueue {
+        std::mutex mutex;
+        std::vector<QueuedCheck> checks;
+    };
 
-    // ICMP helpers
-    static uint16_t calculateChecksum(const uint8_t* data, size_t length);
-    static std::vector<uint8_t> buildIcmpEchoRequest(uint16_t identifier, uint16_t sequence);
+    void schedulePings(const std::shared_ptr<MonitoredHost>& monitored, SpreadPolicy spread);
+    void retire(MonitoredHost& monitored);
+    static void sendMonitoringPing(AsioContext& context,
+                                   const std::shared_ptr<IcmpEngine>& engine,
+                                   const std::shared_ptr<TransportProber>& prober,
+                                   const std::shared_ptr<ProbeQueue>& queue,
+                                   const std::shared_ptr<MonitoredHost>& monitored);
+    static void flushMonitoringPings(AsioContext& context,
+                                     const std::shared_ptr<IcmpEngine>& engine,
+                                     const std::shared_ptr<TransportProber>& prober,
+                                     ProbeQueue& queue);
+    static void startBurst(AsioContext& context, const std::shared_ptr<IcmpEngine>& engine,
+                           const std::shared_ptr<TransportProber>& prober,
+                           const std::shared_ptr<MonitoredHost>& monitored,
+                           std::chrono::microseconds lag);
+    static void completeCheck(MonitoredHost& monitored, core::PingResult result,
+                              std::chrono::microseconds lag);
+    static std::chrono::milliseconds nextTimeout(MonitoredHost& monitored);
+    static void recordOutcome(MonitoredHost& monitored, const core::PingResult& result);
+    static void sendProbe(const std::shared_ptr<IcmpEngine>& engine,
+                          const std::shared_ptr<TransportProber>& prober,
+                          const core::Host& host, std::chrono::milliseconds timeout,
+                          IcmpEngine::EchoCallback callback);
+    static void sendBurstProbe(const std::shared_ptr<IcmpEngine>& engine,
+                               const std::shared_ptr<TransportProber>& prober,
+                               const std::shared_ptr<BurstState>& burst);
+    static void abandonBurst(const std::shared_ptr<BurstState>& burst, const std::string& reason);
 
     AsioContext& context_;
-    std::map<int64_t, std::shared_ptr<MonitoredHost>> monitoredHosts_;
+    std::shared_ptr<IcmpEngine> engine_;
+    std::shared_ptr<TransportProber> prober_;
+    // Sharded by host id; mutex_ only guards the policies below
+    ShardedRegistry<MonitoredHost> monitoredHosts_;
     mutable std::mutex mutex_;
-    std::atomic<uint16_t> sequenceNumber_{0};
-    uint16_t identifier_;
+    SpreadPolicy spreadPolicy_{SpreadPolicy::Hashed};
+    TimeoutPolicy timeoutPolicy_;
+    int maxInFlight_{DEFAULT_MAX_IN_FLIGHT};
+
+    // Per io_context, the monitoring probes due in the same wheel tick, sent
+    // together in one batch
+    std::vector<std::shared_ptr<ProbeQueue>> queues_;
 };
 
 } // namespace netpulse::infra
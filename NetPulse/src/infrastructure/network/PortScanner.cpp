@@ -1,173 +1,922 @@
 #include "infrastructure/network/PortScanner.hpp"
 
+#include "core/types/BannerMatcher.hpp"
 #include "core/types/PortScanResult.hpp"
+#include "infrastructure/network/Awaitable.hpp"
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <limits>
+#include <string_view>
+
 namespace netpulse::infra {
 
-PortScanner::PortScanner(AsioContext& context) : context_(context) {}
+namespace {
+
+// Shared by a probe and its timeout handler, which may run after the probe
+// returned and the worker started its next connect on the same socket
+struct ProbeDeadline {
+    bool finished{false};
+    bool fired{false};
+};
+
+// Sent to open ports that stay silent; HTTP servers answer with a Server
+// header and most other protocols with an error that names them
+constexpr std::string_view BANNER_PROBE = "HEAD / HTTP/1.0\r\n\r\n";
+
+} // namespace
+
+PortScanner::PortScanner(AsioContext& context)
+    : context_(context), scans_(std::make_shared<ScanTable>()),
+      budget_(std::make_shared<ConnectionBudget>()) {}
 
 PortScanner::~PortScanner() {
     cancel();
+
+    std::lock_guard lock(synMutex_);
+    if (syn_) {
+        syn_->shutdown();
+    }
+}
+
+PortScanner::ScanId PortScanner::scanAsync(const core::PortScanConfig& config,
+                                           ResultCallback onResult, ProgressCallback onProgress,
+                                           CompletionCallback onComplete) {
+    core::ScanCheckpoint fresh;
+    fresh.config = config;
+    fresh.targets = config.getTargets();
+    return startScan(std::move(fresh), std::move(onResult), std::move(onProgress),
+                     std::move(onComplete));
+}
+
+PortScanner::ScanId PortScanner::resumeAsync(const core::ScanCheckpoint& checkpoint,
+                                             ResultCallback onResult, ProgressCallback onProgress,
+                                             CompletionCallback onComplete) {
+    return startScan(checkpoint, std::move(onResult), std::move(onProgress),
+                     std::move(onComplete));
+}
+
+PortScanner::ScanId PortScanner::startScan(core::ScanCheckpoint checkpoint,
+                                           ResultCallback onResult, ProgressCallback onProgress,
+                                           CompletionCallback onComplete) {
+    const auto& config = checkpoint.config;
+    auto run = std::make_shared<ScanRun>();
+    run->id = nextScanId_.fetch_add(1);
+    run->config = config;
+    run->targets = std::move(checkpoint.targets);
+    run->ports = config.getPortsToScan();
+    run->onResult = std::move(onResult);
+    run->onProgress = std::move(onProgress);
+    run->onComplete = std::move(onComplete);
+    run->table = scans_;
+    run->budget = budget_;
+    if (config.mode == core::ScanMode::Syn) {
+        run->syn = synScanner();
+    }
+
+    auto concurrency = static_cast<size_t>(std::max(config.maxConcurrency, 1));
+    if (run->syn) {
+        // An outstanding SYN is only a table entry in the engine, so keep
+        // enough of them to send at the full rate for the whole timeout
+        auto rate = run->syn->rateLimit();
+        auto inFlight = rate == 0 ? MAX_SYN_OUTSTANDING
+                                  : rate * static_cast<size_t>(config.timeout.count()) / 1000;
+        concurrency = std::clamp(inFlight, concurrency, MAX_SYN_OUTSTANDING);
+    }
+
+    auto ceiling = concurrency;
+    run->window = std::make_shared<ConnectionBudget>();
+    run->window->limit = concurrency;
+    if (config.adaptiveRate) {
+        ceiling = concurrency * ADAPTIVE_GROWTH;
+        if (run->syn) {
+            ceiling = std::min(ceiling, MAX_SYN_OUTSTANDING);
+        }
+        run->rate.emplace(concurrency, concurrency / ADAPTIVE_FLOOR_DIVISOR, ceiling);
+        run->window->limit = run->rate->window();
+    }
+    run->progress.concurrency = static_cast<int>(run->window->limit);
+    run->perTargetLimit =
+        config.maxPerTarget > 0 ? static_cast<size_t>(config.maxPerTarget) : ceiling;
+
+    auto jobs = run->targets.size() * run->ports.size();
+    run->progress.totalPorts =
+        static_cast<int>(std::min<size_t>(jobs, std::numeric_limits<int>::max()));
+
+    // A resumed scan starts each target after the ports its checkpoint covers
+    bool resumed = !checkpoint.key.empty();
+    size_t remaining = 0;
+    run->targetStates.resize(run->targets.size());
+    for (size_t i = 0; i < run->targets.size(); ++i) {
+        auto& state = run->targetStates[i];
+        if (i < checkpoint.portsDone.size()) {
+            state.done = std::min(checkpoint.portsDone[i], run->ports.size());
+        }
+        state.nextPort = state.done;
+        remaining += run->ports.size() - state.done;
+        if (state.done < run->ports.size()) {
+            state.ready = true;
+            run->ready.push_back(i);
+        }
+    }
+    run->progress.scannedPorts = static_cast<int>(std::min<size_t>(
+        jobs - remaining, std::numeric_limits<int>::max()));
+
+    if (resumed) {
+        // Keep only results for ports that will not be probed again
+        std::unordered_map<std::string, size_t> targetIndex;
+        for (size_t i = 0; i < run->targets.size(); ++i) {
+            targetIndex.emplace(run->targets[i], i);
+        }
+        std::unordered_map<uint16_t, size_t> portIndex;
+        for (size_t i = 0; i < run->ports.size(); ++i) {
+            portIndex.emplace(run->ports[i], i);
+        }
+        for (auto& result : checkpoint.results) {
+            auto target = targetIndex.find(result.targetAddress);
+            auto port = portIndex.find(result.port);
+            if (target != targetIndex.end() && port != portIndex.end() &&
+                port->second < run->targetStates[target->second].done) {
+                run->results.push_back(std::move(result));
+            }
+        }
+        run->progress.openPorts = static_cast<int>(run->results.size());
+        run->checkpointedResults = run->results.size();
+        run->checkpointKey = std::move(checkpoint.key);
+    } else {
+        auto now = std::chrono::system_clock::now().time_since_epoch();
+        run->checkpointKey =
+            std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(now).count()) +
+            "-" + std::to_string(run->id);
+    }
+    {
+        std::lock_guard lock(checkpointMutex_);
+        run->onCheckpoint = onCheckpoint_;
+        run->checkpointInterval = checkpointInterval_;
+    }
+
+    spdlog::info("{} {} scan {} of {} ({} targets) on {} ports, {} probes left",
+                 resumed ? "Resuming" : "Starting", run->syn ? "SYN" : "connect", run->id,
+                 config.targetAddress, run->targets.size(), run->ports.size(), remaining);
+
+    if (remaining == 0) {
+        // Completion is reported from the context, never from inside this call
+        asio::post(context_.nextContext(), [run]() { finishScan(*run); });
+        return run->id;
+    }
+
+    {
+        std::lock_guard lock(scans_->mutex);
+        scans_->runs.emplace(run->id, run);
+    }
+
+    run->maxWorkers = ceiling;
+    run->started = std::chrono::steady_clock::now();
+    run->nextCheckpoint = run->started + run->checkpointInterval;
+    resolveTargets(context_, run);
+    return run->id;
+}
+
+void PortScanner::resolveTargets(AsioContext& context, const std::shared_ptr<ScanRun>& run) {
+    // Literals are taken as they are; names go through the cache once per scan
+    std::vector<size_t> names;
+    {
+        std::lock_guard lock(run->mutex);
+        run->addresses.resize(run->targets.size());
+        for (size_t i = 0; i < run->targets.size(); ++i) {
+            asio::error_code ec;
+            auto literal = asio::ip::make_address(run->targets[i], ec);
+            if (!ec) {
+                run->addresses[i] = literal.to_string();
+            } else if (run->targetStates[i].done < run->ports.size()) {
+                names.push_back(i);
+            }
+        }
+        // Counts the loop below too, so no callback starts the workers early
+        run->unresolvedLookups = names.size() + 1;
+    }
+
+    for (auto target : names) {
+        context.dnsCache().resolveAsync(
+            run->targets[target], [&context, run, target](const asio::error_code& ec,
+                                                          const DnsCache::Addresses& addresses) {
+                onTargetResolved(context, run, target, ec, addresses);
+            });
+    }
+    onTargetResolved(context, run, run->targets.size(), {}, {});
+}
+
+void PortScanner::onTargetResolved(AsioContext& context, const std::shared_ptr<ScanRun>& run,
+                                   size_t target, const asio::error_code& ec,
+                                   const DnsCache::Addresses& addresses) {
+    {
+        std::lock_guard lock(run->mutex);
+        if (target < run->targets.size() && !ec && !addresses.empty()) {
+            // SYN probes are IPv4 only, and most dual-stack names answer on both
+            auto ipv4 = std::find_if(addresses.begin(), addresses.end(),
+                                     [](const asio::ip::address& a) { return a.is_v4(); });
+            run->addresses[target] =
+                (ipv4 != addresses.end() ? *ipv4 : addresses.front()).to_string();
+        } else if (target < run->targets.size()) {
+            spdlog::warn("Port scan {}: cannot resolve {}: {}", run->id, run->targets[target],
+                         ec ? ec.message() : "no addresses");
+        }
+        if (--run->unresolvedLookups > 0) {
+            return;
+        }
+    }
+    startWorkers(context, run);
 }
 
-void PortScanner::scanAsync(const core::PortScanConfig& config, ResultCallback onResult,
-                            ProgressCallback onProgress, CompletionCallback onComplete) {
-    if (scanning_.exchange(true)) {
-        spdlog::warn("Scan already in progress");
+void PortScanner::startWorkers(AsioContext& context, const std::shared_ptr<ScanRun>& run) {
+    size_t remaining = 0;
+    bool unresolved = false;
+    core::PortScanProgress progress;
+    {
+        std::lock_guard lock(run->mutex);
+        // Unresolved targets are left out; their ports stay undone in checkpoints
+        std::erase_if(run->ready, [&run](size_t target) {
+            return run->addresses[target].empty();
+        });
+        for (size_t i = 0; i < run->targets.size(); ++i) {
+            auto left = run->ports.size() - run->targetStates[i].done;
+            if (!run->addresses[i].empty()) {
+                remaining += left;
+            } else if (left > 0) {
+                run->targetStates[i].ready = false;
+                run->progress.totalPorts -= static_cast<int>(
+                    std::min<size_t>(left, static_cast<size_t>(run->progress.totalPorts)));
+                run->progress.unresolvedTargets.push_back(run->targets[i]);
+                unresolved = true;
+            }
+        }
+        progress = run->progress;
+    }
+
+    if (unresolved && run->onProgress) {
+        run->onProgress(progress);
+    }
+    if (remaining == 0 || run->cancelled) {
+        finishScan(*run);
+        return;
+    }
+
+    if (run->syn) {
+        asio::post(context.nextContext(), [run]() { pumpSyn(run); });
         return;
     }
 
-    cancelled_ = false;
-    auto ports = config.getPortsToScan();
+    // Each worker keeps one probe in flight and the window admits as many as
+    // the rate controller allows, so there is a worker per probe it could allow
+    size_t resolved = 0;
+    for (const auto& address : run->addresses) {
+        resolved += address.empty() ? 0 : 1;
+    }
+    auto workers = std::min({run->maxWorkers, resolved * run->perTargetLimit, remaining});
+    run->workers = workers;
+    for (size_t i = 0; i < workers; ++i) {
+        asio::co_spawn(asio::make_strand(context.nextContext()), scanWorker(run), asio::detached);
+    }
+}
+
+asio::awaitable<core::PortScanResult> PortScanner::connectProbe(std::string address,
+                                                                uint16_t port,
+                                                                std::chrono::milliseconds timeout) {
+    auto executor = co_await asio::this_coro::executor;
+    auto socket = std::make_shared<asio::ip::tcp::socket>(executor);
+    co_return co_await probe(socket, std::move(address), port, timeout);
+}
 
-    spdlog::info("Starting port scan of {} on {} ports", config.targetAddress, ports.size());
+asio::awaitable<core::PortScanResult>
+PortScanner::probe(std::shared_ptr<asio::ip::tcp::socket> socket, std::string address,
+                   uint16_t port, std::chrono::milliseconds timeout, bool keepOpen) {
+    core::PortScanResult result;
+    result.targetAddress = address;
+    result.port = port;
+    result.scanTimestamp = std::chrono::system_clock::now();
+
+    asio::error_code ec;
+    auto target = asio::ip::make_address(address, ec);
+    if (ec) {
+        spdlog::debug("Port scan error for {}:{} - {}", address, port, ec.message());
+        result.state = core::PortState::Closed;
+        co_return result;
+    }
 
-    auto progress = std::make_shared<core::PortScanProgress>();
-    progress->totalPorts = static_cast<int>(ports.size());
+    auto executor = co_await asio::this_coro::executor;
+
+    // The timer closes the socket to abort the connect; it holds the socket in
+    // case it fires after this frame has finished
+    auto deadline = std::make_shared<ProbeDeadline>();
+    asio::steady_timer timer(executor);
+    timer.expires_after(timeout);
+    timer.async_wait([socket, deadline](const asio::error_code& waitEc) {
+        if (!waitEc && !deadline->finished) {
+            deadline->fired = true;
+            asio::error_code ignored;
+            socket->close(ignored);
+        }
+    });
+
+    co_await socket->async_connect(asio::ip::tcp::endpoint(target, port),
+                                   asio::redirect_error(asio::use_awaitable, ec));
+    deadline->finished = true;
+    timer.cancel();
+
+    if (deadline->fired) {
+        result.state = core::PortState::Filtered;
+    } else if (!ec) {
+        result.state = core::PortState::Open;
+        result.serviceName = core::ServiceDetector::detectService(port);
+    } else if (ec == asio::error::host_unreachable || ec == asio::error::network_unreachable) {
+        // ICMP unreachable: something on the path rejects the probe
+        result.state = core::PortState::Filtered;
+    } else {
+        result.state = core::PortState::Closed;
+    }
 
-    auto results = std::make_shared<std::vector<core::PortScanResult>>();
-    auto completedCount = std::make_shared<std::atomic<int>>(0);
-    auto openCount = std::make_shared<std::atomic<int>>(0);
-    auto resultsMutex = std::make_shared<std::mutex>();
+    if (!keepOpen || result.state != core::PortState::Open) {
+        asio::error_code ignored;
+        socket->close(ignored);
+    }
+    co_return result;
+}
 
-    semaphore_ = std::make_unique<std::counting_semaphore<>>(config.maxConcurrency);
+asio::awaitable<void> PortScanner::scanWorker(std::shared_ptr<ScanRun> run) {
+    // One socket per connect worker, reopened by each connect and registered
+    // so cancelRun() can close it mid-connect
+    auto executor = co_await asio::this_coro::executor;
+    auto socket = std::make_shared<asio::ip::tcp::socket>(executor);
+    {
+        std::lock_guard lock(run->mutex);
+        run->sockets.push_back(socket);
+    }
+    bool grab = run->config.grabBanners;
 
-    for (uint16_t port : ports) {
-        if (cancelled_) {
+    while (!run->cancelled) {
+        auto job = takeJob(*run);
+        if (!job) {
             break;
         }
 
-        semaphore_->acquire();
+        core::PortScanResult result;
+        for (int attempt = 0; !run->cancelled; ++attempt) {
+            if (!co_await acquireConnection(run->window, run)) {
+                break;
+            }
+            auto sentAt = std::chrono::steady_clock::now();
+            if (!co_await acquireConnection(run->budget, run)) {
+                releaseConnection(*run->window);
+                break;
+            }
+            if (!run->cancelled) {
+                result = co_await probe(socket, run->addresses[job->target], job->port,
+                                        run->config.timeout, grab);
+            }
+            releaseConnection(*run->budget);
+            releaseConnection(*run->window);
+            // Reported under the target as given, not the address it resolved to
+            result.targetAddress = run->targets[job->target];
+
+            // Unreachables come back early; only silence is worth a retry
+            bool timedOut = result.state == core::PortState::Filtered &&
+                            std::chrono::steady_clock::now() - sentAt >= run->config.timeout;
+            if (run->cancelled) {
+                break;
+            }
+            adjustWindow(*run, sentAt, result, timedOut);
+            if (!timedOut || attempt >= run->config.maxRetries) {
+                break;
+            }
+        }
+        finishJob(*run, job->target);
+
+        if (run->cancelled) {
+            break; // Connects aborted by the cancel are not results
+        }
+
+        if (grab && socket->is_open()) {
+            if (++run->bannerGrabs <= MAX_BANNER_GRABS) {
+                // The grab reports the port; carry on with a fresh socket
+                auto connected = socket;
+                socket = std::make_shared<asio::ip::tcp::socket>(executor);
+                {
+                    std::lock_guard lock(run->mutex);
+                    run->sockets.push_back(socket);
+                }
+                ++run->workers;
+                asio::co_spawn(executor, grabBanner(run, connected, *job, result),
+                               asio::detached);
+                continue;
+            }
+            --run->bannerGrabs;
+            asio::error_code ignored;
+            socket->close(ignored);
+        }
+        recordResult(*run, *job, result);
+    }
 
-        // Create shared state for this port scan
-        auto scanState = std::make_shared<struct ScanState>();
-        scanState->socket = std::make_shared<asio::ip::tcp::socket>(context_.getContext());
-        scanState->timer = std::make_shared<asio::steady_timer>(context_.getContext());
-        scanState->result.targetAddress = config.targetAddress;
-        scanState->result.port = port;
-        scanState->result.scanTimestamp = std::chrono::system_clock::now();
+    if (--run->workers == 0) {
+        finishScan(*run);
+    }
+}
 
-        if (cancelled_) {
-            semaphore_->release();
+void PortScanner::pumpSyn(const std::shared_ptr<ScanRun>& run) {
+    ++run->workers; // Keeps the scan open while this pass sends
+    while (!run->cancelled && tryAcquireConnection(*run->window)) {
+        auto job = takeJob(*run);
+        if (!job) {
+            releaseConnection(*run->window);
             break;
         }
+        ++run->workers;
+        sendSyn(run, *job, 0);
+    }
+    if (--run->workers == 0) {
+        finishScan(*run);
+    }
+}
+
+void PortScanner::sendSyn(const std::shared_ptr<ScanRun>& run, Job job, int attempt) {
+    auto sentAt = std::chrono::steady_clock::now();
+    run->syn->probe(run->addresses[job.target], job.port, run->config.timeout,
+                    [run, job, attempt, sentAt](const core::PortScanResult& result) {
+                        onSynResult(run, job, attempt, sentAt, result);
+                    });
+}
+
+void PortScanner::onSynResult(const std::shared_ptr<ScanRun>& run, Job job, int attempt,
+                              std::chrono::steady_clock::time_point sentAt,
+                              core::PortScanResult result) {
+    // Outstanding SYNs cannot be aborted; a cancel only stops new ones and
+    // their answers are not results. Retries keep the probe's window slot.
+    if (!run->cancelled) {
+        // The engine only reports Filtered once the timeout has passed
+        bool timedOut = result.state == core::PortState::Filtered;
+        adjustWindow(*run, sentAt, result, timedOut);
+        if (timedOut && attempt < run->config.maxRetries) {
+            sendSyn(run, job, attempt + 1);
+            return;
+        }
+    }
+    releaseConnection(*run->window);
+    finishJob(*run, job.target);
+
+    if (!run->cancelled) {
+        result.targetAddress = run->targets[job.target];
+        recordResult(*run, job, result);
+        pumpSyn(run);
+    }
+    if (--run->workers == 0) {
+        finishScan(*run);
+    }
+}
+
+asio::awaitable<void> PortScanner::grabBanner(std::shared_ptr<ScanRun> run,
+                                              std::shared_ptr<asio::ip::tcp::socket> socket,
+                                              Job job, core::PortScanResult result) {
+    // Most services greet first (SSH, FTP, SMTP); ask the rest with the
+    // second half of the budget
+    auto firstWait = run->config.bannerTimeout / 2;
+    auto banner = co_await readBanner(socket, firstWait);
+    if (banner.empty() && socket->is_open() && !run->cancelled) {
+        asio::error_code ec;
+        co_await asio::async_write(*socket, asio::buffer(BANNER_PROBE),
+                                   asio::redirect_error(asio::use_awaitable, ec));
+        if (!ec) {
+            banner = co_await readBanner(socket, run->config.bannerTimeout - firstWait);
+        }
+    }
+
+    asio::error_code ignored;
+    socket->close(ignored);
+    {
+        std::lock_guard lock(run->mutex);
+        std::erase(run->sockets, socket);
+    }
+    --run->bannerGrabs;
+
+    if (!banner.empty()) {
+        if (auto match = core::BannerMatcher::defaults().match(banner)) {
+            result.serviceName = match->service;
+            result.serviceVersion = match->describe();
+        }
+        result.banner = core::BannerMatcher::firstLine(banner);
+    }
 
-        try {
-            asio::ip::tcp::endpoint endpoint(asio::ip::make_address(config.targetAddress), port);
-
-            // Start timeout timer
-            scanState->timer->expires_after(config.timeout);
-            scanState->timer->async_wait(
-                [this, scanState, onResult, onProgress, onComplete, progress, results,
-                 completedCount, openCount, resultsMutex,
-                 totalPorts = ports.size()](const asio::error_code& ec) {
-                    if (ec || scanState->completed.exchange(true)) {
-                        return; // Timer cancelled or already completed
-                    }
-
-                    // Timeout occurred
-                    try {
-                        scanState->socket->close();
-                    } catch (...) {
-                    }
-                    scanState->result.state = core::PortState::Filtered;
-
-                    finishPortScan(scanState->result, onResult, onProgress, onComplete, progress,
-                                   results, completedCount, openCount, resultsMutex, totalPorts);
-                });
-
-            // Start async connect
-            scanState->socket->async_connect(
-                endpoint,
-                [this, scanState, onResult, onProgress, onComplete, progress, results,
-                 completedCount, openCount, resultsMutex,
-                 totalPorts = ports.size()](const asio::error_code& ec) {
-                    if (scanState->completed.exchange(true)) {
-                        return; // Already completed (timeout)
-                    }
-
-                    // Cancel the timer
-                    scanState->timer->cancel();
-
-                    if (!ec) {
-                        scanState->result.state = core::PortState::Open;
-                        scanState->result.serviceName =
-                            core::ServiceDetector::detectService(scanState->result.port);
-                        (*openCount)++;
-                    } else {
-                        scanState->result.state = core::PortState::Closed;
-                    }
-
-                    try {
-                        scanState->socket->close();
-                    } catch (...) {
-                    }
-
-                    finishPortScan(scanState->result, onResult, onProgress, onComplete, progress,
-                                   results, completedCount, openCount, resultsMutex, totalPorts);
-                });
-
-        } catch (const std::exception& e) {
-            // Invalid address or other error
-            spdlog::debug("Port scan error for {}:{} - {}", config.targetAddress, port, e.what());
-            scanState->result.state = core::PortState::Closed;
-            finishPortScan(scanState->result, onResult, onProgress, onComplete, progress, results,
-                           completedCount, openCount, resultsMutex, ports.size());
-        }
-    }
-}
-
-void PortScanner::finishPortScan(const core::PortScanResult& result, ResultCallback onResult,
-                                  ProgressCallback onProgress, CompletionCallback onComplete,
-                                  std::shared_ptr<core::PortScanProgress> progress,
-                                  std::shared_ptr<std::vector<core::PortScanResult>> results,
-                                  std::shared_ptr<std::atomic<int>> completedCount,
-                                  std::shared_ptr<std::atomic<int>> openCount,
-                                  std::shared_ptr<std::mutex> resultsMutex, size_t totalPorts) {
-    // Store result
-    if (result.state == core::PortState::Open) {
-        std::lock_guard lock(*resultsMutex);
-        results->push_back(result);
+    if (!run->cancelled) {
+        recordResult(*run, job, result);
+    }
+    if (--run->workers == 0) {
+        finishScan(*run);
+    }
+}
+
+asio::awaitable<std::string>
+PortScanner::readBanner(std::shared_ptr<asio::ip::tcp::socket> socket,
+                        std::chrono::milliseconds timeout) {
+    auto executor = co_await asio::this_coro::executor;
+
+    // Cancelling rather than closing keeps the connection for the next read
+    auto deadline = std::make_shared<ProbeDeadline>();
+    asio::steady_timer timer(executor);
+    timer.expires_after(timeout);
+    timer.async_wait([socket, deadline](const asio::error_code& waitEc) {
+        if (!waitEc && !deadline->finished) {
+            deadline->fired = true;
+            asio::error_code ignored;
+            socket->cancel(ignored);
+        }
+    });
+
+    std::string data(MAX_BANNER_BYTES, '\0');
+    asio::error_code ec;
+    auto bytes = co_await socket->async_read_some(asio::buffer(data),
+                                                  asio::redirect_error(asio::use_awaitable, ec));
+    deadline->finished = true;
+    timer.cancel();
+
+    data.resize(ec ? 0 : bytes);
+    co_return data;
+}
+
+std::optional<PortScanner::Job> PortScanner::takeJob(ScanRun& run) {
+    std::lock_guard lock(run.mutex);
+    if (run.ready.empty()) {
+        // Every target with ports left is at its limit; the workers already
+        // on those targets finish the scan
+        return std::nullopt;
+    }
+
+    // Round-robin over targets spreads consecutive connects across hosts
+    auto target = run.ready.front();
+    run.ready.pop_front();
+    auto& state = run.targetStates[target];
+    Job job{target, run.ports[state.nextPort], state.nextPort};
+    ++state.nextPort;
+    ++state.inFlight;
+
+    state.ready = state.nextPort < run.ports.size() && state.inFlight < run.perTargetLimit;
+    if (state.ready) {
+        run.ready.push_back(target);
+    }
+    return job;
+}
+
+void PortScanner::finishJob(ScanRun& run, size_t target) {
+    std::lock_guard lock(run.mutex);
+    auto& state = run.targetStates[target];
+    --state.inFlight;
+    if (!state.ready && state.nextPort < run.ports.size()) {
+        state.ready = true;
+        run.ready.push_back(target);
+    }
+}
+
+asio::awaitable<bool> PortScanner::acquireConnection(std::shared_ptr<ConnectionBudget> budget,
+                                                     std::shared_ptr<ScanRun> run) {
+    {
+        std::lock_guard lock(budget->mutex);
+        if (budget->inUse < budget->limit) {
+            ++budget->inUse;
+            co_return true;
+        }
+    }
+
+    auto wait = [budget, run](auto done) {
+        std::unique_lock lock(budget->mutex);
+        if (budget->inUse < budget->limit) {
+            ++budget->inUse;
+            lock.unlock();
+            done(true);
+            return;
+        }
+        // Checked under the budget's lock, so cancelRun() either sees this
+        // waiter or it sees the cancel
+        if (run->cancelled) {
+            lock.unlock();
+            done(false);
+            return;
+        }
+        budget->waiters.push_back({run->id, done});
+    };
+    co_return co_await awaitCallback<bool>(std::move(wait));
+}
+
+bool PortScanner::tryAcquireConnection(ConnectionBudget& budget) {
+    std::lock_guard lock(budget.mutex);
+    if (budget.inUse >= budget.limit) {
+        return false;
+    }
+    ++budget.inUse;
+    return true;
+}
+
+void PortScanner::releaseConnection(ConnectionBudget& budget) {
+    std::function<void(bool)> next;
+    {
+        std::lock_guard lock(budget.mutex);
+        if (!budget.waiters.empty() && budget.inUse <= budget.limit) {
+            // Hand the slot straight to the longest waiter
+            next = std::move(budget.waiters.front().resume);
+            budget.waiters.pop_front();
+        } else {
+            --budget.inUse;
+        }
+    }
+    if (next) {
+        next(true);
+    }
+}
+
+void PortScanner::dropWaiters(ConnectionBudget& budget, ScanId scan) {
+    std::vector<std::function<void(bool)>> dropped;
+    {
+        std::lock_guard lock(budget.mutex);
+        std::erase_if(budget.waiters, [&dropped, scan](ConnectionWaiter& waiter) {
+            if (waiter.scan != scan) {
+                return false;
+            }
+            dropped.push_back(std::move(waiter.resume));
+            return true;
+        });
+    }
+    for (auto& resume : dropped) {
+        resume(false);
+    }
+}
+
+void PortScanner::setLimit(ConnectionBudget& budget, size_t limit) {
+    std::vector<std::function<void(bool)>> woken;
+    {
+        std::lock_guard lock(budget.mutex);
+        budget.limit = std::max<size_t>(limit, 1);
+        // A larger limit admits waiters right away
+        while (!budget.waiters.empty() && budget.inUse < budget.limit) {
+            ++budget.inUse;
+            woken.push_back(std::move(budget.waiters.front().resume));
+            budget.waiters.pop_front();
+        }
+    }
+    for (auto& resume : woken) {
+        resume(true);
+    }
+}
+
+void PortScanner::adjustWindow(ScanRun& run, std::chrono::steady_clock::time_point sentAt,
+                               const core::PortScanResult& result, bool timedOut) {
+    size_t window = 0;
+    {
+        std::lock_guard lock(run.mutex);
+        ++run.probesSent;
+        if (!run.rate) {
+            return;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (result.state == core::PortState::Open || result.state == core::PortState::Closed) {
+            run.rate->onResponse(sentAt, now, run.config.timeout);
+        } else if (result.state == core::PortState::Filtered) {
+            run.rate->onDrop(sentAt, now);
+        }
+        window = run.rate->window();
+        if (timedOut) {
+            spdlog::debug("Port scan {}: {}:{} timed out, window {}", run.id,
+                          result.targetAddress, result.port, window);
+        }
+        run.progress.concurrency = static_cast<int>(window);
+    }
+    setLimit(*run.window, window);
+}
+
+void PortScanner::recordResult(ScanRun& run, const Job& job,
+                               const core::PortScanResult& result) {
+    core::PortScanProgress progress;
+    std::optional<core::ScanCheckpoint> checkpoint;
+    CheckpointCallback onCheckpoint;
+    {
+        std::lock_guard lock(run.mutex);
+        if (result.state == core::PortState::Open) {
+            run.results.push_back(result);
+            ++run.progress.openPorts;
+        }
+
+        // Advance the target's done mark over every contiguous recorded port
+        auto& state = run.targetStates[job.target];
+        if (job.index == state.done) {
+            ++state.done;
+            while (!state.doneAhead.empty() && *state.doneAhead.begin() == state.done) {
+                state.doneAhead.erase(state.doneAhead.begin());
+                ++state.done;
+            }
+        } else {
+            state.doneAhead.insert(job.index);
+        }
+
+        ++run.progress.scannedPorts;
+        run.progress.cancelled = run.cancelled.load();
+        auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                                     run.started).count();
+        if (elapsed > 0.0) {
+            run.progress.probesPerSecond = static_cast<double>(run.probesSent) / elapsed;
+        }
+        progress = run.progress;
+
+        auto now = std::chrono::steady_clock::now();
+        if (run.onCheckpoint && now >= run.nextCheckpoint) {
+            checkpoint = takeCheckpoint(run, false);
+            onCheckpoint = run.onCheckpoint;
+            run.nextCheckpoint = now + run.checkpointInterval;
+        }
+    }
+
+    if (checkpoint) {
+        onCheckpoint(*checkpoint);
     }
 
     // Report individual result
-    if (onResult && result.state == core::PortState::Open) {
-        onResult(result);
+    if (run.onResult &&
+        (result.state == core::PortState::Open || run.config.reportAllStates)) {
+        run.onResult(result);
     }
 
-    // Update progress
-    int completed = ++(*completedCount);
-    if (onProgress) {
-        progress->scannedPorts = completed;
-        progress->openPorts = openCount->load();
-        progress->cancelled = cancelled_.load();
-        onProgress(*progress);
+    if (run.onProgress) {
+        run.onProgress(progress);
+    }
+}
+
+core::ScanCheckpoint PortScanner::takeCheckpoint(ScanRun& run, bool finished) {
+    core::ScanCheckpoint checkpoint;
+    checkpoint.key = run.checkpointKey;
+    checkpoint.config = run.config;
+    checkpoint.targets = run.targets;
+    checkpoint.portsDone.reserve(run.targetStates.size());
+    for (const auto& state : run.targetStates) {
+        checkpoint.portsDone.push_back(state.done);
     }
+    auto firstNew = run.results.begin() + static_cast<std::ptrdiff_t>(run.checkpointedResults);
+    checkpoint.results.assign(firstNew, run.results.end());
+    run.checkpointedResults = run.results.size();
+    checkpoint.finished = finished;
+    checkpoint.updatedAt = std::chrono::system_clock::now();
+    return checkpoint;
+}
 
-    semaphore_->release();
+void PortScanner::finishScan(ScanRun& run) {
+    if (auto table = run.table.lock()) {
+        std::lock_guard lock(table->mutex);
+        table->runs.erase(run.id);
+    }
 
-    // Check if scan is complete
-    if (completed == static_cast<int>(totalPorts)) {
-        scanning_ = false;
-        spdlog::info("Port scan complete: {} open ports found", openCount->load());
-        if (onComplete) {
-            std::lock_guard lock(*resultsMutex);
-            onComplete(*results);
+    // Handlers run without the lock: they may call back into the scanner
+    std::optional<core::ScanCheckpoint> checkpoint;
+    CheckpointCallback onCheckpoint;
+    std::vector<core::PortScanResult> results;
+    {
+        std::lock_guard lock(run.mutex);
+        spdlog::info("Port scan {} {}: {} open ports found", run.id,
+                     run.cancelled ? "cancelled" : "complete", run.progress.openPorts);
+        // A cancelled scan stays resumable from here
+        if (run.onCheckpoint) {
+            checkpoint = takeCheckpoint(run, !run.cancelled);
+            onCheckpoint = run.onCheckpoint;
         }
+        results = run.results;
+    }
+
+    // The final checkpoint goes first, so a completed scan is already saved
+    if (checkpoint) {
+        onCheckpoint(*checkpoint);
+    }
+    if (run.onComplete) {
+        run.onComplete(results);
+    }
+}
+
+void PortScanner::cancelRun(ScanRun& run) {
+    if (run.cancelled.exchange(true)) {
+        return;
+    }
+    spdlog::info("Cancelling port scan {}", run.id);
+
+    // Workers parked for a slot would otherwise wait out other scans' connects
+    dropWaiters(*run.window, run.id);
+    dropWaiters(*run.budget, run.id);
+
+    // Sockets belong to their worker's strand; close them there
+    std::lock_guard lock(run.mutex);
+    for (const auto& socket : run.sockets) {
+        asio::post(socket->get_executor(), [socket]() {
+            asio::error_code ignored;
+            socket->close(ignored);
+        });
     }
 }
 
 void PortScanner::cancel() {
-    if (scanning_) {
-        spdlog::info("Cancelling port scan");
-        cancelled_ = true;
+    std::vector<std::shared_ptr<ScanRun>> runs;
+    {
+        std::lock_guard lock(scans_->mutex);
+        for (const auto& [id, run] : scans_->runs) {
+            runs.push_back(run);
+        }
+    }
+    for (const auto& run : runs) {
+        cancelRun(*run);
     }
 }
 
+std::vector<core::ScanCheckpoint> PortScanner::cancelWithCheckpoints() {
+    std::vector<std::shared_ptr<ScanRun>> runs;
+    {
+        std::lock_guard lock(scans_->mutex);
+        for (const auto& [id, run] : scans_->runs) {
+            runs.push_back(run);
+        }
+    }
+
+    // Cancelled workers record nothing more, so each snapshot is the scan's
+    // final state; the handler is dropped so winding down sends no other
+    std::vector<core::ScanCheckpoint> checkpoints;
+    for (const auto& run : runs) {
+        cancelRun(*run);
+        std::lock_guard lock(run->mutex);
+        if (run->onCheckpoint) {
+            checkpoints.push_back(takeCheckpoint(*run, false));
+            run->onCheckpoint = nullptr;
+        }
+    }
+    return checkpoints;
+}
+
+void PortScanner::cancel(ScanId scanId) {
+    std::shared_ptr<ScanRun> run;
+    {
+        std::lock_guard lock(scans_->mutex);
+        auto it = scans_->runs.find(scanId);
+        if (it == scans_->runs.end()) {
+            return;
+        }
+        run = it->second;
+    }
+    cancelRun(*run);
+}
+
 bool PortScanner::isScanning() const {
-    return scanning_.load();
+    return activeScans() > 0;
+}
+
+size_t PortScanner::activeScans() const {
+    std::lock_guard lock(scans_->mutex);
+    return scans_->runs.size();
+}
+
+void PortScanner::setConnectionBudget(size_t maxConnections) {
+    setLimit(*budget_, maxConnections);
+}
+
+size_t PortScanner::connectionBudget() const {
+    std::lock_guard lock(budget_->mutex);
+    return budget_->limit;
+}
+
+void PortScanner::setSynRateLimit(size_t packetsPerSecond) {
+    std::lock_guard lock(synMutex_);
+    synRateLimit_ = packetsPerSecond;
+    if (syn_) {
+        syn_->setRateLimit(packetsPerSecond);
+    }
+}
+
+size_t PortScanner::synRateLimit() const {
+    std::lock_guard lock(synMutex_);
+    return synRateLimit_;
+}
+
+void PortScanner::setCheckpointHandler(std::chrono::milliseconds interval,
+                                       CheckpointCallback callback) {
+    std::lock_guard lock(checkpointMutex_);
+    checkpointInterval_ = interval;
+    onCheckpoint_ = std::move(callback);
+}
+
+std::shared_ptr<SynScanner> PortScanner::synScanner() {
+    std::lock_guard lock(synMutex_);
+    if (syn_ || synUnavailable_) {
+        return syn_;
+    }
+
+    auto syn = std::make_shared<SynScanner>(context_);
+    syn->setRateLimit(synRateLimit_);
+    if (!syn->start()) {
+        spdlog::warn("SYN scan unavailable (raw sockets need CAP_NET_RAW); "
+                     "using connect scans");
+        synUnavailable_ = true;
+        return nullptr;
+    }
+    syn_ = syn;
+    return syn_;
 }
 
 } // namespace netpulse::infra
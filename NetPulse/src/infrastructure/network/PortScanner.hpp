@@ -1,13 +1,24 @@
 #pragma once
 
 #include "core/services/IPortScanner.hpp"
+#include "core/types/ScanCheckpoint.hpp"
 #include "infrastructure/network/AsioContext.hpp"
+#include "infrastructure/network/DnsCache.hpp"
+#include "infrastructure/network/ScanRateController.hpp"
+#include "infrastructure/network/SynScanner.hpp"
 
 #include <asio.hpp>
 #include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
 #include <memory>
 #include <mutex>
-#include <semaphore>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace netpulse::infra {
 
@@ -15,11 +26,62 @@ namespace netpulse::infra {
  * @brief Asynchronous TCP port scanner for network reconnaissance.
  *
  * Performs TCP connect scans on specified port ranges with configurable
- * concurrency limits. Uses Asio for non-blocking I/O operations.
+ * concurrency limits. A scan runs maxConcurrency worker coroutines that take
+ * (target, port) jobs from the scan and co_await a connect for each, so every
+ * completion starts the next connect, scanAsync() returns immediately and no
+ * thread waits on a connection. Any number of scans may run at once; each
+ * worker keeps its socket registered with the scan so cancelling closes
+ * in-flight connects instead of waiting for their timeouts.
+ *
+ * A scan may cover many targets (see core::PortScanConfig::getTargets()).
+ * Hostname targets are resolved once through the shared DnsCache before any
+ * probe starts; results keep the name as given. A name that does not resolve
+ * is not scanned: its ports leave the progress total and the name is listed
+ * in core::PortScanProgress::unresolvedTargets. Jobs rotate through the
+ * targets so consecutive connects go to different hosts, and no target has
+ * more than maxPerTarget connects in flight. Across all scans, connects also
+ * draw on a shared budget (setConnectionBudget()).
+ *
+ * With core::PortScanConfig::adaptiveRate the number of probes in flight
+ * follows a ScanRateController: it grows while answers arrive promptly and
+ * halves on timeouts and ICMP unreachables, between an eighth and four times
+ * maxConcurrency. A probe that times out is retried up to maxRetries times
+ * before the port is reported Filtered.
+ *
+ * Scans with core::ScanMode::Syn probe through one shared SynScanner instead
+ * of connecting: no socket per port and no connection budget, only a packet
+ * rate limit (setSynRateLimit()). They run no worker coroutines either; the
+ * outstanding SYNs are entries in the SynScanner's table, expired by its one
+ * timer, and each answer tops the scan's window up again. When raw sockets
+ * are unavailable such scans run as connect scans.
+ *
+ * With core::PortScanConfig::grabBanners, a worker that finds a port open
+ * hands the connected socket to a banner coroutine and carries on with the
+ * next job on a fresh socket. The banner coroutine waits for the service to
+ * speak, sends an HTTP request if it does not, and identifies the service
+ * and version with core::BannerMatcher before reporting the port. Connect
+ * scans only; SYN probes leave no connection to read from.
+ *
+ * With a checkpoint handler set (setCheckpointHandler()), every scan reports
+ * its progress periodically and once more when it ends, as a
+ * core::ScanCheckpoint holding the open ports found since the previous one.
+ * resumeAsync() continues a scan from its last checkpoint without probing
+ * the ports it records as done.
  * Implements the core::IPortScanner interface.
  */
 class PortScanner : public core::IPortScanner {
 public:
+    /**
+     * @brief Callback function type for scan checkpoints.
+     *
+     * Called from scan worker threads; it should hand slow work (such as
+     * database writes) to another thread.
+     *
+     * @param checkpoint Progress so far, with the open ports found since the
+     *        previous checkpoint of the same scan.
+     */
+    using CheckpointCallback = std::function<void(const core::ScanCheckpoint&)>;
+
     /**
      * @brief Constructs a PortScanner with the given Asio context.
      * @param context Reference to the AsioContext for async operations.
@@ -27,55 +89,289 @@ public:
     explicit PortScanner(AsioContext& context);
 
     /**
-     * @brief Destructor. Cancels any active scan and releases resources.
+     * @brief Destructor. Cancels all active scans.
      */
     ~PortScanner() override;
 
     /**
      * @brief Starts an asynchronous port scan operation.
      * @param config Scan configuration (target, ports, timeout, concurrency).
-     * @param onResult Callback invoked for each port scan result.
+     * @param onResult Callback invoked for each open port (every port with reportAllStates).
      * @param onProgress Callback invoked to report scan progress (0.0-1.0).
      * @param onComplete Callback invoked when the scan completes or is cancelled.
+     * @return Identifier for cancel(ScanId).
+     */
+    ScanId scanAsync(const core::PortScanConfig& config, ResultCallback onResult,
+                     ProgressCallback onProgress, CompletionCallback onComplete) override;
+
+    /**
+     * @brief Continues a scan from a checkpoint.
+     *
+     * Ports the checkpoint records as done are not probed again; its results
+     * are reported at completion along with the new ones. Later checkpoints
+     * keep the checkpoint's key.
+     *
+     * @param checkpoint Last checkpoint of the scan, with all of its results.
+     * @param onResult Callback invoked for each newly found open port.
+     * @param onProgress Callback invoked to report scan progress.
+     * @param onComplete Callback invoked when the scan completes or is cancelled.
+     * @return Identifier for cancel(ScanId).
+     */
+    ScanId resumeAsync(const core::ScanCheckpoint& checkpoint, ResultCallback onResult,
+                       ProgressCallback onProgress, CompletionCallback onComplete);
+
+    /**
+     * @brief Probes one TCP port from a coroutine.
+     *
+     * The connect and its timeout run on the coroutine's executor; run it on
+     * a strand (or a PerThread context).
+     *
+     * @param address Target IP address.
+     * @param port Port to connect to.
+     * @param timeout Time to wait before reporting the port Filtered.
+     * @return Awaitable yielding Open, Closed (refused or invalid address) or Filtered.
      */
-    void scanAsync(const core::PortScanConfig& config, ResultCallback onResult,
-                   ProgressCallback onProgress, CompletionCallback onComplete) override;
+    asio::awaitable<core::PortScanResult> connectProbe(std::string address, uint16_t port,
+                                                       std::chrono::milliseconds timeout);
 
     /**
-     * @brief Cancels the currently running scan.
+     * @brief Cancels every running scan.
      *
-     * Sets the cancelled flag and stops new port scans from starting.
-     * In-progress connections will complete or timeout.
+     * No new connects start and in-flight sockets are closed; each scan's
+     * completion callback then receives its partial results.
      */
     void cancel() override;
 
     /**
-     * @brief Checks if a scan is currently in progress.
+     * @brief Cancels one scan, as cancel() does for all of them.
+     * @param scanId Identifier returned by scanAsync().
+     */
+    void cancel(ScanId scanId) override;
+
+    /**
+     * @brief Cancels every scan and returns their final checkpoints at once.
+     *
+     * For shutdown: cancel() leaves the final checkpoints to the workers as
+     * they wind down, which needs a running io_context. Here they are taken
+     * on the calling thread instead, and the handler receives nothing more
+     * from these scans.
+     *
+     * @return Final checkpoint of each scan that had a checkpoint handler.
+     */
+    std::vector<core::ScanCheckpoint> cancelWithCheckpoints();
+
+    /**
+     * @brief Checks if any scan is currently in progress.
      * @return True if scanning, false otherwise.
      */
     bool isScanning() const override;
 
+    /**
+     * @brief Returns the number of scans in progress.
+     * @return Active scan count.
+     */
+    size_t activeScans() const;
+
+    /**
+     * @brief Limits connects in flight across all scans.
+     *
+     * Workers beyond the budget wait for a slot instead of connecting.
+     *
+     * @param maxConnections Maximum concurrent connects (at least 1).
+     */
+    void setConnectionBudget(size_t maxConnections);
+
+    /**
+     * @brief Returns the connect budget shared by all scans.
+     * @return Maximum concurrent connects.
+     */
+    size_t connectionBudget() const;
+
+    /**
+     * @brief Limits SYN probes sent per second across SYN-mode scans.
+     * @param packetsPerSecond Send rate; 0 sends without pacing.
+     */
+    void setSynRateLimit(size_t packetsPerSecond);
+
+    /**
+     * @brief Returns the SYN send rate limit.
+     * @return Packets per second (0 = unlimited).
+     */
+    size_t synRateLimit() const;
+
+    /**
+     * @brief Reports the progress of scans started from now on.
+     * @param interval Time between checkpoints of a scan; a final one is sent when it ends.
+     * @param callback Receives each checkpoint; null stops checkpointing.
+     */
+    void setCheckpointHandler(std::chrono::milliseconds interval, CheckpointCallback callback);
+
+    static constexpr size_t DEFAULT_CONNECTION_BUDGET = 512;
+
+    /// Adaptive scans may grow to this multiple of maxConcurrency...
+    static constexpr size_t ADAPTIVE_GROWTH = 4;
+
+    /// ...and shrink to this fraction of it
+    static constexpr size_t ADAPTIVE_FLOOR_DIVISOR = 8;
+
+    /// Upper bound on SYN probes one scan keeps outstanding
+    static constexpr size_t MAX_SYN_OUTSTANDING = 65536;
+
+    /// Bytes read from a service when grabbing its banner
+    static constexpr size_t MAX_BANNER_BYTES = 512;
+
+    /// Banner reads one scan runs at once; open ports beyond it are reported unread
+    static constexpr size_t MAX_BANNER_GRABS = 256;
+
 private:
-    struct ScanState {
-        std::shared_ptr<asio::ip::tcp::socket> socket;
-        std::shared_ptr<asio::steady_timer> timer;
-        core::PortScanResult result;
-        std::atomic<bool> completed{false};
+    struct ScanTable;
+
+    // A parked acquire; resumed with true once it holds a slot, or with
+    // false when its scan is cancelled first
+    struct ConnectionWaiter {
+        ScanId scan{0};
+        std::function<void(bool)> resume;
+    };
+
+    // Connect slots shared by every scan; waiters are resumed in FIFO order
+    struct ConnectionBudget {
+        mutable std::mutex mutex;
+        size_t limit{DEFAULT_CONNECTION_BUDGET};
+        size_t inUse{0};
+        std::deque<ConnectionWaiter> waiters;
+    };
+
+    // Per-target job state, guarded by ScanRun::mutex
+    struct TargetState {
+        size_t nextPort{0};
+        size_t inFlight{0};
+        bool ready{false};           // Queued in ScanRun::ready
+        size_t done{0};              // Ports [0, done) have been recorded
+        std::set<size_t> doneAhead;  // Recorded ports past done, finished out of order
+    };
+
+    struct Job {
+        size_t target{0};
+        uint16_t port{0};
+        size_t index{0}; // Position in ScanRun::ports
+    };
+
+    // State shared by the worker coroutines of one scan
+    struct ScanRun {
+        ScanId id{0};
+        core::PortScanConfig config;
+        std::vector<std::string> targets;
+        std::vector<std::string> addresses; // Numeric address per target; empty if unresolved
+        size_t unresolvedLookups{0};       // Hostname lookups still running, under mutex
+        std::vector<uint16_t> ports;
+        size_t perTargetLimit{1};
+        size_t maxWorkers{1}; // Largest window the scan may reach
+        ResultCallback onResult;
+        ProgressCallback onProgress;
+        CompletionCallback onComplete;
+        std::weak_ptr<ScanTable> table;
+        std::shared_ptr<ConnectionBudget> budget;
+        std::shared_ptr<ConnectionBudget> window; // Probes this scan may have in flight
+        std::shared_ptr<SynScanner> syn;          // Set for SYN-mode scans
+        std::chrono::steady_clock::time_point started;
+        std::atomic<size_t> workers{0}; // Workers, banner grabs and SYN probes still running
+        std::atomic<size_t> bannerGrabs{0};
+        std::atomic<bool> cancelled{false};
+
+        std::mutex mutex; // Guards jobs, progress, results and sockets
+        std::vector<TargetState> targetStates;
+        std::deque<size_t> ready; // Targets with ports left and room for another connect
+        core::PortScanProgress progress;
+        std::vector<core::PortScanResult> results;
+        std::vector<std::shared_ptr<asio::ip::tcp::socket>> sockets; // Workers' and grabs'
+        std::optional<ScanRateController> rate; // Sizes window; set for adaptive scans
+        size_t probesSent{0};
+
+        std::string checkpointKey;
+        CheckpointCallback onCheckpoint;
+        std::chrono::milliseconds checkpointInterval{0};
+        std::chrono::steady_clock::time_point nextCheckpoint;
+        size_t checkpointedResults{0}; // Leading results already sent in a checkpoint
     };
 
-    void finishPortScan(const core::PortScanResult& result, ResultCallback onResult,
-                        ProgressCallback onProgress, CompletionCallback onComplete,
-                        std::shared_ptr<core::PortScanProgress> progress,
-                        std::shared_ptr<std::vector<core::PortScanResult>> results,
-                        std::shared_ptr<std::atomic<int>> completedCount,
-                        std::shared_ptr<std::atomic<int>> openCount,
-                        std::shared_ptr<std::mutex> resultsMutex, size_t totalPorts);
+    // Scans in progress; outlives the scanner while workers finish
+    struct ScanTable {
+        mutable std::mutex mutex;
+        std::unordered_map<ScanId, std::shared_ptr<ScanRun>> runs;
+    };
+
+    ScanId startScan(core::ScanCheckpoint checkpoint, ResultCallback onResult,
+                     ProgressCallback onProgress, CompletionCallback onComplete);
+
+    // Connect on a caller-owned socket, so a cancelled scan can close it;
+    // keepOpen leaves an open port's connection up for a banner grab
+    static asio::awaitable<core::PortScanResult>
+    probe(std::shared_ptr<asio::ip::tcp::socket> socket, std::string address, uint16_t port,
+          std::chrono::milliseconds timeout, bool keepOpen = false);
+
+    // Resolve hostname targets through the DNS cache, then start the workers
+    static void resolveTargets(AsioContext& context, const std::shared_ptr<ScanRun>& run);
+    static void onTargetResolved(AsioContext& context, const std::shared_ptr<ScanRun>& run,
+                                 size_t target, const asio::error_code& ec,
+                                 const DnsCache::Addresses& addresses);
+    static void startWorkers(AsioContext& context, const std::shared_ptr<ScanRun>& run);
+
+    // Probe jobs until none are left or the scan is cancelled
+    static asio::awaitable<void> scanWorker(std::shared_ptr<ScanRun> run);
+
+    // Send SYN probes while the scan's window has room; answers call it again
+    static void pumpSyn(const std::shared_ptr<ScanRun>& run);
+    static void sendSyn(const std::shared_ptr<ScanRun>& run, Job job, int attempt);
+    static void onSynResult(const std::shared_ptr<ScanRun>& run, Job job, int attempt,
+                            std::chrono::steady_clock::time_point sentAt,
+                            core::PortScanResult result);
+
+    // Identify the service on a connected socket, then report the port
+    static asio::awaitable<void> grabBanner(std::shared_ptr<ScanRun> run,
+                                            std::shared_ptr<asio::ip::tcp::socket> socket,
+                                            Job job, core::PortScanResult result);
+
+    // One read, cut short by the socket's cancellation at the deadline
+    static asio::awaitable<std::string>
+    readBanner(std::shared_ptr<asio::ip::tcp::socket> socket, std::chrono::milliseconds timeout);
+
+    static std::optional<Job> takeJob(ScanRun& run);
+    static void finishJob(ScanRun& run, size_t target);
+    // False if the scan was cancelled while waiting; no slot is held then
+    static asio::awaitable<bool> acquireConnection(std::shared_ptr<ConnectionBudget> budget,
+                                                   std::shared_ptr<ScanRun> run);
+    static bool tryAcquireConnection(ConnectionBudget& budget);
+    static void releaseConnection(ConnectionBudget& budget);
+    static void dropWaiters(ConnectionBudget& budget, ScanId scan);
+    static void setLimit(ConnectionBudget& budget, size_t limit);
+
+    // Feed one probe's outcome to the scan's rate controller
+    static void adjustWindow(ScanRun& run, std::chrono::steady_clock::time_point sentAt,
+                             const core::PortScanResult& result, bool timedOut);
+
+    static void recordResult(ScanRun& run, const Job& job, const core::PortScanResult& result);
+
+    // Snapshot for the checkpoint handler; requires ScanRun::mutex
+    static core::ScanCheckpoint takeCheckpoint(ScanRun& run, bool finished);
+    static void finishScan(ScanRun& run);
+    static void cancelRun(ScanRun& run);
+
+    // Starts the SYN engine on first use; null if raw sockets are unavailable
+    std::shared_ptr<SynScanner> synScanner();
 
     AsioContext& context_;
-    std::atomic<bool> scanning_{false};
-    std::atomic<bool> cancelled_{false};
-    std::unique_ptr<std::counting_semaphore<>> semaphore_;
-    mutable std::mutex mutex_;
+    std::shared_ptr<ScanTable> scans_;
+    std::shared_ptr<ConnectionBudget> budget_;
+    std::atomic<ScanId> nextScanId_{1};
+
+    mutable std::mutex synMutex_;
+    std::shared_ptr<SynScanner> syn_;
+    bool synUnavailable_{false};
+    size_t synRateLimit_{SynScanner::DEFAULT_RATE_LIMIT};
+
+    mutable std::mutex checkpointMutex_;
+    std::chrono::milliseconds checkpointInterval_{0};
+    CheckpointCallback onCheckpoint_;
 };
 
 } // namespace netpulse::infra
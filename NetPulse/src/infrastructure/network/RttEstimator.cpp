@@ -0,0 +1,50 @@
+#include "infrastructure/network/RttEstimator.hpp"
+
+#include <algorithm>
+
+namespace netpulse::infra {
+
+RttEstimator::RttEstimator(std::chrono::milliseconds floor, std::chrono::milliseconds ceiling)
+    : floor_(floor), ceiling_(std::max(ceiling, floor)) {}
+
+void RttEstimator::addSample(std::chrono::microseconds rtt) {
+    rtt = std::max(rtt, std::chrono::microseconds(0));
+
+    if (!hasSamples_) {
+        srtt_ = rtt;
+        rttvar_ = rtt / 2;
+        hasSamples_ = true;
+    } else {
+        // RTTVAR <- 3/4 RTTVAR + 1/4 |SRTT - R'|, then SRTT <- 7/8 SRTT + 1/8 R'
+        auto delta = srtt_ > rtt ? srtt_ - rtt : rtt - srtt_;
+        rttvar_ = (rttvar_ * 3 + delta) / 4;
+        srtt_ = (srtt_ * 7 + rtt) / 8;
+    }
+    backoff_ = 0;
+}
+
+void RttEstimator::onTimeout() {
+    backoff_ = std::min(backoff_ + 1, kMaxBackoff);
+}
+
+void RttEstimator::setBounds(std::chrono::milliseconds floor, std::chrono::milliseconds ceiling) {
+    floor_ = floor;
+    ceiling_ = std::max(ceiling, floor);
+}
+
+std::chrono::milliseconds RttEstimator::timeout() const {
+    if (!hasSamples_) {
+        return ceiling_;
+    }
+
+    auto rto = srtt_ + std::max(kGranularity, rttvar_ * 4);
+    auto rounded = std::chrono::ceil<std::chrono::milliseconds>(rto);
+
+    // Double per consecutive timeout, stopping once the ceiling is reached
+    for (int i = 0; i < backoff_ && rounded < ceiling_; ++i) {
+        rounded *= 2;
+    }
+    return std::clamp(rounded, floor_, ceiling_);
+}
+
+} // namespace netpulse::infra
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace netpulse::infra {
+
+/**
+ * @brief Round-trip time estimator that sizes probe timeouts (RFC 6298).
+ *
+ * Keeps a smoothed RTT (SRTT) and RTT variation (RTTVAR) from successful
+ * probes and derives a retransmission-style timeout of SRTT + 4 * RTTVAR,
+ * clamped to a configurable floor and ceiling. Every timed-out probe doubles
+ * the timeout (exponential backoff) until the next successful sample, so a
+ * host that goes down is detected quickly without flapping a slow link.
+ *
+ * Until the first sample arrives the ceiling is used.
+ *
+ * @note Not thread-safe; callers serialize access per host.
+ */
+class RttEstimator {
+public:
+    /**
+     * @brief Constructs an estimator with the given timeout bounds.
+     * @param floor Smallest timeout ever returned.
+     * @param ceiling Largest timeout ever returned; also the initial timeout.
+     */
+    RttEstimator(std::chrono::milliseconds floor, std::chrono::milliseconds ceiling);
+
+    /**
+     * @brief Feeds a measured round-trip time and clears any backoff.
+     * @param rtt Latency of a probe that received a reply.
+     */
+    void addSample(std::chrono::microseconds rtt);
+
+    /**
+     * @brief Records an unanswered probe, doubling the next timeout.
+     */
+    void onTimeout();
+
+    /**
+     * @brief Changes the timeout bounds, keeping the RTT history.
+     * @param floor Smallest timeout ever returned.
+     * @param ceiling Largest timeout ever returned; raised to floor if smaller.
+     */
+    void setBounds(std::chrono::milliseconds floor, std::chrono::milliseconds ceiling);
+
+    /**
+     * @brief Returns the timeout to use for the next probe.
+     * @return Timeout within [floor, ceiling].
+     */
+    std::chrono::milliseconds timeout() const;
+
+    /**
+     * @brief Returns the upper timeout bound.
+     * @return The ceiling, also used before the first sample.
+     */
+    std::chrono::milliseconds ceiling() const { return ceiling_; }
+
+    /**
+     * @brief Checks whether any RTT sample has been recorded.
+     * @return True once addSample() has been called.
+     */
+    bool hasSamples() const { return hasSamples_; }
+
+    /**
+     * @brief Returns the smoothed round-trip time.
+     * @return SRTT, zero before the first sample.
+     */
+    std::chrono::microseconds srtt() const { return srtt_; }
+
+    /**
+     * @brief Returns the round-trip time variation.
+     * @return RTTVAR, zero before the first sample.
+     */
+    std::chrono::microseconds rttvar() const { return rttvar_; }
+
+    /**
+     * @brief Returns the number of consecutive timeouts since the last sample.
+     * @return Backoff exponent applied to the timeout.
+     */
+    int backoff() const { return backoff_; }
+
+private:
+    // The ICMP engine times requests out on a 10 ms wheel, so variation below
+    // that cannot be acted on (RFC 6298's clock granularity G).
+    static constexpr std::chrono::microseconds kGranularity{10000};
+    static constexpr int kMaxBackoff = 16;
+
+    std::chrono::milliseconds floor_;
+    std::chrono::milliseconds ceiling_;
+    std::chrono::microseconds srtt_{0};
+    std::chrono::microseconds rttvar_{0};
+    bool hasSamples_{false};
+    int backoff_{0};
+};
+
+} // namespace netpulse::infra
@@ -0,0 +1,40 @@
+#include "infrastructure/network/ScanRateController.hpp"
+
+#include <algorithm>
+
+namespace netpulse::infra {
+
+ScanRateController::ScanRateController(size_t initial, size_t minimum, size_t maximum)
+    : minimum_(std::max<size_t>(minimum, 1)), maximum_(std::max(maximum, minimum_)),
+      window_(static_cast<double>(std::clamp(initial, minimum_, maximum_))),
+      threshold_(static_cast<double>(maximum_)) {}
+
+void ScanRateController::onResponse(Clock::time_point sentAt, Clock::time_point now,
+                                    std::chrono::milliseconds timeout) {
+    if ((now - sentAt) * 2 > timeout) {
+        return; // Answered, but too slowly to call the path uncongested
+    }
+
+    if (window_ < threshold_) {
+        window_ += 1.0;
+    } else {
+        window_ += 1.0 / window_;
+    }
+    window_ = std::min(window_, static_cast<double>(maximum_));
+}
+
+void ScanRateController::onDrop(Clock::time_point sentAt, Clock::time_point now) {
+    if (sentAt < lastDecrease_) {
+        return;
+    }
+
+    threshold_ = std::max(window_ / 2.0, static_cast<double>(minimum_));
+    window_ = threshold_;
+    lastDecrease_ = now;
+}
+
+size_t ScanRateController::window() const {
+    return std::clamp(static_cast<size_t>(window_), minimum_, maximum_);
+}
+
+} // namespace netpulse::infra
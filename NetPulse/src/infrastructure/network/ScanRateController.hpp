@@ -0,0 +1,76 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace netpulse::infra {
+
+/**
+ * @brief Congestion window for the probes of one port scan (AIMD).
+ *
+ * Works like TCP congestion control with probes in place of segments. The
+ * window starts at the configured concurrency and, until the first drop,
+ * grows by one per timely response (slow start). After a drop it grows by
+ * one per window's worth of timely responses (additive increase). A drop is
+ * a probe that timed out or was answered with an ICMP unreachable; it halves
+ * the window (multiplicative decrease), at most once per round: drops of
+ * probes sent before the previous decrease are part of the same congestion
+ * event and are ignored.
+ *
+ * Responses slower than half the probe timeout neither grow nor shrink the
+ * window.
+ *
+ * @note Not thread-safe; callers serialize access per scan.
+ */
+class ScanRateController {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Constructs a controller.
+     * @param initial Starting window.
+     * @param minimum Smallest window a decrease may reach (at least 1).
+     * @param maximum Largest window; raised to minimum if smaller.
+     */
+    ScanRateController(size_t initial, size_t minimum, size_t maximum);
+
+    /**
+     * @brief Records a probe that was answered (Open or Closed).
+     * @param sentAt When the probe was sent.
+     * @param now When the answer arrived.
+     * @param timeout The probe's timeout.
+     */
+    void onResponse(Clock::time_point sentAt, Clock::time_point now,
+                    std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Records a probe that timed out or hit an ICMP unreachable.
+     * @param sentAt When the probe was sent.
+     * @param now When the drop was detected.
+     */
+    void onDrop(Clock::time_point sentAt, Clock::time_point now);
+
+    /**
+     * @brief Returns the number of probes that may be in flight.
+     * @return Window within [minimum, maximum].
+     */
+    size_t window() const;
+
+    /**
+     * @brief Returns the slow start threshold.
+     * @return Window size at which growth turns additive.
+     */
+    double threshold() const { return threshold_; }
+
+    size_t minimum() const { return minimum_; }
+    size_t maximum() const { return maximum_; }
+
+private:
+    size_t minimum_;
+    size_t maximum_;
+    double window_;
+    double threshold_;
+    Clock::time_point lastDecrease_{};
+};
+
+} // namespace netpulse::infra
@@ -3,16 +3,20 @@
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
-#include <unordered_map>
 
 namespace netpulse::infra {
 
 ScheduledPortScanner::ScheduledPortScanner(AsioContext& context, core::IPortScanner& portScanner)
-    : context_(context), portScanner_(portScanner) {
+    : context_(context), portScanner_(portScanner), lifetime_(std::make_shared<Lifetime>()) {
+    lifetime_->scanner = this;
     spdlog::debug("ScheduledPortScanner initialized");
 }
 
 ScheduledPortScanner::~ScheduledPortScanner() {
+    {
+        std::lock_guard lock(lifetime_->mutex);
+        lifetime_->scanner = nullptr;
+    }
     stop();
 }
 
@@ -29,7 +33,6 @@ void ScheduledPortScanner::addSchedule(const core::ScheduledScanConfig& config)
         item->config.id = generateId();
     }
     item->config.createdAt = std::chrono::system_clock::now();
-    item->timer = std::make_shared<asio::steady_timer>(context_.getContext());
     item->active = config.enabled && running_;
 
     schedules_[item->config.id] = item;
@@ -38,7 +41,7 @@ void ScheduledPortScanner::addSchedule(const core::ScheduledScanConfig& config)
                  item->config.id, item->config.targetAddress, item->config.intervalMinutes);
 
     if (running_ && item->config.enabled) {
-        scheduleNextScan(item);
+        scheduleScans(item);
     }
 }
 
@@ -53,9 +56,7 @@ void ScheduledPortScanner::updateSchedule(const core::ScheduledScanConfig& confi
 
     auto& item = it->second;
     item->active = false;
-    if (item->timer) {
-        item->timer->cancel();
-    }
+    cancelScans(*item);
 
     item->config = config;
     item->active = config.enabled && running_;
@@ -63,7 +64,7 @@ void ScheduledPortScanner::updateSchedule(const core::ScheduledScanConfig& confi
     spdlog::info("Updated scheduled scan: {} (ID: {})", config.name, config.id);
 
     if (running_ && item->config.enabled) {
-        scheduleNextScan(item);
+        scheduleScans(item);
     }
 }
 
@@ -76,8 +77,10 @@ void ScheduledPortScanner::removeSchedule(int64_t scheduleId) {
     }
 
     it->second->active = false;
-    if (it->second->timer) {
-        it->second->timer->cancel();
+    cancelScans(*it->second);
+    if (it->second->queued) {
+        it->second->queued = false;
+        std::erase(pending_, it->second);
     }
     schedules_.erase(it);
 
@@ -97,12 +100,10 @@ void ScheduledPortScanner::enableSchedule(int64_t scheduleId, bool enabled) {
 
     if (!enabled) {
         item->active = false;
-        if (item->timer) {
-            item->timer->cancel();
-        }
+        cancelScans(*item);
     } else if (running_) {
         item->active = true;
-        scheduleNextScan(item);
+        scheduleScans(item);
     }
 
     spdlog::info("Schedule {} {}", scheduleId, enabled ? "enabled" : "disabled");
@@ -154,7 +155,7 @@ void ScheduledPortScanner::start() {
     for (auto& [id, item] : schedules_) {
         if (item->config.enabled) {
             item->active = true;
-            scheduleNextScan(item);
+            scheduleScans(item);
         }
     }
 
@@ -169,10 +170,11 @@ void ScheduledPortScanner::stop() {
     std::lock_guard lock(mutex_);
     for (auto& [id, item] : schedules_) {
         item->active = false;
-        if (item->timer) {
-            item->timer->cancel();
-        }
+        item->queued = false;
+        cancelScans(*item);
     }
+    // Scans already started finish on their own
+    pending_.clear();
 
     spdlog::info("ScheduledPortScanner stopped");
 }
@@ -191,80 +193,235 @@ void ScheduledPortScanner::setDiffCallback(DiffCallback callback) {
     diffCallback_ = std::move(callback);
 }
 
-void ScheduledPortScanner::scheduleNextScan(std::shared_ptr<ScheduledItem> item) {
+void ScheduledPortScanner::scheduleScans(const std::shared_ptr<ScheduledItem>& item) {
     if (!item->active || !running_) {
         return;
     }
 
-    auto nextRun = std::chrono::minutes(item->config.intervalMinutes);
-    item->config.nextRunAt = std::chrono::system_clock::now() + nextRun;
+    // Re-enabling or updating a schedule restarts its cadence
+    cancelScans(*item);
 
-    item->timer->expires_after(nextRun);
-    item->timer->async_wait([this, item](const asio::error_code& ec) {
-        if (ec || !item->active || !running_) {
-            return;
-        }
+    auto interval = std::chrono::minutes(std::max(item->config.intervalMinutes, 1));
+    item->config.nextRunAt = std::chrono::system_clock::now() + interval;
 
-        executeScan(item);
-        scheduleNextScan(item);
-    });
+    item->job = context_.timerWheel().scheduleEvery(
+        interval,
+        [lifetime = lifetime_, item, interval]() {
+            std::lock_guard guard(lifetime->mutex);
+            auto* self = lifetime->scanner;
+            if (!self || !item->active || !self->running_) {
+                return;
+            }
+
+            {
+                std::lock_guard lock(self->mutex_);
+                item->config.nextRunAt = std::chrono::system_clock::now() + interval;
+            }
+
+            // Keep scan start-up and its logging off the wheel's batch
+            self->context_.post([lifetime, item]() {
+                std::lock_guard guard(lifetime->mutex);
+                auto* self = lifetime->scanner;
+                if (self && item->active && self->running_) {
+                    self->executeScan(item);
+                }
+            });
+        },
+        interval);
 
     spdlog::debug("Next scan for {} scheduled in {} minutes", item->config.name,
                   item->config.intervalMinutes);
 }
 
+void ScheduledPortScanner::cancelScans(ScheduledItem& item) {
+    if (item.job != 0) {
+        context_.timerWheel().cancel(item.job);
+        item.job = 0;
+    }
+}
+
 void ScheduledPortScanner::executeScan(std::shared_ptr<ScheduledItem> item) {
-    if (portScanner_.isScanning()) {
-        spdlog::warn("Port scanner is busy, skipping scheduled scan: {}", item->config.name);
-        return;
+    {
+        std::lock_guard lock(mutex_);
+        if (item->queued || item->scanning) {
+            spdlog::debug("Scheduled scan {} is already pending", item->config.name);
+            return;
+        }
+        item->queued = true;
+        pending_.push_back(std::move(item));
     }
+    startQueuedScans();
+}
 
-    auto scanConfig = item->config.toPortScanConfig();
-    auto scheduleId = item->config.id;
-    auto targetAddress = item->config.targetAddress;
+void ScheduledPortScanner::startQueuedScans() {
+    std::vector<std::shared_ptr<ScheduledItem>> ready;
+    {
+        std::lock_guard lock(mutex_);
+        while (runningScans_ < MAX_CONCURRENT_SCANS && !pending_.empty()) {
+            auto item = std::move(pending_.front());
+            pending_.pop_front();
+            item->queued = false;
+            item->scanning = true;
+            ++runningScans_;
+            ready.push_back(std::move(item));
+        }
+        if (!pending_.empty()) {
+            spdlog::debug("{} scheduled scans waiting for a free slot", pending_.size());
+        }
+    }
 
-    spdlog::info("Starting scheduled scan: {} for {}", item->config.name, targetAddress);
+    for (auto& item : ready) {
+        launchScan(std::move(item));
+    }
+}
 
-    auto results = std::make_shared<std::vector<core::PortScanResult>>();
+void ScheduledPortScanner::launchScan(std::shared_ptr<ScheduledItem> item) {
+    auto scanConfig = item->config.toPortScanConfig();
+    scanConfig.reportAllStates = true;
+
+    spdlog::info("Starting scheduled scan: {} for {}", item->config.name,
+                 item->config.targetAddress);
+
+    // Results stream straight into per-target bitmaps; only open ports are
+    // kept as full results
+    struct Collector {
+        std::mutex mutex;
+        std::vector<core::PortScanResult> open;
+        std::map<std::string, core::PortStateBitmap> states;
+    };
+    auto collector = std::make_shared<Collector>();
+    // A run that ends with fewer known ports was cancelled or cut short
+    auto expected = scanConfig.getTargets().size() * scanConfig.getPortsToScan().size();
 
     portScanner_.scanAsync(
         scanConfig,
-        [results](const core::PortScanResult& result) {
-            results->push_back(result);
+        [collector](const core::PortScanResult& result) {
+            std::lock_guard lock(collector->mutex);
+            collector->states[result.targetAddress].set(result.port, result.state);
+            if (result.state == core::PortState::Open) {
+                collector->open.push_back(result);
+            }
         },
         [](const core::PortScanProgress& /*progress*/) {},
-        [this, item, scheduleId, targetAddress, results](const std::vector<core::PortScanResult>&) {
-            std::lock_guard lock(mutex_);
+        [lifetime = lifetime_, item, collector,
+         expected](const std::vector<core::PortScanResult>&) {
+            std::lock_guard guard(lifetime->mutex);
+            auto* self = lifetime->scanner;
+            if (!self) {
+                return;
+            }
 
-            item->config.lastRunAt = std::chrono::system_clock::now();
+            std::vector<core::PortScanResult> open;
+            std::map<std::string, core::PortStateBitmap> states;
+            {
+                std::lock_guard lock(collector->mutex);
+                open = std::move(collector->open);
+                states = std::move(collector->states);
+            }
+            size_t probed = 0;
+            for (const auto& [target, bitmap] : states) {
+                probed += bitmap.knownCount();
+            }
+            self->finishScan(item, std::move(open), std::move(states), probed >= expected);
+            self->startQueuedScans();
+        });
+}
 
-            auto previousResults = item->lastResults;
-            item->lastResults = *results;
+void ScheduledPortScanner::finishScan(const std::shared_ptr<ScheduledItem>& item,
+                                      std::vector<core::PortScanResult> results,
+                                      std::map<std::string, core::PortStateBitmap> states,
+                                      bool complete) {
+    std::lock_guard lock(mutex_);
+    item->scanning = false;
+    --runningScans_;
 
-            spdlog::info("Scheduled scan complete: {} - {} ports scanned", item->config.name,
-                         results->size());
+    auto previousTime = item->config.lastRunAt.value_or(std::chrono::system_clock::time_point{});
+    auto currentTime = std::chrono::system_clock::now();
+    item->config.lastRunAt = currentTime;
 
-            if (scanCompleteCallback_) {
-                scanCompleteCallback_(scheduleId, *results);
-            }
+    size_t scanned = 0;
+    for (const auto& [target, bitmap] : states) {
+        scanned += bitmap.knownCount();
+    }
+    spdlog::info("Scheduled scan {}: {} - {} ports scanned",
+                 complete ? "complete" : "incomplete", item->config.name, scanned);
+
+    auto previousStates = item->lastStates;
+    auto previousResults = item->lastResults;
+    if (complete) {
+        item->lastStates = std::move(states);
+        item->lastResults = std::move(results);
+    } else if (!previousStates.empty()) {
+        // A cancelled or partial run only moves the ports it probed; the rest
+        // keep their baseline state instead of turning Unknown
+        std::erase_if(item->lastResults, [&states](const core::PortScanResult& result) {
+            auto probed = states.find(result.targetAddress);
+            return probed != states.end() &&
+                   probed->second.get(result.port) != core::PortState::Unknown;
+        });
+        item->lastResults.insert(item->lastResults.end(),
+                                 std::make_move_iterator(results.begin()),
+                                 std::make_move_iterator(results.end()));
+        for (const auto& [target, probed] : states) {
+            item->lastStates[target].overlay(probed);
+        }
+    }
+
+    if (scanCompleteCallback_) {
+        scanCompleteCallback_(item->config.id, item->lastResults);
+    }
 
-            if (!previousResults.empty() && diffCallback_) {
-                auto diff = computeDiff(targetAddress, previousResults, *results);
-                if (diff.hasChanges()) {
-                    spdlog::info("Detected {} port changes for {}", diff.changes.size(),
-                                 targetAddress);
-                    diffCallback_(scheduleId, diff);
+    if (previousStates.empty() || !diffCallback_) {
+        return;
+    }
+
+    // Diff each target separately when the schedule covers a range; a target
+    // missing from one scan diffs against an all-Unknown bitmap
+    static const core::PortStateBitmap unscanned;
+    auto diffTarget = [&](const std::string& targetAddress, const core::PortStateBitmap& before,
+                          const core::PortStateBitmap& after) {
+        auto diff = computeDiff(targetAddress, before, after);
+        diff.previousScanTime = previousTime;
+        diff.currentScanTime = currentTime;
+
+        // Prefer the names banner grabs gave the port, newest first
+        for (auto& change : diff.changes) {
+            for (const auto* source : {&item->lastResults, &previousResults}) {
+                auto it = std::find_if(source->rbegin(), source->rend(), [&](const auto& result) {
+                    return result.port == change.port && result.targetAddress == targetAddress &&
+                           !result.serviceName.empty();
+                });
+                if (it != source->rend()) {
+                    change.serviceName = it->serviceName;
+                    break;
                 }
             }
-        });
+        }
+        if (diff.hasChanges()) {
+            spdlog::info("Detected {} port changes for {}", diff.changes.size(), targetAddress);
+            diffCallback_(item->config.id, diff);
+        }
+    };
+
+    for (const auto& [targetAddress, after] : item->lastStates) {
+        auto before = previousStates.find(targetAddress);
+        diffTarget(targetAddress, before != previousStates.end() ? before->second : unscanned,
+                   after);
+    }
+    for (const auto& [targetAddress, before] : previousStates) {
+        // Only a complete run can show that a target is gone
+        if (complete && !item->lastStates.contains(targetAddress)) {
+            diffTarget(targetAddress, before, unscanned);
+        }
+    }
 }
 
 core::PortScanDiff ScheduledPortScanner::computeDiff(
     const std::string& targetAddress, const std::vector<core::PortScanResult>& previous,
     const std::vector<core::PortScanResult>& current) {
 
-    core::PortScanDiff diff;
-    diff.targetAddress = targetAddress;
+    auto diff = computeDiff(targetAddress, core::PortStateBitmap::fromResults(previous),
+                            core::PortStateBitmap::fromResults(current));
     diff.totalPortsScanned = static_cast<int>(current.size());
 
     if (!previous.empty()) {
@@ -274,71 +431,49 @@ core::PortScanDiff ScheduledPortScanner::computeDiff(
         diff.currentScanTime = current.front().scanTimestamp;
     }
 
-    std::unordered_map<uint16_t, core::PortScanResult> prevMap;
-    for (const auto& result : previous) {
-        prevMap[result.port] = result;
-        if (result.state == core::PortState::Open) {
-            diff.openPortsBefore++;
-        }
-    }
-
-    std::unordered_map<uint16_t, core::PortScanResult> currMap;
-    for (const auto& result : current) {
-        currMap[result.port] = result;
-        if (result.state == core::PortState::Open) {
-            diff.openPortsAfter++;
-        }
-    }
-
-    for (const auto& [port, currResult] : currMap) {
-        auto prevIt = prevMap.find(port);
-        if (prevIt == prevMap.end()) {
-            if (currResult.state == core::PortState::Open) {
-                core::PortChange change;
-                change.port = port;
-                change.changeType = core::PortChangeType::NewOpen;
-                change.previousState = core::PortState::Unknown;
-                change.currentState = currResult.state;
-                change.serviceName = currResult.serviceName;
-                diff.changes.push_back(change);
-            }
-        } else if (prevIt->second.state != currResult.state) {
-            core::PortChange change;
-            change.port = port;
-            change.previousState = prevIt->second.state;
-            change.currentState = currResult.state;
-            change.serviceName = currResult.serviceName;
-
-            if (currResult.state == core::PortState::Open &&
-                prevIt->second.state != core::PortState::Open) {
-                change.changeType = core::PortChangeType::NewOpen;
-            } else if (currResult.state != core::PortState::Open &&
-                       prevIt->second.state == core::PortState::Open) {
-                change.changeType = core::PortChangeType::NewClosed;
-            } else {
-                change.changeType = core::PortChangeType::StateChanged;
-            }
-
-            diff.changes.push_back(change);
+    // Prefer the service names the results carry
+    for (auto& change : diff.changes) {
+        const auto& source = change.currentState == core::PortState::Unknown ? previous : current;
+        auto it = std::find_if(source.rbegin(), source.rend(), [&change](const auto& result) {
+            return result.port == change.port;
+        });
+        if (it != source.rend()) {
+            change.serviceName = it->serviceName;
         }
     }
+    return diff;
+}
 
-    for (const auto& [port, prevResult] : prevMap) {
-        if (currMap.find(port) == currMap.end()) {
-            if (prevResult.state == core::PortState::Open) {
-                core::PortChange change;
-                change.port = port;
-                change.changeType = core::PortChangeType::NewClosed;
-                change.previousState = prevResult.state;
-                change.currentState = core::PortState::Unknown;
-                change.serviceName = prevResult.serviceName;
-                diff.changes.push_back(change);
-            }
+core::PortScanDiff ScheduledPortScanner::computeDiff(const std::string& targetAddress,
+                                                     const core::PortStateBitmap& previous,
+                                                     const core::PortStateBitmap& current) {
+    core::PortScanDiff diff;
+    diff.targetAddress = targetAddress;
+    diff.totalPortsScanned = static_cast<int>(current.knownCount());
+    diff.openPortsBefore = static_cast<int>(previous.count(core::PortState::Open));
+    diff.openPortsAfter = static_cast<int>(current.count(core::PortState::Open));
+
+    previous.forEachDifference(current, [&diff](uint16_t port, core::PortState before,
+                                                core::PortState after) {
+        bool wasOpen = before == core::PortState::Open;
+        bool isOpen = after == core::PortState::Open;
+
+        core::PortChange change;
+        change.port = port;
+        change.previousState = before;
+        change.currentState = after;
+        if (isOpen) {
+            change.changeType = core::PortChangeType::NewOpen;
+        } else if (wasOpen) {
+            change.changeType = core::PortChangeType::NewClosed;
+        } else if (before != core::PortState::Unknown && after != core::PortState::Unknown) {
+            change.changeType = core::PortChangeType::StateChanged;
+        } else {
+            return; // Scanned only once and never open
         }
-    }
-
-    std::sort(diff.changes.begin(), diff.changes.end(),
-              [](const core::PortChange& a, const core::PortChange& b) { return a.port < b.port; });
+        change.serviceName = core::ServiceDetector::detectService(port);
+        diff.changes.push_back(std::move(change));
+    });
 
     return diff;
 }
@@ -349,10 +484,21 @@ void ScheduledPortScanner::setLastScanResults(int64_t scheduleId,
 
     auto it = schedules_.find(scheduleId);
     if (it != schedules_.end()) {
+        // Rebuild the diff baseline from the results
+        std::map<std::string, core::PortStateBitmap> states;
+        for (const auto& result : results) {
+            states[result.targetAddress].set(result.port, result.state);
+        }
+        it->second->lastStates = std::move(states);
         it->second->lastResults = std::move(results);
     }
 }
 
+size_t ScheduledPortScanner::pendingScans() const {
+    std::lock_guard lock(mutex_);
+    return pending_.size();
+}
+
 std::vector<core::PortScanResult> ScheduledPortScanner::getLastScanResults(int64_t scheduleId) const {
     std::lock_guard lock(mutex_);
 
@@ -2,10 +2,13 @@
 
 #include "core/services/IPortScanner.hpp"
 #include "core/services/IScheduledPortScanner.hpp"
+#include "core/types/PortStateBitmap.hpp"
 #include "infrastructure/network/AsioContext.hpp"
+#include "infrastructure/network/TimerWheel.hpp"
 
 #include <asio.hpp>
 #include <atomic>
+#include <deque>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -18,12 +21,22 @@ namespace netpulse::infra {
  * Provides automated periodic port scanning with the ability to detect
  * changes between scans. Supports multiple schedules with independent
  * intervals and configurations. Implements core::IScheduledPortScanner.
+ *
+ * Due scans wait in a FIFO queue and up to MAX_CONCURRENT_SCANS run at
+ * once, so overlapping schedules are delayed rather than dropped. A schedule
+ * that is already queued or running is not queued a second time.
+ *
+ * Scans stream every port's state (not only open ports) into one
+ * core::PortStateBitmap per target, which is kept as the baseline for the
+ * next run; diffs are a XOR of the two bitmaps.
  */
 class ScheduledPortScanner : public core::IScheduledPortScanner {
 public:
+    static constexpr size_t MAX_CONCURRENT_SCANS = 4;
+
     /**
      * @brief Constructs a ScheduledPortScanner.
-     * @param context Reference to the AsioContext for timer management.
+     * @param context Reference to the AsioContext whose timer wheel drives schedules.
      * @param portScanner Reference to the port scanner to use for scans.
      */
     ScheduledPortScanner(AsioContext& context, core::IPortScanner& portScanner);
@@ -116,6 +129,22 @@ public:
                                     const std::vector<core::PortScanResult>& previous,
                                     const std::vector<core::PortScanResult>& current) override;
 
+    /**
+     * @brief Computes the difference between two scans of one target.
+     *
+     * Ports scanned in only one of the scans count as changed only if they
+     * were open there. Service names come from core::ServiceDetector;
+     * scheduled scans replace them with the names their results carry.
+     *
+     * @param targetAddress The target address for the diff.
+     * @param previous Port states from the previous scan.
+     * @param current Port states from the current scan.
+     * @return PortScanDiff describing the changes, without scan times.
+     */
+    static core::PortScanDiff computeDiff(const std::string& targetAddress,
+                                          const core::PortStateBitmap& previous,
+                                          const core::PortStateBitmap& current);
+
     /**
      * @brief Stores the last scan results for a schedule.
      * @param scheduleId ID of the schedule.
@@ -130,27 +159,55 @@ public:
      */
     std::vector<core::PortScanResult> getLastScanResults(int64_t scheduleId) const;
 
+    /**
+     * @brief Returns the number of scans waiting for a free slot.
+     * @return Queued scan count.
+     */
+    size_t pendingScans() const;
+
 private:
     struct ScheduledItem {
         core::ScheduledScanConfig config;
-        std::shared_ptr<asio::steady_timer> timer;
-        std::vector<core::PortScanResult> lastResults;
+        TimerWheel::JobId job{0};
+        std::vector<core::PortScanResult> lastResults;          // Open ports
+        std::map<std::string, core::PortStateBitmap> lastStates; // Every port, per target
         std::atomic<bool> active{true};
+        bool queued{false};   // Guarded by mutex_
+        bool scanning{false}; // Guarded by mutex_
     };
 
-    void scheduleNextScan(std::shared_ptr<ScheduledItem> item);
+    void scheduleScans(const std::shared_ptr<ScheduledItem>& item);
+    void cancelScans(ScheduledItem& item);
     void executeScan(std::shared_ptr<ScheduledItem> item);
+    void startQueuedScans();
+    void launchScan(std::shared_ptr<ScheduledItem> item);
+    void finishScan(const std::shared_ptr<ScheduledItem>& item,
+                    std::vector<core::PortScanResult> results,
+                    std::map<std::string, core::PortStateBitmap> states, bool complete);
     int64_t generateId();
 
+    // Reached by wheel jobs and scan callbacks instead of a raw this, since
+    // they can still run after the scanner is destroyed. The destructor
+    // clears scanner, waiting for a callback that is already using it;
+    // recursive because a callback may start a scan that completes inline.
+    struct Lifetime {
+        std::recursive_mutex mutex;
+        ScheduledPortScanner* scanner{nullptr};
+    };
+
     AsioContext& context_;
     core::IPortScanner& portScanner_;
     std::map<int64_t, std::shared_ptr<ScheduledItem>> schedules_;
     mutable std::mutex mutex_;
     std::atomic<bool> running_{false};
     std::atomic<int64_t> nextId_{1};
+    std::deque<std::shared_ptr<ScheduledItem>> pending_; // Guarded by mutex_
+    size_t runningScans_{0};                              // Guarded by mutex_
 
     ScanCompleteCallback scanCompleteCallback_;
     DiffCallback diffCallback_;
+
+    std::shared_ptr<Lifetime> lifetime_;
 };
 
 } // namespace netpulse::infra
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "infrastructure/network/Hash.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace netpulse::infra {
+
+/**
+ * @brief Monitor registry split into independently locked shards.
+ *
+ * Entries are spread over a fixed number of shards by hashing their id, and
+ * each shard has its own reader/writer lock. Lookups only take a shared lock
+ * on one shard, and inserts or removals for different hosts rarely touch the
+ * same lock, so a bulk import from the UI or REST thread does not serialize
+ * against isMonitoring() calls or the probe path.
+ *
+ * Values are held by std::shared_ptr, so an entry returned by find() stays
+ * valid after it has been removed from the registry.
+ *
+ * @tparam Value Per-entry state type.
+ */
+template <typename Value>
+class ShardedRegistry {
+public:
+    using Key = int64_t;
+    using Pointer = std::shared_ptr<Value>;
+
+    /**
+     * @brief Constructs a registry with the given number of shards.
+     * @param shardCount Number of shards; typically the worker thread count (at least 1).
+     */
+    explicit ShardedRegistry(size_t shardCount)
+        : shards_(std::max<size_t>(shardCount, 1)) {}
+
+    ShardedRegistry(const ShardedRegistry&) = delete;
+    ShardedRegistry& operator=(const ShardedRegistry&) = delete;
+
+    /**
+     * @brief Inserts an entry, replacing any entry with the same id.
+     * @param key Entry id.
+     * @param value Entry to store.
+     * @return The replaced entry, or nullptr if there was none.
+     */
+    Pointer insertOrReplace(Key key, Pointer value) {
+        auto& shard = shardFor(key);
+        std::unique_lock lock(shard.mutex);
+        auto& slot = shard.items[key];
+        std::swap(slot, value);
+        return value;
+    }
+
+    /**
+     * @brief Removes an entry.
+     * @param key Entry id.
+     * @return The removed entry, or nullptr if there was none.
+     */
+    Pointer erase(Key key) {
+        auto& shard = shardFor(key);
+        std::unique_lock lock(shard.mutex);
+        auto it = shard.items.find(key);
+        if (it == shard.items.end()) {
+            return nullptr;
+        }
+        auto value = std::move(it->second);
+        shard.items.erase(it);
+        return value;
+    }
+
+    /**
+     * @brief Looks up an entry.
+     * @param key Entry id.
+     * @return The entry, or nullptr if there is none.
+     */
+    Pointer find(Key key) const {
+        const auto& shard = shardFor(key);
+        std::shared_lock lock(shard.mutex);
+        auto it = shard.items.find(key);
+        return it != shard.items.end() ? it->second : nullptr;
+    }
+
+    /**
+     * @brief Checks whether an entry exists.
+     * @param key Entry id.
+     * @return True if the registry holds an entry for key.
+     */
+    bool contains(Key key) const {
+        const auto& shard = shardFor(key);
+        std::shared_lock lock(shard.mutex);
+        return shard.items.contains(key);
+    }
+
+    /**
+     * @brief Calls a function for every entry, one shard at a time.
+     *
+     * Each shard is locked shared only while it is visited; entries added or
+     * removed concurrently in other shards may or may not be seen.
+     *
+     * @param visit Callable taking (Key, const Pointer&).
+     */
+    template <typename Visitor>
+    void forEach(Visitor&& visit) const {
+        for (const auto& shard : shards_) {
+            std::shared_lock lock(shard.mutex);
+            for (const auto& [key, value] : shard.items) {
+                visit(key, value);
+            }
+        }
+    }
+
+    /**
+     * @brief Removes and returns every entry.
+     * @return The removed entries, in no particular order.
+     */
+    std::vector<Pointer> takeAll() {
+        std::vector<Pointer> taken;
+        for (auto& shard : shards_) {
+            std::unique_lock lock(shard.mutex);
+            for (auto& [key, value] : shard.items) {
+                taken.push_back(std::move(value));
+            }
+            shard.items.clear();
+        }
+        return taken;
+    }
+
+    /**
+     * @brief Counts the entries across all shards.
+     * @return Number of entries at the time each shard was visited.
+     */
+    size_t size() const {
+        size_t total = 0;
+        for (const auto& shard : shards_) {
+            std::shared_lock lock(shard.mutex);
+            total += shard.items.size();
+        }
+        return total;
+    }
+
+    /**
+     * @brief Returns the number of shards.
+     * @return Shard count fixed at construction.
+     */
+    size_t shardCount() const { return shards_.size(); }
+
+    /**
+     * @brief Returns the shard an id maps to.
+     * @param key Entry id.
+     * @return Shard index in [0, shardCount()).
+     */
+    size_t shardOf(Key key) const {
+        return static_cast<size_t>(mix64(static_cast<uint64_t>(key)) % shards_.size());
+    }
+
+private:
+    // Padded to a cache line so neighbouring shard locks do not false-share
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<Key, Pointer> items;
+    };
+
+    Shard& shardFor(Key key) { return shards_[shardOf(key)]; }
+    const Shard& shardFor(Key key) const { return shards_[shardOf(key)]; }
+
+    std::vector<Shard> shards_;
+};
+
+} // namespace netpulse::infra
@@ -1,5 +1,9 @@
 #include "infrastructure/network/SnmpService.hpp"
 
+#include "infrastructure/network/Awaitable.hpp"
+#include "infrastructure/network/BlockingExecutor.hpp"
+#include "infrastructure/network/DnsCache.hpp"
+
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
@@ -7,6 +11,7 @@
 #include <iomanip>
 #include <random>
 #include <sstream>
+#include <unordered_map>
 
 #ifdef _WIN32
 #include <winsock2.h>
@@ -22,6 +27,37 @@
 namespace netpulse::infra {
 
 namespace {
+
+core::SnmpResult resolveFailure(const std::string& address) {
+    core::SnmpResult result;
+    result.timestamp = std::chrono::system_clock::now();
+    result.success = false;
+    result.errorMessage = "Failed to resolve address: " + address;
+    return result;
+}
+
+// SNMP requests go to the first IPv4 address a name resolves to
+std::optional<asio::ip::udp::endpoint> firstIpv4Endpoint(const asio::error_code& ec,
+                                                         const DnsCache::Addresses& addresses,
+                                                         uint16_t port) {
+    if (!ec) {
+        for (const auto& resolved : addresses) {
+            if (resolved.is_v4()) {
+                return asio::ip::udp::endpoint(resolved, port);
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+core::SnmpResult overloadFailure() {
+    core::SnmpResult result;
+    result.timestamp = std::chrono::system_clock::now();
+    result.success = false;
+    result.errorMessage = "SNMP request queue full";
+    return result;
+}
+
 // ASN.1/BER tag types
 constexpr uint8_t TAG_INTEGER = 0x02;
 constexpr uint8_t TAG_OCTET_STRING = 0x04;
@@ -80,13 +116,26 @@ core::SnmpDataType tagToDataType(uint8_t tag) {
     }
 }
 
+// One root of a bulk walk; at most one request is outstanding for it
+struct WalkRoot {
+    std::string rootOid;        // As the caller passed it
+    std::string prefix;         // Normalized, for the subtree check
+    std::vector<uint32_t> last; // Last OID returned; the next one must sort after it
+    std::string cursor;         // OID the next request continues from
+    int32_t requestId{0};
+    std::chrono::steady_clock::time_point deadline;
+    int attempts{0};            // Sends of the current request
+    bool done{false};
+};
+
 } // anonymous namespace
 
 SnmpService::SnmpService(AsioContext& context)
-    : context_(context) {
+    : context_(context), monitoredDevices_(context.threadCount()),
+      requestIds_(std::make_shared<std::atomic<int32_t>>(1)) {
     // Initialize request ID with random value for security
     std::random_device rd;
-    requestIdCounter_ = static_cast<int32_t>(rd() & 0x7FFFFFFF);
+    *requestIds_ = static_cast<int32_t>(rd() & 0x7FFFFFFF);
     spdlog::debug("SnmpService initialized");
 }
 
@@ -102,9 +151,16 @@ std::future<core::SnmpResult> SnmpService::getAsync(
     auto promise = std::make_shared<std::promise<core::SnmpResult>>();
     auto future = promise->get_future();
 
-    context_.post([this, promise, address, oids, config]() {
+    resolveThen(context_, address, config.port,
+                [requestIds = requestIds_, promise, address, oids,
+                 config](std::optional<asio::ip::udp::endpoint> endpoint) {
+        if (!endpoint) {
+            promise->set_value(resolveFailure(address));
+            return;
+        }
         try {
-            auto result = performSnmpGet(address, oids, config, PduType::GetRequest);
+            auto result =
+                performSnmpGet(*requestIds, *endpoint, oids, config, PduType::GetRequest);
             promise->set_value(result);
         } catch (const std::exception& e) {
             core::SnmpResult result;
@@ -113,7 +169,7 @@ std::future<core::SnmpResult> SnmpService::getAsync(
             result.errorMessage = e.what();
             promise->set_value(result);
         }
-    });
+    }, [promise]() { promise->set_value(overloadFailure()); });
 
     return future;
 }
@@ -126,9 +182,16 @@ std::future<core::SnmpResult> SnmpService::getNextAsync(
     auto promise = std::make_shared<std::promise<core::SnmpResult>>();
     auto future = promise->get_future();
 
-    context_.post([this, promise, address, oids, config]() {
+    resolveThen(context_, address, config.port,
+                [requestIds = requestIds_, promise, address, oids,
+                 config](std::optional<asio::ip::udp::endpoint> endpoint) {
+        if (!endpoint) {
+            promise->set_value(resolveFailure(address));
+            return;
+        }
         try {
-            auto result = performSnmpGet(address, oids, config, PduType::GetNextRequest);
+            auto result =
+                performSnmpGet(*requestIds, *endpoint, oids, config, PduType::GetNextRequest);
             promise->set_value(result);
         } catch (const std::exception& e) {
             core::SnmpResult result;
@@ -137,7 +200,7 @@ std::future<core::SnmpResult> SnmpService::getNextAsync(
             result.errorMessage = e.what();
             promise->set_value(result);
         }
-    });
+    }, [promise]() { promise->set_value(overloadFailure()); });
 
     return future;
 }
@@ -150,193 +213,570 @@ std::future<std::vector<core::SnmpVarBind>> SnmpService::walkAsync(
     auto promise = std::make_shared<std::promise<std::vector<core::SnmpVarBind>>>();
     auto future = promise->get_future();
 
-    context_.post([this, promise, address, rootOid, config]() {
-        std::vector<core::SnmpVarBind> results;
-        std::string currentOid = rootOid;
+    // Each step awaits its response on the strand instead of parking a thread
+    asio::co_spawn(asio::make_strand(context_.nextContext()), walk(address, rootOid, config),
+                   [promise](std::exception_ptr error, std::vector<core::SnmpVarBind> results) {
+                       if (error) {
+                           spdlog::error("SNMP walk failed");
+                       }
+                       promise->set_value(std::move(results));
+                   });
+
+    return future;
+}
+
+asio::awaitable<core::SnmpResult> SnmpService::snmpGet(std::string address,
+                                                       std::vector<std::string> oids,
+                                                       core::SnmpDeviceConfig config) {
+    co_return co_await request(std::move(address), std::move(oids), std::move(config),
+                               PduType::GetRequest);
+}
+
+asio::awaitable<core::SnmpResult> SnmpService::snmpGetNext(std::string address,
+                                                           std::vector<std::string> oids,
+                                                           core::SnmpDeviceConfig config) {
+    co_return co_await request(std::move(address), std::move(oids), std::move(config),
+                               PduType::GetNextRequest);
+}
+
+asio::awaitable<std::vector<core::SnmpVarBind>> SnmpService::walk(std::string address,
+                                                                  std::string rootOid,
+                                                                  core::SnmpDeviceConfig config) {
+    std::vector<core::SnmpVarBind> results;
+    auto collect = [&results](const std::string&, const core::SnmpVarBind& varbind) {
+        results.push_back(varbind);
+    };
+    std::vector<std::string> rootOids{std::move(rootOid)};
+
+    co_await bulkWalk(std::move(address), std::move(rootOids), std::move(config),
+                      std::move(collect));
+    co_return results;
+}
+
+std::future<core::SnmpWalkResult> SnmpService::bulkWalkAsync(
+    const std::string& address, const std::vector<std::string>& rootOids,
+    const core::SnmpDeviceConfig& config, WalkCallback onVarBind, int maxRepetitions) {
+
+    auto promise = std::make_shared<std::promise<core::SnmpWalkResult>>();
+    auto future = promise->get_future();
+
+    asio::co_spawn(asio::make_strand(context_.nextContext()),
+                   bulkWalk(address, rootOids, config, std::move(onVarBind), maxRepetitions),
+                   [promise](std::exception_ptr error, core::SnmpWalkResult result) {
+                       if (error) {
+                           result.success = false;
+                           try {
+                               std::rethrow_exception(error);
+                           } catch (const std::exception& e) {
+                               result.errorMessage = std::string("SNMP error: ") + e.what();
+                           } catch (...) {
+                               result.errorMessage = "SNMP error";
+                           }
+                           spdlog::error("SNMP bulk walk failed: {}", result.errorMessage);
+                       }
+                       promise->set_value(std::move(result));
+                   });
+
+    return future;
+}
+
+asio::awaitable<core::SnmpWalkResult> SnmpService::bulkWalk(std::string address,
+                                                            std::vector<std::string> rootOids,
+                                                            core::SnmpDeviceConfig config,
+                                                            WalkCallback onVarBind,
+                                                            int maxRepetitions) {
+    core::SnmpWalkResult result;
+    result.timestamp = std::chrono::system_clock::now();
+    result.success = true;
+    auto startTime = std::chrono::steady_clock::now();
+
+    // A failed root ends; the walk reports the first failure
+    auto fail = [&result](WalkRoot& root, const std::string& message) {
+        root.done = true;
+        if (result.success) {
+            result.success = false;
+            result.errorMessage = root.rootOid + ": " + message;
+        }
+    };
 
+    std::vector<WalkRoot> roots(rootOids.size());
+    for (size_t i = 0; i < rootOids.size(); ++i) {
+        auto& root = roots[i];
+        root.rootOid = rootOids[i];
         try {
-            constexpr int maxIterations = 1000;  // Prevent infinite loops
-            int iterations = 0;
+            root.last = parseOidString(root.rootOid);
+        } catch (const std::exception&) {
+            root.last.clear();
+        }
+        if (root.last.size() < 2) {
+            fail(root, "Invalid OID");
+            continue;
+        }
+        root.prefix = oidVectorToString(root.last);
+        root.cursor = root.prefix;
+    }
 
-            while (iterations++ < maxIterations) {
-                auto result = performSnmpGet(address, {currentOid}, config, PduType::GetNextRequest);
+    auto endpoint = co_await resolve(address, config.port);
+    if (!endpoint) {
+        result.success = false;
+        result.errorMessage = resolveFailure(address).errorMessage;
+        co_return result;
+    }
 
-                if (!result.success || result.varbinds.empty()) {
-                    break;
-                }
+    auto socket = std::make_shared<asio::ip::udp::socket>(co_await asio::this_coro::executor,
+                                                          endpoint->protocol());
+
+    // SNMP v1 has no GETBULK; GET-NEXT is a bulk request of one
+    auto pduType = config.version == core::SnmpVersion::V1 ? PduType::GetNextRequest
+                                                           : PduType::GetBulkRequest;
+    int32_t repetitions = std::clamp(maxRepetitions, 1, MAX_REPETITIONS_LIMIT);
+    auto timeout = std::chrono::milliseconds(std::max(config.timeoutMs, 1));
+    int maxAttempts = 1 + std::max(config.retries, 0);
+
+    std::unordered_map<int32_t, size_t> outstanding; // Request id -> root index
+    std::vector<size_t> ready;                       // Roots whose next request is due
+    size_t nextRoot = 0;                             // First root not yet started
+    std::vector<uint8_t> recvBuffer(65535);
+
+    while (true) {
+        while (outstanding.size() + ready.size() < MAX_WALK_REQUESTS_IN_FLIGHT &&
+               nextRoot < roots.size()) {
+            if (!roots[nextRoot].done) {
+                ready.push_back(nextRoot);
+            }
+            ++nextRoot;
+        }
+
+        for (auto index : ready) {
+            auto& root = roots[index];
+            std::vector<std::string> oids{root.cursor};
+            auto packet = buildRequest(*requestIds_, oids, config, pduType, repetitions,
+                                       &root.requestId);
+
+            asio::error_code ec;
+            co_await socket->async_send_to(asio::buffer(packet), *endpoint,
+                                           asio::redirect_error(asio::use_awaitable, ec));
+            ++result.requests;
+            if (ec) {
+                fail(root, "Send error: " + ec.message());
+                continue;
+            }
+            ++root.attempts;
+            root.deadline = std::chrono::steady_clock::now() + timeout;
+            outstanding.emplace(root.requestId, index);
+        }
+        ready.clear();
+
+        if (outstanding.empty()) {
+            break;
+        }
 
-                const auto& vb = result.varbinds[0];
+        auto deadline = std::chrono::steady_clock::time_point::max();
+        for (const auto& [requestId, index] : outstanding) {
+            deadline = std::min(deadline, roots[index].deadline);
+        }
 
-                // Check if we've gone past the subtree
-                if (!isOidPrefix(rootOid, vb.oid)) {
-                    break;
+        // The timer cancels the receive; it holds the socket in case it fires
+        // after this iteration has finished
+        asio::steady_timer timer(socket->get_executor());
+        timer.expires_at(deadline);
+        timer.async_wait([socket](const asio::error_code& ec) {
+            if (!ec) {
+                asio::error_code ignored;
+                socket->cancel(ignored);
+            }
+        });
+
+        asio::ip::udp::endpoint senderEndpoint;
+        asio::error_code ec;
+        size_t bytesReceived = co_await socket->async_receive_from(
+            asio::buffer(recvBuffer), senderEndpoint, asio::redirect_error(asio::use_awaitable, ec));
+        timer.cancel();
+
+        if (ec && ec != asio::error::operation_aborted) {
+            for (const auto& [requestId, index] : outstanding) {
+                fail(roots[index], "Receive error: " + ec.message());
+            }
+            outstanding.clear();
+            continue;
+        }
+
+        if (!ec) {
+            std::vector<uint8_t> packet(recvBuffer.begin(),
+                                        recvBuffer.begin() + static_cast<std::ptrdiff_t>(
+                                                                 bytesReceived));
+            int32_t requestId = 0;
+            auto response = parseSnmpResponse(packet, config, &requestId);
+
+            // Anything else is a late answer to a request that was resent
+            auto entry = outstanding.find(requestId);
+            if (entry != outstanding.end()) {
+                auto index = entry->second;
+                auto& root = roots[index];
+                outstanding.erase(entry);
+                root.attempts = 0;
+
+                if (!response.success) {
+                    // A v1 agent signals the end of the MIB view with noSuchName
+                    if (pduType == PduType::GetNextRequest &&
+                        response.errorStatus == SNMP_ERR_NO_SUCH_NAME) {
+                        root.done = true;
+                    } else {
+                        fail(root, response.errorMessage);
+                    }
                 }
 
-                // Check for end-of-mib-view
-                if (vb.type == core::SnmpDataType::EndOfMibView ||
-                    vb.type == core::SnmpDataType::NoSuchObject ||
-                    vb.type == core::SnmpDataType::NoSuchInstance) {
-                    break;
+                bool ended = response.varbinds.empty();
+                for (const auto& varbind : response.varbinds) {
+                    if (root.done) {
+                        break;
+                    }
+                    if (varbind.type == core::SnmpDataType::EndOfMibView ||
+                        varbind.type == core::SnmpDataType::NoSuchObject ||
+                        varbind.type == core::SnmpDataType::NoSuchInstance ||
+                        !isOidPrefix(root.prefix, varbind.oid)) {
+                        ended = true;
+                        break;
+                    }
+
+                    auto oid = parseOidString(varbind.oid);
+                    if (!std::lexicographical_compare(root.last.begin(), root.last.end(),
+                                                      oid.begin(), oid.end())) {
+                        fail(root, "OID not increasing: " + varbind.oid);
+                        break;
+                    }
+                    root.last = std::move(oid);
+                    root.cursor = varbind.oid;
+                    ++result.varbindCount;
+                    if (onVarBind) {
+                        onVarBind(root.rootOid, varbind);
+                    }
                 }
 
-                results.push_back(vb);
-                currentOid = vb.oid;
+                if (ended) {
+                    root.done = true;
+                }
+                if (!root.done) {
+                    ready.push_back(index);
+                }
             }
+        }
 
-            promise->set_value(results);
-        } catch (const std::exception& e) {
-            spdlog::error("SNMP walk error: {}", e.what());
-            promise->set_value(results);  // Return partial results
+        // Resend what went unanswered, with a new request id
+        auto now = std::chrono::steady_clock::now();
+        for (auto it = outstanding.begin(); it != outstanding.end();) {
+            auto& root = roots[it->second];
+            if (root.deadline > now) {
+                ++it;
+                continue;
+            }
+            if (root.attempts < maxAttempts) {
+                ready.push_back(it->second);
+            } else {
+                fail(root, "Request timed out");
+            }
+            it = outstanding.erase(it);
         }
-    });
+    }
 
-    return future;
+    result.duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - startTime);
+    spdlog::debug("SNMP bulk walk of {}: {} varbinds, {} requests, {} roots", address,
+                  result.varbindCount, result.requests, roots.size());
+    co_return result;
 }
 
 void SnmpService::startMonitoring(const core::Host& host,
                                    const core::SnmpDeviceConfig& config,
                                    SnmpCallback callback) {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    // Stop existing monitoring for this host
-    auto it = monitoredDevices_.find(host.id);
-    if (it != monitoredDevices_.end()) {
-        it->second->active = false;
-        if (it->second->timer) {
-            it->second->timer->cancel();
-        }
-        monitoredDevices_.erase(it);
-    }
-
     // Create new monitored device
     auto device = std::make_shared<MonitoredDevice>();
     device->host = host;
     device->config = config;
     device->callback = std::move(callback);
-    device->timer = std::make_shared<asio::steady_timer>(context_.getContext());
     device->active = true;
     device->statistics.hostId = host.id;
 
-    monitoredDevices_[host.id] = device;
+    // Register recurring poll before publishing, then stop any existing
+    // monitoring for this host
+    schedulePolls(device);
+    if (auto previous = monitoredDevices_.insertOrReplace(host.id, device)) {
+        retire(*previous);
+    }
 
     spdlog::info("Started SNMP monitoring for host {} ({})",
                  host.name, host.address);
-
-    // Schedule first poll
-    scheduleNextPoll(device);
 }
 
 void SnmpService::stopMonitoring(int64_t hostId) {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    auto it = monitoredDevices_.find(hostId);
-    if (it != monitoredDevices_.end()) {
-        it->second->active = false;
-        if (it->second->timer) {
-            it->second->timer->cancel();
-        }
+    if (auto device = monitoredDevices_.erase(hostId)) {
+        retire(*device);
         spdlog::info("Stopped SNMP monitoring for host ID {}", hostId);
-        monitoredDevices_.erase(it);
     }
 }
 
 void SnmpService::stopAllMonitoring() {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    for (auto& [id, device] : monitoredDevices_) {
-        device->active = false;
-        if (device->timer) {
-            device->timer->cancel();
-        }
+    for (auto& device : monitoredDevices_.takeAll()) {
+        retire(*device);
     }
-    monitoredDevices_.clear();
     spdlog::info("Stopped all SNMP monitoring");
 }
 
 bool SnmpService::isMonitoring(int64_t hostId) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return monitoredDevices_.find(hostId) != monitoredDevices_.end();
+    return monitoredDevices_.contains(hostId);
 }
 
 void SnmpService::updateConfig(int64_t hostId, const core::SnmpDeviceConfig& config) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    auto device = monitoredDevices_.find(hostId);
+    if (!device) {
+        return;
+    }
 
-    auto it = monitoredDevices_.find(hostId);
-    if (it != monitoredDevices_.end()) {
-        it->second->config = config;
-        spdlog::debug("Updated SNMP config for host ID {}", hostId);
+    std::lock_guard<std::mutex> lock(device->mutex);
+    bool intervalChanged = device->config.pollIntervalSeconds != config.pollIntervalSeconds;
+    device->config = config;
+    if (intervalChanged && device->active) {
+        context_.timerWheelFor(static_cast<uint64_t>(device->host.id)).cancel(device->job);
+        schedulePolls(device);
     }
+    spdlog::debug("Updated SNMP config for host ID {}", hostId);
 }
 
 core::SnmpStatistics SnmpService::getStatistics(int64_t hostId) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    auto it = monitoredDevices_.find(hostId);
-    if (it != monitoredDevices_.end()) {
-        return it->second->statistics;
+    auto device = monitoredDevices_.find(hostId);
+    if (!device) {
+        return core::SnmpStatistics{};
     }
-    return core::SnmpStatistics{};
+
+    std::lock_guard<std::mutex> lock(device->mutex);
+    return device->statistics;
 }
 
-void SnmpService::scheduleNextPoll(std::shared_ptr<MonitoredDevice> device) {
+void SnmpService::retire(MonitoredDevice& device) {
+    std::lock_guard<std::mutex> lock(device.mutex);
+    device.active = false;
+    context_.timerWheelFor(static_cast<uint64_t>(device.host.id)).cancel(device.job);
+}
+
+void SnmpService::schedulePolls(const std::shared_ptr<MonitoredDevice>& device) {
+    auto interval = std::chrono::milliseconds(
+        std::chrono::seconds(std::max(device->config.pollIntervalSeconds, 1)));
+
+    // On the device's shard, so each thread only expires its own devices' jobs.
+    // The job owns what it touches: a batch already collected by the wheel may
+    // still run it after the service is destroyed
+    auto& wheel = context_.timerWheelFor(static_cast<uint64_t>(device->host.id));
+    device->job = wheel.scheduleEvery(
+        interval,
+        [&context = context_, requestIds = requestIds_, device]() {
+            if (!device->active || device->pollInFlight.exchange(true)) {
+                return;
+            }
+            uint16_t port;
+            {
+                std::lock_guard<std::mutex> lock(device->mutex);
+                port = device->config.port;
+            }
+            // The poll blocks on socket I/O, so it runs on its own handler
+            // once the address is resolved, never inside the wheel's batch
+            resolveThen(
+                context, device->host.address, port,
+                [requestIds, device](std::optional<asio::ip::udp::endpoint> endpoint) {
+                    pollDevice(*requestIds, device, endpoint);
+                    device->pollInFlight = false;
+                },
+                [device]() {
+                    if (device->active) {
+                        recordPoll(*device, overloadFailure());
+                    }
+                    device->pollInFlight = false;
+                });
+        },
+        interval);
+}
+
+void SnmpService::pollDevice(std::atomic<int32_t>& requestIds,
+                             const std::shared_ptr<MonitoredDevice>& device,
+                             const std::optional<asio::ip::udp::endpoint>& endpoint) {
     if (!device->active) {
         return;
     }
 
-    auto interval = std::chrono::seconds(device->config.pollIntervalSeconds);
-    device->timer->expires_after(interval);
+    core::SnmpDeviceConfig config;
+    {
+        std::lock_guard<std::mutex> lock(device->mutex);
+        config = device->config;
+    }
 
-    device->timer->async_wait([this, device](const asio::error_code& ec) {
-        if (ec || !device->active) {
-            return;
+    // Perform SNMP poll
+    auto result = endpoint ? performSnmpGet(requestIds, *endpoint, config.oids, config,
+                                            PduType::GetRequest)
+                           : resolveFailure(device->host.address);
+    recordPoll(*device, result);
+}
+
+void SnmpService::recordPoll(MonitoredDevice& device, core::SnmpResult result) {
+    result.hostId = device.host.id;
+
+    // Update statistics
+    std::unique_lock<std::mutex> lock(device.mutex);
+    device.statistics.totalPolls++;
+    if (result.success) {
+        device.statistics.successfulPolls++;
+
+        // Update response time stats
+        if (device.statistics.minResponseTime.count() == 0 ||
+            result.responseTime < device.statistics.minResponseTime) {
+            device.statistics.minResponseTime = result.responseTime;
+        }
+        if (result.responseTime > device.statistics.maxResponseTime) {
+            device.statistics.maxResponseTime = result.responseTime;
         }
 
-        // Perform SNMP poll
-        auto result = performSnmpGet(device->host.address,
-                                      device->config.oids,
-                                      device->config,
-                                      PduType::GetRequest);
-        result.hostId = device->host.id;
+        // Calculate running average
+        auto total = device.statistics.avgResponseTime.count() *
+                     (device.statistics.successfulPolls - 1);
+        device.statistics.avgResponseTime = std::chrono::microseconds(
+            (total + result.responseTime.count()) / device.statistics.successfulPolls);
 
-        // Update statistics
-        device->statistics.totalPolls++;
-        if (result.success) {
-            device->statistics.successfulPolls++;
+        // Store last values
+        for (const auto& vb : result.varbinds) {
+            device.statistics.lastValues[vb.oid] = vb.value;
+        }
+    }
+    device.statistics.successRate = device.statistics.calculateSuccessRate();
+    lock.unlock();
 
-            // Update response time stats
-            if (device->statistics.minResponseTime.count() == 0 ||
-                result.responseTime < device->statistics.minResponseTime) {
-                device->statistics.minResponseTime = result.responseTime;
-            }
-            if (result.responseTime > device->statistics.maxResponseTime) {
-                device->statistics.maxResponseTime = result.responseTime;
+    // Invoke callback
+    if (device.callback) {
+        device.callback(result);
+    }
+}
+
+void SnmpService::resolveThen(AsioContext& context, const std::string& address, uint16_t port,
+                              ResolvedWork work, RejectedWork rejected) {
+    context.dnsCache().resolveAsync(
+        address, [&context, address, port, work = std::move(work),
+                  rejected = std::move(rejected)](const asio::error_code& ec,
+                                                  const DnsCache::Addresses& addresses) {
+            auto endpoint = firstIpv4Endpoint(ec, addresses, port);
+            // The SNMP exchange blocks, so it never runs on an I/O thread; a
+            // request still queued at shutdown is rejected like an overload
+            if (!context.blockingExecutor().tryPost([work, endpoint]() { work(endpoint); },
+                                                    rejected)) {
+                spdlog::warn("SNMP request to {} rejected: blocking queue full", address);
+                rejected();
             }
+        });
+}
+
+asio::awaitable<std::optional<asio::ip::udp::endpoint>> SnmpService::resolve(
+    std::string address, uint16_t port) {
+    auto start = [&cache = context_.dnsCache(), address, port](auto done) {
+        cache.resolveAsync(address, [done, port](const asio::error_code& ec,
+                                                 const DnsCache::Addresses& addresses) {
+            done(firstIpv4Endpoint(ec, addresses, port));
+        });
+    };
+    co_return co_await awaitCallback<std::optional<asio::ip::udp::endpoint>>(std::move(start));
+}
+
+asio::awaitable<core::SnmpResult> SnmpService::request(std::string address,
+                                                       std::vector<std::string> oids,
+                                                       core::SnmpDeviceConfig config,
+                                                       PduType pduType) {
+    auto endpoint = co_await resolve(address, config.port);
+    if (!endpoint) {
+        co_return resolveFailure(address);
+    }
+
+    auto socket = std::make_shared<asio::ip::udp::socket>(co_await asio::this_coro::executor,
+                                                          endpoint->protocol());
+    co_return co_await exchange(socket, *endpoint, std::move(oids), std::move(config), pduType);
+}
+
+asio::awaitable<core::SnmpResult> SnmpService::exchange(
+    std::shared_ptr<asio::ip::udp::socket> socket, asio::ip::udp::endpoint endpoint,
+    std::vector<std::string> oids, core::SnmpDeviceConfig config, PduType pduType) {
+
+    core::SnmpResult result;
+    result.timestamp = std::chrono::system_clock::now();
+    result.version = config.version;
 
-            // Calculate running average
-            auto total = device->statistics.avgResponseTime.count() *
-                         (device->statistics.successfulPolls - 1);
-            device->statistics.avgResponseTime = std::chrono::microseconds(
-                (total + result.responseTime.count()) / device->statistics.successfulPolls);
+    auto startTime = std::chrono::steady_clock::now();
 
-            // Store last values
-            for (const auto& vb : result.varbinds) {
-                device->statistics.lastValues[vb.oid] = vb.value;
+    try {
+        auto packet = buildRequest(*requestIds_, oids, config, pduType);
+        co_await socket->async_send_to(asio::buffer(packet), endpoint, asio::use_awaitable);
+
+        // The timer cancels the receive; it holds the socket in case it fires
+        // after this frame has finished
+        auto timedOut = std::make_shared<bool>(false);
+        asio::steady_timer timer(socket->get_executor());
+        timer.expires_after(std::chrono::milliseconds(config.timeoutMs));
+        timer.async_wait([socket, timedOut](const asio::error_code& ec) {
+            if (!ec) {
+                *timedOut = true;
+                asio::error_code ignored;
+                socket->cancel(ignored);
             }
-        }
-        device->statistics.successRate = device->statistics.calculateSuccessRate();
+        });
 
-        // Invoke callback
-        if (device->callback) {
-            device->callback(result);
+        std::vector<uint8_t> recvBuffer(65535);
+        asio::ip::udp::endpoint senderEndpoint;
+        asio::error_code ec;
+        size_t bytesReceived = co_await socket->async_receive_from(
+            asio::buffer(recvBuffer), senderEndpoint, asio::redirect_error(asio::use_awaitable, ec));
+        timer.cancel();
+
+        auto endTime = std::chrono::steady_clock::now();
+        result.responseTime =
+            std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime);
+
+        if (*timedOut) {
+            result.success = false;
+            result.errorMessage = "Request timed out";
+            co_return result;
+        }
+        if (ec) {
+            result.success = false;
+            result.errorMessage = "Receive error: " + ec.message();
+            co_return result;
         }
 
-        // Schedule next poll
-        scheduleNextPoll(device);
-    });
+        // Parse response
+        recvBuffer.resize(bytesReceived);
+        result = parseSnmpResponse(recvBuffer, config);
+        result.responseTime =
+            std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime);
+        result.version = config.version;
+
+    } catch (const std::exception& e) {
+        result.success = false;
+        result.errorMessage = std::string("SNMP error: ") + e.what();
+    }
+
+    co_return result;
+}
+
+std::vector<uint8_t> SnmpService::buildRequest(std::atomic<int32_t>& requestIds,
+                                               const std::vector<std::string>& oids,
+                                               const core::SnmpDeviceConfig& config,
+                                               PduType pduType, int32_t maxRepetitions,
+                                               int32_t* requestId) {
+    int32_t id = requestIds++;
+    if (requestId) {
+        *requestId = id;
+    }
+    if (config.version == core::SnmpVersion::V3) {
+        return buildSnmpV3Packet(oids, config, pduType, id, maxRepetitions);
+    }
+    return buildSnmpPacket(oids, config, pduType, id, maxRepetitions);
 }
 
 core::SnmpResult SnmpService::performSnmpGet(
-    const std::string& address,
+    std::atomic<int32_t>& requestIds,
+    const asio::ip::udp::endpoint& endpoint,
     const std::vector<std::string>& oids,
     const core::SnmpDeviceConfig& config,
     PduType pduType) {
@@ -348,58 +788,39 @@ core::SnmpResult SnmpService::performSnmpGet(
     auto startTime = std::chrono::steady_clock::now();
 
     try {
-        // Resolve address
         asio::io_context tempContext;
-        asio::ip::udp::resolver resolver(tempContext);
-        auto endpoints = resolver.resolve(asio::ip::udp::v4(),
-                                           address,
-                                           std::to_string(config.port));
-
-        if (endpoints.empty()) {
-            result.success = false;
-            result.errorMessage = "Failed to resolve address: " + address;
-            return result;
-        }
-
-        auto endpoint = *endpoints.begin();
 
         // Create UDP socket
-        asio::ip::udp::socket socket(tempContext, asio::ip::udp::v4());
+        asio::ip::udp::socket socket(tempContext, endpoint.protocol());
 
         // Build SNMP request
-        int32_t requestId = requestIdCounter_++;
-        std::vector<uint8_t> packet;
-
-        if (config.version == core::SnmpVersion::V3) {
-            packet = buildSnmpV3Packet(oids, config, pduType, requestId);
-        } else {
-            packet = buildSnmpPacket(oids, config, pduType, requestId);
-        }
+        auto packet = buildRequest(requestIds, oids, config, pduType);
 
         // Send request
-        socket.send_to(asio::buffer(packet), endpoint.endpoint());
+        socket.send_to(asio::buffer(packet), endpoint);
 
         // Set up receive with timeout
         std::vector<uint8_t> recvBuffer(65535);
         asio::ip::udp::endpoint senderEndpoint;
 
-        // Configure socket timeout
-        struct timeval tv;
-        tv.tv_sec = config.timeoutMs / 1000;
-        tv.tv_usec = (config.timeoutMs % 1000) * 1000;
-#ifdef _WIN32
-        DWORD timeout = config.timeoutMs;
-        setsockopt(socket.native_handle(), SOL_SOCKET, SO_RCVTIMEO,
-                   reinterpret_cast<const char*>(&timeout), sizeof(timeout));
-#else
-        setsockopt(socket.native_handle(), SOL_SOCKET, SO_RCVTIMEO,
-                   &tv, sizeof(tv));
-#endif
-
-        // Receive response
+        // A synchronous receive waits out SO_RCVTIMEO and polls again, so the
+        // timeout cancels an asynchronous one on the private context instead
         asio::error_code ec;
-        size_t bytesReceived = socket.receive_from(
-            asio::buffer(recvBuffer), senderEndpoint, 0, ec);
+        size_t bytesReceived = 0;
+        asio::steady_timer timer(tempContext, std::chrono::milliseconds(config.timeoutMs));
+        socket.async_receive_from(asio::buffer(recvBuffer), senderEndpoint,
+                                  [&](const asio::error_code& error, size_t received) {
+                                      ec = error;
+                                      bytesReceived = received;
+                                      timer.cancel();
+                                  });
+        timer.async_wait([&socket](const asio::error_code& error) {
+            if (!error) {
+                asio::error_code ignored;
+                socket.cancel(ignored);
+            }
+        });
+        tempContext.run();
 
         auto endTime = std::chrono::steady_clock::now();
         result.responseTime = std::chrono::duration_cast<std::chrono::microseconds>(
@@ -407,8 +828,7 @@ core::SnmpResult SnmpService::performSnmpGet(
 
         if (ec) {
             result.success = false;
-            if (ec == asio::error::timed_out ||
-                ec == asio::error::would_block) {
+            if (ec == asio::error::operation_aborted) {
                 result.errorMessage = "Request timed out";
             } else {
                 result.errorMessage = "Receive error: " + ec.message();
@@ -435,7 +855,8 @@ std::vector<uint8_t> SnmpService::buildSnmpPacket(
     const std::vector<std::string>& oids,
     const core::SnmpDeviceConfig& config,
     PduType pduType,
-    int32_t requestId) {
+    int32_t requestId,
+    int32_t maxRepetitions) {
 
     std::vector<uint8_t> packet;
 
@@ -455,9 +876,11 @@ std::vector<uint8_t> SnmpService::buildSnmpPacket(
 
     // Build PDU
     std::vector<uint8_t> pduContent;
+    // GetBulkRequest reuses the error fields for non-repeaters and max-repetitions
+    bool bulk = pduType == PduType::GetBulkRequest;
     auto encodedRequestId = encodeInteger(requestId);
-    auto encodedErrorStatus = encodeInteger(0);  // No error
-    auto encodedErrorIndex = encodeInteger(0);   // No error
+    auto encodedErrorStatus = encodeInteger(0);  // No error / no non-repeaters
+    auto encodedErrorIndex = encodeInteger(bulk ? maxRepetitions : 0);
 
     pduContent.insert(pduContent.end(), encodedRequestId.begin(), encodedRequestId.end());
     pduContent.insert(pduContent.end(), encodedErrorStatus.begin(), encodedErrorStatus.end());
@@ -497,7 +920,8 @@ std::vector<uint8_t> SnmpService::buildSnmpV3Packet(
     const std::vector<std::string>& oids,
     const core::SnmpDeviceConfig& config,
     PduType pduType,
-    int32_t requestId) {
+    int32_t requestId,
+    int32_t maxRepetitions) {
 
     // SNMPv3 packet structure:
     // SEQUENCE {
@@ -510,7 +934,7 @@ std::vector<uint8_t> SnmpService::buildSnmpV3Packet(
     auto* v3Creds = std::get_if<core::SnmpV3Credentials>(&config.credentials);
     if (!v3Creds) {
         // Fall back to v2c if no v3 credentials
-        return buildSnmpPacket(oids, config, pduType, requestId);
+        return buildSnmpPacket(oids, config, pduType, requestId, maxRepetitions);
     }
 
     std::vector<uint8_t> packet;
@@ -531,9 +955,10 @@ std::vector<uint8_t> SnmpService::buildSnmpV3Packet(
 
     // Build PDU
     std::vector<uint8_t> pduContent;
+    bool bulk = pduType == PduType::GetBulkRequest;
     auto encodedRequestId = encodeInteger(requestId);
     auto encodedErrorStatus = encodeInteger(0);
-    auto encodedErrorIndex = encodeInteger(0);
+    auto encodedErrorIndex = encodeInteger(bulk ? maxRepetitions : 0);
 
     pduContent.insert(pduContent.end(), encodedRequestId.begin(), encodedRequestId.end());
     pduContent.insert(pduContent.end(), encodedErrorStatus.begin(), encodedErrorStatus.end());
@@ -612,7 +1037,8 @@ std::vector<uint8_t> SnmpService::buildSnmpV3Packet(
 
 core::SnmpResult SnmpService::parseSnmpResponse(
     const std::vector<uint8_t>& response,
-    const core::SnmpDeviceConfig& config) {
+    const core::SnmpDeviceConfig& config,
+    int32_t* requestId) {
 
     core::SnmpResult result;
     result.timestamp = std::chrono::system_clock::now();
@@ -701,6 +1127,9 @@ core::SnmpResult SnmpService::parseSnmpResponse(
             throw std::runtime_error("Expected INTEGER for request-id");
         }
         size_t reqIdLen = decodeLength(data, offset);
+        if (requestId) {
+            *requestId = decodeInteger(data + offset, reqIdLen);
+        }
         offset += reqIdLen;
 
         // Error status
@@ -2,12 +2,15 @@
 
 #include "core/services/ISnmpService.hpp"
 #include "infrastructure/network/AsioContext.hpp"
+#include "infrastructure/network/ShardedRegistry.hpp"
+#include "infrastructure/network/TimerWheel.hpp"
 
 #include <asio.hpp>
 #include <atomic>
-#include <map>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
 
 namespace netpulse::infra {
 
@@ -18,10 +21,31 @@ namespace netpulse::infra {
  * and WALK. Supports continuous monitoring of devices with configurable
  * polling intervals. Implements the core::ISnmpService interface.
  *
+ * Monitored devices are sharded by host id: each device's poll job runs on
+ * the timer wheel of AsioContext::contextFor(id), and the poll itself, a
+ * blocking exchange, on the context's blocking executor.
+ *
  * @note This class is non-copyable.
  */
 class SnmpService : public core::ISnmpService {
 public:
+    /**
+     * @brief Callback invoked for each varbind a bulk walk retrieves.
+     * @param rootOid The root OID (as passed in) whose subtree holds the varbind.
+     * @param varbind The retrieved varbind.
+     */
+    using WalkCallback =
+        std::function<void(const std::string& rootOid, const core::SnmpVarBind& varbind)>;
+
+    /// Varbinds requested per root in each GETBULK, unless the caller says otherwise
+    static constexpr int DEFAULT_MAX_REPETITIONS = 25;
+
+    /// Upper bound on max-repetitions, so a response stays within one datagram
+    static constexpr int MAX_REPETITIONS_LIMIT = 200;
+
+    /// Roots a bulk walk keeps a request outstanding for at once
+    static constexpr size_t MAX_WALK_REQUESTS_IN_FLIGHT = 8;
+
     /**
      * @brief Constructs an SnmpService with the given Asio context.
      * @param context Reference to the AsioContext for async operations.
@@ -69,6 +93,92 @@ public:
                                                            const std::string& rootOid,
                                                            const core::SnmpDeviceConfig& config) override;
 
+    /**
+     * @brief Performs an SNMP GET from a coroutine.
+     *
+     * The request is sent and awaited on the coroutine's executor without
+     * blocking a thread. Run it on a strand (or a PerThread context) so the
+     * timeout and the receive never touch the socket concurrently.
+     *
+     * @param address Target hostname or IP address.
+     * @param oids Vector of OID strings to query.
+     * @param config SNMP device configuration (community, version, etc.).
+     * @return Awaitable yielding the SnmpResult.
+     */
+    asio::awaitable<core::SnmpResult> snmpGet(std::string address, std::vector<std::string> oids,
+                                              core::SnmpDeviceConfig config);
+
+    /**
+     * @brief Performs an SNMP GET-NEXT from a coroutine.
+     * @param address Target hostname or IP address.
+     * @param oids Vector of OID strings for GET-NEXT operation.
+     * @param config SNMP device configuration.
+     * @return Awaitable yielding the SnmpResult.
+     * @see snmpGet() for executor requirements.
+     */
+    asio::awaitable<core::SnmpResult> snmpGetNext(std::string address,
+                                                  std::vector<std::string> oids,
+                                                  core::SnmpDeviceConfig config);
+
+    /**
+     * @brief Walks a subtree from a coroutine.
+     *
+     * Collects the varbinds of bulkWalk() with the default max-repetitions.
+     * Stops at the end of the subtree or when a request fails for good.
+     *
+     * @param address Target hostname or IP address.
+     * @param rootOid Root OID to walk from.
+     * @param config SNMP device configuration.
+     * @return Awaitable yielding the varbinds under rootOid.
+     * @see snmpGet() for executor requirements.
+     */
+    asio::awaitable<std::vector<core::SnmpVarBind>> walk(std::string address, std::string rootOid,
+                                                         core::SnmpDeviceConfig config);
+
+    /**
+     * @brief Walks several subtrees at once from a coroutine, streaming the varbinds.
+     *
+     * Each root is walked with GETBULK requests of maxRepetitions varbinds
+     * (GET-NEXT for SNMP v1, which has no GETBULK). Up to
+     * MAX_WALK_REQUESTS_IN_FLIGHT roots have a request outstanding at once,
+     * all over one socket, and responses are matched to roots by request id.
+     * An unanswered request is resent config.retries times.
+     *
+     * There is no step limit: a root ends at the end of its subtree or of the
+     * MIB view, or fails when a request goes unanswered, the agent reports an
+     * error, or an OID does not increase (which would otherwise loop forever).
+     *
+     * @param address Target hostname or IP address.
+     * @param rootOids Root OIDs of the subtrees to walk.
+     * @param config SNMP device configuration.
+     * @param onVarBind Invoked on the coroutine's executor for each varbind, in
+     *        OID order within a root; roots interleave.
+     * @param maxRepetitions Varbinds requested per GETBULK, clamped to
+     *        1..MAX_REPETITIONS_LIMIT.
+     * @return Awaitable yielding the walk's counts and first failure.
+     * @see snmpGet() for executor requirements.
+     */
+    asio::awaitable<core::SnmpWalkResult> bulkWalk(std::string address,
+                                                   std::vector<std::string> rootOids,
+                                                   core::SnmpDeviceConfig config,
+                                                   WalkCallback onVarBind,
+                                                   int maxRepetitions = DEFAULT_MAX_REPETITIONS);
+
+    /**
+     * @brief Performs bulkWalk() on a strand of the service's context.
+     * @param address Target hostname or IP address.
+     * @param rootOids Root OIDs of the subtrees to walk.
+     * @param config SNMP device configuration.
+     * @param onVarBind Invoked on an Asio worker thread for each varbind.
+     * @param maxRepetitions Varbinds requested per GETBULK.
+     * @return Future containing the walk's counts and first failure.
+     */
+    std::future<core::SnmpWalkResult> bulkWalkAsync(const std::string& address,
+                                                    const std::vector<std::string>& rootOids,
+                                                    const core::SnmpDeviceConfig& config,
+                                                    WalkCallback onVarBind,
+                                                    int maxRepetitions = DEFAULT_MAX_REPETITIONS);
+
     /**
      * @brief Starts continuous SNMP monitoring of a host.
      * @param host The host to monitor.
@@ -124,30 +234,77 @@ private:
     // Internal monitoring state
     struct MonitoredDevice {
         core::Host host;
-        core::SnmpDeviceConfig config;
         SnmpCallback callback;
-        std::shared_ptr<asio::steady_timer> timer;
         std::atomic<bool> active{true};
+        std::atomic<bool> pollInFlight{false};
+
+        // Guards config, job and statistics
+        mutable std::mutex mutex;
+        core::SnmpDeviceConfig config;
+        TimerWheel::JobId job{0};
         core::SnmpStatistics statistics;
     };
 
-    // Schedule next poll for a monitored device
-    void scheduleNextPoll(std::shared_ptr<MonitoredDevice> device);
+    // Deactivate a device removed from the registry and cancel its polls
+    void retire(MonitoredDevice& device);
+
+    // Register the recurring poll job for a monitored device on the timer wheel
+    void schedulePolls(const std::shared_ptr<MonitoredDevice>& device);
+
+    // Run one poll cycle (blocking, runs on the blocking executor)
+    static void pollDevice(std::atomic<int32_t>& requestIds,
+                           const std::shared_ptr<MonitoredDevice>& device,
+                           const std::optional<asio::ip::udp::endpoint>& endpoint);
+
+    // Fold a poll result into the device statistics and report it
+    static void recordPoll(MonitoredDevice& device, core::SnmpResult result);
+
+    // Resolve through the shared DNS cache, then run blocking work on the
+    // blocking executor; if its queue is full or it stops first, call rejected instead
+    using ResolvedWork = std::function<void(std::optional<asio::ip::udp::endpoint>)>;
+    using RejectedWork = std::function<void()>;
+    static void resolveThen(AsioContext& context, const std::string& address, uint16_t port,
+                            ResolvedWork work, RejectedWork rejected);
+
+    // Resolve through the shared DNS cache to the first IPv4 endpoint
+    asio::awaitable<std::optional<asio::ip::udp::endpoint>> resolve(std::string address,
+                                                                    uint16_t port);
+
+    // Resolve, then perform one request over a fresh socket
+    asio::awaitable<core::SnmpResult> request(std::string address, std::vector<std::string> oids,
+                                              core::SnmpDeviceConfig config, PduType pduType);
+
+    // Send one request and await its response without blocking
+    asio::awaitable<core::SnmpResult> exchange(std::shared_ptr<asio::ip::udp::socket> socket,
+                                               asio::ip::udp::endpoint endpoint,
+                                               std::vector<std::string> oids,
+                                               core::SnmpDeviceConfig config, PduType pduType);
+
+    // Encode a request with the next request id (returned through requestId if given)
+    static std::vector<uint8_t> buildRequest(std::atomic<int32_t>& requestIds,
+                                             const std::vector<std::string>& oids,
+                                             const core::SnmpDeviceConfig& config,
+                                             PduType pduType, int32_t maxRepetitions = 0,
+                                             int32_t* requestId = nullptr);
 
     // Perform SNMP operation synchronously
-    core::SnmpResult performSnmpGet(const std::string& address,
-                                     const std::vector<std::string>& oids,
-                                     const core::SnmpDeviceConfig& config,
-                                     PduType pduType);
+    static core::SnmpResult performSnmpGet(std::atomic<int32_t>& requestIds,
+                                           const asio::ip::udp::endpoint& endpoint,
+                                           const std::vector<std::string>& oids,
+                                           const core::SnmpDeviceConfig& config,
+                                           PduType pduType);
 
     // SNMP packet encoding/decoding
-    std::vector<uint8_t> buildSnmpPacket(const std::vector<std::string>& oids,
-                                          const core::SnmpDeviceConfig& config,
-                                          PduType pduType,
-                                          int32_t requestId);
+    // For GetBulkRequest, maxRepetitions goes where error-index usually is
+    static std::vector<uint8_t> buildSnmpPacket(const std::vector<std::string>& oids,
+                                                const core::SnmpDeviceConfig& config,
+                                                PduType pduType,
+                                                int32_t requestId,
+                                                int32_t maxRepetitions = 0);
 
-    core::SnmpResult parseSnmpResponse(const std::vector<uint8_t>& response,
-                                        const core::SnmpDeviceConfig& config);
+    static core::SnmpResult parseSnmpResponse(const std::vector<uint8_t>& response,
+                                              const core::SnmpDeviceConfig& config,
+                                              int32_t* requestId = nullptr);
 
     // BER/ASN.1 encoding helpers
     static std::vector<uint8_t> encodeLength(size_t length);
@@ -170,15 +327,16 @@ private:
     static bool isOidPrefix(const std::string& prefix, const std::string& oid);
 
     // SNMP v3 helpers
-    std::vector<uint8_t> buildSnmpV3Packet(const std::vector<std::string>& oids,
-                                            const core::SnmpDeviceConfig& config,
-                                            PduType pduType,
-                                            int32_t requestId);
+    static std::vector<uint8_t> buildSnmpV3Packet(const std::vector<std::string>& oids,
+                                                  const core::SnmpDeviceConfig& config,
+                                                  PduType pduType,
+                                                  int32_t requestId,
+                                                  int32_t maxRepetitions = 0);
 
     AsioContext& context_;
-    std::map<int64_t, std::shared_ptr<MonitoredDevice>> monitoredDevices_;
-    mutable std::mutex mutex_;
-    std::atomic<int32_t> requestIdCounter_{1};
+    ShardedRegistry<MonitoredDevice> monitoredDevices_; // Sharded by host id
+    // Shared with queued polls and requests, which may run after the service is gone
+    std::shared_ptr<std::atomic<int32_t>> requestIds_;
 };
 
 } // namespace netpulse::infra
@@ -0,0 +1,505 @@
+#include "infrastructure/network/SynScanner.hpp"
+
+#include "core/types/Ipv4Range.hpp"
+#include "infrastructure/network/Hash.hpp"
+#include "infrastructure/network/IcmpEngine.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <random>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace netpulse::infra {
+
+namespace {
+
+constexpr size_t TCP_HEADER_SIZE = 20;
+constexpr size_t IPV4_MIN_HEADER_SIZE = 20;
+constexpr uint8_t IP_PROTOCOL_TCP = 6;
+constexpr uint8_t TCP_FLAG_RST = 0x04;
+constexpr uint8_t TCP_FLAG_SYN = 0x02;
+constexpr uint8_t TCP_FLAG_ACK = 0x10;
+constexpr size_t RECV_BUFFER_SIZE = 1500;
+constexpr size_t RECV_BATCH_SIZE = 64;
+constexpr size_t MAX_CACHED_SOURCES = 65536;
+constexpr auto SEND_RETRY_DELAY = std::chrono::milliseconds(1); // After EAGAIN/ENOBUFS
+
+void put16(uint8_t* out, uint16_t value) {
+    out[0] = static_cast<uint8_t>(value >> 8);
+    out[1] = static_cast<uint8_t>(value & 0xFF);
+}
+
+void put32(uint8_t* out, uint32_t value) {
+    put16(out, static_cast<uint16_t>(value >> 16));
+    put16(out + 2, static_cast<uint16_t>(value & 0xFFFF));
+}
+
+uint16_t get16(const uint8_t* in) {
+    return static_cast<uint16_t>((in[0] << 8) | in[1]);
+}
+
+uint32_t get32(const uint8_t* in) {
+    return (uint32_t{get16(in)} << 16) | get16(in + 2);
+}
+
+core::PortScanResult makeResult(uint32_t address, uint16_t port, core::PortState state) {
+    core::PortScanResult result;
+    result.targetAddress = core::Ipv4Range::formatAddress(address);
+    result.port = port;
+    result.state = state;
+    result.scanTimestamp = std::chrono::system_clock::now();
+    if (state == core::PortState::Open) {
+        result.serviceName = core::ServiceDetector::detectService(port);
+    }
+    return result;
+}
+
+} // namespace
+
+SynScanner::SynScanner(AsioContext& context)
+    : context_(context), socket_(context.getContext()), pacer_(context.getContext()),
+      expiry_(context.getContext()) {
+    std::random_device rd;
+    std::uniform_int_distribution<uint32_t> ports(40000, 59999);
+    sourcePort_ = static_cast<uint16_t>(ports(rd));
+    for (auto& half : sequenceKey_) {
+        half = (uint64_t{rd()} << 32) | rd();
+    }
+}
+
+SynScanner::~SynScanner() {
+    shutdown();
+}
+
+bool SynScanner::start() {
+#if defined(__linux__) || defined(__APPLE__)
+    std::lock_guard lock(mutex_);
+    if (open_) {
+        return true;
+    }
+
+    int fd = ::socket(AF_INET, SOCK_RAW, IPPROTO_TCP);
+    if (fd < 0) {
+        spdlog::info("SynScanner: raw TCP socket unavailable: {}", std::strerror(errno));
+        return false;
+    }
+
+    asio::error_code ec;
+    socket_.assign(asio::generic::raw_protocol(AF_INET, IPPROTO_TCP), fd, ec);
+    if (!ec) {
+        socket_.non_blocking(true, ec);
+    }
+    if (ec) {
+        spdlog::warn("SynScanner: failed to register raw socket: {}", ec.message());
+        ::close(fd);
+        return false;
+    }
+
+    open_ = true;
+    lastRefill_ = Clock::now();
+    tokens_ = 0.0;
+    spdlog::info("SynScanner started (source port {}, {} packets/s)", sourcePort_, rateLimit_);
+#else
+    spdlog::info("SynScanner: raw sockets not supported on this platform");
+    return false;
+#endif
+
+    // startReceive() takes the lock itself
+    asio::post(socket_.get_executor(), [self = shared_from_this()]() { self->startReceive(); });
+    return true;
+}
+
+void SynScanner::shutdown() {
+    std::vector<Completion> failed;
+    {
+        std::lock_guard lock(mutex_);
+        if (!open_.exchange(false)) {
+            return;
+        }
+
+        asio::error_code ignored;
+        socket_.close(ignored);
+        pacer_.cancel();
+        expiry_.cancel();
+        pacerArmed_ = false;
+        expiryArmedFor_ = Clock::time_point::max();
+
+        std::vector<uint64_t> keys;
+        keys.reserve(pending_.size());
+        for (const auto& [key, entry] : pending_) {
+            keys.push_back(key);
+        }
+        for (auto key : keys) {
+            failed.push_back(complete(key, core::PortState::Unknown));
+        }
+        sendQueue_.clear();
+        expiries_ = {};
+    }
+    invokeAll(failed);
+    spdlog::info("SynScanner stopped");
+}
+
+void SynScanner::setRateLimit(size_t packetsPerSecond) {
+    std::lock_guard lock(mutex_);
+    rateLimit_ = packetsPerSecond;
+}
+
+size_t SynScanner::rateLimit() const {
+    std::lock_guard lock(mutex_);
+    return rateLimit_;
+}
+
+void SynScanner::probe(const std::string& address, uint16_t port,
+                       std::chrono::milliseconds timeout, ResultCallback callback) {
+    auto target = core::Ipv4Range::parseAddress(address);
+    if (target) {
+        // Checked under the lock: an entry added after shutdown() would never complete
+        std::lock_guard lock(mutex_);
+        if (open_) {
+            auto key = keyFor(*target, port);
+            auto& entry = pending_[key];
+            if (entry.callbacks.empty()) {
+                entry.address = *target;
+                entry.port = port;
+                entry.sequence = sequenceFor(*target, port);
+                entry.timeout = timeout;
+                sendQueue_.push_back(key);
+            }
+            entry.callbacks.push_back(std::move(callback));
+            armPacer();
+            return;
+        }
+    }
+
+    core::PortScanResult result;
+    result.targetAddress = address;
+    result.port = port;
+    result.state = core::PortState::Unknown;
+    result.scanTimestamp = std::chrono::system_clock::now();
+    context_.post([callback = std::move(callback), result]() { callback(result); });
+}
+
+size_t SynScanner::outstandingCount() const {
+    std::lock_guard lock(mutex_);
+    return pending_.size();
+}
+
+std::array<uint8_t, 20> SynScanner::buildSyn(uint32_t source, uint32_t destination,
+                                             uint16_t sourcePort, uint16_t destinationPort,
+                                             uint32_t sequence) {
+    // Pseudo-header followed by the segment, so one pass computes the checksum
+    std::array<uint8_t, 12 + TCP_HEADER_SIZE> buffer{};
+    put32(buffer.data(), source);
+    put32(buffer.data() + 4, destination);
+    buffer[9] = IP_PROTOCOL_TCP;
+    put16(buffer.data() + 10, static_cast<uint16_t>(TCP_HEADER_SIZE));
+
+    uint8_t* tcp = buffer.data() + 12;
+    put16(tcp, sourcePort);
+    put16(tcp + 2, destinationPort);
+    put32(tcp + 4, sequence);
+    tcp[12] = static_cast<uint8_t>((TCP_HEADER_SIZE / 4) << 4); // Data offset
+    tcp[13] = TCP_FLAG_SYN;
+    put16(tcp + 14, 1024); // Window
+
+    put16(tcp + 16, IcmpEngine::calculateChecksum(buffer.data(), buffer.size()));
+
+    std::array<uint8_t, 20> segment{};
+    std::copy(tcp, tcp + TCP_HEADER_SIZE, segment.begin());
+    return segment;
+}
+
+std::optional<SynScanner::Reply> SynScanner::parseReply(const uint8_t* data, size_t length) {
+    if (length < IPV4_MIN_HEADER_SIZE || (data[0] >> 4) != 4 || data[9] != IP_PROTOCOL_TCP) {
+        return std::nullopt;
+    }
+    size_t ipHeader = size_t{data[0] & 0x0Fu} * 4;
+    if (ipHeader < IPV4_MIN_HEADER_SIZE || length < ipHeader + TCP_HEADER_SIZE) {
+        return std::nullopt;
+    }
+
+    const uint8_t* tcp = data + ipHeader;
+    Reply reply;
+    reply.source = get32(data + 12);
+    reply.destination = get32(data + 16);
+    reply.sourcePort = get16(tcp);
+    reply.destinationPort = get16(tcp + 2);
+    reply.acknowledgement = get32(tcp + 8);
+    reply.syn = (tcp[13] & TCP_FLAG_SYN) != 0;
+    reply.ack = (tcp[13] & TCP_FLAG_ACK) != 0;
+    reply.rst = (tcp[13] & TCP_FLAG_RST) != 0;
+    return reply;
+}
+
+uint32_t SynScanner::sequenceFor(uint32_t address, uint16_t port) const {
+    return static_cast<uint32_t>(
+        sipHash24(sequenceKey_[0], sequenceKey_[1], keyFor(address, port)));
+}
+
+std::optional<uint32_t> SynScanner::sourceFor(uint32_t destination) {
+    auto it = sources_.find(destination);
+    if (it != sources_.end()) {
+        return it->second;
+    }
+
+#if defined(__linux__) || defined(__APPLE__)
+    // Connecting a UDP socket sends nothing but makes the kernel pick the
+    // route, and with it the local address the SYN will carry
+    int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        return std::nullopt;
+    }
+    sockaddr_in remote{};
+    remote.sin_family = AF_INET;
+    remote.sin_port = htons(9);
+    remote.sin_addr.s_addr = htonl(destination);
+    sockaddr_in local{};
+    socklen_t localLength = sizeof(local);
+    bool ok = ::connect(fd, reinterpret_cast<const sockaddr*>(&remote), sizeof(remote)) == 0 &&
+              ::getsockname(fd, reinterpret_cast<sockaddr*>(&local), &localLength) == 0;
+    ::close(fd);
+    if (!ok) {
+        return std::nullopt;
+    }
+
+    if (sources_.size() >= MAX_CACHED_SOURCES) {
+        sources_.clear();
+    }
+    auto source = ntohl(local.sin_addr.s_addr);
+    sources_.emplace(destination, source);
+    return source;
+#else
+    return std::nullopt;
+#endif
+}
+
+void SynScanner::startReceive() {
+    std::lock_guard lock(mutex_);
+    if (!open_) {
+        return;
+    }
+
+    auto self = shared_from_this();
+    socket_.async_wait(asio::socket_base::wait_read, [this, self](const asio::error_code& ec) {
+        if (ec || !open_) {
+            return;
+        }
+        handleReadable();
+        startReceive();
+    });
+}
+
+void SynScanner::handleReadable() {
+    std::vector<Completion> completions;
+
+#if defined(__linux__) || defined(__APPLE__)
+    {
+        std::lock_guard lock(mutex_);
+        if (!open_) {
+            return;
+        }
+
+        std::array<uint8_t, RECV_BUFFER_SIZE> buffer;
+        for (size_t i = 0; i < RECV_BATCH_SIZE; ++i) {
+            auto received = ::recv(socket_.native_handle(), buffer.data(), buffer.size(),
+                                   MSG_DONTWAIT);
+            if (received <= 0) {
+                break;
+            }
+
+            auto reply = parseReply(buffer.data(), static_cast<size_t>(received));
+            if (!reply || reply->destinationPort != sourcePort_) {
+                continue;
+            }
+
+            auto key = keyFor(reply->source, reply->sourcePort);
+            auto it = pending_.find(key);
+            if (it == pending_.end() || it->second.deadline == Clock::time_point::max() ||
+                reply->acknowledgement != it->second.sequence + 1) {
+                continue;
+            }
+
+            if (reply->syn && reply->ack) {
+                completions.push_back(complete(key, core::PortState::Open));
+            } else if (reply->rst) {
+                completions.push_back(complete(key, core::PortState::Closed));
+            }
+        }
+    }
+#endif
+
+    invokeAll(completions);
+}
+
+void SynScanner::armPacer(std::chrono::nanoseconds minimumWait) {
+    if (pacerArmed_ || sendQueue_.empty() || !open_) {
+        return;
+    }
+    pacerArmed_ = true;
+
+    auto wait = std::chrono::nanoseconds{0};
+    if (rateLimit_ > 0 && tokens_ < 1.0) {
+        auto needed =
+            std::chrono::duration<double>((1.0 - tokens_) / static_cast<double>(rateLimit_));
+        wait = std::max(std::chrono::duration_cast<std::chrono::nanoseconds>(needed),
+                        std::chrono::nanoseconds{std::chrono::milliseconds{1}});
+    }
+    wait = std::max(wait, minimumWait);
+
+    auto self = shared_from_this();
+    pacer_.expires_after(wait);
+    pacer_.async_wait([this, self](const asio::error_code& ec) {
+        if (!ec) {
+            sendQueued();
+        }
+    });
+}
+
+void SynScanner::sendQueued() {
+    std::vector<Completion> failures;
+
+#if defined(__linux__) || defined(__APPLE__)
+    {
+        std::lock_guard lock(mutex_);
+        pacerArmed_ = false;
+        if (!open_) {
+            return;
+        }
+
+        auto now = Clock::now();
+        size_t budget = sendQueue_.size();
+        if (rateLimit_ > 0) {
+            // Allow bursts of up to 10 ms worth of packets
+            double burst = std::max(1.0, static_cast<double>(rateLimit_) / 100.0);
+            double elapsed = std::chrono::duration<double>(now - lastRefill_).count();
+            tokens_ = std::min(burst, tokens_ + elapsed * static_cast<double>(rateLimit_));
+            budget = std::min(budget, static_cast<size_t>(tokens_));
+        }
+        lastRefill_ = now;
+
+        bool blocked = false;
+        for (size_t sent = 0; sent < budget && !sendQueue_.empty(); ++sent) {
+            auto key = sendQueue_.front();
+            sendQueue_.pop_front();
+            auto it = pending_.find(key);
+            if (it == pending_.end()) {
+                continue;
+            }
+            auto& entry = it->second;
+
+            auto source = sourceFor(entry.address);
+            if (!source) {
+                failures.push_back(complete(key, core::PortState::Unknown));
+                continue;
+            }
+
+            auto segment =
+                buildSyn(*source, entry.address, sourcePort_, entry.port, entry.sequence);
+            sockaddr_in destination{};
+            destination.sin_family = AF_INET;
+            destination.sin_addr.s_addr = htonl(entry.address);
+            auto rc = ::sendto(socket_.native_handle(), segment.data(), segment.size(), 0,
+                               reinterpret_cast<const sockaddr*>(&destination),
+                               sizeof(destination));
+            if (rc < 0) {
+                if (errno == EAGAIN || errno == ENOBUFS) {
+                    // Send buffer full: back off rather than spin until it drains
+                    sendQueue_.push_front(key);
+                    blocked = true;
+                    break;
+                }
+                spdlog::debug("SynScanner: send to {}:{} failed: {}",
+                              core::Ipv4Range::formatAddress(entry.address), entry.port,
+                              std::strerror(errno));
+                failures.push_back(complete(key, core::PortState::Unknown));
+                continue;
+            }
+
+            entry.deadline = now + entry.timeout;
+            expiries_.push({entry.deadline, key});
+            if (rateLimit_ > 0) {
+                tokens_ -= 1.0;
+            }
+        }
+
+        armExpiry();
+        armPacer(blocked ? SEND_RETRY_DELAY : std::chrono::milliseconds{0});
+    }
+#endif
+
+    invokeAll(failures);
+}
+
+void SynScanner::armExpiry() {
+    if (expiries_.empty() || expiries_.top().deadline >= expiryArmedFor_) {
+        return;
+    }
+    expiryArmedFor_ = expiries_.top().deadline;
+
+    auto self = shared_from_this();
+    expiry_.expires_at(expiryArmedFor_);
+    expiry_.async_wait([this, self](const asio::error_code& ec) {
+        if (!ec) {
+            expire();
+        }
+    });
+}
+
+void SynScanner::expire() {
+    std::vector<Completion> completions;
+    {
+        std::lock_guard lock(mutex_);
+        expiryArmedFor_ = Clock::time_point::max();
+        if (!open_) {
+            return;
+        }
+
+        auto now = Clock::now();
+        while (!expiries_.empty() && expiries_.top().deadline <= now) {
+            auto expired = expiries_.top();
+            expiries_.pop();
+            auto it = pending_.find(expired.key);
+            // Entries answered meanwhile, or re-probed later, are skipped
+            if (it != pending_.end() && it->second.deadline == expired.deadline) {
+                completions.push_back(complete(expired.key, core::PortState::Filtered));
+            }
+        }
+        armExpiry();
+    }
+    invokeAll(completions);
+}
+
+SynScanner::Completion SynScanner::complete(uint64_t key, core::PortState state) {
+    Completion completion;
+    auto it = pending_.find(key);
+    if (it == pending_.end()) {
+        return completion;
+    }
+    completion.result = makeResult(it->second.address, it->second.port, state);
+    completion.callbacks = std::move(it->second.callbacks);
+    pending_.erase(it);
+    return completion;
+}
+
+void SynScanner::invokeAll(std::vector<Completion>& completions) {
+    for (auto& completion : completions) {
+        for (auto& callback : completion.callbacks) {
+            try {
+                callback(completion.result);
+            } catch (const std::exception& e) {
+                spdlog::error("SynScanner: probe callback threw: {}", e.what());
+            }
+        }
+    }
+}
+
+} // namespace netpulse::infra
@@ -0,0 +1,209 @@
+#pragma once
+
+#include "core/types/PortScanResult.hpp"
+#include "infrastructure/network/AsioContext.hpp"
+
+#include <asio.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace netpulse::infra {
+
+/**
+ * @brief Half-open ("SYN") TCP port prober over one raw socket.
+ *
+ * Sends hand-built TCP SYN segments from a single raw IPv4 socket and
+ * classifies the answer: SYN-ACK means Open, RST means Closed, and no reply
+ * before the timeout means Filtered. No connection is ever completed (the
+ * kernel answers the SYN-ACK with a RST, as it has no socket for it), and no
+ * socket or timer is allocated per port, so one engine sustains tens of
+ * thousands of probes per second.
+ *
+ * Outgoing SYNs are paced by a token bucket (setRateLimit()). Replies are
+ * matched to outstanding probes by target address and port and validated
+ * against the sequence number the probe carried. Sequence numbers are a
+ * SipHash-2-4 of the target under a per-engine random key, so an off-path
+ * host cannot forge a matching reply.
+ *
+ * @note Requires a raw socket (CAP_NET_RAW on Linux) and IPv4 targets;
+ *       start() returns false when raw sockets are unavailable so callers can
+ *       fall back to connect scans.
+ */
+class SynScanner : public std::enable_shared_from_this<SynScanner> {
+public:
+    /**
+     * @brief Callback invoked exactly once per probe.
+     * @param result Open, Closed or Filtered; Unknown if the probe could not be sent.
+     */
+    using ResultCallback = std::function<void(const core::PortScanResult&)>;
+
+    /**
+     * @brief Fields of a received TCP segment that matter to a probe.
+     */
+    struct Reply {
+        uint32_t source{0};      ///< Sender address (host byte order)
+        uint32_t destination{0}; ///< Receiver address (host byte order)
+        uint16_t sourcePort{0};
+        uint16_t destinationPort{0};
+        uint32_t acknowledgement{0};
+        bool syn{false};
+        bool ack{false};
+        bool rst{false};
+    };
+
+    static constexpr size_t DEFAULT_RATE_LIMIT = 10000; ///< Packets per second
+
+    /**
+     * @brief Constructs a stopped engine.
+     * @param context AsioContext that runs socket and timer handlers.
+     */
+    explicit SynScanner(AsioContext& context);
+
+    /**
+     * @brief Destructor. Closes the socket.
+     */
+    ~SynScanner();
+
+    SynScanner(const SynScanner&) = delete;
+    SynScanner& operator=(const SynScanner&) = delete;
+
+    /**
+     * @brief Opens the raw socket and starts reading replies.
+     * @return True if SYN probes can be sent.
+     */
+    bool start();
+
+    /**
+     * @brief Closes the socket and fails outstanding probes with Unknown.
+     */
+    void shutdown();
+
+    /**
+     * @brief Checks whether the raw socket is open.
+     * @return True after a successful start().
+     */
+    bool isAvailable() const { return open_.load(); }
+
+    /**
+     * @brief Limits outgoing SYNs.
+     * @param packetsPerSecond Maximum send rate; 0 sends without pacing.
+     */
+    void setRateLimit(size_t packetsPerSecond);
+
+    /**
+     * @brief Returns the send rate limit.
+     * @return Packets per second (0 = unlimited).
+     */
+    size_t rateLimit() const;
+
+    /**
+     * @brief Queues a SYN probe.
+     *
+     * A probe for a port that already has one outstanding shares its answer.
+     *
+     * @param address Target IPv4 address.
+     * @param port Target port.
+     * @param timeout Time to wait for a reply after the SYN is sent.
+     * @param callback Invoked once, on an Asio worker thread.
+     */
+    void probe(const std::string& address, uint16_t port, std::chrono::milliseconds timeout,
+               ResultCallback callback);
+
+    /**
+     * @brief Returns the number of probes queued or awaiting a reply.
+     * @return Outstanding probe count.
+     */
+    size_t outstandingCount() const;
+
+    /**
+     * @brief Builds a 20-byte TCP SYN segment with a valid checksum.
+     * @param source Source address (host byte order), used for the checksum.
+     * @param destination Destination address (host byte order).
+     * @param sourcePort Source port.
+     * @param destinationPort Destination port.
+     * @param sequence Initial sequence number.
+     * @return Serialized TCP header.
+     */
+    static std::array<uint8_t, 20> buildSyn(uint32_t source, uint32_t destination,
+                                            uint16_t sourcePort, uint16_t destinationPort,
+                                            uint32_t sequence);
+
+    /**
+     * @brief Parses an IPv4 datagram carrying a TCP segment.
+     * @param data Datagram starting at the IP header.
+     * @param length Datagram length.
+     * @return The reply fields, or nullopt if not a complete IPv4/TCP packet.
+     */
+    static std::optional<Reply> parseReply(const uint8_t* data, size_t length);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Pending {
+        uint32_t address{0};
+        uint16_t port{0};
+        uint32_t sequence{0};
+        std::chrono::milliseconds timeout{0};
+        Clock::time_point deadline{Clock::time_point::max()}; // Set when sent
+        std::vector<ResultCallback> callbacks;
+    };
+
+    struct Expiry {
+        Clock::time_point deadline;
+        uint64_t key;
+        bool operator>(const Expiry& other) const { return deadline > other.deadline; }
+    };
+
+    struct Completion {
+        std::vector<ResultCallback> callbacks;
+        core::PortScanResult result;
+    };
+
+    static uint64_t keyFor(uint32_t address, uint16_t port) {
+        return (uint64_t{address} << 16) | port;
+    }
+
+    uint32_t sequenceFor(uint32_t address, uint16_t port) const;
+    std::optional<uint32_t> sourceFor(uint32_t destination);
+    void startReceive();
+    void handleReadable();
+    // Wakes the sender once the queue may go; minimumWait backs off a full send buffer
+    void armPacer(std::chrono::nanoseconds minimumWait = std::chrono::nanoseconds{0});
+    void sendQueued();
+    void armExpiry();
+    void expire();
+    Completion complete(uint64_t key, core::PortState state);
+    static void invokeAll(std::vector<Completion>& completions);
+
+    AsioContext& context_;
+    asio::generic::raw_protocol::socket socket_;
+    asio::steady_timer pacer_;
+    asio::steady_timer expiry_;
+    std::atomic<bool> open_{false};
+    uint16_t sourcePort_;
+    std::array<uint64_t, 2> sequenceKey_{}; // SipHash key for sequence numbers
+
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, Pending> pending_;
+    std::deque<uint64_t> sendQueue_;
+    std::priority_queue<Expiry, std::vector<Expiry>, std::greater<>> expiries_;
+    std::unordered_map<uint32_t, uint32_t> sources_; // Destination -> local address
+    size_t rateLimit_{DEFAULT_RATE_LIMIT};
+    double tokens_{0.0};
+    Clock::time_point lastRefill_;
+    bool pacerArmed_{false};
+    Clock::time_point expiryArmedFor_{Clock::time_point::max()};
+};
+
+} // namespace netpulse::infra
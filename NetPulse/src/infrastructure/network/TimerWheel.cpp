@@ -0,0 +1,283 @@
+#include "infrastructure/network/TimerWheel.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+namespace netpulse::infra {
+
+namespace {
+// Four levels of 256 slots address 2^32 ticks (~497 days at 10 ms resolution)
+constexpr uint64_t MAX_DELAY_TICKS = (uint64_t{1} << 32) - 1;
+} // namespace
+
+TimerWheel::TimerWheel(asio::io_context& ioContext, std::chrono::milliseconds tick)
+    : timer_(ioContext), tick_(std::max(tick, std::chrono::milliseconds(1))),
+      origin_(std::chrono::steady_clock::now()) {
+    for (auto& level : slots_) {
+        level.fill(kNil);
+    }
+}
+
+TimerWheel::~TimerWheel() {
+    asio::error_code ec;
+    timer_.cancel(ec);
+}
+
+TimerWheel::JobId TimerWheel::scheduleAfter(std::chrono::milliseconds delay, Job job) {
+    return insertJob(ticksFor(delay), 0, std::move(job));
+}
+
+TimerWheel::JobId TimerWheel::scheduleEvery(std::chrono::milliseconds interval, Job job,
+                                            std::chrono::milliseconds firstDelay) {
+    return insertJob(ticksFor(firstDelay), std::max<uint64_t>(ticksFor(interval), 1),
+                     std::move(job));
+}
+
+bool TimerWheel::cancel(JobId id) {
+    if (id == 0) {
+        return false;
+    }
+
+    auto index = static_cast<uint32_t>((id & 0xFFFFFFFF) - 1);
+    auto generation = static_cast<uint32_t>(id >> 32);
+
+    std::lock_guard lock(mutex_);
+    if (index >= nodes_.size() || !nodes_[index].inUse ||
+        nodes_[index].generation != generation) {
+        return false;
+    }
+
+    unlink(index);
+    releaseNode(index);
+    return true;
+}
+
+void TimerWheel::clear() {
+    std::lock_guard lock(mutex_);
+    for (uint32_t i = 0; i < nodes_.size(); ++i) {
+        if (nodes_[i].inUse) {
+            releaseNode(i);
+        }
+    }
+    for (auto& level : slots_) {
+        level.fill(kNil);
+    }
+    jobCount_ = 0;
+
+    asio::error_code ec;
+    timer_.cancel(ec);
+    armed_ = false;
+}
+
+size_t TimerWheel::size() const {
+    std::lock_guard lock(mutex_);
+    return jobCount_;
+}
+
+TimerWheel::JobId TimerWheel::insertJob(uint64_t delayTicks, uint64_t intervalTicks, Job job) {
+    std::lock_guard lock(mutex_);
+
+    auto nowTick = currentTickLocked();
+    if (jobCount_ == 0 && nowTick > currentTick_) {
+        // Nothing to cascade, so an idle wheel can simply jump to the present
+        currentTick_ = nowTick;
+    }
+
+    uint32_t index = allocateNode();
+    auto& node = nodes_[index];
+    node.job = std::make_shared<const Job>(std::move(job));
+    node.deadline = nowTick + std::clamp<uint64_t>(delayTicks, 1, MAX_DELAY_TICKS);
+    node.interval = std::min(intervalTicks, MAX_DELAY_TICKS);
+    link(index);
+
+    armTimer();
+
+    return (static_cast<uint64_t>(node.generation) << 32) | (static_cast<uint64_t>(index) + 1);
+}
+
+uint64_t TimerWheel::ticksFor(std::chrono::milliseconds duration) const {
+    if (duration.count() <= 0) {
+        return 0;
+    }
+    // Round up so a job never runs before its requested delay
+    return static_cast<uint64_t>((duration.count() + tick_.count() - 1) / tick_.count());
+}
+
+uint64_t TimerWheel::currentTickLocked() const {
+    auto elapsed = std::chrono::steady_clock::now() - origin_;
+    return static_cast<uint64_t>(elapsed / tick_);
+}
+
+uint32_t TimerWheel::allocateNode() {
+    uint32_t index;
+    if (!freeNodes_.empty()) {
+        index = freeNodes_.back();
+        freeNodes_.pop_back();
+    } else {
+        index = static_cast<uint32_t>(nodes_.size());
+        nodes_.emplace_back();
+    }
+    nodes_[index].inUse = true;
+    ++jobCount_;
+    return index;
+}
+
+void TimerWheel::releaseNode(uint32_t index) {
+    auto& node = nodes_[index];
+    node.job.reset();
+    node.inUse = false;
+    node.prev = kNil;
+    node.next = kNil;
+    ++node.generation; // Invalidates outstanding JobIds for this slot
+    freeNodes_.push_back(index);
+    --jobCount_;
+}
+
+void TimerWheel::link(uint32_t index) {
+    auto& node = nodes_[index];
+    uint64_t deadline = std::max(node.deadline, currentTick_);
+    uint64_t delta = deadline - currentTick_;
+
+    size_t level = 0;
+    while (level + 1 < kLevels && delta >= (uint64_t{1} << (kSlotBits * (level + 1)))) {
+        ++level;
+    }
+    size_t slot = (deadline >> (kSlotBits * level)) & kSlotMask;
+
+    node.level = static_cast<uint16_t>(level);
+    node.slot = static_cast<uint16_t>(slot);
+    node.prev = kNil;
+    node.next = slots_[level][slot];
+    if (node.next != kNil) {
+        nodes_[node.next].prev = index;
+    }
+    slots_[level][slot] = index;
+}
+
+void TimerWheel::unlink(uint32_t index) {
+    auto& node = nodes_[index];
+    if (node.prev != kNil) {
+        nodes_[node.prev].next = node.next;
+    } else {
+        slots_[node.level][node.slot] = node.next;
+    }
+    if (node.next != kNil) {
+        nodes_[node.next].prev = node.prev;
+    }
+    node.prev = kNil;
+    node.next = kNil;
+}
+
+void TimerWheel::cascade(size_t level) {
+    size_t slot = (currentTick_ >> (kSlotBits * level)) & kSlotMask;
+    uint32_t index = slots_[level][slot];
+    slots_[level][slot] = kNil;
+
+    while (index != kNil) {
+        uint32_t next = nodes_[index].next;
+        link(index); // Re-file relative to the current tick
+        index = next;
+    }
+}
+
+void TimerWheel::advanceTo(uint64_t targetTick, std::vector<std::shared_ptr<const Job>>& due) {
+    if (jobCount_ == 0) {
+        currentTick_ = std::max(currentTick_, targetTick);
+        return;
+    }
+
+    while (currentTick_ < targetTick) {
+        ++currentTick_;
+
+        // Entering a new level-0 revolution: pull down jobs from higher levels,
+        // outermost first so they can trickle all the way to level 0.
+        if ((currentTick_ & kSlotMask) == 0) {
+            size_t top = 1;
+            while (top + 1 < kLevels && ((currentTick_ >> (kSlotBits * top)) & kSlotMask) == 0) {
+                ++top;
+            }
+            for (size_t level = top; level >= 1; --level) {
+                cascade(level);
+            }
+        }
+
+        size_t slot = currentTick_ & kSlotMask;
+        uint32_t index = slots_[0][slot];
+        slots_[0][slot] = kNil;
+
+        while (index != kNil) {
+            uint32_t next = nodes_[index].next;
+            auto& node = nodes_[index];
+            due.push_back(node.job);
+
+            if (node.interval > 0) {
+                // Drift-free: next deadline derives from this deadline, not from "now"
+                node.deadline += node.interval;
+                link(index);
+            } else {
+                releaseNode(index);
+            }
+            index = next;
+        }
+    }
+}
+
+uint64_t TimerWheel::nextWakeTick() const {
+    // First non-empty level-0 slot in the current revolution, otherwise the
+    // next revolution boundary where higher levels cascade.
+    uint64_t remaining = kSlots - (currentTick_ & kSlotMask);
+    for (uint64_t offset = 1; offset < remaining; ++offset) {
+        if (slots_[0][(currentTick_ + offset) & kSlotMask] != kNil) {
+            return currentTick_ + offset;
+        }
+    }
+    return currentTick_ + remaining;
+}
+
+void TimerWheel::armTimer() {
+    if (jobCount_ == 0) {
+        return;
+    }
+
+    auto wakeTick = nextWakeTick();
+    if (armed_ && armedTick_ <= wakeTick) {
+        return;
+    }
+    armed_ = true;
+    armedTick_ = wakeTick;
+
+    // Resetting the expiry cancels any earlier wait, which then completes
+    // with operation_aborted and is ignored.
+    std::weak_ptr<TimerWheel> weak = weak_from_this();
+    timer_.expires_at(origin_ + tick_ * wakeTick);
+    timer_.async_wait([weak](const asio::error_code& ec) {
+        if (ec) {
+            return;
+        }
+        if (auto self = weak.lock()) {
+            self->onTimer();
+        }
+    });
+}
+
+void TimerWheel::onTimer() {
+    std::vector<std::shared_ptr<const Job>> due;
+    {
+        std::lock_guard lock(mutex_);
+        armed_ = false;
+        advanceTo(currentTickLocked(), due);
+        armTimer();
+    }
+
+    // Everything that became due in this wake-up runs as one batch
+    for (const auto& job : due) {
+        try {
+            (*job)();
+        } catch (const std::exception& e) {
+            spdlog::error("TimerWheel job threw: {}", e.what());
+        }
+    }
+}
+
+} // namespace netpulse::infra
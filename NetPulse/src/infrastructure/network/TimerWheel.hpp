@@ -0,0 +1,145 @@
+#pragma once
+
+#include <asio.hpp>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace netpulse::infra {
+
+/**
+ * @brief Hierarchical timing wheel driven by a single Asio timer.
+ *
+ * Replaces one asio::steady_timer per scheduled item with a four-level wheel
+ * of 256 slots each. Arming and cancelling a job are O(1); jobs whose deadline
+ * falls in the same tick are collected and executed as one batch from a single
+ * timer completion. Recurring jobs keep drift-free deadlines: each run is
+ * scheduled relative to the previous deadline, not to when the job finished.
+ *
+ * Jobs run on whichever Asio worker thread completes the wheel timer, so
+ * they must not block; long-running work should be posted elsewhere.
+ *
+ * @note Create instances with std::make_shared; pending timer handlers only
+ *       hold weak references, so destroying the wheel cancels everything.
+ */
+class TimerWheel : public std::enable_shared_from_this<TimerWheel> {
+public:
+    /// Opaque handle identifying a scheduled job. Zero is never a valid id.
+    using JobId = uint64_t;
+
+    /// Callable executed when a job becomes due.
+    using Job = std::function<void()>;
+
+    /**
+     * @brief Constructs a timer wheel on the given io_context.
+     * @param ioContext The io_context that runs the driving timer.
+     * @param tick Wheel resolution; deadlines are rounded up to a whole tick.
+     */
+    explicit TimerWheel(asio::io_context& ioContext,
+                        std::chrono::milliseconds tick = std::chrono::milliseconds(10));
+
+    /**
+     * @brief Destructor. Cancels the driving timer and drops all jobs.
+     */
+    ~TimerWheel();
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    /**
+     * @brief Schedules a one-shot job.
+     * @param delay Time from now until the job runs.
+     * @param job Callable to execute.
+     * @return Handle that can be passed to cancel().
+     */
+    JobId scheduleAfter(std::chrono::milliseconds delay, Job job);
+
+    /**
+     * @brief Schedules a recurring job with drift-free deadlines.
+     * @param interval Period between consecutive runs (at least one tick).
+     * @param job Callable to execute on every run.
+     * @param firstDelay Time from now until the first run.
+     * @return Handle that can be passed to cancel().
+     */
+    JobId scheduleEvery(std::chrono::milliseconds interval, Job job,
+                        std::chrono::milliseconds firstDelay);
+
+    /**
+     * @brief Cancels a scheduled job.
+     *
+     * Safe to call from inside a running job, including the job being cancelled.
+     * A job already collected into the current batch may still run once.
+     *
+     * @param id Handle returned by scheduleAfter() or scheduleEvery().
+     * @return True if the job was pending and has been removed.
+     */
+    bool cancel(JobId id);
+
+    /**
+     * @brief Cancels all jobs and stops the driving timer.
+     */
+    void clear();
+
+    /**
+     * @brief Returns the number of scheduled jobs.
+     * @return Count of pending one-shot and recurring jobs.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Returns the wheel resolution.
+     * @return Duration of one tick.
+     */
+    std::chrono::milliseconds tick() const { return tick_; }
+
+private:
+    static constexpr size_t kLevels = 4;
+    static constexpr size_t kSlotBits = 8;
+    static constexpr size_t kSlots = size_t{1} << kSlotBits;
+    static constexpr size_t kSlotMask = kSlots - 1;
+    static constexpr uint32_t kNil = UINT32_MAX;
+
+    struct Node {
+        std::shared_ptr<const Job> job;
+        uint64_t deadline{0}; // Absolute tick
+        uint64_t interval{0}; // Ticks between runs, 0 for one-shot jobs
+        uint32_t prev{kNil};
+        uint32_t next{kNil};
+        uint32_t generation{0};
+        uint16_t level{0};
+        uint16_t slot{0};
+        bool inUse{false};
+    };
+
+    JobId insertJob(uint64_t delayTicks, uint64_t intervalTicks, Job job);
+    uint64_t ticksFor(std::chrono::milliseconds duration) const;
+    uint64_t currentTickLocked() const;
+    uint32_t allocateNode();
+    void releaseNode(uint32_t index);
+    void link(uint32_t index);
+    void unlink(uint32_t index);
+    void cascade(size_t level);
+    void advanceTo(uint64_t targetTick, std::vector<std::shared_ptr<const Job>>& due);
+    uint64_t nextWakeTick() const;
+    void armTimer();
+    void onTimer();
+
+    asio::steady_timer timer_;
+    const std::chrono::milliseconds tick_;
+    const std::chrono::steady_clock::time_point origin_;
+
+    mutable std::mutex mutex_;
+    std::vector<Node> nodes_;
+    std::vector<uint32_t> freeNodes_;
+    std::array<std::array<uint32_t, kSlots>, kLevels> slots_;
+    uint64_t currentTick_{0};
+    uint64_t armedTick_{0};
+    bool armed_{false};
+    size_t jobCount_{0};
+};
+
+} // namespace netpulse::infra
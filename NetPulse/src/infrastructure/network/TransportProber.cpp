@@ -0,0 +1,334 @@
+#include "infrastructure/network/TransportProber.hpp"
+
+#include "infrastructure/network/DnsCache.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <array>
+#include <atomic>
+#include <optional>
+#include <random>
+
+namespace netpulse::infra {
+
+namespace {
+
+constexpr size_t DNS_HEADER_SIZE = 12;
+constexpr uint16_t DNS_TYPE_NS = 2;
+constexpr uint16_t DNS_CLASS_IN = 1;
+constexpr size_t UDP_RECV_BUFFER_SIZE = 1500;
+
+// Payload for echo-style UDP services
+constexpr std::array<uint8_t, 16> UDP_PROBE_PAYLOAD = {'N', 'e', 't', 'P', 'u', 'l', 's', 'e',
+                                                       ' ', 'p', 'r', 'o', 'b', 'e', '\r', '\n'};
+
+uint16_t randomQueryId() {
+    thread_local std::mt19937 generator{std::random_device{}()};
+    return static_cast<uint16_t>(generator());
+}
+
+core::AddressFamily familyOf(const asio::ip::address& address) {
+    return address.is_v6() ? core::AddressFamily::IPv6 : core::AddressFamily::IPv4;
+}
+
+// Resolvers may hand back IPv4 addresses in v4-mapped IPv6 form
+asio::ip::address unmapped(const asio::ip::address& address) {
+    if (address.is_v6() && address.to_v6().is_v4_mapped()) {
+        return asio::ip::make_address_v4(asio::ip::v4_mapped, address.to_v6());
+    }
+    return address;
+}
+
+} // namespace
+
+// One probe's sockets and timer share a strand, so the timeout and the I/O
+// completion never touch the sockets concurrently.
+struct TransportProber::Probe {
+    explicit Probe(asio::io_context& ioContext)
+        : strand(asio::make_strand(ioContext)), tcp(strand), udp(strand), timer(strand) {}
+
+    asio::strand<asio::io_context::executor_type> strand;
+    asio::ip::tcp::socket tcp;
+    asio::ip::udp::socket udp;
+    asio::steady_timer timer;
+
+    std::string address;
+    uint16_t port{0};
+    core::ProbeType type{core::ProbeType::Tcp};
+    core::AddressFamily preference{core::AddressFamily::Any};
+    core::AddressFamily family{core::AddressFamily::Any};
+    std::chrono::milliseconds timeout{0};
+    ProbeCallback callback;
+    std::atomic<bool> done{false};
+
+    std::chrono::system_clock::time_point timestamp;
+    std::chrono::steady_clock::time_point sendTime;
+    std::vector<uint8_t> request;
+    std::array<uint8_t, UDP_RECV_BUFFER_SIZE> buffer{};
+    uint16_t queryId{0};
+};
+
+TransportProber::TransportProber(AsioContext& context) : context_(context) {}
+
+void TransportProber::probe(const core::Host& host, std::chrono::milliseconds timeout,
+                            ProbeCallback callback) {
+    auto port = static_cast<uint16_t>(host.effectiveProbePort());
+    switch (host.probeType) {
+    case core::ProbeType::Tcp:
+        probeTcp(host.address, port, timeout, std::move(callback), host.addressFamily);
+        return;
+    case core::ProbeType::Udp:
+        probeUdp(host.address, port, timeout, std::move(callback), host.addressFamily);
+        return;
+    case core::ProbeType::Dns:
+        probeDns(host.address, port, timeout, std::move(callback), host.addressFamily);
+        return;
+    case core::ProbeType::Icmp:
+        break;
+    }
+
+    core::PingResult result;
+    result.timestamp = std::chrono::system_clock::now();
+    result.errorMessage = "ICMP probes are not handled by the transport prober";
+    context_.post([callback = std::move(callback), result]() { callback(result); });
+}
+
+void TransportProber::probeTcp(const std::string& address, uint16_t port,
+                               std::chrono::milliseconds timeout, ProbeCallback callback,
+                               core::AddressFamily family) {
+    auto probe = std::make_shared<Probe>(context_.nextContext());
+    probe->address = address;
+    probe->port = port;
+    probe->type = core::ProbeType::Tcp;
+    probe->preference = family;
+    probe->timeout = timeout;
+    probe->callback = std::move(callback);
+
+    auto self = shared_from_this();
+    armTimeout(probe);
+    resolve(probe, [self, probe](const asio::ip::address& target) { self->startTcp(probe, target); });
+}
+
+void TransportProber::probeUdp(const std::string& address, uint16_t port,
+                               std::chrono::milliseconds timeout, ProbeCallback callback,
+                               core::AddressFamily family) {
+    auto probe = std::make_shared<Probe>(context_.nextContext());
+    probe->address = address;
+    probe->port = port;
+    probe->type = core::ProbeType::Udp;
+    probe->preference = family;
+    probe->timeout = timeout;
+    probe->callback = std::move(callback);
+    probe->request.assign(UDP_PROBE_PAYLOAD.begin(), UDP_PROBE_PAYLOAD.end());
+
+    auto self = shared_from_this();
+    armTimeout(probe);
+    resolve(probe, [self, probe](const asio::ip::address& target) { self->startUdp(probe, target); });
+}
+
+void TransportProber::probeDns(const std::string& address, uint16_t port,
+                               std::chrono::milliseconds timeout, ProbeCallback callback,
+                               core::AddressFamily family) {
+    auto probe = std::make_shared<Probe>(context_.nextContext());
+    probe->address = address;
+    probe->port = port;
+    probe->type = core::ProbeType::Dns;
+    probe->preference = family;
+    probe->timeout = timeout;
+    probe->callback = std::move(callback);
+    probe->queryId = randomQueryId();
+    probe->request = buildDnsQuery(probe->queryId);
+
+    auto self = shared_from_this();
+    armTimeout(probe);
+    resolve(probe, [self, probe](const asio::ip::address& target) { self->startUdp(probe, target); });
+}
+
+std::vector<uint8_t> TransportProber::buildDnsQuery(uint16_t id) {
+    std::vector<uint8_t> query(DNS_HEADER_SIZE, 0);
+    query[0] = static_cast<uint8_t>(id >> 8);
+    query[1] = static_cast<uint8_t>(id & 0xFF);
+    query[2] = 0x01; // RD: let recursive resolvers answer from cache
+    query[5] = 1;    // QDCOUNT
+
+    // Question: root name, NS, IN. Every server can answer this cheaply.
+    query.push_back(0);
+    query.push_back(static_cast<uint8_t>(DNS_TYPE_NS >> 8));
+    query.push_back(static_cast<uint8_t>(DNS_TYPE_NS & 0xFF));
+    query.push_back(static_cast<uint8_t>(DNS_CLASS_IN >> 8));
+    query.push_back(static_cast<uint8_t>(DNS_CLASS_IN & 0xFF));
+    return query;
+}
+
+bool TransportProber::isDnsResponse(const uint8_t* data, size_t length, uint16_t id) {
+    if (length < DNS_HEADER_SIZE) {
+        return false;
+    }
+    auto responseId = static_cast<uint16_t>((data[0] << 8) | data[1]);
+    bool isResponse = (data[2] & 0x80) != 0;
+    return isResponse && responseId == id;
+}
+
+void TransportProber::resolve(const std::shared_ptr<Probe>& probe,
+                              std::function<void(const asio::ip::address&)> onAddress) {
+    context_.dnsCache().resolveAsync(
+        probe->address, [probe, onAddress = std::move(onAddress)](
+                            const asio::error_code& ec, const DnsCache::Addresses& addresses) {
+            if (probe->done) {
+                return; // Timed out while resolving
+            }
+            if (ec || addresses.empty()) {
+                asio::dispatch(probe->strand, [probe]() {
+                    finish(probe, false, "Failed to resolve address: " + probe->address);
+                });
+                return;
+            }
+
+            // The preference only applies to names; a literal is its own family
+            asio::error_code parseError;
+            asio::ip::make_address(probe->address, parseError);
+            auto preference = parseError ? probe->preference : core::AddressFamily::Any;
+
+            for (const auto& candidate : addresses) {
+                auto address = unmapped(candidate);
+                if (preference == core::AddressFamily::Any || familyOf(address) == preference) {
+                    asio::dispatch(probe->strand, [probe, onAddress, address]() {
+                        if (!probe->done) {
+                            onAddress(address);
+                        }
+                    });
+                    return;
+                }
+            }
+
+            asio::dispatch(probe->strand, [probe, preference]() {
+                finish(probe, false,
+                       std::string("No ") +
+                           (preference == core::AddressFamily::IPv6 ? "IPv6" : "IPv4") +
+                           " address for " + probe->address);
+            });
+        });
+}
+
+void TransportProber::startTcp(const std::shared_ptr<Probe>& probe,
+                               const asio::ip::address& address) {
+    probe->family = familyOf(address);
+
+    asio::error_code ec;
+    asio::ip::tcp::endpoint endpoint(address, probe->port);
+    probe->tcp.open(endpoint.protocol(), ec);
+    if (ec) {
+        finish(probe, false, "Failed to create TCP socket: " + ec.message());
+        return;
+    }
+
+    probe->timestamp = std::chrono::system_clock::now();
+    probe->sendTime = std::chrono::steady_clock::now();
+    probe->tcp.async_connect(endpoint, [probe](const asio::error_code& connectError) {
+        if (connectError == asio::error::operation_aborted) {
+            return; // Closed by the timeout
+        }
+        if (connectError) {
+            finish(probe, false,
+                   connectError == asio::error::connection_refused ? "Connection refused"
+                                                                  : connectError.message());
+            return;
+        }
+        finish(probe, true, {});
+    });
+}
+
+void TransportProber::startUdp(const std::shared_ptr<Probe>& probe,
+                               const asio::ip::address& address) {
+    probe->family = familyOf(address);
+
+    // Connecting filters out datagrams from other peers and lets the kernel
+    // report ICMP port unreachable as connection_refused
+    asio::error_code ec;
+    asio::ip::udp::endpoint endpoint(address, probe->port);
+    probe->udp.open(endpoint.protocol(), ec);
+    if (!ec) {
+        probe->udp.connect(endpoint, ec);
+    }
+    if (ec) {
+        finish(probe, false, "Failed to create UDP socket: " + ec.message());
+        return;
+    }
+
+    probe->timestamp = std::chrono::system_clock::now();
+    probe->sendTime = std::chrono::steady_clock::now();
+    probe->udp.async_send(asio::buffer(probe->request),
+                          [probe](const asio::error_code& sendError, size_t /*bytes*/) {
+                              if (sendError == asio::error::operation_aborted) {
+                                  return;
+                              }
+                              if (sendError) {
+                                  finish(probe, false, "Send failed: " + sendError.message());
+                                  return;
+                              }
+                              receiveUdp(probe);
+                          });
+}
+
+void TransportProber::receiveUdp(const std::shared_ptr<Probe>& probe) {
+    probe->udp.async_receive(
+        asio::buffer(probe->buffer), [probe](const asio::error_code& ec, size_t length) {
+            if (ec == asio::error::operation_aborted) {
+                return;
+            }
+            if (ec) {
+                finish(probe, false,
+                       ec == asio::error::connection_refused ? "Port unreachable" : ec.message());
+                return;
+            }
+
+            // Stray datagrams (e.g. a late answer to an earlier query) are skipped
+            if (probe->type == core::ProbeType::Dns &&
+                !isDnsResponse(probe->buffer.data(), length, probe->queryId)) {
+                receiveUdp(probe);
+                return;
+            }
+            finish(probe, true, {});
+        });
+}
+
+void TransportProber::armTimeout(const std::shared_ptr<Probe>& probe) {
+    probe->timestamp = std::chrono::system_clock::now();
+    probe->timer.expires_after(probe->timeout);
+    probe->timer.async_wait([probe](const asio::error_code& ec) {
+        if (!ec) {
+            finish(probe, false, "Request timed out");
+        }
+    });
+}
+
+void TransportProber::finish(const std::shared_ptr<Probe>& probe, bool success,
+                             const std::string& error) {
+    if (probe->done.exchange(true)) {
+        return;
+    }
+
+    core::PingResult result;
+    result.timestamp = probe->timestamp;
+    result.success = success;
+    result.family = probe->family;
+    if (success) {
+        result.latency = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - probe->sendTime);
+    } else {
+        result.errorMessage = error;
+        spdlog::debug("{} probe to {}:{} failed: {}", core::Host::probeTypeToString(probe->type),
+                      probe->address, probe->port, error);
+    }
+
+    asio::error_code ignored;
+    probe->timer.cancel();
+    probe->tcp.close(ignored);
+    probe->udp.close(ignored);
+
+    if (probe->callback) {
+        probe->callback(result);
+    }
+}
+
+} // namespace netpulse::infra
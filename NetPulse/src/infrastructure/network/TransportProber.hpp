@@ -0,0 +1,136 @@
+#pragma once
+
+#include "core/types/PingResult.hpp"
+#include "infrastructure/network/AsioContext.hpp"
+
+#include <asio.hpp>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace netpulse::infra {
+
+/**
+ * @brief Reachability probes over TCP and UDP for hosts that drop ICMP.
+ *
+ * Every probe runs on the shared Asio event loop: hostnames go through the
+ * shared DnsCache and the connect, send and receive are asynchronous, with one
+ * steady_timer bounding each probe. Results use the same core::PingResult as
+ * ICMP echoes, so callers store and alert on them unchanged. Latency is the
+ * TCP handshake time, or the time until the first UDP reply.
+ *
+ * @note Create instances with std::make_shared; in-flight probes keep the
+ *       prober alive until they complete.
+ */
+class TransportProber : public std::enable_shared_from_this<TransportProber> {
+public:
+    /**
+     * @brief Callback invoked exactly once per probe.
+     * @param result The completed result (success, timeout or error).
+     */
+    using ProbeCallback = std::function<void(const core::PingResult&)>;
+
+    /**
+     * @brief Constructs a prober bound to the given Asio context.
+     * @param context Reference to the AsioContext that runs socket and timer handlers.
+     */
+    explicit TransportProber(AsioContext& context);
+
+    TransportProber(const TransportProber&) = delete;
+    TransportProber& operator=(const TransportProber&) = delete;
+
+    /**
+     * @brief Probes a host the way its ProbeType asks for.
+     *
+     * Uses Host::effectiveProbePort() and Host::addressFamily. ICMP hosts are
+     * rejected with an error result; they belong to IcmpEngine.
+     *
+     * @param host The host to probe.
+     * @param timeout Maximum time for the whole probe.
+     * @param callback Invoked once with the result.
+     */
+    void probe(const core::Host& host, std::chrono::milliseconds timeout,
+               ProbeCallback callback);
+
+    /**
+     * @brief Measures the TCP handshake time to a port.
+     *
+     * Succeeds once the connection is established; a refused connection or
+     * timeout fails the probe. The connection is closed immediately.
+     *
+     * @param address Target hostname, IPv4 or IPv6 address.
+     * @param port TCP port to connect to.
+     * @param timeout Maximum time to wait for the handshake.
+     * @param callback Invoked once with the result.
+     * @param family Address family to use for hostnames.
+     */
+    void probeTcp(const std::string& address, uint16_t port, std::chrono::milliseconds timeout,
+                  ProbeCallback callback,
+                  core::AddressFamily family = core::AddressFamily::Any);
+
+    /**
+     * @brief Sends a UDP datagram and waits for any reply from the target.
+     *
+     * Suits echo-style services. An ICMP port unreachable fails the probe.
+     *
+     * @param address Target hostname, IPv4 or IPv6 address.
+     * @param port UDP port to send to.
+     * @param timeout Maximum time to wait for a reply.
+     * @param callback Invoked once with the result.
+     * @param family Address family to use for hostnames.
+     */
+    void probeUdp(const std::string& address, uint16_t port, std::chrono::milliseconds timeout,
+                  ProbeCallback callback,
+                  core::AddressFamily family = core::AddressFamily::Any);
+
+    /**
+     * @brief Sends a DNS query and waits for the matching response.
+     *
+     * Any response carrying the query's id counts, whatever its rcode: the
+     * server answered, which is what reachability needs.
+     *
+     * @param address Target hostname, IPv4 or IPv6 address of the DNS server.
+     * @param port UDP port of the DNS server.
+     * @param timeout Maximum time to wait for the response.
+     * @param callback Invoked once with the result.
+     * @param family Address family to use for hostnames.
+     */
+    void probeDns(const std::string& address, uint16_t port, std::chrono::milliseconds timeout,
+                  ProbeCallback callback,
+                  core::AddressFamily family = core::AddressFamily::Any);
+
+    /**
+     * @brief Builds a DNS query for the root zone's NS records.
+     * @param id Query id echoed back by the server.
+     * @return Serialized query.
+     */
+    static std::vector<uint8_t> buildDnsQuery(uint16_t id);
+
+    /**
+     * @brief Checks whether a datagram is the response to a DNS query.
+     * @param data Received bytes.
+     * @param length Number of bytes.
+     * @param id Id of the query that was sent.
+     * @return True if the header has the QR bit set and the matching id.
+     */
+    static bool isDnsResponse(const uint8_t* data, size_t length, uint16_t id);
+
+private:
+    struct Probe;
+
+    void resolve(const std::shared_ptr<Probe>& probe,
+                 std::function<void(const asio::ip::address&)> onAddress);
+    void startTcp(const std::shared_ptr<Probe>& probe, const asio::ip::address& address);
+    void startUdp(const std::shared_ptr<Probe>& probe, const asio::ip::address& address);
+    static void receiveUdp(const std::shared_ptr<Probe>& probe);
+    static void armTimeout(const std::shared_ptr<Probe>& probe);
+    static void finish(const std::shared_ptr<Probe>& probe, bool success,
+                       const std::string& error);
+
+    AsioContext& context_;
+};
+
+} // namespace netpulse::infra
@@ -11,6 +11,8 @@
 #include <QInputDialog>
 #include <QMenuBar>
 #include <QMessageBox>
+#include <QPointer>
+#include <QProgressDialog>
 #include <QSplitter>
 #include <QStackedWidget>
 #include <QStatusBar>
@@ -160,6 +162,9 @@ void MainWindow::setupMenuBar() {
     portScanAction_ = toolsMenu->addAction("&Port Scanner...", this, &MainWindow::onPortScan);
     portScanAction_->setShortcut(QKeySequence("Ctrl+P"));
 
+    discoverHostsAction_ =
+        toolsMenu->addAction("&Discover Hosts...", this, &MainWindow::onDiscoverHosts);
+
     toolsMenu->addSeparator();
 
     settingsAction_ = toolsMenu->addAction("&Settings...", this, &MainWindow::onSettings);
@@ -185,10 +190,12 @@ void MainWindow::setupStatusBar() {
     statusLabel_ = new QLabel("Ready", this);
     hostCountLabel_ = new QLabel("Hosts: 0", this);
     networkStatusLabel_ = new QLabel("Network: OK", this);
+    eventLoopLabel_ = new QLabel("Loop: --", this);
 
     statusBar()->addWidget(statusLabel_, 1);
     statusBar()->addPermanentWidget(hostCountLabel_);
     statusBar()->addPermanentWidget(networkStatusLabel_);
+    statusBar()->addPermanentWidget(eventLoopLabel_);
 }
 
 void MainWindow::setupSystemTray() {
@@ -308,6 +315,78 @@ void MainWindow::onPortScan() {
     dialog.exec();
 }
 
+void MainWindow::onDiscoverHosts() {
+    bool ok;
+    QString targets = QInputDialog::getText(
+        this, "Discover Hosts", "Addresses or CIDR ranges to sweep (e.g. 192.168.1.0/24):",
+        QLineEdit::Normal, QString(), &ok);
+    if (!ok || targets.trimmed().isEmpty())
+        return;
+
+    core::DiscoveryConfig config;
+    config.targetAddress = targets.trimmed().toStdString();
+    if (config.getAddresses().empty()) {
+        QMessageBox::warning(this, "Discover Hosts",
+                             "Enter IPv4 addresses or CIDR ranges such as 10.0.0.0/24.");
+        return;
+    }
+
+    // Non-modal, so the window stays usable during a long sweep
+    auto* progress = new QProgressDialog("Sweeping " + targets.trimmed() + "...", "Cancel", 0,
+                                         100, this);
+    progress->setWindowTitle("Discover Hosts");
+    progress->setAttribute(Qt::WA_DeleteOnClose);
+    progress->setAutoClose(false);
+    progress->setAutoReset(false);
+    progress->setMinimumDuration(0);
+    QPointer<QProgressDialog> dialog(progress);
+    discoverHostsAction_->setEnabled(false);
+
+    auto onProgress = [this, dialog](const core::DiscoveryProgress& state) {
+        QMetaObject::invokeMethod(
+            this,
+            [dialog, percent = static_cast<int>(state.percentComplete()),
+             found = state.hostsFound]() {
+                if (dialog) {
+                    dialog->setValue(percent);
+                    dialog->setLabelText(QString("%1 live hosts found").arg(found));
+                }
+            },
+            Qt::QueuedConnection);
+    };
+    auto onComplete = [this, dialog](const std::vector<core::DiscoveredHost>& hosts) {
+        QMetaObject::invokeMethod(
+            this,
+            [this, dialog, hosts]() {
+                if (dialog) {
+                    dialog->close();
+                }
+                discoverHostsAction_->setEnabled(true);
+                try {
+                    auto ids = app::Application::instance()
+                                   .hostMonitorViewModel()
+                                   .addDiscoveredHosts(hosts);
+                    statusLabel_->setText(QString("Discovery found %1 live hosts, %2 new")
+                                              .arg(hosts.size())
+                                              .arg(ids.size()));
+                } catch (const std::exception& e) {
+                    statusLabel_->setText(
+                        QString("Discovery found %1 live hosts").arg(hosts.size()));
+                    QMessageBox::warning(this, "Discover Hosts",
+                                         QString("Failed to add discovered hosts: %1")
+                                             .arg(QString::fromStdString(e.what())));
+                }
+            },
+            Qt::QueuedConnection);
+    };
+
+    auto& sweeper = app::Application::instance().hostSweeper();
+    auto sweepId = sweeper.sweepAsync(config, nullptr, onProgress, onComplete);
+    connect(progress, &QProgressDialog::canceled, this,
+            [&sweeper, sweepId]() { sweeper.cancel(sweepId); });
+    progress->show();
+}
+
 void MainWindow::onSettings() {
     SettingsDialog dialog(this);
     if (dialog.exec() == QDialog::Accepted) {
@@ -433,6 +512,38 @@ void MainWindow::updateStatusBar() {
     } else {
         networkStatusLabel_->setText("Network: --");
     }
+
+    auto metrics = app::Application::instance().asioContext().loopMetrics();
+    if (metrics.samples == 0) {
+        eventLoopLabel_->setText("Loop: --");
+        return;
+    }
+
+    double lagMs = static_cast<double>(metrics.queueLatencyAvg.count()) / 1000.0;
+    QString text = QString("Loop: %1 ms lag").arg(lagMs, 0, 'f', 1);
+    if (metrics.busyPercent >= 0.0) {
+        text += QString(", %1% busy").arg(metrics.busyPercent, 0, 'f', 0);
+    }
+    // Queued handlers waiting over 50 ms are noticeable as UI and probe delays
+    if (metrics.queueLatencyMax.count() > 50'000) {
+        text = QString("<span style='color:orange'>%1</span>").arg(text);
+    }
+    eventLoopLabel_->setText(text);
+
+    QStringList details;
+    details << QString("%1 handlers/s, longest handler %2 ms")
+                   .arg(metrics.handlersPerSecond, 0, 'f', 0)
+                   .arg(static_cast<double>(metrics.longestHandler.count()) / 1000.0, 0, 'f', 1);
+    for (const auto& worker : metrics.workers) {
+        QString busy = worker.busyPercent >= 0.0
+                           ? QString("%1% busy").arg(worker.busyPercent, 0, 'f', 0)
+                           : QString("busy n/a");
+        details << QString("Thread %1: %2 handlers/s, %3")
+                       .arg(worker.index)
+                       .arg(worker.handlersPerSecond, 0, 'f', 0)
+                       .arg(busy);
+    }
+    eventLoopLabel_->setToolTip(details.join('\n'));
 }
 
 void MainWindow::refreshInterfaceStats() {
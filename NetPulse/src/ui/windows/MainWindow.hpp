@@ -36,6 +36,7 @@ private slots:
     void onRemoveHost();
     void onEditHost();
     void onPortScan();
+    void onDiscoverHosts();
     void onSettings();
     void onExportData();
     void onAbout();
@@ -95,12 +96,14 @@ private:
     QLabel* statusLabel_{nullptr};
     QLabel* hostCountLabel_{nullptr};
     QLabel* networkStatusLabel_{nullptr};
+    QLabel* eventLoopLabel_{nullptr};
 
     // Actions
     QAction* addHostAction_{nullptr};
     QAction* removeHostAction_{nullptr};
     QAction* editHostAction_{nullptr};
     QAction* portScanAction_{nullptr};
+    QAction* discoverHostsAction_{nullptr};
     QAction* settingsAction_{nullptr};
     QAction* exportAction_{nullptr};
     QAction* quitAction_{nullptr};
@@ -8,6 +8,7 @@
 #include <QHeaderView>
 #include <QLabel>
 #include <QMessageBox>
+#include <QPointer>
 #include <QSpinBox>
 #include <QVBoxLayout>
 
@@ -20,6 +21,19 @@ PortScanDialog::PortScanDialog(QWidget* parent) : QDialog(parent) {
     setupUi();
 }
 
+PortScanDialog::~PortScanDialog() {
+    if (scanning_) {
+        app::Application::instance().portScanner().cancel(scanId_);
+    }
+}
+
+void PortScanDialog::done(int result) {
+    if (scanning_) {
+        onCancelScan();
+    }
+    QDialog::done(result);
+}
+
 void PortScanDialog::setupUi() {
     auto* mainLayout = new QVBoxLayout(this);
 
@@ -28,7 +42,7 @@ void PortScanDialog::setupUi() {
     auto* targetLayout = new QFormLayout(targetGroup);
 
     addressEdit_ = new QLineEdit(this);
-    addressEdit_->setPlaceholderText("IP address or hostname");
+    addressEdit_->setPlaceholderText("IP address, hostname or CIDR range (comma-separated)");
     targetLayout->addRow("Address:", addressEdit_);
 
     portRangeCombo_ = new QComboBox(this);
@@ -65,6 +79,18 @@ void PortScanDialog::setupUi() {
     timeoutSpin_->setSuffix(" ms");
     optionsLayout->addRow("Timeout:", timeoutSpin_);
 
+    scanModeCombo_ = new QComboBox(this);
+    scanModeCombo_->addItem("TCP connect", static_cast<int>(core::ScanMode::Connect));
+    scanModeCombo_->addItem("SYN (raw socket)", static_cast<int>(core::ScanMode::Syn));
+    scanModeCombo_->setToolTip("SYN scans need raw socket access and fall back to TCP connect");
+    optionsLayout->addRow("Scan Type:", scanModeCombo_);
+
+    bannerCheck_ = new QCheckBox("Identify services from banners", this);
+    bannerCheck_->setChecked(config.portScanBanners);
+    bannerCheck_->setToolTip("Reads what open ports send to detect the service and version "
+                             "(TCP connect scans only)");
+    optionsLayout->addRow("", bannerCheck_);
+
     mainLayout->addWidget(optionsGroup);
 
     // Results
@@ -72,8 +98,8 @@ void PortScanDialog::setupUi() {
     auto* resultsLayout = new QVBoxLayout(resultsGroup);
 
     resultsTable_ = new QTableWidget(this);
-    resultsTable_->setColumnCount(3);
-    resultsTable_->setHorizontalHeaderLabels({"Port", "State", "Service"});
+    resultsTable_->setColumnCount(5);
+    resultsTable_->setHorizontalHeaderLabels({"Host", "Port", "State", "Service", "Version"});
     resultsTable_->horizontalHeader()->setStretchLastSection(true);
     resultsTable_->setSelectionBehavior(QAbstractItemView::SelectRows);
     resultsTable_->setEditTriggers(QAbstractItemView::NoEditTriggers);
@@ -126,7 +152,14 @@ void PortScanDialog::onStartScan() {
     config.range =
         static_cast<core::PortRange>(portRangeCombo_->currentData().toInt());
     config.maxConcurrency = concurrencySpin_->value();
+    const auto& appConfig = app::Application::instance().config().config();
+    config.maxPerTarget = appConfig.portScanPerTarget;
+    config.maxRetries = appConfig.portScanRetries;
+    config.adaptiveRate = appConfig.portScanAdaptive;
     config.timeout = std::chrono::milliseconds(timeoutSpin_->value());
+    config.mode = static_cast<core::ScanMode>(scanModeCombo_->currentData().toInt());
+    config.grabBanners = bannerCheck_->isChecked();
+    config.bannerTimeout = std::chrono::milliseconds(appConfig.portScanBannerTimeoutMs);
 
     if (config.range == core::PortRange::Custom) {
         QString customPorts = customPortsEdit_->text().trimmed();
@@ -157,30 +190,80 @@ void PortScanDialog::onStartScan() {
 
     resultsTable_->setRowCount(0);
     progressBar_->setValue(0);
+    unresolvedTargets_.clear();
     updateUiForScanning(true);
 
     auto& scanner = app::Application::instance().portScanner();
 
-    scanner.scanAsync(
-        config,
-        [this](const core::PortScanResult& result) {
-            QMetaObject::invokeMethod(this, [this, result]() { onScanResult(result); },
-                                      Qt::QueuedConnection);
-        },
-        [this](const core::PortScanProgress& progress) {
+    // The scan reports from I/O threads and may outlive the dialog; calls
+    // that arrive after it is gone are dropped
+    QPointer<PortScanDialog> self(this);
+    auto onResult = [self](const core::PortScanResult& result) {
+        if (!self) {
+            return;
+        }
+        QMetaObject::invokeMethod(
+            self, [self, result]() { self->onScanResult(result); }, Qt::QueuedConnection);
+    };
+    auto onProgress = [self](const core::PortScanProgress& progress) {
+        if (!self) {
+            return;
+        }
+        if (!progress.unresolvedTargets.empty()) {
+            QStringList names;
+            for (const auto& name : progress.unresolvedTargets) {
+                names << QString::fromStdString(name);
+            }
             QMetaObject::invokeMethod(
-                this,
-                [this, scanned = progress.scannedPorts, total = progress.totalPorts,
-                 open = progress.openPorts]() { onScanProgress(scanned, total, open); },
+                self, [self, names]() { self->unresolvedTargets_ = names; },
                 Qt::QueuedConnection);
-        },
-        [this](const std::vector<core::PortScanResult>&) {
-            QMetaObject::invokeMethod(this, [this]() { onScanComplete(); }, Qt::QueuedConnection);
-        });
+        }
+        QMetaObject::invokeMethod(
+            self,
+            [self, scanned = progress.scannedPorts, total = progress.totalPorts,
+             open = progress.openPorts, rate = progress.probesPerSecond]() {
+                self->onScanProgress(scanned, total, open, rate);
+            },
+            Qt::QueuedConnection);
+    };
+    auto onComplete = [self](const std::vector<core::PortScanResult>&) {
+        if (!self) {
+            return;
+        }
+        QMetaObject::invokeMethod(
+            self, [self]() { self->onScanComplete(); }, Qt::QueuedConnection);
+    };
+
+    // Offer to continue an unfinished scan of the same targets and ports
+    auto& checkpoints = app::Application::instance().scanCheckpoints();
+    for (const auto& checkpoint : checkpoints.findResumable()) {
+        if (checkpoint.config.targetAddress != config.targetAddress ||
+            checkpoint.config.getPortsToScan() != config.getPortsToScan()) {
+            continue;
+        }
+
+        auto answer = QMessageBox::question(
+            this, "Resume Scan",
+            QString("A previous scan of %1 stopped after %2 of %3 ports. Resume it?")
+                .arg(address)
+                .arg(checkpoint.scannedPorts())
+                .arg(checkpoint.totalPorts()));
+        if (answer == QMessageBox::Yes) {
+            for (const auto& result : checkpoint.results) {
+                onScanResult(result);
+            }
+            scanId_ = scanner.resumeAsync(checkpoint, onResult, onProgress, onComplete);
+            return;
+        }
+        checkpoints.remove(checkpoint.key);
+        break;
+    }
+
+    scanId_ = scanner.scanAsync(config, onResult, onProgress, onComplete);
 }
 
 void PortScanDialog::onCancelScan() {
-    app::Application::instance().portScanner().cancel();
+    app::Application::instance().portScanner().cancel(scanId_);
     statusLabel_->setText("Scan cancelled");
     updateUiForScanning(false);
 }
@@ -189,28 +272,39 @@ void PortScanDialog::onScanResult(const core::PortScanResult& result) {
     int row = resultsTable_->rowCount();
     resultsTable_->insertRow(row);
 
-    resultsTable_->setItem(row, 0, new QTableWidgetItem(QString::number(result.port)));
-    resultsTable_->setItem(row, 1, new QTableWidgetItem(QString::fromStdString(result.stateToString())));
-    resultsTable_->setItem(row, 2, new QTableWidgetItem(QString::fromStdString(result.serviceName)));
+    resultsTable_->setItem(row, 0, new QTableWidgetItem(QString::fromStdString(result.targetAddress)));
+    resultsTable_->setItem(row, 1, new QTableWidgetItem(QString::number(result.port)));
+    resultsTable_->setItem(row, 2, new QTableWidgetItem(QString::fromStdString(result.stateToString())));
+    resultsTable_->setItem(row, 3, new QTableWidgetItem(QString::fromStdString(result.serviceName)));
+    auto* version = new QTableWidgetItem(QString::fromStdString(result.serviceVersion));
+    version->setToolTip(QString::fromStdString(result.banner));
+    resultsTable_->setItem(row, 4, version);
 
     // Color code by state
     QColor color = result.state == core::PortState::Open ? QColor(0, 200, 0) : QColor(128, 128, 128);
-    for (int col = 0; col < 3; ++col) {
+    for (int col = 0; col < resultsTable_->columnCount(); ++col) {
         resultsTable_->item(row, col)->setForeground(color);
     }
 }
 
-void PortScanDialog::onScanProgress(int scanned, int total, int open) {
+void PortScanDialog::onScanProgress(int scanned, int total, int open, double probesPerSecond) {
     if (total > 0) {
         progressBar_->setMaximum(total);
         progressBar_->setValue(scanned);
-        statusLabel_->setText(
-            QString("Scanning... %1/%2 (%3 open)").arg(scanned).arg(total).arg(open));
+        statusLabel_->setText(QString("Scanning... %1/%2 (%3 open, %4 probes/s)")
+                                  .arg(scanned)
+                                  .arg(total)
+                                  .arg(open)
+                                  .arg(probesPerSecond, 0, 'f', 0));
     }
 }
 
 void PortScanDialog::onScanComplete() {
-    statusLabel_->setText(QString("Scan complete. Found %1 open port(s).").arg(resultsTable_->rowCount()));
+    auto status = QString("Scan complete. Found %1 open port(s).").arg(resultsTable_->rowCount());
+    if (!unresolvedTargets_.isEmpty()) {
+        status += QString(" Could not resolve: %1").arg(unresolvedTargets_.join(", "));
+    }
+    statusLabel_->setText(status);
     updateUiForScanning(false);
 }
 
@@ -224,6 +318,8 @@ void PortScanDialog::updateUiForScanning(bool scanning) {
                                                   static_cast<int>(core::PortRange::Custom));
     concurrencySpin_->setEnabled(!scanning);
     timeoutSpin_->setEnabled(!scanning);
+    scanModeCombo_->setEnabled(!scanning);
+    bannerCheck_->setEnabled(!scanning);
 }
 
 } // namespace netpulse::ui
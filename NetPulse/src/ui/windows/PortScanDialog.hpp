@@ -1,7 +1,9 @@
 #pragma once
 
+#include "core/services/IPortScanner.hpp"
 #include "core/types/PortScanResult.hpp"
 
+#include <QCheckBox>
 #include <QComboBox>
 #include <QDialog>
 #include <QLabel>
@@ -9,6 +11,7 @@
 #include <QProgressBar>
 #include <QPushButton>
 #include <QSpinBox>
+#include <QStringList>
 #include <QTableWidget>
 
 namespace netpulse::ui {
@@ -18,13 +21,17 @@ class PortScanDialog : public QDialog {
 
 public:
     explicit PortScanDialog(QWidget* parent = nullptr);
+    ~PortScanDialog() override;
+
+    /// Cancels a running scan before the dialog closes
+    void done(int result) override;
 
 private slots:
     void onStartScan();
     void onCancelScan();
     void onPortRangeChanged(int index);
     void onScanResult(const core::PortScanResult& result);
-    void onScanProgress(int scanned, int total, int open);
+    void onScanProgress(int scanned, int total, int open, double probesPerSecond);
     void onScanComplete();
 
 private:
@@ -36,6 +43,8 @@ private:
     QLineEdit* customPortsEdit_{nullptr};
     QSpinBox* concurrencySpin_{nullptr};
     QSpinBox* timeoutSpin_{nullptr};
+    QComboBox* scanModeCombo_{nullptr};
+    QCheckBox* bannerCheck_{nullptr};
 
     QTableWidget* resultsTable_{nullptr};
     QProgressBar* progressBar_{nullptr};
@@ -45,6 +54,8 @@ private:
     QPushButton* cancelButton_{nullptr};
 
     bool scanning_{false};
+    QStringList unresolvedTargets_; // Names of the current scan that did not resolve
+    core::IPortScanner::ScanId scanId_{0};
 };
 
 } // namespace netpulse::ui
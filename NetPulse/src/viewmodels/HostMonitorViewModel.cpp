@@ -27,6 +27,47 @@ int64_t HostMonitorViewModel::addHost(const std::string& name, const std::string
     return id;
 }
 
+std::vector<int64_t>
+HostMonitorViewModel::addDiscoveredHosts(const std::vector<core::DiscoveredHost>& hosts) {
+    std::vector<std::string> addresses;
+    addresses.reserve(hosts.size());
+    for (const auto& discovered : hosts) {
+        addresses.push_back(discovered.address);
+    }
+    auto existing = hostRepo_->findExistingAddresses(addresses);
+
+    std::vector<core::Host> added;
+    auto now = std::chrono::system_clock::now();
+    for (const auto& discovered : hosts) {
+        // Also drops repeats within the list itself
+        if (!existing.insert(discovered.address).second) {
+            continue;
+        }
+        core::Host host;
+        host.name = discovered.address;
+        host.address = discovered.address;
+        host.createdAt = now;
+        host.status = core::HostStatus::Unknown;
+        host.enabled = true;
+        host.addressFamily = core::AddressFamily::IPv4;
+        // A refused port proves the host is there but would never connect
+        if (discovered.method == core::DiscoveryMethod::Tcp && discovered.portOpen) {
+            host.probeType = core::ProbeType::Tcp;
+            host.probePort = discovered.port;
+        }
+        added.push_back(std::move(host));
+    }
+
+    auto ids = hostRepo_->insertBatch(added);
+    spdlog::info("Added {} discovered hosts ({} already known)", ids.size(),
+                 hosts.size() - ids.size());
+
+    for (auto id : ids) {
+        emit hostAdded(id);
+    }
+    return ids;
+}
+
 void HostMonitorViewModel::updateHost(const core::Host& host) {
     hostRepo_->update(host);
     spdlog::info("Updated host: {} ({})", host.name, host.address);
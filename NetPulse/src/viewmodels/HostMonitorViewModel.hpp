@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "core/types/DiscoveryResult.hpp"
 #include "core/types/Host.hpp"
 #include "infrastructure/database/HostRepository.hpp"
 #include "infrastructure/database/MetricsRepository.hpp"
@@ -48,6 +49,18 @@ public:
      */
     int64_t addHost(const std::string& name, const std::string& address);
 
+    /**
+     * @brief Adds the hosts a discovery sweep found, skipping known addresses.
+     *
+     * Known addresses are looked up in one pass and the new hosts are
+     * inserted in a single transaction. Hosts that answered only TCP are
+     * monitored with a TCP probe on the port that answered.
+     *
+     * @param hosts Live hosts reported by a discovery sweep.
+     * @return IDs of the hosts added.
+     */
+    std::vector<int64_t> addDiscoveredHosts(const std::vector<core::DiscoveredHost>& hosts);
+
     /**
      * @brief Updates an existing host's configuration.
      * @param host The host object with updated fields.
@@ -0,0 +1,189 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "infrastructure/network/AsioContext.hpp"
+#include "infrastructure/network/TimerWheel.hpp"
+#include "infrastructure/network/TransportProber.hpp"
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+
+using namespace netpulse::core;
+using namespace netpulse::infra;
+using namespace std::chrono_literals;
+
+TEST_CASE("AsioContext topology", "[AsioContext]") {
+    SECTION("Shared topology uses one context") {
+        AsioContext context(4);
+
+        REQUIRE(context.topology() == AsioContext::Topology::Shared);
+        REQUIRE(context.threadCount() == 4);
+        REQUIRE(context.contextCount() == 1);
+        REQUIRE(&context.nextContext() == &context.getContext());
+        REQUIRE(&context.contextFor(42) == &context.getContext());
+        REQUIRE(&context.timerWheelFor(42) == &context.timerWheel());
+    }
+
+    SECTION("Per-thread topology creates one context per worker") {
+        AsioContext context(3, AsioContext::Topology::PerThread);
+
+        REQUIRE(context.contextCount() == 3);
+
+        std::set<asio::io_context*> seen;
+        for (int i = 0; i < 3; ++i) {
+            seen.insert(&context.nextContext());
+        }
+        REQUIRE(seen.size() == 3);
+    }
+
+    SECTION("Hashed assignment is stable and spreads keys") {
+        AsioContext context(4, AsioContext::Topology::PerThread);
+
+        std::set<asio::io_context*> seen;
+        for (uint64_t key = 1; key <= 64; ++key) {
+            REQUIRE(&context.contextFor(key) == &context.contextFor(key));
+            seen.insert(&context.contextFor(key));
+        }
+        REQUIRE(seen.size() == 4);
+    }
+
+    SECTION("Each context drives a timer wheel of its own") {
+        AsioContext context(4, AsioContext::Topology::PerThread);
+
+        std::set<TimerWheel*> wheels;
+        for (uint64_t key = 1; key <= 64; ++key) {
+            REQUIRE(&context.timerWheelFor(key) == &context.timerWheelFor(key));
+            wheels.insert(&context.timerWheelFor(key));
+        }
+        REQUIRE(wheels.size() == 4);
+    }
+
+    SECTION("Zero threads falls back to one") {
+        AsioContext context(0, AsioContext::Topology::PerThread);
+        REQUIRE(context.threadCount() == 1);
+        REQUIRE(context.contextCount() == 1);
+    }
+
+    SECTION("Topology names round-trip") {
+        REQUIRE(AsioContext::topologyFromString("per_thread") ==
+                AsioContext::Topology::PerThread);
+        REQUIRE(AsioContext::topologyFromString("shared") == AsioContext::Topology::Shared);
+        REQUIRE(AsioContext::topologyFromString("bogus") == AsioContext::Topology::Shared);
+        REQUIRE(AsioContext::topologyToString(AsioContext::Topology::PerThread) ==
+                "per_thread");
+    }
+}
+
+TEST_CASE("AsioContext per-thread execution", "[AsioContext][integration]") {
+    AsioContext context(3, AsioContext::Topology::PerThread, true);
+    context.start();
+
+    SECTION("Each context runs on its own thread") {
+        std::mutex mutex;
+        std::set<std::thread::id> threads;
+        auto done = std::make_shared<std::promise<void>>();
+        auto remaining = std::make_shared<std::atomic<int>>(3);
+
+        for (int i = 0; i < 3; ++i) {
+            asio::post(context.nextContext(), [&, done, remaining]() {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    threads.insert(std::this_thread::get_id());
+                }
+                if (--*remaining == 0) {
+                    done->set_value();
+                }
+            });
+        }
+
+        REQUIRE(done->get_future().wait_for(2s) == std::future_status::ready);
+        REQUIRE(threads.size() == 3);
+    }
+
+    SECTION("A key's wheel jobs run on that key's context") {
+        for (uint64_t key : {7u, 8u, 9u}) {
+            auto promise = std::make_shared<std::promise<bool>>();
+            auto& keyContext = context.contextFor(key);
+            context.timerWheelFor(key).scheduleAfter(1ms, [promise, &keyContext]() {
+                promise->set_value(keyContext.get_executor().running_in_this_thread());
+            });
+
+            auto future = promise->get_future();
+            REQUIRE(future.wait_for(2s) == std::future_status::ready);
+            REQUIRE(future.get());
+        }
+    }
+
+    SECTION("Probes complete on worker contexts") {
+        asio::io_context local;
+        asio::ip::tcp::acceptor acceptor(
+            local, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+        auto prober = std::make_shared<TransportProber>(context);
+
+        auto promise = std::make_shared<std::promise<PingResult>>();
+        auto future = promise->get_future();
+        prober->probeTcp("127.0.0.1", acceptor.local_endpoint().port(), 1000ms,
+                         [promise](const PingResult& result) { promise->set_value(result); });
+
+        REQUIRE(future.wait_for(5s) == std::future_status::ready);
+        REQUIRE(future.get().success);
+    }
+
+    context.stop();
+}
+
+TEST_CASE("AsioContext event loop metrics", "[AsioContext]") {
+    AsioContext context(1, AsioContext::Topology::PerThread);
+    context.setMetricsInterval(20ms);
+    context.start();
+
+    auto waitFor = [&context](auto predicate) {
+        auto deadline = std::chrono::steady_clock::now() + 3s;
+        while (std::chrono::steady_clock::now() < deadline) {
+            if (predicate(context.loopMetrics())) {
+                return true;
+            }
+            std::this_thread::sleep_for(2ms);
+        }
+        return false;
+    };
+
+    SECTION("Counts handlers and samples every window") {
+        for (int i = 0; i < 100; ++i) {
+            context.post([]() {});
+        }
+
+        REQUIRE(waitFor(
+            [](const EventLoopMetrics& m) { return m.handlers >= 100 && m.samples >= 2; }));
+        auto metrics = context.loopMetrics();
+        REQUIRE(metrics.workers.size() == 1);
+        REQUIRE(metrics.workers[0].handlers == metrics.handlers);
+    }
+
+    SECTION("Times a handler that ran after an idle wait") {
+        REQUIRE(waitFor([](const EventLoopMetrics& m) { return m.samples >= 1; }));
+        context.post([]() { std::this_thread::sleep_for(30ms); });
+
+        REQUIRE(waitFor([](const EventLoopMetrics& m) { return m.longestHandler >= 25ms; }));
+    }
+
+    SECTION("Measures queue latency behind a busy handler") {
+        REQUIRE(waitFor([](const EventLoopMetrics& m) { return m.samples >= 1; }));
+        context.post([]() { std::this_thread::sleep_for(60ms); });
+
+        REQUIRE(waitFor([](const EventLoopMetrics& m) { return m.queueLatencyMax >= 20ms; }));
+    }
+
+    SECTION("Counts a handler blocked off the CPU as busy") {
+        REQUIRE(waitFor([](const EventLoopMetrics& m) { return m.samples >= 1; }));
+        context.post([]() { std::this_thread::sleep_for(60ms); });
+
+        REQUIRE(waitFor([](const EventLoopMetrics& m) { return m.busyPercent >= 50.0; }));
+        REQUIRE(context.loopMetrics().workers[0].busyPercent <= 100.0);
+    }
+
+    context.stop();
+}
@@ -0,0 +1,98 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/types/BannerMatcher.hpp"
+
+#include <string>
+
+using namespace netpulse::core;
+
+TEST_CASE("BannerMatcher custom signatures", "[BannerMatcher]") {
+    BannerMatcher matcher({
+        {"he", "first", "", false},
+        {"she", "second", "", false},
+        {"hers", "third", "", false},
+        {"product/", "fourth", "Product", true},
+    });
+    REQUIRE(matcher.size() == 4);
+
+    SECTION("Patterns match anywhere, ignoring case") {
+        REQUIRE(matcher.match("xxSHExx")->service == "first");
+        REQUIRE(matcher.match("ushers")->service == "first");
+        REQUIRE_FALSE(matcher.match("nothing to see").has_value());
+        REQUIRE_FALSE(matcher.match("").has_value());
+    }
+
+    SECTION("Overlapping matches resolve to the earliest signature") {
+        // "he" is a suffix of "she", so both end on the same byte
+        REQUIRE(matcher.match("she")->service == "first");
+        REQUIRE(matcher.match("product/1.0 and then he")->service == "first");
+        REQUIRE(matcher.match("product/1.0 and then hers")->service == "first");
+    }
+
+    SECTION("Versions are captured after the pattern") {
+        auto match = matcher.match("Banner: PRODUCT/2.4.1-beta (extra)");
+        REQUIRE(match.has_value());
+        REQUIRE(match->version == "2.4.1-beta");
+        REQUIRE(match->describe() == "Product 2.4.1-beta");
+
+        // Only tokens starting with a digit count as versions
+        auto unversioned = matcher.match("product/latest");
+        REQUIRE(unversioned->version.empty());
+        REQUIRE(unversioned->describe() == "Product");
+    }
+}
+
+TEST_CASE("BannerMatcher default signatures", "[BannerMatcher]") {
+    const auto& matcher = BannerMatcher::defaults();
+
+    SECTION("SSH servers") {
+        auto openssh = matcher.match("SSH-2.0-OpenSSH_9.6p1 Ubuntu-3ubuntu13\r\n");
+        REQUIRE(openssh == ServiceMatch{"ssh", "OpenSSH", "9.6p1"});
+
+        auto dropbear = matcher.match("SSH-2.0-dropbear_2022.83\r\n");
+        REQUIRE(dropbear == ServiceMatch{"ssh", "Dropbear", "2022.83"});
+
+        REQUIRE(matcher.match("SSH-2.0-Go\r\n") == ServiceMatch{"ssh", "", ""});
+    }
+
+    SECTION("HTTP servers prefer the Server header over the status line") {
+        auto nginx = matcher.match("HTTP/1.1 200 OK\r\nServer: nginx/1.25.3\r\n\r\n");
+        REQUIRE(nginx == ServiceMatch{"http", "nginx", "1.25.3"});
+
+        auto apache = matcher.match("HTTP/1.1 403 Forbidden\r\nServer: Apache/2.4.58 (Ubuntu)\r\n");
+        REQUIRE(apache->describe() == "Apache httpd 2.4.58");
+
+        REQUIRE(matcher.match("HTTP/1.0 404 Not Found\r\n")->service == "http");
+    }
+
+    SECTION("Mail and file transfer greetings") {
+        REQUIRE(matcher.match("220 mx.example.com ESMTP Postfix (Debian)\r\n") ==
+                ServiceMatch{"smtp", "Postfix", ""});
+        REQUIRE(matcher.match("220 host ESMTP Exim 4.96 Mon, 1 Jan 2024\r\n")->describe() ==
+                "Exim 4.96");
+        REQUIRE(matcher.match("220 (vsFTPd 3.0.5)\r\n") == ServiceMatch{"ftp", "vsftpd", "3.0.5"});
+        REQUIRE(matcher.match("+OK Dovecot ready.\r\n")->service == "pop3");
+        REQUIRE(matcher.match("* OK [CAPABILITY IMAP4rev1 LITERAL+] Dovecot ready.\r\n") ==
+                ServiceMatch{"imap", "Dovecot", ""});
+    }
+
+    SECTION("Replies to the HTTP probe from other protocols") {
+        REQUIRE(matcher.match("-ERR unknown command 'HEAD', with args beginning with: '/'")
+                    ->service == "redis");
+        REQUIRE(matcher.match("RFB 003.008\n")->service == "vnc");
+    }
+
+    SECTION("Binary greetings") {
+        std::string mysql("J\0\0\0\x0a" "8.0.36\0mysql_native_password", 33);
+        REQUIRE(matcher.match(mysql)->service == "mysql");
+        REQUIRE(matcher.match(std::string("\xff\xfd\x18\xff\xfd\x20"))->service == "telnet");
+    }
+}
+
+TEST_CASE("BannerMatcher first line", "[BannerMatcher]") {
+    REQUIRE(BannerMatcher::firstLine("SSH-2.0-OpenSSH_9.6\r\nmore") == "SSH-2.0-OpenSSH_9.6");
+    REQUIRE(BannerMatcher::firstLine("\r\n220 ready  \r\n") == "220 ready");
+    REQUIRE(BannerMatcher::firstLine(std::string("a\0b\x7f", 4)) == "a.b.");
+    REQUIRE(BannerMatcher::firstLine("abcdef", 3) == "abc");
+    REQUIRE(BannerMatcher::firstLine("").empty());
+}
@@ -0,0 +1,169 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "infrastructure/network/BlockingExecutor.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+
+using namespace netpulse::infra;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Waits until the executor reports the expected number of running tasks
+bool waitForActive(const BlockingExecutor& executor, size_t active) {
+    auto deadline = std::chrono::steady_clock::now() + 2s;
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (executor.stats().active == active) {
+            return true;
+        }
+        std::this_thread::sleep_for(1ms);
+    }
+    return false;
+}
+
+} // namespace
+
+TEST_CASE("BlockingExecutor runs tasks", "[BlockingExecutor]") {
+    BlockingExecutor executor(2, 16);
+    executor.start();
+
+    SECTION("Accepted tasks run and are counted") {
+        std::atomic<int> ran{0};
+        auto done = std::make_shared<std::promise<void>>();
+        for (int i = 0; i < 10; ++i) {
+            REQUIRE(executor.tryPost([&ran, done]() {
+                if (++ran == 10) {
+                    done->set_value();
+                }
+            }));
+        }
+
+        REQUIRE(done->get_future().wait_for(2s) == std::future_status::ready);
+        REQUIRE(waitForActive(executor, 0));
+
+        auto stats = executor.stats();
+        REQUIRE(stats.submitted == 10);
+        REQUIRE(stats.completed == 10);
+        REQUIRE(stats.rejected == 0);
+        REQUIRE(stats.queued == 0);
+        REQUIRE(stats.threads == 2);
+        REQUIRE(stats.capacity == 16);
+    }
+
+    SECTION("A throwing task does not stop the worker") {
+        REQUIRE(executor.tryPost([]() { throw std::runtime_error("boom"); }));
+
+        auto done = std::make_shared<std::promise<void>>();
+        REQUIRE(executor.tryPost([done]() { done->set_value(); }));
+        REQUIRE(done->get_future().wait_for(2s) == std::future_status::ready);
+    }
+
+    executor.stop();
+}
+
+TEST_CASE("BlockingExecutor back-pressure", "[BlockingExecutor]") {
+    BlockingExecutor executor(1, 2);
+    executor.start();
+
+    std::promise<void> release;
+    auto gate = release.get_future().share();
+
+    // Occupy the only worker, then fill the queue
+    REQUIRE(executor.tryPost([gate]() { gate.wait(); }));
+    REQUIRE(waitForActive(executor, 1));
+    REQUIRE(executor.tryPost([]() {}));
+    REQUIRE(executor.tryPost([]() {}));
+
+    SECTION("A full queue rejects new work") {
+        REQUIRE_FALSE(executor.tryPost([]() {}));
+
+        auto stats = executor.stats();
+        REQUIRE(stats.queued == 2);
+        REQUIRE(stats.peakQueued == 2);
+        REQUIRE(stats.active == 1);
+        REQUIRE(stats.rejected == 1);
+    }
+
+    SECTION("Raising the capacity accepts more work") {
+        executor.configure(1, 3);
+        REQUIRE(executor.tryPost([]() {}));
+        REQUIRE_FALSE(executor.tryPost([]() {}));
+    }
+
+    release.set_value();
+    REQUIRE(waitForActive(executor, 0));
+    executor.stop();
+}
+
+TEST_CASE("BlockingExecutor keeps queued work across stop", "[BlockingExecutor]") {
+    BlockingExecutor executor(1, 4);
+
+    auto done = std::make_shared<std::promise<void>>();
+    REQUIRE(executor.tryPost([done]() { done->set_value(); }));
+    REQUIRE(executor.stats().queued == 1);
+
+    executor.start();
+    REQUIRE(done->get_future().wait_for(2s) == std::future_status::ready);
+    executor.stop();
+}
+
+TEST_CASE("BlockingExecutor cancels queued work on stop", "[BlockingExecutor]") {
+    auto outcome = std::make_shared<std::promise<bool>>();
+    auto ran = outcome->get_future();
+    auto run = [outcome]() { outcome->set_value(true); };
+    auto cancel = [outcome]() { outcome->set_value(false); };
+
+    SECTION("Tasks still queued when the workers stop are cancelled") {
+        BlockingExecutor executor(1, 4);
+        executor.start();
+
+        std::promise<void> release;
+        auto gate = release.get_future().share();
+        REQUIRE(executor.tryPost([gate]() { gate.wait(); }));
+        REQUIRE(waitForActive(executor, 1));
+        REQUIRE(executor.tryPost(run, cancel));
+
+        // stop() waits for the running task, so release it once stop is under way
+        auto stopper = std::async(std::launch::async, [&executor]() { executor.stop(); });
+        std::this_thread::sleep_for(50ms);
+        release.set_value();
+        stopper.get();
+
+        REQUIRE(ran.wait_for(0s) == std::future_status::ready);
+        REQUIRE_FALSE(ran.get());
+
+        auto stats = executor.stats();
+        REQUIRE(stats.queued == 0);
+        REQUIRE(stats.cancelled == 1);
+        REQUIRE(stats.completed == 1);
+    }
+
+    SECTION("A stopped executor rejects new work until restarted") {
+        BlockingExecutor executor(1, 4);
+        executor.start();
+        executor.stop();
+
+        REQUIRE_FALSE(executor.tryPost(run, cancel));
+        REQUIRE(ran.wait_for(0s) == std::future_status::timeout);
+        REQUIRE(executor.stats().rejected == 1);
+
+        executor.start();
+        REQUIRE(executor.tryPost(run, cancel));
+        REQUIRE(ran.wait_for(2s) == std::future_status::ready);
+        REQUIRE(ran.get());
+        executor.stop();
+    }
+
+    SECTION("Destroying an executor that never started cancels its queue") {
+        {
+            BlockingExecutor executor(1, 4);
+            REQUIRE(executor.tryPost(run, cancel));
+        }
+        REQUIRE(ran.wait_for(0s) == std::future_status::ready);
+        REQUIRE_FALSE(ran.get());
+    }
+}
@@ -115,12 +115,31 @@ TEST_CASE("ConfigManager load operations", "[ConfigManager]") {
         REQUIRE(config.defaultPingIntervalSeconds == 30);
         REQUIRE(config.defaultWarningThresholdMs == 100);
         REQUIRE(config.defaultCriticalThresholdMs == 500);
+        REQUIRE(config.probeSpreadPolicy == "hashed");
+        REQUIRE(config.kernelTimestamps);
+        REQUIRE(config.adaptiveTimeouts);
+        REQUIRE(config.probeTimeoutFloorMs == 200);
+        REQUIRE(config.probeTimeoutCeilingMs == 5000);
+        REQUIRE(config.maxInFlightProbes == 3);
+        REQUIRE(config.ioThreads == 0);
+        REQUIRE(config.ioTopology == "shared");
+        REQUIRE_FALSE(config.pinIoThreads);
+        REQUIRE(config.blockingThreads == 4);
+        REQUIRE(config.blockingQueueCapacity == 1024);
         REQUIRE(config.desktopNotifications == true);
         REQUIRE(config.soundAlerts == false);
         REQUIRE(config.dataRetentionDays == 30);
         REQUIRE(config.autoCleanup == true);
         REQUIRE(config.portScanConcurrency == 100);
         REQUIRE(config.portScanTimeoutMs == 1000);
+        REQUIRE(config.portScanPerTarget == 0);
+        REQUIRE(config.portScanMaxConnections == 512);
+        REQUIRE(config.portScanSynRate == 10000);
+        REQUIRE(config.portScanRetries == 1);
+        REQUIRE(config.portScanAdaptive);
+        REQUIRE_FALSE(config.portScanBanners);
+        REQUIRE(config.portScanBannerTimeoutMs == 500);
+        REQUIRE(config.portScanCheckpointSeconds == 30);
         REQUIRE(config.webhooksEnabled == true);
         REQUIRE(config.webhookTimeoutMs == 5000);
         REQUIRE(config.webhookMaxRetries == 3);
@@ -235,6 +254,17 @@ TEST_CASE("ConfigManager save operations", "[ConfigManager]") {
         config.defaultPingIntervalSeconds = 45;
         config.defaultWarningThresholdMs = 150;
         config.defaultCriticalThresholdMs = 750;
+        config.probeSpreadPolicy = "none";
+        config.kernelTimestamps = false;
+        config.adaptiveTimeouts = false;
+        config.probeTimeoutFloorMs = 50;
+        config.probeTimeoutCeilingMs = 2000;
+        config.maxInFlightProbes = 1;
+        config.ioThreads = 16;
+        config.ioTopology = "per_thread";
+        config.pinIoThreads = true;
+        config.blockingThreads = 8;
+        config.blockingQueueCapacity = 64;
         config.alertThresholds.latencyWarningMs = 250;
         config.alertThresholds.latencyCriticalMs = 750;
         config.alertThresholds.packetLossWarningPercent = 10.0;
@@ -246,6 +276,14 @@ TEST_CASE("ConfigManager save operations", "[ConfigManager]") {
         config.autoCleanup = false;
         config.portScanConcurrency = 200;
         config.portScanTimeoutMs = 2000;
+        config.portScanPerTarget = 4;
+        config.portScanMaxConnections = 256;
+        config.portScanSynRate = 2500;
+        config.portScanRetries = 3;
+        config.portScanAdaptive = false;
+        config.portScanBanners = true;
+        config.portScanBannerTimeoutMs = 800;
+        config.portScanCheckpointSeconds = 120;
         config.windowX = 200;
         config.windowY = 150;
         config.windowWidth = 1400;
@@ -271,6 +309,17 @@ TEST_CASE("ConfigManager save operations", "[ConfigManager]") {
         REQUIRE(loaded.defaultPingIntervalSeconds == 45);
         REQUIRE(loaded.defaultWarningThresholdMs == 150);
         REQUIRE(loaded.defaultCriticalThresholdMs == 750);
+        REQUIRE(loaded.probeSpreadPolicy == "none");
+        REQUIRE_FALSE(loaded.kernelTimestamps);
+        REQUIRE_FALSE(loaded.adaptiveTimeouts);
+        REQUIRE(loaded.probeTimeoutFloorMs == 50);
+        REQUIRE(loaded.probeTimeoutCeilingMs == 2000);
+        REQUIRE(loaded.maxInFlightProbes == 1);
+        REQUIRE(loaded.ioThreads == 16);
+        REQUIRE(loaded.ioTopology == "per_thread");
+        REQUIRE(loaded.pinIoThreads);
+        REQUIRE(loaded.blockingThreads == 8);
+        REQUIRE(loaded.blockingQueueCapacity == 64);
         REQUIRE(loaded.alertThresholds.latencyWarningMs == 250);
         REQUIRE(loaded.alertThresholds.latencyCriticalMs == 750);
         REQUIRE_THAT(loaded.alertThresholds.packetLossWarningPercent,
@@ -284,6 +333,14 @@ TEST_CASE("ConfigManager save operations", "[ConfigManager]") {
         REQUIRE(loaded.autoCleanup == false);
         REQUIRE(loaded.portScanConcurrency == 200);
         REQUIRE(loaded.portScanTimeoutMs == 2000);
+        REQUIRE(loaded.portScanPerTarget == 4);
+        REQUIRE(loaded.portScanMaxConnections == 256);
+        REQUIRE(loaded.portScanSynRate == 2500);
+        REQUIRE(loaded.portScanRetries == 3);
+        REQUIRE_FALSE(loaded.portScanAdaptive);
+        REQUIRE(loaded.portScanBanners);
+        REQUIRE(loaded.portScanBannerTimeoutMs == 800);
+        REQUIRE(loaded.portScanCheckpointSeconds == 120);
         REQUIRE(loaded.windowX == 200);
         REQUIRE(loaded.windowY == 150);
         REQUIRE(loaded.windowWidth == 1400);
@@ -0,0 +1,57 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/types/DiscoveryResult.hpp"
+#include "core/types/Ipv4Range.hpp"
+
+#include <vector>
+
+using namespace netpulse::core;
+
+TEST_CASE("DiscoveryConfig address expansion", "[DiscoveryResult]") {
+    DiscoveryConfig config;
+
+    SECTION("CIDR ranges and single addresses") {
+        config.targetAddress = "10.0.0.0/30, 192.168.1.7";
+        auto addresses = config.getAddresses();
+        REQUIRE(addresses == std::vector<uint32_t>{0x0A000001, 0x0A000002, 0xC0A80107});
+    }
+
+    SECTION("Overlaps and duplicates are dropped, output ascending") {
+        config.targetAddress = "10.0.0.5 10.0.0.0/29 10.0.0.4/30 10.0.0.5";
+        auto addresses = config.getAddresses();
+        REQUIRE(addresses.size() == 6);
+        REQUIRE(addresses.front() == 0x0A000001);
+        REQUIRE(addresses.back() == 0x0A000006);
+    }
+
+    SECTION("Invalid entries and hostnames are skipped") {
+        config.targetAddress = "example.com,10.0.0.300 10.0.0.1/33 ,, 10.0.0.9";
+        REQUIRE(config.getAddresses() == std::vector<uint32_t>{0x0A000009});
+    }
+
+    SECTION("A /16 fits, wider ranges are truncated") {
+        config.targetAddress = "172.16.0.0/16";
+        REQUIRE(config.getAddresses().size() == 65534);
+
+        config.targetAddress = "10.0.0.0/8";
+        auto addresses = config.getAddresses();
+        REQUIRE(addresses.size() == DiscoveryConfig::MAX_ADDRESSES);
+        REQUIRE(Ipv4Range::formatAddress(addresses.front()) == "10.0.0.1");
+    }
+
+    SECTION("Empty target") {
+        REQUIRE(config.getAddresses().empty());
+    }
+}
+
+TEST_CASE("DiscoveredHost and progress", "[DiscoveryResult]") {
+    REQUIRE(DiscoveredHost::methodToString(DiscoveryMethod::Icmp) == "ICMP");
+    REQUIRE(DiscoveredHost::methodToString(DiscoveryMethod::Tcp) == "TCP");
+    REQUIRE(DiscoveredHost::methodToString(DiscoveryMethod::Arp) == "ARP");
+
+    DiscoveryProgress progress;
+    REQUIRE(progress.percentComplete() == 0.0);
+    progress.totalAddresses = 200;
+    progress.probedAddresses = 50;
+    REQUIRE(progress.percentComplete() == 25.0);
+}
@@ -0,0 +1,174 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "infrastructure/network/AsioContext.hpp"
+#include "infrastructure/network/DnsCache.hpp"
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <utility>
+
+using namespace netpulse::infra;
+using namespace std::chrono_literals;
+
+namespace {
+
+std::pair<asio::error_code, DnsCache::Addresses> resolveAndWait(DnsCache& cache,
+                                                               const std::string& host) {
+    auto promise = std::make_shared<std::promise<std::pair<asio::error_code, DnsCache::Addresses>>>();
+    auto future = promise->get_future();
+    cache.resolveAsync(host, [promise](const asio::error_code& ec,
+                                       const DnsCache::Addresses& addresses) {
+        promise->set_value({ec, addresses});
+    });
+    REQUIRE(future.wait_for(10s) == std::future_status::ready);
+    return future.get();
+}
+
+} // namespace
+
+TEST_CASE("DnsCache literals", "[DnsCache]") {
+    AsioContext context(1);
+    auto cache = std::make_shared<DnsCache>(context.getContext());
+
+    SECTION("IPv4 literal resolves inline without touching the cache") {
+        bool called = false;
+        cache->resolveAsync("192.0.2.1", [&called](const asio::error_code& ec,
+                                                   const DnsCache::Addresses& addresses) {
+            called = true;
+            REQUIRE_FALSE(ec);
+            REQUIRE(addresses.size() == 1);
+            REQUIRE(addresses[0].to_string() == "192.0.2.1");
+        });
+
+        REQUIRE(called);
+        auto stats = cache->stats();
+        REQUIRE(stats.hits == 0);
+        REQUIRE(stats.misses == 0);
+        REQUIRE(stats.entries == 0);
+    }
+
+    SECTION("IPv6 literal resolves inline") {
+        bool called = false;
+        cache->resolveAsync("::1", [&called](const asio::error_code& ec,
+                                             const DnsCache::Addresses& addresses) {
+            called = true;
+            REQUIRE_FALSE(ec);
+            REQUIRE(addresses.size() == 1);
+            REQUIRE(addresses[0].is_v6());
+        });
+        REQUIRE(called);
+    }
+}
+
+TEST_CASE("DnsCache destruction", "[DnsCache]") {
+    // Not started, so the lookup cannot complete before the cache goes away
+    AsioContext context(1);
+    auto cache = std::make_shared<DnsCache>(context.getContext());
+
+    SECTION("Waiting callbacks are failed rather than dropped") {
+        int calls = 0;
+        asio::error_code error;
+        cache->resolveAsync("localhost", [&calls, &error](const asio::error_code& ec,
+                                                          const DnsCache::Addresses& addresses) {
+            ++calls;
+            error = ec;
+            REQUIRE(addresses.empty());
+        });
+        REQUIRE(calls == 0);
+
+        cache.reset();
+        REQUIRE(calls == 1);
+        REQUIRE(error == asio::error::operation_aborted);
+    }
+}
+
+TEST_CASE("DnsCache lookups", "[DnsCache][integration]") {
+    AsioContext context(2);
+    context.start();
+
+    SECTION("Second lookup is served from cache") {
+        auto cache = std::make_shared<DnsCache>(context.getContext());
+
+        auto [firstError, first] = resolveAndWait(*cache, "localhost");
+        REQUIRE_FALSE(firstError);
+        REQUIRE_FALSE(first.empty());
+
+        auto [secondError, second] = resolveAndWait(*cache, "localhost");
+        REQUIRE_FALSE(secondError);
+        REQUIRE(second == first);
+
+        auto stats = cache->stats();
+        REQUIRE(stats.misses == 1);
+        REQUIRE(stats.hits == 1);
+        REQUIRE(stats.entries == 1);
+    }
+
+    SECTION("Failures are negatively cached") {
+        auto cache = std::make_shared<DnsCache>(context.getContext());
+
+        auto [firstError, first] = resolveAndWait(*cache, "nonexistent.invalid");
+        REQUIRE(firstError);
+        REQUIRE(first.empty());
+
+        auto [secondError, second] = resolveAndWait(*cache, "nonexistent.invalid");
+        REQUIRE(secondError);
+
+        auto stats = cache->stats();
+        REQUIRE(stats.misses == 1);
+        REQUIRE(stats.negativeHits == 1);
+        REQUIRE(stats.failures == 1);
+    }
+
+    SECTION("Concurrent lookups for one name share a query") {
+        auto cache = std::make_shared<DnsCache>(context.getContext());
+
+        constexpr int lookupCount = 10;
+        std::vector<std::future<bool>> futures;
+        for (int i = 0; i < lookupCount; ++i) {
+            auto promise = std::make_shared<std::promise<bool>>();
+            futures.push_back(promise->get_future());
+            cache->resolveAsync("localhost", [promise](const asio::error_code& ec,
+                                                       const DnsCache::Addresses&) {
+                promise->set_value(!ec);
+            });
+        }
+
+        for (auto& future : futures) {
+            REQUIRE(future.wait_for(10s) == std::future_status::ready);
+            REQUIRE(future.get());
+        }
+        REQUIRE(cache->stats().failures == 0);
+        REQUIRE(cache->stats().inFlight == 0);
+    }
+
+    SECTION("Expired answers are served stale while refreshing") {
+        DnsCache::Options options;
+        options.positiveTtl = std::chrono::seconds(0);
+        auto cache = std::make_shared<DnsCache>(context.getContext(), options);
+
+        auto [firstError, first] = resolveAndWait(*cache, "localhost");
+        REQUIRE_FALSE(firstError);
+
+        bool servedInline = false;
+        cache->resolveAsync("localhost", [&servedInline](const asio::error_code& ec,
+                                                         const DnsCache::Addresses& addresses) {
+            servedInline = !ec && !addresses.empty();
+        });
+
+        REQUIRE(servedInline);
+        REQUIRE(cache->stats().staleServes == 1);
+    }
+
+    SECTION("Invalidate forgets a name") {
+        auto cache = std::make_shared<DnsCache>(context.getContext());
+        resolveAndWait(*cache, "localhost");
+        REQUIRE(cache->stats().entries == 1);
+
+        cache->invalidate("localhost");
+        REQUIRE(cache->stats().entries == 0);
+    }
+
+    context.stop();
+}
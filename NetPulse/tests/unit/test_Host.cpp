@@ -59,6 +59,34 @@ TEST_CASE("Host validation", "[Host]") {
 
         REQUIRE_FALSE(host.isValid());
     }
+
+    SECTION("Invalid host - burst without probes") {
+        Host host;
+        host.name = "Test Host";
+        host.address = "192.168.1.1";
+        host.burstCount = 0;
+
+        REQUIRE_FALSE(host.isValid());
+
+        host.burstCount = Host::MAX_BURST_COUNT + 1;
+        REQUIRE_FALSE(host.isValid());
+
+        host.burstCount = 5;
+        REQUIRE(host.isValid());
+    }
+
+    SECTION("Invalid host - probe port out of range") {
+        Host host;
+        host.name = "Test Host";
+        host.address = "192.168.1.1";
+        host.probeType = ProbeType::Tcp;
+        host.probePort = 65536;
+
+        REQUIRE_FALSE(host.isValid());
+
+        host.probePort = 443;
+        REQUIRE(host.isValid());
+    }
 }
 
 TEST_CASE("Host status conversion", "[Host]") {
@@ -87,6 +115,48 @@ TEST_CASE("Host status conversion", "[Host]") {
     }
 }
 
+TEST_CASE("Host address family conversion", "[Host]") {
+    SECTION("Family round-trips through its string form") {
+        for (auto family : {AddressFamily::Any, AddressFamily::IPv4, AddressFamily::IPv6}) {
+            REQUIRE(Host::addressFamilyFromString(Host::addressFamilyToString(family)) == family);
+        }
+    }
+
+    SECTION("Unknown strings fall back to Any") {
+        REQUIRE(Host::addressFamilyFromString("ipx") == AddressFamily::Any);
+    }
+
+    SECTION("New hosts follow the resolver") {
+        Host host;
+        REQUIRE(host.addressFamily == AddressFamily::Any);
+    }
+}
+
+TEST_CASE("Host probe type", "[Host]") {
+    SECTION("Probe type round-trips through its string form") {
+        for (auto type : {ProbeType::Icmp, ProbeType::Tcp, ProbeType::Udp, ProbeType::Dns}) {
+            REQUIRE(Host::probeTypeFromString(Host::probeTypeToString(type)) == type);
+        }
+        REQUIRE(Host::probeTypeFromString("sctp") == ProbeType::Icmp);
+    }
+
+    SECTION("Unset ports use the probe's well-known port") {
+        Host host;
+        REQUIRE(host.probeType == ProbeType::Icmp);
+        REQUIRE(host.effectiveProbePort() == 0);
+
+        host.probeType = ProbeType::Tcp;
+        REQUIRE(host.effectiveProbePort() == 80);
+        host.probeType = ProbeType::Udp;
+        REQUIRE(host.effectiveProbePort() == 7);
+        host.probeType = ProbeType::Dns;
+        REQUIRE(host.effectiveProbePort() == 53);
+
+        host.probePort = 5353;
+        REQUIRE(host.effectiveProbePort() == 5353);
+    }
+}
+
 TEST_CASE("Host equality", "[Host]") {
     Host host1;
     host1.id = 1;
@@ -7,6 +7,8 @@
 
 #include <chrono>
 #include <filesystem>
+#include <string>
+#include <vector>
 
 using namespace netpulse::infra;
 using namespace netpulse::core;
@@ -436,6 +438,102 @@ TEST_CASE("HostRepository update operations", "[HostRepository][CRUD]") {
         REQUIRE(updated->groupId.has_value());
         REQUIRE(*updated->groupId == groupId);
     }
+
+    SECTION("update persists address family") {
+        Host host = createTestHost("Dual Stack Host", "dual.example.com");
+        int64_t hostId = repo.insert(host);
+        REQUIRE(repo.findById(hostId)->addressFamily == AddressFamily::Any);
+
+        auto retrieved = repo.findById(hostId);
+        retrieved->addressFamily = AddressFamily::IPv6;
+        repo.update(*retrieved);
+
+        REQUIRE(repo.findById(hostId)->addressFamily == AddressFamily::IPv6);
+    }
+
+    SECTION("update persists burst settings") {
+        Host host = createTestHost("Burst Host", "burst.example.com");
+        int64_t hostId = repo.insert(host);
+        REQUIRE(repo.findById(hostId)->burstCount == 1);
+
+        auto retrieved = repo.findById(hostId);
+        retrieved->burstCount = 10;
+        retrieved->burstSpacingMs = 5;
+        repo.update(*retrieved);
+
+        auto updated = repo.findById(hostId);
+        REQUIRE(updated->burstCount == 10);
+        REQUIRE(updated->burstSpacingMs == 5);
+    }
+
+    SECTION("insert and update persist the probe type") {
+        Host host = createTestHost("Web Host", "web.example.com");
+        host.probeType = ProbeType::Tcp;
+        host.probePort = 443;
+        int64_t hostId = repo.insert(host);
+
+        auto retrieved = repo.findById(hostId);
+        REQUIRE(retrieved->probeType == ProbeType::Tcp);
+        REQUIRE(retrieved->probePort == 443);
+
+        retrieved->probeType = ProbeType::Dns;
+        retrieved->probePort = 0;
+        repo.update(*retrieved);
+
+        auto updated = repo.findById(hostId);
+        REQUIRE(updated->probeType == ProbeType::Dns);
+        REQUIRE(updated->probePort == 0);
+    }
+}
+
+TEST_CASE("HostRepository bulk operations", "[HostRepository][CRUD]") {
+    TestDatabase testDb;
+    HostRepository repo(testDb.get());
+
+    SECTION("insertBatch inserts every host in order") {
+        std::vector<Host> hosts = {createTestHost("A", "10.0.0.1"),
+                                   createTestHost("B", "10.0.0.2"),
+                                   createTestHost("C", "10.0.0.3")};
+
+        auto ids = repo.insertBatch(hosts);
+        REQUIRE(ids.size() == 3);
+        REQUIRE(ids[1] > ids[0]);
+        REQUIRE(repo.count() == 3);
+        REQUIRE(repo.findById(ids[2])->address == "10.0.0.3");
+    }
+
+    SECTION("insertBatch inserts nothing if one insert fails") {
+        repo.insert(createTestHost("Existing", "10.0.0.2"));
+        std::vector<Host> hosts = {createTestHost("A", "10.0.0.1"),
+                                   createTestHost("Duplicate", "10.0.0.2")};
+
+        REQUIRE_THROWS(repo.insertBatch(hosts));
+        REQUIRE(repo.count() == 1);
+        REQUIRE_FALSE(repo.findByAddress("10.0.0.1").has_value());
+    }
+
+    SECTION("findExistingAddresses across several query chunks") {
+        std::vector<Host> hosts;
+        std::vector<std::string> addresses;
+        for (int i = 0; i < 1200; ++i) {
+            auto address = "10.1." + std::to_string(i / 256) + "." + std::to_string(i % 256);
+            addresses.push_back(address);
+            if (i % 3 == 0) {
+                hosts.push_back(createTestHost(address, address));
+            }
+        }
+        repo.insertBatch(hosts);
+
+        auto existing = repo.findExistingAddresses(addresses);
+        REQUIRE(existing.size() == 400);
+        REQUIRE(existing.count("10.1.0.0") == 1);
+        REQUIRE(existing.count("10.1.0.1") == 0);
+        REQUIRE(existing.count("10.1.4.173") == 1); // i = 1197, last chunk
+    }
+
+    SECTION("findExistingAddresses with no addresses") {
+        REQUIRE(repo.findExistingAddresses({}).empty());
+    }
 }
 
 TEST_CASE("HostRepository delete operations", "[HostRepository][CRUD]") {
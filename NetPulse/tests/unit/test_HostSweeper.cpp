@@ -0,0 +1,201 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "infrastructure/network/ArpScanner.hpp"
+#include "infrastructure/network/AsioContext.hpp"
+#include "infrastructure/network/HostSweeper.hpp"
+
+#include <array>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace netpulse::core;
+using namespace netpulse::infra;
+
+namespace {
+
+struct SweepOutcome {
+    std::vector<DiscoveredHost> streamed;
+    std::vector<DiscoveredHost> hosts;
+    DiscoveryProgress progress;
+};
+
+// Runs a sweep to completion, or cancels it after cancelAfter when given
+SweepOutcome sweep(HostSweeper& sweeper, const DiscoveryConfig& config,
+                   std::chrono::milliseconds cancelAfter = std::chrono::milliseconds(0)) {
+    auto outcome = std::make_shared<SweepOutcome>();
+    auto mutex = std::make_shared<std::mutex>();
+    auto promise = std::make_shared<std::promise<void>>();
+    auto done = promise->get_future();
+
+    auto id = sweeper.sweepAsync(
+        config,
+        [outcome, mutex](const DiscoveredHost& host) {
+            std::lock_guard lock(*mutex);
+            outcome->streamed.push_back(host);
+        },
+        [outcome, mutex](const DiscoveryProgress& progress) {
+            std::lock_guard lock(*mutex);
+            outcome->progress = progress;
+        },
+        [outcome, mutex, promise](const std::vector<DiscoveredHost>& hosts) {
+            {
+                std::lock_guard lock(*mutex);
+                outcome->hosts = hosts;
+            }
+            promise->set_value();
+        });
+
+    if (cancelAfter.count() > 0 &&
+        done.wait_for(cancelAfter) == std::future_status::timeout) {
+        sweeper.cancel(id);
+    }
+    REQUIRE(done.wait_for(std::chrono::seconds(30)) == std::future_status::ready);
+    std::lock_guard lock(*mutex);
+    return *outcome;
+}
+
+} // namespace
+
+TEST_CASE("ArpScanner packets", "[HostSweeper][ArpScanner]") {
+    const std::array<uint8_t, 6> mac{0x00, 0x1a, 0x2b, 0x3c, 0x4d, 0x5e};
+
+    SECTION("Request fields") {
+        auto packet = ArpScanner::buildRequest(mac, 0xC0A80101, 0xC0A80114);
+
+        REQUIRE(packet[0] == 0x00); // Ethernet
+        REQUIRE(packet[1] == 0x01);
+        REQUIRE(packet[2] == 0x08); // IPv4
+        REQUIRE(packet[3] == 0x00);
+        REQUIRE(packet[4] == 6);
+        REQUIRE(packet[5] == 4);
+        REQUIRE(packet[7] == 1); // Request
+        REQUIRE(packet[8] == 0x00);
+        REQUIRE(packet[13] == 0x5e);
+        REQUIRE(packet[14] == 192);
+        REQUIRE(packet[17] == 1);
+        REQUIRE(packet[18] == 0); // Target MAC unknown
+        REQUIRE(packet[23] == 0);
+        REQUIRE(packet[24] == 192);
+        REQUIRE(packet[27] == 20);
+    }
+
+    SECTION("Replies parse back") {
+        auto packet = ArpScanner::buildRequest(mac, 0xC0A80114, 0xC0A80101);
+        packet[7] = 2; // Reply
+
+        auto reply = ArpScanner::parseReply(packet.data(), packet.size());
+        REQUIRE(reply.has_value());
+        REQUIRE(reply->operation == 2);
+        REQUIRE(reply->senderAddress == 0xC0A80114);
+        REQUIRE(reply->targetAddress == 0xC0A80101);
+        REQUIRE(ArpScanner::formatMac(reply->senderMac) == "00:1a:2b:3c:4d:5e");
+    }
+
+    SECTION("Truncated or non-IPv4 packets are rejected") {
+        auto packet = ArpScanner::buildRequest(mac, 0xC0A80114, 0xC0A80101);
+        REQUIRE_FALSE(ArpScanner::parseReply(packet.data(), packet.size() - 1).has_value());
+        packet[3] = 0xDD; // IPv6
+        REQUIRE_FALSE(ArpScanner::parseReply(packet.data(), packet.size()).has_value());
+    }
+
+    SECTION("Interfaces exclude loopback") {
+        for (const auto& iface : ArpScanner::interfaces()) {
+            REQUIRE(iface.name != "lo");
+            REQUIRE(iface.index > 0);
+            REQUIRE(iface.contains(iface.address));
+            REQUIRE_FALSE(iface.contains(iface.address ^ 0x80000000u));
+        }
+    }
+}
+
+TEST_CASE("HostSweeper sweeps", "[HostSweeper][integration]") {
+    AsioContext context(2);
+    context.start();
+    HostSweeper sweeper(context);
+
+    DiscoveryConfig config;
+    config.timeout = std::chrono::milliseconds(500);
+
+    SECTION("Every loopback address is alive") {
+        config.targetAddress = "127.0.0.0/29";
+        auto outcome = sweep(sweeper, config);
+
+        REQUIRE(outcome.hosts.size() == 6);
+        REQUIRE(outcome.hosts.front().address == "127.0.0.1");
+        REQUIRE(outcome.hosts.back().address == "127.0.0.6");
+        REQUIRE(outcome.streamed.size() == 6);
+        REQUIRE(outcome.progress.totalAddresses == 6);
+        REQUIRE(outcome.progress.probedAddresses == 6);
+        REQUIRE(outcome.progress.hostsFound == 6);
+        REQUIRE_FALSE(outcome.progress.cancelled);
+        REQUIRE_FALSE(sweeper.isSweeping());
+    }
+
+    SECTION("TCP probes report the port that answered") {
+        asio::io_context io;
+        asio::ip::tcp::acceptor acceptor(io, {asio::ip::make_address("127.0.0.1"), 0});
+        auto port = acceptor.local_endpoint().port();
+
+        config.targetAddress = "127.0.0.1";
+        config.useIcmp = false;
+        config.tcpPorts = {port};
+        auto outcome = sweep(sweeper, config);
+
+        REQUIRE(outcome.hosts.size() == 1);
+        REQUIRE(outcome.hosts[0].method == DiscoveryMethod::Tcp);
+        REQUIRE(outcome.hosts[0].port == port);
+        REQUIRE(outcome.hosts[0].portOpen);
+    }
+
+    SECTION("A refused TCP probe finds the host but not an open port") {
+        asio::io_context io;
+        asio::ip::tcp::acceptor acceptor(io, {asio::ip::make_address("127.0.0.1"), 0});
+        auto port = acceptor.local_endpoint().port();
+        acceptor.close();
+
+        config.targetAddress = "127.0.0.1";
+        config.useIcmp = false;
+        config.tcpPorts = {port};
+        auto outcome = sweep(sweeper, config);
+
+        REQUIRE(outcome.hosts.size() == 1);
+        REQUIRE(outcome.hosts[0].method == DiscoveryMethod::Tcp);
+        REQUIRE(outcome.hosts[0].port == port);
+        REQUIRE_FALSE(outcome.hosts[0].portOpen);
+    }
+
+    SECTION("Unused addresses are not reported") {
+        config.targetAddress = "198.51.100.0/30"; // TEST-NET-2
+        config.timeout = std::chrono::milliseconds(200);
+        auto outcome = sweep(sweeper, config);
+
+        REQUIRE(outcome.hosts.empty());
+        REQUIRE(outcome.progress.probedAddresses == 2);
+    }
+
+    SECTION("Nothing to probe completes at once") {
+        config.targetAddress = "not-an-address";
+        auto outcome = sweep(sweeper, config);
+        REQUIRE(outcome.hosts.empty());
+        REQUIRE(outcome.progress.totalAddresses == 0);
+    }
+
+    SECTION("Cancel ends a sweep early") {
+        config.targetAddress = "198.18.0.0/20"; // Benchmarking range, nothing answers
+        config.timeout = std::chrono::milliseconds(2000);
+        config.maxInFlight = 16;
+        auto start = std::chrono::steady_clock::now();
+        auto outcome = sweep(sweeper, config, std::chrono::milliseconds(200));
+
+        REQUIRE(outcome.progress.cancelled);
+        REQUIRE(outcome.progress.probedAddresses < outcome.progress.totalAddresses);
+        REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::seconds(5));
+        REQUIRE_FALSE(sweeper.isSweeping());
+    }
+
+    context.stop();
+}
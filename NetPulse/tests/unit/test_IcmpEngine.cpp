@@ -0,0 +1,241 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "infrastructure/network/AsioContext.hpp"
+#include "infrastructure/network/IcmpEngine.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace netpulse::core;
+using namespace netpulse::infra;
+
+TEST_CASE("IcmpEngine packet construction", "[IcmpEngine]") {
+    SECTION("Checksum of known data") {
+        // Example from RFC 1071 section 3
+        std::vector<uint8_t> data = {0x00, 0x01, 0xf2, 0x03, 0xf4, 0xf5, 0xf6, 0xf7};
+        REQUIRE(IcmpEngine::calculateChecksum(data.data(), data.size()) == 0x220d);
+    }
+
+    SECTION("Checksum handles odd length") {
+        std::vector<uint8_t> data = {0x01};
+        REQUIRE(IcmpEngine::calculateChecksum(data.data(), data.size()) == 0xFEFF);
+    }
+
+    SECTION("Echo request has valid header and checksum") {
+        auto packet = IcmpEngine::buildEchoRequest(0x1234, 0xABCD);
+
+        REQUIRE(packet.size() == 64);
+        REQUIRE(packet[0] == 8); // Echo request
+        REQUIRE(packet[1] == 0);
+        REQUIRE(packet[4] == 0x12);
+        REQUIRE(packet[5] == 0x34);
+        REQUIRE(packet[6] == 0xAB);
+        REQUIRE(packet[7] == 0xCD);
+
+        // Checksum over a packet including its checksum folds to zero
+        REQUIRE(IcmpEngine::calculateChecksum(packet.data(), packet.size()) == 0);
+    }
+
+    SECTION("ICMPv6 echo request leaves the checksum to the kernel") {
+        auto packet = IcmpEngine::buildEchoRequest(0x1234, 0xABCD, AddressFamily::IPv6);
+
+        REQUIRE(packet.size() == 64);
+        REQUIRE(packet[0] == 128); // ICMPv6 echo request
+        REQUIRE(packet[1] == 0);
+        REQUIRE(packet[2] == 0);
+        REQUIRE(packet[3] == 0);
+        REQUIRE(packet[6] == 0xAB);
+        REQUIRE(packet[7] == 0xCD);
+    }
+}
+
+TEST_CASE("IcmpEngine request lifecycle", "[IcmpEngine][integration]") {
+    AsioContext context(2);
+    context.start();
+    auto engine = std::make_shared<IcmpEngine>(context);
+    engine->start();
+
+    auto sendAndWait = [&engine](const std::string& address, std::chrono::milliseconds timeout) {
+        auto promise = std::make_shared<std::promise<PingResult>>();
+        auto future = promise->get_future();
+        engine->sendEcho(address, timeout,
+                         [promise](const PingResult& result) { promise->set_value(result); });
+        REQUIRE(future.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+        return future.get();
+    };
+
+    SECTION("Unresolvable address fails without waiting for a timeout") {
+        auto result = sendAndWait("999.999.999.999", std::chrono::milliseconds(2000));
+        REQUIRE_FALSE(result.success);
+        REQUIRE_FALSE(result.errorMessage.empty());
+    }
+
+    SECTION("Unanswered request times out and leaves the table") {
+        auto start = std::chrono::steady_clock::now();
+        auto result = sendAndWait("10.255.255.1", std::chrono::milliseconds(100));
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        REQUIRE(result.timestamp.time_since_epoch().count() > 0);
+        REQUIRE(elapsed < std::chrono::seconds(2));
+        REQUIRE(engine->outstandingCount() == 0);
+    }
+
+    SECTION("Concurrent requests each complete exactly once") {
+        constexpr int requestCount = 50;
+        std::vector<std::future<PingResult>> futures;
+        for (int i = 0; i < requestCount; ++i) {
+            auto promise = std::make_shared<std::promise<PingResult>>();
+            futures.push_back(promise->get_future());
+            engine->sendEcho("127.0.0.1", std::chrono::milliseconds(500),
+                             [promise](const PingResult& result) { promise->set_value(result); });
+        }
+
+        for (auto& future : futures) {
+            REQUIRE(future.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+            auto result = future.get();
+            REQUIRE((result.success || !result.errorMessage.empty()));
+        }
+        REQUIRE(engine->outstandingCount() == 0);
+    }
+
+    SECTION("Batch reports every address once, in request order") {
+        std::vector<std::string> addresses = {"127.0.0.1", "999.999.999.999", "127.0.0.1",
+                                              "10.255.255.1"};
+        auto promise = std::make_shared<std::promise<std::vector<PingResult>>>();
+        auto future = promise->get_future();
+        std::atomic<int> invocations{0};
+
+        engine->sendEchoBatch(addresses, std::chrono::milliseconds(200),
+                              [promise, &invocations](const std::vector<PingResult>& results) {
+                                  ++invocations;
+                                  promise->set_value(results);
+                              });
+
+        REQUIRE(future.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+        auto results = future.get();
+        REQUIRE(results.size() == addresses.size());
+        REQUIRE_FALSE(results[1].success);
+        REQUIRE(results[1].errorMessage.find("resolve") != std::string::npos);
+        REQUIRE_FALSE(results[3].success);
+        REQUIRE(invocations == 1);
+        REQUIRE(engine->outstandingCount() == 0);
+    }
+
+    SECTION("Batch with per-request callbacks completes each request") {
+        constexpr int requestCount = 20;
+        std::vector<std::future<PingResult>> futures;
+        std::vector<IcmpEngine::EchoRequest> requests;
+        for (int i = 0; i < requestCount; ++i) {
+            auto promise = std::make_shared<std::promise<PingResult>>();
+            futures.push_back(promise->get_future());
+            requests.push_back({"127.0.0.1", [promise](const PingResult& result) {
+                                    promise->set_value(result);
+                                }});
+        }
+
+        engine->sendEchoBatch(std::move(requests), std::chrono::milliseconds(500));
+
+        for (auto& future : futures) {
+            REQUIRE(future.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+        }
+        REQUIRE(engine->outstandingCount() == 0);
+    }
+
+    SECTION("A batch larger than the send buffer is queued rather than failed") {
+        if (!engine->isAvailable()) {
+            return;
+        }
+        constexpr size_t requestCount = 4000;
+        std::vector<std::string> addresses(requestCount, "127.0.0.1");
+        auto promise = std::make_shared<std::promise<std::vector<PingResult>>>();
+        auto future = promise->get_future();
+
+        engine->sendEchoBatch(addresses, std::chrono::milliseconds(2000),
+                              [promise](const std::vector<PingResult>& results) {
+                                  promise->set_value(results);
+                              });
+
+        REQUIRE(future.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+        for (const auto& result : future.get()) {
+            REQUIRE(result.errorMessage.find("Failed to send") == std::string::npos);
+        }
+        REQUIRE(engine->outstandingCount() == 0);
+    }
+
+    SECTION("Empty batch still reports") {
+        auto promise = std::make_shared<std::promise<size_t>>();
+        auto future = promise->get_future();
+        engine->sendEchoBatch(std::span<const std::string>{}, std::chrono::milliseconds(100),
+                              [promise](const std::vector<PingResult>& results) {
+                                  promise->set_value(results.size());
+                              });
+
+        REQUIRE(future.wait_for(std::chrono::seconds(2)) == std::future_status::ready);
+        REQUIRE(future.get() == 0);
+    }
+
+    SECTION("Literal address selects the family") {
+        auto v4 = sendAndWait("127.0.0.1", std::chrono::milliseconds(1000));
+        REQUIRE(v4.family == AddressFamily::IPv4);
+
+        if (engine->isAvailable(AddressFamily::IPv6)) {
+            auto v6 = sendAndWait("::1", std::chrono::milliseconds(1000));
+            REQUIRE(v6.family == AddressFamily::IPv6);
+            REQUIRE(v6.success);
+            REQUIRE(v6.latency.count() >= 0);
+        }
+    }
+
+    SECTION("Loopback replies are timed by the selected clock") {
+        engine->setKernelTimestamps(false);
+        auto user = sendAndWait("127.0.0.1", std::chrono::milliseconds(1000));
+        if (user.success) {
+            REQUIRE(user.timestampSource == TimestampSource::Userspace);
+        }
+
+        engine->setKernelTimestamps(true);
+        auto kernel = sendAndWait("127.0.0.1", std::chrono::milliseconds(1000));
+        if (kernel.success) {
+            // Kernel stamps are preferred but platform-dependent
+            REQUIRE(kernel.latency.count() >= 0);
+            REQUIRE(kernel.latency < std::chrono::milliseconds(1000));
+#if defined(__linux__)
+            // Linux stamps the request on transmit as well as the reply
+            REQUIRE(kernel.timestampSource == TimestampSource::Kernel);
+#endif
+        }
+    }
+
+    SECTION("Family preference does not override a literal") {
+        auto promise = std::make_shared<std::promise<PingResult>>();
+        auto future = promise->get_future();
+        engine->sendEcho(
+            "127.0.0.1", std::chrono::milliseconds(1000),
+            [promise](const PingResult& result) { promise->set_value(result); },
+            AddressFamily::IPv6);
+
+        REQUIRE(future.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+        REQUIRE(future.get().family == AddressFamily::IPv4);
+    }
+
+    SECTION("Shutdown fails outstanding requests") {
+        auto promise = std::make_shared<std::promise<PingResult>>();
+        auto future = promise->get_future();
+        engine->sendEcho("10.255.255.1", std::chrono::milliseconds(10000),
+                         [promise](const PingResult& result) { promise->set_value(result); });
+
+        engine->shutdown();
+
+        REQUIRE(future.wait_for(std::chrono::seconds(2)) == std::future_status::ready);
+        REQUIRE_FALSE(future.get().success);
+        REQUIRE(engine->outstandingCount() == 0);
+    }
+
+    engine->shutdown();
+    context.stop();
+}
@@ -0,0 +1,76 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/types/Ipv4Range.hpp"
+#include "core/types/PortScanResult.hpp"
+
+using namespace netpulse::core;
+
+TEST_CASE("Ipv4Range parsing", "[Ipv4Range]") {
+    SECTION("Single address") {
+        auto range = Ipv4Range::parse("192.168.1.10");
+        REQUIRE(range.has_value());
+        REQUIRE(range->size() == 1);
+        REQUIRE(range->addressAt(0) == "192.168.1.10");
+    }
+
+    SECTION("CIDR block excludes network and broadcast") {
+        auto range = Ipv4Range::parse("10.0.0.77/24");
+        REQUIRE(range.has_value());
+        REQUIRE(range->size() == 254);
+        REQUIRE(range->addressAt(0) == "10.0.0.1");
+        REQUIRE(range->addressAt(253) == "10.0.0.254");
+    }
+
+    SECTION("/31 and /32 keep every address") {
+        REQUIRE(Ipv4Range::parse("10.0.0.0/31")->size() == 2);
+        REQUIRE(Ipv4Range::parse("10.0.0.9/32")->size() == 1);
+    }
+
+    SECTION("/0 covers the whole address space") {
+        auto range = Ipv4Range::parse("0.0.0.0/0");
+        REQUIRE(range.has_value());
+        REQUIRE(range->size() == 4294967294ULL);
+    }
+
+    SECTION("Invalid specs are rejected") {
+        REQUIRE_FALSE(Ipv4Range::parse("").has_value());
+        REQUIRE_FALSE(Ipv4Range::parse("example.com").has_value());
+        REQUIRE_FALSE(Ipv4Range::parse("10.0.0").has_value());
+        REQUIRE_FALSE(Ipv4Range::parse("10.0.0.256").has_value());
+        REQUIRE_FALSE(Ipv4Range::parse("10.0.0.1.2").has_value());
+        REQUIRE_FALSE(Ipv4Range::parse("10.0.0.0/33").has_value());
+        REQUIRE_FALSE(Ipv4Range::parse("10.0.0.0/").has_value());
+        REQUIRE_FALSE(Ipv4Range::parse("::1").has_value());
+    }
+
+    SECTION("Address formatting round-trips") {
+        auto address = Ipv4Range::parseAddress("172.16.254.3");
+        REQUIRE(address.has_value());
+        REQUIRE(*address == 0xAC10FE03u);
+        REQUIRE(Ipv4Range::formatAddress(*address) == "172.16.254.3");
+    }
+}
+
+TEST_CASE("PortScanConfig target expansion", "[Ipv4Range]") {
+    PortScanConfig config;
+
+    SECTION("Single target is kept as given") {
+        config.targetAddress = "example.com";
+        REQUIRE(config.getTargets() == std::vector<std::string>{"example.com"});
+    }
+
+    SECTION("Lists and ranges expand in order without duplicates") {
+        config.targetAddress = "10.0.0.2, 10.0.0.0/30 host.local";
+        REQUIRE(config.getTargets() ==
+                std::vector<std::string>{"10.0.0.2", "10.0.0.1", "host.local"});
+    }
+
+    SECTION("Large ranges are truncated") {
+        config.targetAddress = "10.0.0.0/8";
+        REQUIRE(config.getTargets().size() == PortScanConfig::MAX_TARGETS);
+    }
+
+    SECTION("Empty address has no targets") {
+        REQUIRE(config.getTargets().empty());
+    }
+}
@@ -122,6 +122,47 @@ TEST_CASE("MetricsRepository ping result insert operations", "[MetricsRepository
         REQUIRE(*results[0].ttl == 128);
     }
 
+    SECTION("Insert ping result keeps its address family") {
+        PingResult result = createTestPingResult(hostId);
+        result.family = AddressFamily::IPv6;
+        repo.insertPingResult(result);
+
+        auto results = repo.getPingResults(hostId, 1);
+        REQUIRE(results.size() == 1);
+        REQUIRE(results[0].family == AddressFamily::IPv6);
+    }
+
+    SECTION("Insert burst result keeps its summary") {
+        PingResult result = createTestPingResult(hostId, true, std::chrono::microseconds(2000));
+        BurstSummary burst;
+        burst.probesSent = 10;
+        burst.probesReceived = 9;
+        burst.minLatency = std::chrono::microseconds(1000);
+        burst.avgLatency = std::chrono::microseconds(2000);
+        burst.maxLatency = std::chrono::microseconds(4000);
+        burst.stddev = std::chrono::microseconds(500);
+        burst.outOfOrder = 1;
+        result.burst = burst;
+        repo.insertPingResult(result);
+
+        auto results = repo.getPingResults(hostId, 1);
+        REQUIRE(results.size() == 1);
+        REQUIRE(results[0].burst.has_value());
+        REQUIRE(*results[0].burst == burst);
+    }
+
+    SECTION("Insert ping result keeps its schedule accounting") {
+        PingResult result = createTestPingResult(hostId);
+        result.missedCycles = 2;
+        result.scheduleLag = std::chrono::microseconds(75000);
+        repo.insertPingResult(result);
+
+        auto results = repo.getPingResults(hostId, 1);
+        REQUIRE(results.size() == 1);
+        REQUIRE(results[0].missedCycles == 2);
+        REQUIRE(results[0].scheduleLag == std::chrono::microseconds(75000));
+    }
+
     SECTION("Insert failed ping result") {
         PingResult result = createTestPingResult(hostId, false, std::chrono::microseconds(0));
         result.ttl = std::nullopt;
@@ -281,6 +322,43 @@ TEST_CASE("MetricsRepository ping statistics", "[MetricsRepository][PingResults]
         REQUIRE(stats.maxLatency == std::chrono::microseconds(3000));
     }
 
+    SECTION("getStatistics counts every probe of a burst") {
+        PingResult single = createTestPingResult(hostId, true, std::chrono::microseconds(2000));
+        repo.insertPingResult(single);
+
+        PingResult result = createTestPingResult(hostId, true, std::chrono::microseconds(2000));
+        BurstSummary burst;
+        burst.probesSent = 10;
+        burst.probesReceived = 8;
+        burst.minLatency = std::chrono::microseconds(500);
+        burst.avgLatency = std::chrono::microseconds(2000);
+        burst.maxLatency = std::chrono::microseconds(6000);
+        result.burst = burst;
+        repo.insertPingResult(result);
+
+        auto stats = repo.getStatistics(hostId);
+        REQUIRE(stats.totalPings == 11);
+        REQUIRE(stats.successfulPings == 9);
+        REQUIRE(stats.minLatency == std::chrono::microseconds(500));
+        REQUIRE(stats.maxLatency == std::chrono::microseconds(6000));
+    }
+
+    SECTION("getStatistics reports missed cycles apart from loss") {
+        for (int i = 0; i < 3; ++i) {
+            repo.insertPingResult(createTestPingResult(hostId, true));
+        }
+        PingResult overrun = createTestPingResult(hostId, false);
+        overrun.missedCycles = 4;
+        repo.insertPingResult(overrun);
+
+        // Loss covers only the four probes sent
+        auto stats = repo.getStatistics(hostId);
+        REQUIRE(stats.missedCycles == 4);
+        REQUIRE(stats.totalPings == 4);
+        REQUIRE(stats.successfulPings == 3);
+        REQUIRE(stats.packetLossPercent == Catch::Approx(25.0));
+    }
+
     SECTION("getStatistics respects sampleCount parameter") {
         for (int i = 0; i < 20; ++i) {
             repo.insertPingResult(createTestPingResult(hostId, true));
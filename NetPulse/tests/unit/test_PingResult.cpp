@@ -2,6 +2,8 @@
 
 #include "core/types/PingResult.hpp"
 
+#include <vector>
+
 using namespace netpulse::core;
 
 TEST_CASE("PingResult default values", "[PingResult]") {
@@ -120,3 +122,70 @@ TEST_CASE("PingStatistics successRate", "[PingResult][Statistics]") {
         REQUIRE(stats.successRate() == 70.0);
     }
 }
+
+TEST_CASE("PingResult burst aggregation", "[PingResult]") {
+    auto probe = [](bool success, int latencyUs) {
+        PingResult result;
+        result.hostId = 7;
+        result.success = success;
+        result.latency = std::chrono::microseconds{latencyUs};
+        result.family = AddressFamily::IPv4;
+        if (success) {
+            result.ttl = 64;
+        } else {
+            result.errorMessage = "Request timed out";
+        }
+        return result;
+    };
+
+    SECTION("All probes answered in order") {
+        std::vector<PingResult> probes = {probe(true, 1000), probe(true, 2000), probe(true, 3000),
+                                          probe(true, 2000)};
+        auto result = PingResult::fromBurst(probes, {0, 1, 2, 3});
+
+        REQUIRE(result.success);
+        REQUIRE(result.hostId == 7);
+        REQUIRE(result.family == AddressFamily::IPv4);
+        REQUIRE(result.ttl == 64);
+        REQUIRE(result.latency == std::chrono::microseconds{2000});
+        REQUIRE(result.burst.has_value());
+        REQUIRE(result.burst->probesSent == 4);
+        REQUIRE(result.burst->probesReceived == 4);
+        REQUIRE(result.burst->minLatency == std::chrono::microseconds{1000});
+        REQUIRE(result.burst->maxLatency == std::chrono::microseconds{3000});
+        REQUIRE(result.burst->stddev == std::chrono::microseconds{707});
+        REQUIRE(result.burst->outOfOrder == 0);
+        REQUIRE(result.burst->lossPercent() == 0.0);
+    }
+
+    SECTION("Partial loss is reported within the burst") {
+        std::vector<PingResult> probes = {probe(true, 1000), probe(false, 0), probe(true, 3000),
+                                          probe(false, 0)};
+        auto result = PingResult::fromBurst(probes, {0, 2, 1, 3});
+
+        REQUIRE(result.success);
+        REQUIRE(result.errorMessage.empty());
+        REQUIRE(result.burst->probesReceived == 2);
+        REQUIRE(result.burst->lossPercent() == 50.0);
+        REQUIRE(result.burst->avgLatency == std::chrono::microseconds{2000});
+        REQUIRE(result.burst->outOfOrder == 0);
+    }
+
+    SECTION("Replies overtaken by later probes count as out of order") {
+        std::vector<PingResult> probes = {probe(true, 9000), probe(true, 1000), probe(true, 1000)};
+        auto result = PingResult::fromBurst(probes, {1, 2, 0});
+
+        REQUIRE(result.burst->outOfOrder == 1);
+    }
+
+    SECTION("Fully lost burst fails with the probe error") {
+        std::vector<PingResult> probes = {probe(false, 0), probe(false, 0)};
+        auto result = PingResult::fromBurst(probes, {0, 1});
+
+        REQUIRE_FALSE(result.success);
+        REQUIRE(result.errorMessage == "Request timed out");
+        REQUIRE(result.burst->probesReceived == 0);
+        REQUIRE(result.burst->lossPercent() == 100.0);
+        REQUIRE_FALSE(result.ttl.has_value());
+    }
+}
@@ -4,7 +4,11 @@
 #include "infrastructure/network/AsioContext.hpp"
 #include "infrastructure/network/PingService.hpp"
 
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <future>
+#include <memory>
 #include <thread>
 
 using namespace netpulse::core;
@@ -179,6 +183,196 @@ TEST_CASE("PingService monitoring management", "[PingService]") {
     context.stop();
 }
 
+TEST_CASE("PingService burst monitoring", "[PingService][integration]") {
+    AsioContext context;
+    context.start();
+    PingService service(context);
+    service.setSpreadPolicy(PingService::SpreadPolicy::None);
+
+    SECTION("Burst reports one aggregated result per check") {
+        Host host;
+        host.id = 42;
+        host.name = "Burst Host";
+        host.address = "127.0.0.1";
+        host.pingIntervalSeconds = 1;
+        host.burstCount = 5;
+        host.burstSpacingMs = 2;
+
+        auto promise = std::make_shared<std::promise<PingResult>>();
+        auto future = promise->get_future();
+        auto delivered = std::make_shared<std::atomic<bool>>(false);
+        service.startMonitoring(host, [promise, delivered](const PingResult& result) {
+            if (!delivered->exchange(true)) {
+                promise->set_value(result);
+            }
+        });
+
+        REQUIRE(future.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+        auto result = future.get();
+        service.stopMonitoring(42);
+
+        REQUIRE(result.hostId == 42);
+        REQUIRE(result.burst.has_value());
+        REQUIRE(result.burst->probesSent == 5);
+        REQUIRE(result.burst->probesReceived <= 5);
+        if (result.success) {
+            REQUIRE(result.burst->minLatency <= result.burst->avgLatency);
+            REQUIRE(result.burst->avgLatency <= result.burst->maxLatency);
+        }
+    }
+
+    context.stop();
+}
+
+TEST_CASE("PingService TCP probe monitoring", "[PingService][integration]") {
+    AsioContext context;
+    context.start();
+    PingService service(context);
+    service.setSpreadPolicy(PingService::SpreadPolicy::None);
+
+    SECTION("TCP hosts report through the ping callback") {
+        asio::io_context local;
+        asio::ip::tcp::acceptor acceptor(
+            local, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+
+        Host host;
+        host.id = 43;
+        host.name = "TCP Host";
+        host.address = "127.0.0.1";
+        host.pingIntervalSeconds = 1;
+        host.probeType = ProbeType::Tcp;
+        host.probePort = acceptor.local_endpoint().port();
+
+        auto promise = std::make_shared<std::promise<PingResult>>();
+        auto future = promise->get_future();
+        auto delivered = std::make_shared<std::atomic<bool>>(false);
+        service.startMonitoring(host, [promise, delivered](const PingResult& result) {
+            if (!delivered->exchange(true)) {
+                promise->set_value(result);
+            }
+        });
+
+        REQUIRE(future.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+        auto result = future.get();
+        service.stopMonitoring(43);
+
+        REQUIRE(result.hostId == 43);
+        REQUIRE(result.success);
+        REQUIRE_FALSE(result.ttl.has_value());
+    }
+
+    context.stop();
+}
+
+TEST_CASE("PingService schedule overruns", "[PingService][integration]") {
+    AsioContext context;
+    context.start();
+    PingService service(context);
+    service.setSpreadPolicy(PingService::SpreadPolicy::None);
+
+    SECTION("In-flight limit is clamped and reported") {
+        REQUIRE(service.maxInFlight() == PingService::DEFAULT_MAX_IN_FLIGHT);
+        service.setMaxInFlight(0);
+        REQUIRE(service.maxInFlight() == 1);
+        REQUIRE_FALSE(service.scheduleStats(12345).has_value());
+    }
+
+    SECTION("Cycles beyond the in-flight limit are missed, not delayed") {
+        // A UDP port that never answers keeps each check open for its full timeout
+        asio::io_context local;
+        asio::ip::udp::socket silent(
+            local, asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), 0));
+
+        service.setMaxInFlight(1);
+        service.setTimeoutPolicy({false, std::chrono::milliseconds(100),
+                                  std::chrono::milliseconds(2500)});
+
+        Host host;
+        host.id = 44;
+        host.name = "Slow Host";
+        host.address = "127.0.0.1";
+        host.pingIntervalSeconds = 1;
+        host.probeType = ProbeType::Udp;
+        host.probePort = silent.local_endpoint().port();
+
+        auto promise = std::make_shared<std::promise<PingResult>>();
+        auto future = promise->get_future();
+        auto delivered = std::make_shared<std::atomic<bool>>(false);
+        service.startMonitoring(host, [promise, delivered](const PingResult& result) {
+            if (!delivered->exchange(true)) {
+                promise->set_value(result);
+            }
+        });
+
+        REQUIRE(future.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+        auto result = future.get();
+        auto stats = service.scheduleStats(44);
+        service.stopMonitoring(44);
+
+        // Checks at 1 s and 2 s fall inside the first 2.5 s timeout
+        REQUIRE_FALSE(result.success);
+        REQUIRE(result.missedCycles >= 1);
+        REQUIRE(stats.has_value());
+        REQUIRE(stats->cycles >= 3);
+        REQUIRE(stats->missedCycles >= 1);
+        REQUIRE(stats->inFlight <= 1);
+    }
+
+    context.stop();
+}
+
+TEST_CASE("PingService phase spreading", "[PingService]") {
+    using std::chrono::milliseconds;
+
+    SECTION("Policy names parse with hashed as the default") {
+        REQUIRE(PingService::spreadPolicyFromString("none") == PingService::SpreadPolicy::None);
+        REQUIRE(PingService::spreadPolicyFromString("hashed") ==
+                PingService::SpreadPolicy::Hashed);
+        REQUIRE(PingService::spreadPolicyFromString("bogus") ==
+                PingService::SpreadPolicy::Hashed);
+    }
+
+    SECTION("Phase offset is deterministic and within the interval") {
+        milliseconds interval(30000);
+        for (int64_t id = 1; id <= 100; ++id) {
+            auto offset = PingService::phaseOffset(id, interval);
+            REQUIRE(offset >= milliseconds(0));
+            REQUIRE(offset < interval);
+            REQUIRE(offset == PingService::phaseOffset(id, interval));
+        }
+    }
+
+    SECTION("Sequential host ids spread across the interval") {
+        milliseconds interval(30000);
+        constexpr int buckets = 10;
+        std::array<int, buckets> counts{};
+
+        for (int64_t id = 1; id <= 1000; ++id) {
+            auto offset = PingService::phaseOffset(id, interval);
+            counts[static_cast<size_t>(offset.count() * buckets / interval.count())]++;
+        }
+
+        // Each tenth of the interval receives roughly a tenth of the hosts
+        for (int count : counts) {
+            REQUIRE(count > 50);
+            REQUIRE(count < 150);
+        }
+    }
+
+    SECTION("Zero interval yields zero offset") {
+        REQUIRE(PingService::phaseOffset(42, milliseconds(0)) == milliseconds(0));
+    }
+
+    SECTION("Policy setter round-trips") {
+        AsioContext context(1);
+        PingService service(context);
+
+        REQUIRE(service.spreadPolicy() == PingService::SpreadPolicy::Hashed);
+        service.setSpreadPolicy(PingService::SpreadPolicy::None);
+        REQUIRE(service.spreadPolicy() == PingService::SpreadPolicy::None);
+    }
+}
+
 TEST_CASE("PingService async ping", "[PingService][integration]") {
     AsioContext context;
     context.start();
@@ -224,6 +418,19 @@ TEST_CASE("PingService async ping", "[PingService][integration]") {
         REQUIRE(result.timestamp.time_since_epoch().count() > 0);
     }
 
+    SECTION("Coroutine ping resumes with the result") {
+        auto future = asio::co_spawn(context.getContext(),
+                                     service.ping("999.999.999.999", std::chrono::milliseconds(1000)),
+                                     asio::use_future);
+
+        auto status = future.wait_for(std::chrono::seconds(5));
+        REQUIRE(status == std::future_status::ready);
+
+        auto result = future.get();
+        REQUIRE_FALSE(result.success);
+        REQUIRE_FALSE(result.errorMessage.empty());
+    }
+
     context.stop();
 }
 
@@ -0,0 +1,607 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "infrastructure/network/AsioContext.hpp"
+#include "infrastructure/network/PortScanner.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace netpulse::core;
+using namespace netpulse::infra;
+using namespace std::chrono_literals;
+
+namespace {
+
+uint16_t closedTcpPort(asio::io_context& ioContext) {
+    asio::ip::tcp::acceptor acceptor(ioContext,
+                                     asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+    return acceptor.local_endpoint().port();
+}
+
+} // namespace
+
+TEST_CASE("PortScanner connect probes", "[PortScanner][integration]") {
+    AsioContext context(2);
+    context.start();
+    PortScanner scanner(context);
+    asio::io_context local;
+    auto strand = asio::make_strand(context.getContext());
+
+    SECTION("Listening port is open") {
+        asio::ip::tcp::acceptor acceptor(
+            local, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+
+        auto future = asio::co_spawn(
+            strand, scanner.connectProbe("127.0.0.1", acceptor.local_endpoint().port(), 1000ms),
+            asio::use_future);
+
+        REQUIRE(future.wait_for(5s) == std::future_status::ready);
+        auto result = future.get();
+        REQUIRE(result.state == PortState::Open);
+        REQUIRE(result.targetAddress == "127.0.0.1");
+    }
+
+    SECTION("Refused port is closed") {
+        auto port = closedTcpPort(local);
+
+        auto future =
+            asio::co_spawn(strand, scanner.connectProbe("127.0.0.1", port, 1000ms), asio::use_future);
+
+        REQUIRE(future.wait_for(5s) == std::future_status::ready);
+        REQUIRE(future.get().state == PortState::Closed);
+    }
+
+    SECTION("Invalid address is closed") {
+        auto future = asio::co_spawn(strand, scanner.connectProbe("not-an-ip", 80, 1000ms),
+                                     asio::use_future);
+
+        REQUIRE(future.wait_for(5s) == std::future_status::ready);
+        REQUIRE(future.get().state == PortState::Closed);
+    }
+
+    context.stop();
+}
+
+TEST_CASE("PortScanner scans", "[PortScanner][integration]") {
+    AsioContext context(2);
+    context.start();
+    PortScanner scanner(context);
+    asio::io_context local;
+
+    asio::ip::tcp::acceptor first(local,
+                                  asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+    asio::ip::tcp::acceptor second(local,
+                                   asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+
+    PortScanConfig config;
+    config.targetAddress = "127.0.0.1";
+    config.range = PortRange::Custom;
+    config.customPorts = {first.local_endpoint().port(), closedTcpPort(local),
+                          second.local_endpoint().port()};
+    config.maxConcurrency = 2;
+    config.timeout = 1000ms;
+
+    SECTION("Reports open ports, progress and completion") {
+        std::mutex mutex;
+        int reported = 0;
+        int lastScanned = 0;
+        auto done = std::make_shared<std::promise<std::vector<PortScanResult>>>();
+
+        scanner.scanAsync(
+            config,
+            [&](const PortScanResult&) {
+                std::lock_guard lock(mutex);
+                ++reported;
+            },
+            [&](const PortScanProgress& progress) {
+                std::lock_guard lock(mutex);
+                lastScanned = std::max(lastScanned, progress.scannedPorts);
+            },
+            [done](const std::vector<PortScanResult>& results) { done->set_value(results); });
+
+        auto future = done->get_future();
+        REQUIRE(future.wait_for(5s) == std::future_status::ready);
+        auto results = future.get();
+
+        REQUIRE(results.size() == 2);
+        REQUIRE_FALSE(scanner.isScanning());
+        std::lock_guard lock(mutex);
+        REQUIRE(reported == 2);
+        REQUIRE(lastScanned == 3);
+    }
+
+    SECTION("Concurrent scans run independently") {
+        auto first = std::make_shared<std::promise<std::vector<PortScanResult>>>();
+        auto second = std::make_shared<std::promise<std::vector<PortScanResult>>>();
+
+        auto firstId = scanner.scanAsync(
+            config, nullptr, nullptr,
+            [first](const std::vector<PortScanResult>& results) { first->set_value(results); });
+        auto secondId = scanner.scanAsync(
+            config, nullptr, nullptr,
+            [second](const std::vector<PortScanResult>& results) { second->set_value(results); });
+        REQUIRE(firstId != secondId);
+
+        auto firstFuture = first->get_future();
+        auto secondFuture = second->get_future();
+        REQUIRE(firstFuture.wait_for(5s) == std::future_status::ready);
+        REQUIRE(secondFuture.wait_for(5s) == std::future_status::ready);
+        REQUIRE(firstFuture.get().size() == 2);
+        REQUIRE(secondFuture.get().size() == 2);
+        REQUIRE(scanner.activeScans() == 0);
+    }
+
+    SECTION("Multiple targets are scanned and reported per host") {
+        auto multi = config;
+        multi.targetAddress = "127.0.0.1, 127.0.0.2";
+        multi.maxPerTarget = 1;
+
+        int total = 0;
+        int lastScanned = 0;
+        std::mutex mutex;
+        auto done = std::make_shared<std::promise<std::vector<PortScanResult>>>();
+        scanner.scanAsync(
+            multi, nullptr,
+            [&](const PortScanProgress& progress) {
+                std::lock_guard lock(mutex);
+                total = progress.totalPorts;
+                lastScanned = std::max(lastScanned, progress.scannedPorts);
+            },
+            [done](const std::vector<PortScanResult>& results) { done->set_value(results); });
+
+        auto future = done->get_future();
+        REQUIRE(future.wait_for(5s) == std::future_status::ready);
+        auto results = future.get();
+
+        // The listeners are bound to 127.0.0.1 only
+        REQUIRE(results.size() == 2);
+        for (const auto& result : results) {
+            REQUIRE(result.targetAddress == "127.0.0.1");
+        }
+        std::lock_guard lock(mutex);
+        REQUIRE(total == 6);
+        REQUIRE(lastScanned == 6);
+    }
+
+    SECTION("Hostname targets are resolved once and reported by name") {
+        auto named = config;
+        named.targetAddress = "localhost, netpulse-test.invalid";
+
+        std::mutex mutex;
+        PortScanProgress last;
+        auto done = std::make_shared<std::promise<std::vector<PortScanResult>>>();
+        scanner.scanAsync(
+            named, nullptr,
+            [&](const PortScanProgress& progress) {
+                std::lock_guard lock(mutex);
+                last = progress;
+            },
+            [done](const std::vector<PortScanResult>& results) { done->set_value(results); });
+
+        auto future = done->get_future();
+        REQUIRE(future.wait_for(10s) == std::future_status::ready);
+        auto results = future.get();
+
+        // localhost resolves to 127.0.0.1, where both listeners are
+        REQUIRE(results.size() == 2);
+        for (const auto& result : results) {
+            REQUIRE(result.targetAddress == "localhost");
+            REQUIRE(result.state == PortState::Open);
+        }
+
+        // The .invalid name never resolves, so its ports are not probed
+        std::lock_guard lock(mutex);
+        REQUIRE(last.unresolvedTargets == std::vector<std::string>{"netpulse-test.invalid"});
+        REQUIRE(last.totalPorts == 3);
+        REQUIRE(last.scannedPorts == 3);
+    }
+
+    SECTION("Prompt answers grow the adaptive window") {
+        std::mutex mutex;
+        PortScanProgress last;
+        auto done = std::make_shared<std::promise<void>>();
+        scanner.scanAsync(
+            config, nullptr,
+            [&](const PortScanProgress& progress) {
+                std::lock_guard lock(mutex);
+                if (progress.scannedPorts > last.scannedPorts) {
+                    last = progress;
+                }
+            },
+            [done](const std::vector<PortScanResult>&) { done->set_value(); });
+
+        REQUIRE(done->get_future().wait_for(5s) == std::future_status::ready);
+        std::lock_guard lock(mutex);
+        REQUIRE(last.scannedPorts == 3);
+        REQUIRE(last.concurrency > config.maxConcurrency);
+        REQUIRE(last.probesPerSecond > 0.0);
+    }
+
+    SECTION("SYN mode finds the same ports, falling back to connect without raw sockets") {
+        auto syn = config;
+        syn.mode = ScanMode::Syn;
+        scanner.setSynRateLimit(1000);
+
+        auto done = std::make_shared<std::promise<std::vector<PortScanResult>>>();
+        scanner.scanAsync(
+            syn, nullptr, nullptr,
+            [done](const std::vector<PortScanResult>& results) { done->set_value(results); });
+
+        auto future = done->get_future();
+        REQUIRE(future.wait_for(5s) == std::future_status::ready);
+        auto results = future.get();
+        REQUIRE(results.size() == 2);
+        for (const auto& result : results) {
+            REQUIRE(result.state == PortState::Open);
+        }
+        REQUIRE(scanner.synRateLimit() == 1000);
+    }
+
+    SECTION("Checkpoints cover every port and resuming skips recorded ones") {
+        std::mutex mutex;
+        std::vector<ScanCheckpoint> checkpoints;
+        scanner.setCheckpointHandler(0ms, [&](const ScanCheckpoint& checkpoint) {
+            std::lock_guard lock(mutex);
+            checkpoints.push_back(checkpoint);
+        });
+
+        auto done = std::make_shared<std::promise<void>>();
+        scanner.scanAsync(config, nullptr, nullptr,
+                          [done](const std::vector<PortScanResult>&) { done->set_value(); });
+        REQUIRE(done->get_future().wait_for(5s) == std::future_status::ready);
+
+        std::string key;
+        {
+            std::lock_guard lock(mutex);
+            REQUIRE(checkpoints.size() >= 2);
+            const auto& last = checkpoints.back();
+            REQUIRE(last.finished);
+            REQUIRE(last.portsDone == std::vector<size_t>{3});
+            REQUIRE(last.targets == std::vector<std::string>{"127.0.0.1"});
+
+            // Each open port is in exactly one checkpoint
+            size_t saved = 0;
+            for (const auto& checkpoint : checkpoints) {
+                REQUIRE(checkpoint.key == last.key);
+                saved += checkpoint.results.size();
+            }
+            REQUIRE(saved == 2);
+            key = last.key;
+            checkpoints.clear();
+        }
+
+        // Resume as if only the first two ports had been probed
+        ScanCheckpoint partial;
+        partial.key = key;
+        partial.config = config;
+        partial.targets = {"127.0.0.1"};
+        partial.portsDone = {2};
+        for (auto port : {first.local_endpoint().port(), second.local_endpoint().port()}) {
+            PortScanResult result;
+            result.targetAddress = "127.0.0.1";
+            result.port = port;
+            result.state = PortState::Open;
+            partial.results.push_back(result);
+        }
+
+        std::vector<uint16_t> reported;
+        int firstScanned = 0;
+        auto resumed = std::make_shared<std::promise<std::vector<PortScanResult>>>();
+        scanner.resumeAsync(
+            partial,
+            [&](const PortScanResult& result) {
+                std::lock_guard lock(mutex);
+                reported.push_back(result.port);
+            },
+            [&](const PortScanProgress& progress) {
+                std::lock_guard lock(mutex);
+                if (firstScanned == 0) {
+                    firstScanned = progress.scannedPorts;
+                }
+            },
+            [resumed](const std::vector<PortScanResult>& results) {
+                resumed->set_value(results);
+            });
+
+        auto future = resumed->get_future();
+        REQUIRE(future.wait_for(5s) == std::future_status::ready);
+        REQUIRE(future.get().size() == 2);
+
+        std::lock_guard lock(mutex);
+        REQUIRE(reported == std::vector<uint16_t>{second.local_endpoint().port()});
+        REQUIRE(firstScanned == 3);
+        REQUIRE(checkpoints.back().key == key);
+        REQUIRE(checkpoints.back().portsDone == std::vector<size_t>{3});
+    }
+
+    SECTION("A scan with nothing to probe completes on the context") {
+        auto empty = config;
+        empty.customPorts.clear();
+
+        auto done = std::make_shared<std::promise<std::thread::id>>();
+        scanner.scanAsync(empty, nullptr, nullptr, [done](const std::vector<PortScanResult>&) {
+            done->set_value(std::this_thread::get_id());
+        });
+
+        auto future = done->get_future();
+        REQUIRE(future.wait_for(5s) == std::future_status::ready);
+        REQUIRE(future.get() != std::this_thread::get_id());
+    }
+
+    SECTION("Cancelling still completes the scan") {
+        auto done = std::make_shared<std::promise<void>>();
+        scanner.scanAsync(config, nullptr, nullptr,
+                          [done](const std::vector<PortScanResult>&) { done->set_value(); });
+        scanner.cancel();
+
+        REQUIRE(done->get_future().wait_for(5s) == std::future_status::ready);
+        REQUIRE_FALSE(scanner.isScanning());
+    }
+
+    context.stop();
+}
+
+TEST_CASE("PortScanner shutdown checkpoints", "[PortScanner]") {
+    // Not started yet, so the scan cannot have progressed when it is cancelled
+    AsioContext context(1);
+    PortScanner scanner(context);
+
+    std::atomic<size_t> handled{0};
+    scanner.setCheckpointHandler(1h, [&handled](const ScanCheckpoint&) { ++handled; });
+
+    PortScanConfig config;
+    config.targetAddress = "127.0.0.1";
+    config.range = PortRange::Custom;
+    config.customPorts = {22, 80, 443};
+    auto done = std::make_shared<std::promise<void>>();
+    scanner.scanAsync(config, nullptr, nullptr,
+                      [done](const std::vector<PortScanResult>&) { done->set_value(); });
+
+    auto checkpoints = scanner.cancelWithCheckpoints();
+    REQUIRE(checkpoints.size() == 1);
+    REQUIRE_FALSE(checkpoints[0].finished);
+    REQUIRE(checkpoints[0].targets == std::vector<std::string>{"127.0.0.1"});
+    REQUIRE(checkpoints[0].portsDone == std::vector<size_t>{0});
+
+    // Winding down sends no further checkpoint
+    context.start();
+    REQUIRE(done->get_future().wait_for(5s) == std::future_status::ready);
+    REQUIRE(handled == 0);
+    context.stop();
+}
+
+TEST_CASE("PortScanner banner grabbing", "[PortScanner][integration]") {
+    AsioContext context(2);
+    context.start();
+    PortScanner scanner(context);
+    asio::io_context local;
+    auto loopback = asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0);
+
+    // One service greets on connect, one only answers a request, one never speaks
+    asio::ip::tcp::acceptor greeting(local, loopback);
+    asio::ip::tcp::acceptor answering(local, loopback);
+    asio::ip::tcp::acceptor silent(local, loopback);
+    std::thread ssh([&greeting]() {
+        auto peer = greeting.accept();
+        asio::write(peer, asio::buffer(std::string("SSH-2.0-OpenSSH_9.6p1 Ubuntu-3\r\n")));
+        std::array<char, 64> discard{};
+        asio::error_code ec;
+        peer.read_some(asio::buffer(discard), ec);
+    });
+    std::thread http([&answering]() {
+        auto peer = answering.accept();
+        std::array<char, 256> request{};
+        asio::error_code ec;
+        peer.read_some(asio::buffer(request), ec);
+        asio::write(peer, asio::buffer(std::string("HTTP/1.1 200 OK\r\n"
+                                                   "Server: nginx/1.25.3\r\n\r\n")),
+                    ec);
+    });
+
+    PortScanConfig config;
+    config.targetAddress = "127.0.0.1";
+    config.range = PortRange::Custom;
+    config.customPorts = {greeting.local_endpoint().port(), answering.local_endpoint().port(),
+                          silent.local_endpoint().port()};
+    config.timeout = 1000ms;
+    config.grabBanners = true;
+    config.bannerTimeout = 400ms;
+
+    auto done = std::make_shared<std::promise<std::vector<PortScanResult>>>();
+    scanner.scanAsync(config, nullptr, nullptr,
+                      [done](const std::vector<PortScanResult>& results) {
+                          done->set_value(results);
+                      });
+
+    auto future = done->get_future();
+    REQUIRE(future.wait_for(5s) == std::future_status::ready);
+    auto results = future.get();
+    ssh.join();
+    http.join();
+
+    REQUIRE(results.size() == 3);
+    std::map<uint16_t, PortScanResult> byPort;
+    for (const auto& result : results) {
+        REQUIRE(result.state == PortState::Open);
+        byPort[result.port] = result;
+    }
+
+    const auto& sshResult = byPort[greeting.local_endpoint().port()];
+    REQUIRE(sshResult.serviceName == "ssh");
+    REQUIRE(sshResult.serviceVersion == "OpenSSH 9.6p1");
+    REQUIRE(sshResult.banner == "SSH-2.0-OpenSSH_9.6p1 Ubuntu-3");
+
+    const auto& httpResult = byPort[answering.local_endpoint().port()];
+    REQUIRE(httpResult.serviceName == "http");
+    REQUIRE(httpResult.serviceVersion == "nginx 1.25.3");
+    REQUIRE(httpResult.banner == "HTTP/1.1 200 OK");
+
+    const auto& silentResult = byPort[silent.local_endpoint().port()];
+    REQUIRE(silentResult.banner.empty());
+    REQUIRE(silentResult.serviceVersion.empty());
+
+    context.stop();
+}
+
+TEST_CASE("PortScanner cancellation", "[PortScanner][integration]") {
+    AsioContext context(2);
+    context.start();
+    PortScanner scanner(context);
+    asio::io_context local;
+
+    // A listener whose accept queue is full drops further SYNs, so connects
+    // to it stay in flight until their timeout
+    asio::ip::tcp::acceptor acceptor(local);
+    asio::ip::tcp::endpoint endpoint(asio::ip::address_v4::loopback(), 0);
+    acceptor.open(endpoint.protocol());
+    acceptor.bind(endpoint);
+    acceptor.listen(0);
+    auto port = acceptor.local_endpoint().port();
+
+    std::vector<std::unique_ptr<asio::ip::tcp::socket>> backlog;
+    for (int i = 0; i < 4; ++i) {
+        backlog.push_back(std::make_unique<asio::ip::tcp::socket>(local));
+        backlog.back()->async_connect(acceptor.local_endpoint(), [](const asio::error_code&) {});
+    }
+
+    PortScanConfig config;
+    config.targetAddress = "127.0.0.1";
+    config.range = PortRange::Custom;
+    config.customPorts = {port, port, port, port};
+    config.maxConcurrency = 4;
+    config.timeout = 30s;
+
+    SECTION("Cancel closes in-flight connects") {
+        auto done = std::make_shared<std::promise<std::vector<PortScanResult>>>();
+        auto id = scanner.scanAsync(
+            config, nullptr, nullptr,
+            [done](const std::vector<PortScanResult>& results) { done->set_value(results); });
+
+        std::this_thread::sleep_for(200ms);
+        REQUIRE(scanner.isScanning());
+
+        auto started = std::chrono::steady_clock::now();
+        scanner.cancel(id);
+
+        auto future = done->get_future();
+        REQUIRE(future.wait_for(5s) == std::future_status::ready);
+        REQUIRE(std::chrono::steady_clock::now() - started < 5s);
+        REQUIRE(future.get().empty());
+        REQUIRE_FALSE(scanner.isScanning());
+    }
+
+    SECTION("Per-target limit serialises connects to one host") {
+        auto limited = config;
+        limited.maxPerTarget = 1;
+        limited.timeout = 200ms;
+
+        auto done = std::make_shared<std::promise<std::vector<PortScanResult>>>();
+        auto started = std::chrono::steady_clock::now();
+        scanner.scanAsync(
+            limited, nullptr, nullptr,
+            [done](const std::vector<PortScanResult>& results) { done->set_value(results); });
+
+        REQUIRE(done->get_future().wait_for(5s) == std::future_status::ready);
+        // Four unanswered connects, one at a time
+        REQUIRE(std::chrono::steady_clock::now() - started >= 750ms);
+    }
+
+    SECTION("Connection budget is shared across scans") {
+        scanner.setConnectionBudget(1);
+        REQUIRE(scanner.connectionBudget() == 1);
+
+        auto budgeted = config;
+        budgeted.customPorts = {port, port};
+        budgeted.timeout = 200ms;
+
+        auto first = std::make_shared<std::promise<void>>();
+        auto second = std::make_shared<std::promise<void>>();
+        auto started = std::chrono::steady_clock::now();
+        scanner.scanAsync(budgeted, nullptr, nullptr, [first](const auto&) { first->set_value(); });
+        scanner.scanAsync(budgeted, nullptr, nullptr,
+                          [second](const auto&) { second->set_value(); });
+
+        REQUIRE(first->get_future().wait_for(5s) == std::future_status::ready);
+        REQUIRE(second->get_future().wait_for(5s) == std::future_status::ready);
+        REQUIRE(std::chrono::steady_clock::now() - started >= 750ms);
+    }
+
+    SECTION("Cancelling a scan waiting on the budget does not wait for the holder") {
+        scanner.setConnectionBudget(1);
+
+        auto holding = config;
+        holding.customPorts = {port};
+        auto held = std::make_shared<std::promise<void>>();
+        auto holder = scanner.scanAsync(holding, nullptr, nullptr,
+                                        [held](const auto&) { held->set_value(); });
+        std::this_thread::sleep_for(200ms);
+
+        auto done = std::make_shared<std::promise<void>>();
+        auto id = scanner.scanAsync(holding, nullptr, nullptr,
+                                    [done](const auto&) { done->set_value(); });
+        std::this_thread::sleep_for(200ms);
+
+        scanner.cancel(id);
+        REQUIRE(done->get_future().wait_for(5s) == std::future_status::ready);
+        REQUIRE(scanner.activeScans() == 1);
+
+        scanner.cancel(holder);
+        REQUIRE(held->get_future().wait_for(5s) == std::future_status::ready);
+    }
+
+    SECTION("Timed-out probes are retried before the port is Filtered") {
+        auto retried = config;
+        retried.customPorts = {port};
+        retried.timeout = 150ms;
+
+        auto runScan = [&scanner](const PortScanConfig& scanConfig) {
+            auto last = std::make_shared<PortScanProgress>();
+            auto done = std::make_shared<std::promise<void>>();
+            auto started = std::chrono::steady_clock::now();
+            scanner.scanAsync(
+                scanConfig, nullptr,
+                [last](const PortScanProgress& progress) { *last = progress; },
+                [done](const std::vector<PortScanResult>&) { done->set_value(); });
+            REQUIRE(done->get_future().wait_for(5s) == std::future_status::ready);
+            return std::make_pair(std::chrono::steady_clock::now() - started, *last);
+        };
+
+        retried.maxRetries = 2;
+        auto [withRetries, progress] = runScan(retried);
+        // Three unanswered probes, one after another
+        REQUIRE(withRetries >= 440ms);
+        REQUIRE(progress.scannedPorts == 1);
+        REQUIRE(progress.openPorts == 0);
+        REQUIRE(progress.probesPerSecond > 0.0);
+
+        retried.maxRetries = 0;
+        auto [withoutRetries, single] = runScan(retried);
+        REQUIRE(withoutRetries < 440ms);
+        REQUIRE(single.scannedPorts == 1);
+    }
+
+    SECTION("Cancelling one scan leaves others running") {
+        auto cancelled = std::make_shared<std::promise<void>>();
+        auto other = std::make_shared<std::promise<void>>();
+        auto id = scanner.scanAsync(config, nullptr, nullptr,
+                                    [cancelled](const auto&) { cancelled->set_value(); });
+        scanner.scanAsync(config, nullptr, nullptr, [other](const auto&) { other->set_value(); });
+
+        scanner.cancel(id);
+        REQUIRE(cancelled->get_future().wait_for(5s) == std::future_status::ready);
+        REQUIRE(scanner.activeScans() == 1);
+
+        scanner.cancel();
+        REQUIRE(other->get_future().wait_for(5s) == std::future_status::ready);
+    }
+
+    context.stop();
+}
@@ -0,0 +1,125 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/types/PortStateBitmap.hpp"
+
+#include <tuple>
+#include <vector>
+
+using namespace netpulse::core;
+
+TEST_CASE("PortStateBitmap states", "[PortStateBitmap]") {
+    PortStateBitmap bitmap;
+
+    SECTION("Ports start Unknown") {
+        REQUIRE(bitmap.get(0) == PortState::Unknown);
+        REQUIRE(bitmap.get(65535) == PortState::Unknown);
+        REQUIRE(bitmap.count(PortState::Unknown) == PortStateBitmap::PORT_COUNT);
+        REQUIRE(bitmap.knownCount() == 0);
+    }
+
+    SECTION("Set and get every state without disturbing neighbours") {
+        bitmap.set(31, PortState::Open);
+        bitmap.set(32, PortState::Closed);
+        bitmap.set(33, PortState::Filtered);
+        bitmap.set(65535, PortState::Open);
+
+        REQUIRE(bitmap.get(30) == PortState::Unknown);
+        REQUIRE(bitmap.get(31) == PortState::Open);
+        REQUIRE(bitmap.get(32) == PortState::Closed);
+        REQUIRE(bitmap.get(33) == PortState::Filtered);
+        REQUIRE(bitmap.get(34) == PortState::Unknown);
+        REQUIRE(bitmap.get(65535) == PortState::Open);
+
+        bitmap.set(33, PortState::Open);
+        REQUIRE(bitmap.get(33) == PortState::Open);
+        bitmap.set(33, PortState::Unknown);
+        REQUIRE(bitmap.get(33) == PortState::Unknown);
+    }
+
+    SECTION("Counts per state") {
+        for (uint16_t port = 1; port <= 1024; ++port) {
+            bitmap.set(port, PortState::Closed);
+        }
+        bitmap.set(22, PortState::Open);
+        bitmap.set(80, PortState::Open);
+        bitmap.set(443, PortState::Filtered);
+
+        REQUIRE(bitmap.count(PortState::Open) == 2);
+        REQUIRE(bitmap.count(PortState::Filtered) == 1);
+        REQUIRE(bitmap.count(PortState::Closed) == 1021);
+        REQUIRE(bitmap.knownCount() == 1024);
+    }
+
+    SECTION("Built from results, later entries winning") {
+        std::vector<PortScanResult> results = {
+            {.targetAddress = "10.0.0.1", .port = 22, .state = PortState::Closed},
+            {.targetAddress = "10.0.0.1", .port = 22, .state = PortState::Open},
+            {.targetAddress = "10.0.0.1", .port = 80, .state = PortState::Filtered},
+        };
+        auto built = PortStateBitmap::fromResults(results);
+        REQUIRE(built.get(22) == PortState::Open);
+        REQUIRE(built.get(80) == PortState::Filtered);
+        REQUIRE(built.knownCount() == 2);
+    }
+
+    SECTION("Overlay replaces only the ports known in the newer bitmap") {
+        bitmap.set(22, PortState::Open);
+        bitmap.set(80, PortState::Open);
+        bitmap.set(443, PortState::Closed);
+
+        PortStateBitmap partial;
+        partial.set(80, PortState::Closed);
+        partial.set(8080, PortState::Filtered);
+        bitmap.overlay(partial);
+
+        REQUIRE(bitmap.get(22) == PortState::Open);
+        REQUIRE(bitmap.get(80) == PortState::Closed);
+        REQUIRE(bitmap.get(443) == PortState::Closed);
+        REQUIRE(bitmap.get(8080) == PortState::Filtered);
+        REQUIRE(bitmap.knownCount() == 4);
+    }
+}
+
+TEST_CASE("PortStateBitmap differences", "[PortStateBitmap]") {
+    PortStateBitmap before;
+    PortStateBitmap after;
+
+    SECTION("Identical bitmaps have no differences") {
+        before.set(80, PortState::Open);
+        after.set(80, PortState::Open);
+        REQUIRE(before == after);
+        REQUIRE(before.differences(after).empty());
+    }
+
+    SECTION("Differences are reported in port order with both states") {
+        before.set(65535, PortState::Open);
+        before.set(443, PortState::Closed);
+        after.set(443, PortState::Open);
+        after.set(0, PortState::Filtered);
+        // Open -> Closed and Closed -> Open differ in both bits
+        before.set(1000, PortState::Open);
+        after.set(1000, PortState::Closed);
+
+        std::vector<std::tuple<uint16_t, PortState, PortState>> seen;
+        before.forEachDifference(after, [&seen](uint16_t port, PortState was, PortState now) {
+            seen.emplace_back(port, was, now);
+        });
+
+        REQUIRE(seen.size() == 4);
+        REQUIRE(seen[0] == std::make_tuple(uint16_t{0}, PortState::Unknown, PortState::Filtered));
+        REQUIRE(seen[1] == std::make_tuple(uint16_t{443}, PortState::Closed, PortState::Open));
+        REQUIRE(seen[2] == std::make_tuple(uint16_t{1000}, PortState::Open, PortState::Closed));
+        REQUIRE(seen[3] == std::make_tuple(uint16_t{65535}, PortState::Open, PortState::Unknown));
+    }
+
+    SECTION("Full-range scans differ only where states changed") {
+        for (uint32_t port = 0; port < PortStateBitmap::PORT_COUNT; ++port) {
+            before.set(static_cast<uint16_t>(port), PortState::Closed);
+            after.set(static_cast<uint16_t>(port), PortState::Closed);
+        }
+        after.set(8080, PortState::Open);
+        after.set(12345, PortState::Filtered);
+
+        REQUIRE(before.differences(after) == std::vector<uint16_t>{8080, 12345});
+    }
+}
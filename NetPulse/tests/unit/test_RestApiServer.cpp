@@ -556,3 +556,66 @@ TEST_CASE("RestApiServer 404 for unknown endpoints", "[RestApi][Integration]") {
     server->stop();
     asioContext.stop();
 }
+
+TEST_CASE("RestApiServer DNS diagnostics endpoint", "[RestApi][Integration]") {
+    infra::AsioContext asioContext(2);
+    asioContext.start();
+
+    auto db = createTestDatabase();
+    auto server = std::make_shared<infra::RestApiServer>(asioContext, db, 8191);
+    server->start();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    asio::io_context clientIo;
+    TestHttpClient client(clientIo);
+    client.setPort(8191);
+
+    SECTION("Returns resolver cache counters") {
+        auto [status, body] = client.request("GET", "/api/diagnostics/dns");
+
+        REQUIRE(status == 200);
+        auto json = nlohmann::json::parse(body);
+        REQUIRE(json.contains("hits"));
+        REQUIRE(json.contains("misses"));
+        REQUIRE(json.contains("staleServes"));
+        REQUIRE(json.contains("entries"));
+    }
+
+    server->stop();
+    asioContext.stop();
+}
+
+TEST_CASE("RestApiServer event loop diagnostics endpoint", "[RestApi][Integration]") {
+    infra::AsioContext asioContext(2);
+    asioContext.setMetricsInterval(std::chrono::milliseconds(20));
+    asioContext.start();
+
+    auto db = createTestDatabase();
+    auto server = std::make_shared<infra::RestApiServer>(asioContext, db, 8192);
+    server->start();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    asio::io_context clientIo;
+    TestHttpClient client(clientIo);
+    client.setPort(8192);
+
+    SECTION("Returns per-worker loop metrics and blocking pool counters") {
+        auto [status, body] = client.request("GET", "/api/diagnostics/event-loop");
+
+        REQUIRE(status == 200);
+        auto json = nlohmann::json::parse(body);
+        REQUIRE(json["threads"] == 2);
+        REQUIRE(json["samples"].get<uint64_t>() > 0);
+        REQUIRE(json.contains("handlersPerSecond"));
+        REQUIRE(json.contains("queueLatencyAvgUs"));
+        REQUIRE(json.contains("longestHandlerUs"));
+        REQUIRE(json["workers"].size() == 2);
+        REQUIRE(json["workers"][0].contains("busyPercent"));
+        REQUIRE(json["blocking"].contains("queued"));
+    }
+
+    server->stop();
+    asioContext.stop();
+}
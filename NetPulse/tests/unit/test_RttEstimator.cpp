@@ -0,0 +1,92 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "infrastructure/network/RttEstimator.hpp"
+
+#include <chrono>
+
+using namespace netpulse::infra;
+using namespace std::chrono_literals;
+
+TEST_CASE("RttEstimator timeouts", "[RttEstimator]") {
+    RttEstimator estimator(50ms, 5000ms);
+
+    SECTION("Ceiling is used before any sample") {
+        REQUIRE_FALSE(estimator.hasSamples());
+        REQUIRE(estimator.timeout() == 5000ms);
+    }
+
+    SECTION("First sample seeds SRTT and RTTVAR") {
+        estimator.addSample(20000us);
+
+        REQUIRE(estimator.hasSamples());
+        REQUIRE(estimator.srtt() == 20000us);
+        REQUIRE(estimator.rttvar() == 10000us);
+        // 20 ms + 4 * 10 ms
+        REQUIRE(estimator.timeout() == 60ms);
+    }
+
+    SECTION("Stable samples converge towards the RTT") {
+        for (int i = 0; i < 50; ++i) {
+            estimator.addSample(100000us);
+        }
+
+        REQUIRE(estimator.srtt() == 100000us);
+        REQUIRE(estimator.rttvar() < 1000us);
+        // Variation collapses to the 10 ms granularity term
+        REQUIRE(estimator.timeout() == 110ms);
+    }
+
+    SECTION("Fast hosts are held at the floor") {
+        for (int i = 0; i < 10; ++i) {
+            estimator.addSample(300us);
+        }
+        REQUIRE(estimator.timeout() == 50ms);
+    }
+
+    SECTION("Slow hosts are capped at the ceiling") {
+        estimator.addSample(4000000us);
+        REQUIRE(estimator.timeout() == 5000ms);
+    }
+
+    SECTION("Jitter widens the timeout") {
+        RttEstimator steady(1ms, 5000ms);
+        RttEstimator jittery(1ms, 5000ms);
+        for (int i = 0; i < 20; ++i) {
+            steady.addSample(50000us);
+            jittery.addSample(i % 2 == 0 ? 20000us : 80000us);
+        }
+        REQUIRE(jittery.timeout() > steady.timeout());
+    }
+
+    SECTION("Timeouts back off exponentially until a sample arrives") {
+        for (int i = 0; i < 50; ++i) {
+            estimator.addSample(100000us);
+        }
+        auto base = estimator.timeout();
+
+        estimator.onTimeout();
+        REQUIRE(estimator.timeout() == base * 2);
+        estimator.onTimeout();
+        REQUIRE(estimator.timeout() == base * 4);
+
+        for (int i = 0; i < 20; ++i) {
+            estimator.onTimeout();
+        }
+        REQUIRE(estimator.timeout() == 5000ms);
+
+        estimator.addSample(100000us);
+        REQUIRE(estimator.backoff() == 0);
+        REQUIRE(estimator.timeout() < 5000ms);
+    }
+
+    SECTION("Changing bounds keeps the history") {
+        estimator.addSample(20000us);
+        estimator.setBounds(100ms, 200ms);
+
+        REQUIRE(estimator.srtt() == 20000us);
+        REQUIRE(estimator.timeout() == 100ms);
+
+        estimator.setBounds(10ms, 5ms);
+        REQUIRE(estimator.ceiling() == 10ms);
+    }
+}
@@ -0,0 +1,154 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/types/ScanCheckpoint.hpp"
+#include "infrastructure/database/Database.hpp"
+#include "infrastructure/database/ScanCheckpointRepository.hpp"
+
+#include <chrono>
+#include <filesystem>
+
+using namespace netpulse::infra;
+using namespace netpulse::core;
+
+namespace {
+
+class TestDatabase {
+public:
+    TestDatabase()
+        : dbPath_(std::filesystem::temp_directory_path() / "netpulse_checkpoint_test.db") {
+        std::filesystem::remove(dbPath_);
+        db_ = std::make_shared<Database>(dbPath_.string());
+        db_->runMigrations();
+    }
+
+    ~TestDatabase() {
+        db_.reset();
+        std::filesystem::remove(dbPath_);
+    }
+
+    std::shared_ptr<Database> get() { return db_; }
+
+private:
+    std::filesystem::path dbPath_;
+    std::shared_ptr<Database> db_;
+};
+
+ScanCheckpoint createCheckpoint() {
+    ScanCheckpoint checkpoint;
+    checkpoint.key = "1700000000000-1";
+    checkpoint.config.targetAddress = "10.0.0.0/30";
+    checkpoint.config.range = PortRange::All;
+    checkpoint.config.maxConcurrency = 250;
+    checkpoint.config.timeout = std::chrono::milliseconds(750);
+    checkpoint.config.mode = ScanMode::Syn;
+    checkpoint.config.grabBanners = true;
+    checkpoint.targets = {"10.0.0.1", "10.0.0.2"};
+    checkpoint.portsDone = {100, 0};
+    checkpoint.updatedAt = std::chrono::system_clock::now();
+
+    PortScanResult result;
+    result.targetAddress = "10.0.0.1";
+    result.port = 22;
+    result.state = PortState::Open;
+    result.serviceName = "ssh";
+    result.serviceVersion = "OpenSSH 9.6p1";
+    result.banner = "SSH-2.0-OpenSSH_9.6p1";
+    result.scanTimestamp = std::chrono::system_clock::now();
+    checkpoint.results.push_back(result);
+    return checkpoint;
+}
+
+} // namespace
+
+TEST_CASE("ScanCheckpointRepository saves and resumes checkpoints",
+          "[ScanCheckpointRepository][database]") {
+    TestDatabase testDb;
+    ScanCheckpointRepository repo(testDb.get());
+    auto checkpoint = createCheckpoint();
+    repo.save(checkpoint);
+
+    SECTION("Round-trips configuration, progress and results") {
+        auto loaded = repo.findByKey(checkpoint.key);
+        REQUIRE(loaded.has_value());
+        REQUIRE(loaded->config.targetAddress == "10.0.0.0/30");
+        REQUIRE(loaded->config.range == PortRange::All);
+        REQUIRE(loaded->config.maxConcurrency == 250);
+        REQUIRE(loaded->config.timeout == std::chrono::milliseconds(750));
+        REQUIRE(loaded->config.mode == ScanMode::Syn);
+        REQUIRE(loaded->config.grabBanners);
+        REQUIRE(loaded->targets == checkpoint.targets);
+        REQUIRE(loaded->portsDone == std::vector<size_t>{100, 0});
+        REQUIRE_FALSE(loaded->finished);
+        REQUIRE(loaded->scannedPorts() == 100);
+        REQUIRE(loaded->totalPorts() == 2 * 65535);
+
+        REQUIRE(loaded->results.size() == 1);
+        REQUIRE(loaded->results[0].port == 22);
+        REQUIRE(loaded->results[0].state == PortState::Open);
+        REQUIRE(loaded->results[0].serviceVersion == "OpenSSH 9.6p1");
+        REQUIRE(loaded->results[0].banner == "SSH-2.0-OpenSSH_9.6p1");
+    }
+
+    SECTION("Later saves add results and never move progress back") {
+        auto next = checkpoint;
+        next.portsDone = {300, 50};
+        next.results[0].port = 80;
+        repo.save(next);
+
+        auto stale = checkpoint;
+        stale.portsDone = {200, 10};
+        stale.results.clear();
+        repo.save(stale);
+
+        auto loaded = repo.findByKey(checkpoint.key);
+        REQUIRE(loaded->portsDone == std::vector<size_t>{300, 50});
+        REQUIRE(loaded->results.size() == 2);
+        REQUIRE(repo.findResumable().size() == 1);
+    }
+
+    SECTION("Completed scans are no longer resumable, even after a late save") {
+        auto finished = checkpoint;
+        finished.finished = true;
+        finished.results.clear();
+        repo.save(finished);
+        repo.save(checkpoint);
+
+        REQUIRE(repo.findResumable().empty());
+        REQUIRE(repo.findByKey(checkpoint.key)->finished);
+
+        repo.cleanupOld(std::chrono::hours(24));
+        REQUIRE_FALSE(repo.findByKey(checkpoint.key).has_value());
+    }
+
+    SECTION("Results of a failed save are written with the next one") {
+        testDb.get()->execute(R"(
+            CREATE TEMP TRIGGER fail_results BEFORE INSERT ON scan_checkpoint_results
+            BEGIN SELECT RAISE(ABORT, 'disk full'); END
+        )");
+        auto failed = checkpoint;
+        failed.portsDone = {300, 50};
+        failed.results[0].port = 80;
+        REQUIRE_THROWS(repo.save(failed));
+
+        // Nothing of the failed save is kept, progress included
+        auto loaded = repo.findByKey(checkpoint.key);
+        REQUIRE(loaded->portsDone == std::vector<size_t>{100, 0});
+        REQUIRE(loaded->results.size() == 1);
+
+        testDb.get()->execute("DROP TRIGGER fail_results");
+        auto next = checkpoint;
+        next.portsDone = {400, 60};
+        next.results[0].port = 443;
+        repo.save(next);
+
+        loaded = repo.findByKey(checkpoint.key);
+        REQUIRE(loaded->portsDone == std::vector<size_t>{400, 60});
+        REQUIRE(loaded->results.size() == 3);
+    }
+
+    SECTION("Remove deletes the checkpoint and its results") {
+        repo.remove(checkpoint.key);
+        REQUIRE_FALSE(repo.findByKey(checkpoint.key).has_value());
+        REQUIRE(repo.findResumable().empty());
+    }
+}
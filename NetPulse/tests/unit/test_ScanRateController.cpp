@@ -0,0 +1,70 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "infrastructure/network/ScanRateController.hpp"
+
+#include <chrono>
+
+using namespace netpulse::infra;
+using namespace std::chrono_literals;
+
+TEST_CASE("ScanRateController window", "[ScanRateController]") {
+    using Clock = ScanRateController::Clock;
+    ScanRateController controller(10, 2, 40);
+    auto t0 = Clock::now();
+
+    SECTION("Starts at the initial window, clamped to the bounds") {
+        REQUIRE(controller.window() == 10);
+        REQUIRE(ScanRateController(100, 2, 40).window() == 40);
+        REQUIRE(ScanRateController(0, 0, 0).window() == 1);
+    }
+
+    SECTION("Slow start grows by one per timely response up to the maximum") {
+        for (int i = 0; i < 5; ++i) {
+            controller.onResponse(t0, t0 + 10ms, 1000ms);
+        }
+        REQUIRE(controller.window() == 15);
+
+        for (int i = 0; i < 100; ++i) {
+            controller.onResponse(t0, t0 + 10ms, 1000ms);
+        }
+        REQUIRE(controller.window() == 40);
+    }
+
+    SECTION("Late responses do not grow the window") {
+        controller.onResponse(t0, t0 + 600ms, 1000ms);
+        REQUIRE(controller.window() == 10);
+    }
+
+    SECTION("A drop halves the window and ends slow start") {
+        controller.onDrop(t0, t0 + 1000ms);
+        REQUIRE(controller.window() == 5);
+        REQUIRE(controller.threshold() == 5.0);
+
+        // Additive increase: a full window of responses adds one
+        for (int i = 0; i < 5; ++i) {
+            controller.onResponse(t0 + 1100ms, t0 + 1110ms, 1000ms);
+        }
+        REQUIRE(controller.window() == 5);
+        controller.onResponse(t0 + 1100ms, t0 + 1110ms, 1000ms);
+        REQUIRE(controller.window() == 6);
+    }
+
+    SECTION("Drops of probes sent before the last decrease are one event") {
+        controller.onDrop(t0, t0 + 1000ms);
+        controller.onDrop(t0 + 10ms, t0 + 1010ms);
+        controller.onDrop(t0 + 20ms, t0 + 1020ms);
+        REQUIRE(controller.window() == 5);
+
+        // A probe sent after the decrease that is also lost halves again
+        controller.onDrop(t0 + 1005ms, t0 + 2005ms);
+        REQUIRE(controller.window() == 2);
+    }
+
+    SECTION("Window never falls below the minimum") {
+        for (int i = 0; i < 10; ++i) {
+            auto sent = t0 + std::chrono::seconds(i);
+            controller.onDrop(sent, sent + 500ms);
+        }
+        REQUIRE(controller.window() == 2);
+    }
+}
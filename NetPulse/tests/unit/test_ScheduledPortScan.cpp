@@ -1,5 +1,6 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include "core/types/PortStateBitmap.hpp"
 #include "core/types/ScheduledPortScan.hpp"
 #include "infrastructure/database/Database.hpp"
 #include "infrastructure/database/ScheduledScanRepository.hpp"
@@ -7,13 +8,70 @@
 #include "infrastructure/network/PortScanner.hpp"
 #include "infrastructure/network/ScheduledPortScanner.hpp"
 
+#include <atomic>
 #include <chrono>
 #include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
 
 using namespace netpulse::core;
 using namespace netpulse::infra;
 
+namespace {
+
+// Reports the next scripted run's results and completes immediately, so a
+// test can stand in for a scan that was cancelled part way
+class ScriptedPortScanner : public IPortScanner {
+public:
+    std::vector<std::vector<std::pair<uint16_t, PortState>>> runs;
+    std::map<uint16_t, std::string> services; // Names reported for open ports
+
+    ScanId scanAsync(const PortScanConfig& config, ResultCallback onResult,
+                     ProgressCallback /*onProgress*/, CompletionCallback onComplete) override {
+        std::vector<PortScanResult> results;
+        for (auto [port, state] : runs.at(next_)) {
+            PortScanResult result;
+            result.targetAddress = config.targetAddress;
+            result.port = port;
+            result.state = state;
+            if (auto service = services.find(port);
+                state == PortState::Open && service != services.end()) {
+                result.serviceName = service->second;
+            }
+            onResult(result);
+            results.push_back(result);
+        }
+        onComplete(results);
+        return ++next_;
+    }
+    void cancel() override {}
+    void cancel(ScanId /*scanId*/) override {}
+    bool isScanning() const override { return false; }
+
+private:
+    size_t next_{0};
+};
+
+// Holds every scan open until the test completes it
+class HeldPortScanner : public IPortScanner {
+public:
+    std::vector<CompletionCallback> held;
+
+    ScanId scanAsync(const PortScanConfig& /*config*/, ResultCallback /*onResult*/,
+                     ProgressCallback /*onProgress*/, CompletionCallback onComplete) override {
+        held.push_back(std::move(onComplete));
+        return held.size();
+    }
+    void cancel() override {}
+    void cancel(ScanId /*scanId*/) override {}
+    bool isScanning() const override { return !held.empty(); }
+};
+
+} // namespace
+
 TEST_CASE("PortChange structure", "[ScheduledPortScan]") {
     SECTION("Default values") {
         PortChange change;
@@ -444,6 +502,33 @@ TEST_CASE("ScheduledPortScanner diff computation", "[ScheduledPortScan]") {
         REQUIRE(diff.changes[2].port == 443);
     }
 
+    SECTION("Bitmap diff classifies every kind of change") {
+        PortStateBitmap previous;
+        PortStateBitmap current;
+        previous.set(22, PortState::Open);     // Open -> Closed
+        current.set(22, PortState::Closed);
+        previous.set(80, PortState::Closed);   // Closed -> Open
+        current.set(80, PortState::Open);
+        previous.set(443, PortState::Filtered); // Filtered -> Closed
+        current.set(443, PortState::Closed);
+        previous.set(3306, PortState::Open);   // No longer scanned
+        current.set(5432, PortState::Closed);  // Newly scanned, not open
+        current.set(8080, PortState::Open);    // Newly scanned and open
+
+        auto diff = ScheduledPortScanner::computeDiff("192.168.1.1", previous, current);
+        REQUIRE(diff.changes.size() == 5);
+        REQUIRE(diff.changes[0].changeType == PortChangeType::NewClosed);
+        REQUIRE(diff.changes[1].changeType == PortChangeType::NewOpen);
+        REQUIRE(diff.changes[1].serviceName == "http");
+        REQUIRE(diff.changes[2].changeType == PortChangeType::StateChanged);
+        REQUIRE(diff.changes[3].port == 3306);
+        REQUIRE(diff.changes[3].currentState == PortState::Unknown);
+        REQUIRE(diff.changes[4].port == 8080);
+        REQUIRE(diff.openPortsBefore == 2);
+        REQUIRE(diff.openPortsAfter == 2);
+        REQUIRE(diff.totalPortsScanned == 5);
+    }
+
     context.stop();
 }
 
@@ -675,3 +760,220 @@ TEST_CASE("ScheduledPortScanner last results management", "[ScheduledPortScan]")
 
     context.stop();
 }
+
+TEST_CASE("ScheduledPortScanner queues overlapping scans", "[ScheduledPortScan]") {
+    AsioContext context(2);
+    context.start();
+    PortScanner portScanner(context);
+    ScheduledPortScanner scheduler(context, portScanner);
+
+    asio::io_context local;
+    asio::ip::tcp::acceptor acceptor(local,
+                                     asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+
+    std::atomic<int> completed{0};
+    scheduler.setScanCompleteCallback(
+        [&completed](int64_t /*scheduleId*/, const std::vector<PortScanResult>& /*results*/) {
+            ++completed;
+        });
+
+    constexpr int scheduleCount = static_cast<int>(ScheduledPortScanner::MAX_CONCURRENT_SCANS) + 2;
+    for (int i = 0; i < scheduleCount; ++i) {
+        ScheduledScanConfig config;
+        config.name = "Overlap " + std::to_string(i);
+        config.targetAddress = "127.0.0.1";
+        config.portRange = PortRange::Custom;
+        config.customPorts = {acceptor.local_endpoint().port()};
+        config.intervalMinutes = 60;
+        scheduler.addSchedule(config);
+    }
+
+    SECTION("Every schedule runs even while others are scanning") {
+        for (const auto& schedule : scheduler.getSchedules()) {
+            scheduler.runNow(schedule.id);
+        }
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (completed < scheduleCount && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        REQUIRE(completed == scheduleCount);
+        REQUIRE(scheduler.pendingScans() == 0);
+    }
+
+    context.stop();
+}
+
+TEST_CASE("ScheduledPortScanner diffs consecutive runs", "[ScheduledPortScan]") {
+    AsioContext context(2);
+    context.start();
+    PortScanner portScanner(context);
+    ScheduledPortScanner scheduler(context, portScanner);
+
+    asio::io_context local;
+    auto listener = std::make_unique<asio::ip::tcp::acceptor>(
+        local, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+    auto port = listener->local_endpoint().port();
+
+    std::atomic<int> completed{0};
+    std::mutex mutex;
+    std::vector<PortScanDiff> diffs;
+    scheduler.setScanCompleteCallback(
+        [&completed](int64_t, const std::vector<PortScanResult>&) { ++completed; });
+    scheduler.setDiffCallback([&](int64_t, const PortScanDiff& diff) {
+        std::lock_guard lock(mutex);
+        diffs.push_back(diff);
+    });
+
+    ScheduledScanConfig config;
+    config.name = "Diff";
+    config.targetAddress = "127.0.0.1";
+    config.portRange = PortRange::Custom;
+    config.customPorts = {port};
+    scheduler.addSchedule(config);
+    auto id = scheduler.getSchedules()[0].id;
+
+    auto runAndWait = [&](int expected) {
+        scheduler.runNow(id);
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (completed < expected && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        REQUIRE(completed == expected);
+    };
+
+    SECTION("Closing a port is reported with its scanned state") {
+        runAndWait(1);
+        REQUIRE(scheduler.getLastScanResults(id).size() == 1);
+
+        listener.reset();
+        runAndWait(2);
+
+        std::lock_guard lock(mutex);
+        REQUIRE(diffs.size() == 1);
+        REQUIRE(diffs[0].changes.size() == 1);
+        REQUIRE(diffs[0].changes[0].port == port);
+        REQUIRE(diffs[0].changes[0].changeType == PortChangeType::NewClosed);
+        // Closed results are streamed, so the port is not merely missing
+        REQUIRE(diffs[0].changes[0].currentState == PortState::Closed);
+        REQUIRE(diffs[0].totalPortsScanned == 1);
+        REQUIRE(scheduler.getLastScanResults(id).empty());
+    }
+
+    context.stop();
+}
+
+TEST_CASE("ScheduledPortScanner diffs name services from the results", "[ScheduledPortScan]") {
+    AsioContext context(1);
+    ScriptedPortScanner portScanner;
+    ScheduledPortScanner scheduler(context, portScanner);
+
+    std::vector<PortScanDiff> diffs;
+    scheduler.setDiffCallback([&diffs](int64_t, const PortScanDiff& diff) { diffs.push_back(diff); });
+
+    ScheduledScanConfig config;
+    config.name = "Banners";
+    config.targetAddress = "127.0.0.1";
+    config.portRange = PortRange::Custom;
+    config.customPorts = {8080};
+    scheduler.addSchedule(config);
+    auto id = scheduler.getSchedules()[0].id;
+
+    // A banner grab found SSH on a port the detector would call http-alt
+    portScanner.services = {{8080, "ssh"}};
+    portScanner.runs = {
+        {{8080, PortState::Closed}},
+        {{8080, PortState::Open}},
+        {{8080, PortState::Closed}},
+    };
+
+    scheduler.runNow(id);
+    scheduler.runNow(id);
+    REQUIRE(diffs.size() == 1);
+    REQUIRE(diffs[0].changes[0].changeType == PortChangeType::NewOpen);
+    REQUIRE(diffs[0].changes[0].serviceName == "ssh");
+
+    // Once closed, the name comes from the previous run
+    scheduler.runNow(id);
+    REQUIRE(diffs.size() == 2);
+    REQUIRE(diffs[1].changes[0].changeType == PortChangeType::NewClosed);
+    REQUIRE(diffs[1].changes[0].serviceName == "ssh");
+}
+
+TEST_CASE("ScheduledPortScanner keeps the baseline across incomplete runs", "[ScheduledPortScan]") {
+    AsioContext context(1);
+    ScriptedPortScanner portScanner;
+    ScheduledPortScanner scheduler(context, portScanner);
+
+    std::vector<PortScanDiff> diffs;
+    scheduler.setDiffCallback([&diffs](int64_t, const PortScanDiff& diff) { diffs.push_back(diff); });
+
+    ScheduledScanConfig config;
+    config.name = "Partial";
+    config.targetAddress = "127.0.0.1";
+    config.portRange = PortRange::Custom;
+    config.customPorts = {22, 80, 443};
+    scheduler.addSchedule(config);
+    auto id = scheduler.getSchedules()[0].id;
+
+    SECTION("A cancelled run diffs only the ports it probed") {
+        portScanner.runs = {
+            {{22, PortState::Open}, {80, PortState::Open}, {443, PortState::Closed}},
+            {{22, PortState::Closed}}, // Cancelled after one port
+            {{22, PortState::Closed}, {80, PortState::Open}, {443, PortState::Closed}},
+        };
+
+        scheduler.runNow(id);
+        REQUIRE(scheduler.getLastScanResults(id).size() == 2);
+
+        scheduler.runNow(id);
+        REQUIRE(diffs.size() == 1);
+        REQUIRE(diffs[0].changes.size() == 1);
+        REQUIRE(diffs[0].changes[0].port == 22);
+        REQUIRE(diffs[0].changes[0].changeType == PortChangeType::NewClosed);
+        // Ports the run never reached stay open in the baseline
+        auto results = scheduler.getLastScanResults(id);
+        REQUIRE(results.size() == 1);
+        REQUIRE(results[0].port == 80);
+
+        scheduler.runNow(id);
+        REQUIRE(diffs.size() == 1);
+    }
+
+    SECTION("A cancelled first run does not become the baseline") {
+        portScanner.runs = {
+            {{22, PortState::Open}},
+            {{22, PortState::Open}, {80, PortState::Open}, {443, PortState::Closed}},
+        };
+
+        scheduler.runNow(id);
+        scheduler.runNow(id);
+        REQUIRE(diffs.empty());
+        REQUIRE(scheduler.getLastScanResults(id).size() == 2);
+    }
+}
+
+TEST_CASE("ScheduledPortScanner outlived by its scans", "[ScheduledPortScan]") {
+    AsioContext context(1);
+    HeldPortScanner portScanner;
+
+    std::atomic<int> completed{0};
+    {
+        ScheduledPortScanner scheduler(context, portScanner);
+        scheduler.setScanCompleteCallback(
+            [&completed](int64_t, const std::vector<PortScanResult>&) { ++completed; });
+
+        ScheduledScanConfig config;
+        config.name = "Held";
+        config.targetAddress = "127.0.0.1";
+        config.portRange = PortRange::Custom;
+        config.customPorts = {22};
+        scheduler.addSchedule(config);
+        scheduler.runNow(scheduler.getSchedules()[0].id);
+        REQUIRE(portScanner.held.size() == 1);
+    }
+
+    // Completing after the scanner is gone is ignored rather than touching it
+    REQUIRE_NOTHROW(portScanner.held[0]({}));
+    REQUIRE(completed == 0);
+}
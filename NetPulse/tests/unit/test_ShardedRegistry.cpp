@@ -0,0 +1,97 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "infrastructure/network/ShardedRegistry.hpp"
+
+#include <atomic>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace netpulse::infra;
+
+TEST_CASE("ShardedRegistry basic operations", "[ShardedRegistry]") {
+    ShardedRegistry<int> registry(4);
+
+    SECTION("Shard count is at least one") {
+        REQUIRE(registry.shardCount() == 4);
+        ShardedRegistry<int> single(0);
+        REQUIRE(single.shardCount() == 1);
+    }
+
+    SECTION("Insert, find and erase") {
+        REQUIRE(registry.insertOrReplace(7, std::make_shared<int>(70)) == nullptr);
+        REQUIRE(registry.contains(7));
+        REQUIRE(*registry.find(7) == 70);
+        REQUIRE(registry.find(8) == nullptr);
+
+        auto removed = registry.erase(7);
+        REQUIRE(removed);
+        REQUIRE(*removed == 70);
+        REQUIRE_FALSE(registry.contains(7));
+        REQUIRE(registry.erase(7) == nullptr);
+    }
+
+    SECTION("Replacing an entry returns the previous one") {
+        registry.insertOrReplace(1, std::make_shared<int>(10));
+        auto previous = registry.insertOrReplace(1, std::make_shared<int>(11));
+
+        REQUIRE(previous);
+        REQUIRE(*previous == 10);
+        REQUIRE(*registry.find(1) == 11);
+        REQUIRE(registry.size() == 1);
+    }
+
+    SECTION("forEach and takeAll visit every entry") {
+        for (int64_t id = 1; id <= 20; ++id) {
+            registry.insertOrReplace(id, std::make_shared<int>(static_cast<int>(id)));
+        }
+
+        std::set<int64_t> seen;
+        registry.forEach([&](int64_t id, const auto& value) {
+            REQUIRE(*value == id);
+            seen.insert(id);
+        });
+        REQUIRE(seen.size() == 20);
+
+        auto taken = registry.takeAll();
+        REQUIRE(taken.size() == 20);
+        REQUIRE(registry.size() == 0);
+    }
+
+    SECTION("Sequential ids spread across shards") {
+        std::set<size_t> used;
+        for (int64_t id = 1; id <= 64; ++id) {
+            auto shard = registry.shardOf(id);
+            REQUIRE(shard < registry.shardCount());
+            used.insert(shard);
+        }
+        REQUIRE(used.size() == registry.shardCount());
+    }
+}
+
+TEST_CASE("ShardedRegistry concurrent access", "[ShardedRegistry]") {
+    ShardedRegistry<int> registry(8);
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 1250;
+
+    std::atomic<int> missing{0};
+    std::vector<std::thread> writers;
+    for (int t = 0; t < kThreads; ++t) {
+        writers.emplace_back([&registry, &missing, t]() {
+            for (int i = 0; i < kPerThread; ++i) {
+                int64_t id = t * kPerThread + i;
+                registry.insertOrReplace(id, std::make_shared<int>(i));
+                if (!registry.contains(id)) {
+                    ++missing;
+                }
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+
+    REQUIRE(missing == 0);
+    REQUIRE(registry.size() == kThreads * kPerThread);
+}
@@ -4,15 +4,248 @@
 #include "infrastructure/database/Database.hpp"
 #include "infrastructure/database/SnmpRepository.hpp"
 #include "infrastructure/network/AsioContext.hpp"
+#include "infrastructure/network/BlockingExecutor.hpp"
 #include "infrastructure/network/SnmpService.hpp"
 
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <filesystem>
+#include <map>
+#include <sstream>
+#include <string>
 #include <thread>
+#include <vector>
 
 using namespace netpulse::core;
 using namespace netpulse::infra;
 
+namespace {
+
+// Minimal SNMP v2c agent on loopback that answers GET-NEXT and GETBULK from
+// a fixed MIB, enough to exercise walks end to end
+class FakeAgent {
+public:
+    using Oid = std::vector<uint32_t>;
+
+    explicit FakeAgent(std::map<Oid, int32_t> mib)
+        : mib_(std::move(mib)),
+          socket_(io_, asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), 0)) {
+        receive();
+        thread_ = std::thread([this]() { io_.run(); });
+    }
+
+    ~FakeAgent() {
+        io_.stop();
+        thread_.join();
+    }
+
+    FakeAgent(const FakeAgent&) = delete;
+    FakeAgent& operator=(const FakeAgent&) = delete;
+
+    uint16_t port() const { return socket_.local_endpoint().port(); }
+
+    std::atomic<size_t> requests{0};       // Requests received, dropped ones included
+    std::atomic<int32_t> maxRepetitions{0}; // As sent in the last GETBULK
+    std::atomic<size_t> dropRequests{0};   // Leave this many requests unanswered
+    std::atomic<bool> repeatOids{false};   // Answer every request with the OID asked for
+
+    static Oid parse(const std::string& text) {
+        Oid oid;
+        std::istringstream stream(text);
+        std::string part;
+        while (std::getline(stream, part, '.')) {
+            oid.push_back(static_cast<uint32_t>(std::stoul(part)));
+        }
+        return oid;
+    }
+
+private:
+    static size_t readLength(const std::vector<uint8_t>& in, size_t& offset) {
+        size_t length = in[offset++];
+        if (length & 0x80) {
+            size_t bytes = length & 0x7F;
+            length = 0;
+            for (size_t i = 0; i < bytes; ++i) {
+                length = (length << 8) | in[offset++];
+            }
+        }
+        return length;
+    }
+
+    static int32_t readInteger(const std::vector<uint8_t>& in, size_t& offset) {
+        ++offset; // Tag
+        size_t length = readLength(in, offset);
+        int32_t value = (in[offset] & 0x80) ? -1 : 0;
+        for (size_t i = 0; i < length; ++i) {
+            value = static_cast<int32_t>(static_cast<uint32_t>(value) << 8 | in[offset++]);
+        }
+        return value;
+    }
+
+    static Oid readOid(const std::vector<uint8_t>& in, size_t& offset) {
+        ++offset; // Tag
+        size_t end = readLength(in, offset);
+        end += offset;
+        Oid oid{in[offset] / 40u, in[offset] % 40u};
+        ++offset;
+        uint32_t value = 0;
+        while (offset < end) {
+            value = (value << 7) | (in[offset] & 0x7Fu);
+            if ((in[offset++] & 0x80) == 0) {
+                oid.push_back(value);
+                value = 0;
+            }
+        }
+        return oid;
+    }
+
+    static std::vector<uint8_t> wrap(uint8_t tag, const std::vector<uint8_t>& content) {
+        std::vector<uint8_t> out{tag};
+        if (content.size() < 0x80) {
+            out.push_back(static_cast<uint8_t>(content.size()));
+        } else {
+            out.push_back(0x82);
+            out.push_back(static_cast<uint8_t>(content.size() >> 8));
+            out.push_back(static_cast<uint8_t>(content.size() & 0xFF));
+        }
+        out.insert(out.end(), content.begin(), content.end());
+        return out;
+    }
+
+    static std::vector<uint8_t> integer(int32_t value) {
+        std::vector<uint8_t> bytes;
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            bytes.push_back(static_cast<uint8_t>(static_cast<uint32_t>(value) >> shift));
+        }
+        while (bytes.size() > 1 && ((bytes[0] == 0 && (bytes[1] & 0x80) == 0) ||
+                                    (bytes[0] == 0xFF && (bytes[1] & 0x80) != 0))) {
+            bytes.erase(bytes.begin());
+        }
+        return wrap(0x02, bytes);
+    }
+
+    static std::vector<uint8_t> oid(const Oid& value) {
+        std::vector<uint8_t> bytes{static_cast<uint8_t>(value[0] * 40 + value[1])};
+        for (size_t i = 2; i < value.size(); ++i) {
+            std::vector<uint8_t> part{static_cast<uint8_t>(value[i] & 0x7F)};
+            for (uint32_t rest = value[i] >> 7; rest != 0; rest >>= 7) {
+                part.insert(part.begin(), static_cast<uint8_t>(0x80 | (rest & 0x7F)));
+            }
+            bytes.insert(bytes.end(), part.begin(), part.end());
+        }
+        return wrap(0x06, bytes);
+    }
+
+    static void append(std::vector<uint8_t>& out, const std::vector<uint8_t>& bytes) {
+        out.insert(out.end(), bytes.begin(), bytes.end());
+    }
+
+    void receive() {
+        socket_.async_receive_from(asio::buffer(buffer_), sender_,
+                                   [this](const asio::error_code& ec, size_t received) {
+                                       if (ec) {
+                                           return;
+                                       }
+                                       std::vector<uint8_t> request(buffer_.begin(),
+                                                                    buffer_.begin() +
+                                                                        static_cast<long>(received));
+                                       ++requests;
+                                       if (dropRequests > 0) {
+                                           --dropRequests;
+                                       } else {
+                                           auto reply = answer(request);
+                                           socket_.send_to(asio::buffer(reply), sender_);
+                                       }
+                                       receive();
+                                   });
+    }
+
+    std::vector<uint8_t> answer(const std::vector<uint8_t>& request) {
+        size_t offset = 1;
+        readLength(request, offset);
+        auto version = readInteger(request, offset);
+        ++offset; // Community tag
+        auto communityLength = readLength(request, offset);
+        std::string community(request.begin() + static_cast<long>(offset),
+                              request.begin() + static_cast<long>(offset + communityLength));
+        offset += communityLength;
+        auto pduType = request[offset++];
+        readLength(request, offset);
+        auto requestId = readInteger(request, offset);
+        readInteger(request, offset); // Non-repeaters, always 0 here
+        auto repetitions = readInteger(request, offset);
+        ++offset; // Varbind list tag
+        auto listEnd = readLength(request, offset);
+        listEnd += offset;
+        std::vector<Oid> oids;
+        while (offset < listEnd) {
+            ++offset;
+            readLength(request, offset);
+            oids.push_back(readOid(request, offset));
+            offset += 2; // NULL value
+        }
+
+        if (pduType == 0xA5) {
+            maxRepetitions = repetitions;
+        } else {
+            repetitions = 1;
+        }
+
+        std::vector<uint8_t> varbinds;
+        for (auto current : oids) {
+            for (int32_t i = 0; i < repetitions; ++i) {
+                std::vector<uint8_t> varbind = oid(current);
+                auto next = mib_.upper_bound(current);
+                if (repeatOids) {
+                    append(varbind, integer(0));
+                } else if (next == mib_.end()) {
+                    append(varbind, {0x82, 0x00}); // endOfMibView
+                    append(varbinds, wrap(0x30, varbind));
+                    break;
+                } else {
+                    current = next->first;
+                    varbind = oid(current);
+                    append(varbind, integer(next->second));
+                }
+                append(varbinds, wrap(0x30, varbind));
+            }
+        }
+
+        std::vector<uint8_t> pdu;
+        append(pdu, integer(requestId));
+        append(pdu, integer(0));
+        append(pdu, integer(0));
+        append(pdu, wrap(0x30, varbinds));
+
+        std::vector<uint8_t> message;
+        append(message, integer(version));
+        append(message, wrap(0x04, std::vector<uint8_t>(community.begin(), community.end())));
+        append(message, wrap(0xA2, pdu));
+        return wrap(0x30, message);
+    }
+
+    std::map<Oid, int32_t> mib_;
+    asio::io_context io_;
+    asio::ip::udp::socket socket_;
+    asio::ip::udp::endpoint sender_;
+    std::array<uint8_t, 65535> buffer_{};
+    std::thread thread_;
+};
+
+// Rows 1..count of a table column under prefix, valued by row
+std::map<FakeAgent::Oid, int32_t> column(const std::string& prefix, uint32_t count) {
+    std::map<FakeAgent::Oid, int32_t> mib;
+    for (uint32_t row = 1; row <= count; ++row) {
+        auto oid = FakeAgent::parse(prefix);
+        oid.push_back(row);
+        mib.emplace(oid, static_cast<int32_t>(row));
+    }
+    return mib;
+}
+
+} // namespace
+
 TEST_CASE("SnmpTypes structures", "[SnmpService]") {
     SECTION("SnmpVarBind default values") {
         SnmpVarBind vb;
@@ -373,6 +606,167 @@ TEST_CASE("SnmpService async queries", "[SnmpService][integration]") {
     context.stop();
 }
 
+TEST_CASE("SnmpService coroutine queries", "[SnmpService][integration]") {
+    AsioContext context(2);
+    context.start();
+    SnmpService service(context);
+    asio::io_context local;
+
+    // Nothing ever answers on this socket
+    asio::ip::udp::socket silent(local,
+                                 asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), 0));
+
+    SnmpDeviceConfig config;
+    config.version = SnmpVersion::V2c;
+    config.credentials = SnmpV2cCredentials{"public"};
+    config.port = silent.local_endpoint().port();
+    config.timeoutMs = 100;
+
+    auto strand = asio::make_strand(context.getContext());
+
+    SECTION("GET times out without blocking a thread") {
+        auto future = asio::co_spawn(
+            strand, service.snmpGet("127.0.0.1", {SnmpOids::SYS_DESCR}, config), asio::use_future);
+
+        REQUIRE(future.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+        auto result = future.get();
+        REQUIRE_FALSE(result.success);
+        REQUIRE(result.errorMessage == "Request timed out");
+        REQUIRE(context.blockingExecutor().stats().submitted == 0);
+    }
+
+    SECTION("GET-NEXT on an unresolvable name fails") {
+        auto future = asio::co_spawn(
+            strand, service.snmpGetNext("nonexistent.invalid", {SnmpOids::SYS_DESCR}, config),
+            asio::use_future);
+
+        REQUIRE(future.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+        auto result = future.get();
+        REQUIRE_FALSE(result.success);
+        REQUIRE_FALSE(result.errorMessage.empty());
+    }
+
+    SECTION("Walks stop at the first unanswered step") {
+        auto future = service.walkAsync("127.0.0.1", SnmpOids::SYS_DESCR, config);
+
+        REQUIRE(future.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+        REQUIRE(future.get().empty());
+        REQUIRE(context.blockingExecutor().stats().submitted == 0);
+    }
+
+    context.stop();
+}
+
+TEST_CASE("SnmpService bulk walks", "[SnmpService][integration]") {
+    AsioContext context(2);
+    context.start();
+    SnmpService service(context);
+
+    const std::string descr = SnmpOids::IF_DESCR;
+    const std::string speed = SnmpOids::IF_SPEED;
+    auto mib = column(descr, 100);
+    mib.merge(column(speed, 100));
+    mib.emplace(FakeAgent::parse(SnmpOids::SYS_DESCR), 1);
+    mib.emplace(FakeAgent::parse("1.3.6.1.2.1.4.1.0"), 2);
+    FakeAgent agent(std::move(mib));
+
+    SnmpDeviceConfig config;
+    config.version = SnmpVersion::V2c;
+    config.credentials = SnmpV2cCredentials{"public"};
+    config.port = agent.port();
+    config.timeoutMs = 200;
+
+    SECTION("Roots are walked together with GETBULK and streamed in order") {
+        std::map<std::string, std::vector<SnmpVarBind>> received;
+        auto onVarBind = [&received](const std::string& root, const SnmpVarBind& varbind) {
+            received[root].push_back(varbind);
+        };
+
+        auto future = service.bulkWalkAsync("127.0.0.1", {descr, speed}, config, onVarBind, 25);
+        REQUIRE(future.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+        auto result = future.get();
+
+        REQUIRE(result.success);
+        REQUIRE(result.errorMessage.empty());
+        REQUIRE(result.varbindCount == 200);
+        // Four requests fetch 100 rows; a fifth finds the end of the column
+        REQUIRE(result.requests == 10);
+        REQUIRE(agent.requests == 10);
+        REQUIRE(agent.maxRepetitions == 25);
+
+        REQUIRE(received[descr].size() == 100);
+        REQUIRE(received[speed].size() == 100);
+        for (size_t i = 0; i < 100; ++i) {
+            REQUIRE(received[descr][i].oid == descr + "." + std::to_string(i + 1));
+            REQUIRE(received[speed][i].intValue == static_cast<int64_t>(i + 1));
+        }
+    }
+
+    SECTION("Max-repetitions is clamped") {
+        auto future = service.bulkWalkAsync("127.0.0.1", {descr}, config, nullptr, 100000);
+        REQUIRE(future.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+        REQUIRE(future.get().varbindCount == 100);
+        REQUIRE(agent.maxRepetitions == SnmpService::MAX_REPETITIONS_LIMIT);
+    }
+
+    SECTION("Walks have no step limit") {
+        FakeAgent large(column("1.3.6.1.2.1.31.1.1.1.1", 1500));
+        config.port = large.port();
+
+        auto future = service.walkAsync("127.0.0.1", "1.3.6.1.2.1.31.1.1.1.1", config);
+        REQUIRE(future.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+        auto results = future.get();
+        REQUIRE(results.size() == 1500);
+        REQUIRE(results.back().oid == "1.3.6.1.2.1.31.1.1.1.1.1500");
+    }
+
+    SECTION("An unanswered request is resent") {
+        agent.dropRequests = 1;
+        config.retries = 1;
+
+        auto future = service.bulkWalkAsync("127.0.0.1", {SnmpOids::IF_TABLE}, config, nullptr);
+        REQUIRE(future.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+        auto result = future.get();
+        REQUIRE(result.success);
+        REQUIRE(result.varbindCount == 200);
+        REQUIRE(result.requests == agent.requests);
+    }
+
+    SECTION("A root fails when its retries run out") {
+        agent.dropRequests = 100;
+        config.retries = 1;
+
+        auto future = service.bulkWalkAsync("127.0.0.1", {descr}, config, nullptr);
+        REQUIRE(future.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+        auto result = future.get();
+        REQUIRE_FALSE(result.success);
+        REQUIRE(result.errorMessage == descr + ": Request timed out");
+        REQUIRE(result.requests == 2);
+    }
+
+    SECTION("OIDs that do not increase end the walk") {
+        agent.repeatOids = true;
+
+        auto future = service.bulkWalkAsync("127.0.0.1", {descr}, config, nullptr);
+        REQUIRE(future.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+        auto result = future.get();
+        REQUIRE_FALSE(result.success);
+        REQUIRE(result.errorMessage.find("OID not increasing") != std::string::npos);
+        REQUIRE(result.varbindCount == 0);
+    }
+
+    SECTION("Invalid roots fail without a request") {
+        auto future = service.bulkWalkAsync("127.0.0.1", {"not.an.oid"}, config, nullptr);
+        REQUIRE(future.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+        auto result = future.get();
+        REQUIRE_FALSE(result.success);
+        REQUIRE(result.errorMessage == "not.an.oid: Invalid OID");
+        REQUIRE(agent.requests == 0);
+    }
+
+    context.stop();
+}
+
 TEST_CASE("SnmpRepository operations", "[SnmpService][database]") {
     auto tempDir = std::filesystem::temp_directory_path();
     auto dbPath = tempDir / "test_snmp_repo.db";
@@ -0,0 +1,194 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "infrastructure/network/AsioContext.hpp"
+#include "infrastructure/network/Hash.hpp"
+#include "infrastructure/network/IcmpEngine.hpp"
+#include "infrastructure/network/SynScanner.hpp"
+
+#include <array>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace netpulse::core;
+using namespace netpulse::infra;
+
+TEST_CASE("SynScanner packet construction", "[SynScanner]") {
+    constexpr uint32_t source = 0x0A000001;      // 10.0.0.1
+    constexpr uint32_t destination = 0x0A000002; // 10.0.0.2
+
+    SECTION("SYN segment has the expected header fields") {
+        auto segment = SynScanner::buildSyn(source, destination, 40000, 443, 0x12345678);
+
+        REQUIRE(segment[0] == 0x9C); // 40000
+        REQUIRE(segment[1] == 0x40);
+        REQUIRE(segment[2] == 0x01); // 443
+        REQUIRE(segment[3] == 0xBB);
+        REQUIRE(segment[4] == 0x12);
+        REQUIRE(segment[7] == 0x78);
+        REQUIRE(segment[12] == 0x50); // Data offset 5 words
+        REQUIRE(segment[13] == 0x02); // SYN only
+    }
+
+    SECTION("Checksum covers the pseudo-header") {
+        auto segment = SynScanner::buildSyn(source, destination, 40000, 443, 0x12345678);
+
+        std::array<uint8_t, 32> buffer{0x0A, 0x00, 0x00, 0x01, 0x0A, 0x00, 0x00, 0x02,
+                                       0x00, 0x06, 0x00, 0x14};
+        std::copy(segment.begin(), segment.end(), buffer.begin() + 12);
+        REQUIRE(IcmpEngine::calculateChecksum(buffer.data(), buffer.size()) == 0);
+
+        // A different destination would not verify
+        buffer[7] = 0x03;
+        REQUIRE(IcmpEngine::calculateChecksum(buffer.data(), buffer.size()) != 0);
+    }
+}
+
+TEST_CASE("SynScanner sequence hash", "[SynScanner]") {
+    // Key bytes 00..0f and message bytes 00..07, as in the SipHash reference vectors
+    constexpr uint64_t k0 = 0x0706050403020100ULL;
+    constexpr uint64_t k1 = 0x0F0E0D0C0B0A0908ULL;
+
+    SECTION("Matches the SipHash-2-4 reference output") {
+        REQUIRE(sipHash24(k0, k1, 0x0706050403020100ULL) == 0x93F5F5799A932462ULL);
+    }
+
+    SECTION("Depends on the key") {
+        REQUIRE(sipHash24(k0, k1, 42) != sipHash24(k0 ^ 1, k1, 42));
+        REQUIRE(sipHash24(k0, k1, 42) != sipHash24(k0, k1 ^ 1, 42));
+    }
+}
+
+TEST_CASE("SynScanner reply parsing", "[SynScanner]") {
+    // IPv4 header (20 bytes) + SYN-ACK from 10.0.0.2:443 to 10.0.0.1:40000
+    std::vector<uint8_t> packet = {
+        0x45, 0x00, 0x00, 0x28, 0x00, 0x00, 0x40, 0x00, 0x40, 0x06, 0x00, 0x00, 0x0A, 0x00,
+        0x00, 0x02, 0x0A, 0x00, 0x00, 0x01, 0x01, 0xBB, 0x9C, 0x40, 0xAA, 0xBB, 0xCC, 0xDD,
+        0x12, 0x34, 0x56, 0x79, 0x50, 0x12, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00};
+
+    SECTION("SYN-ACK fields") {
+        auto reply = SynScanner::parseReply(packet.data(), packet.size());
+        REQUIRE(reply.has_value());
+        REQUIRE(reply->source == 0x0A000002);
+        REQUIRE(reply->destination == 0x0A000001);
+        REQUIRE(reply->sourcePort == 443);
+        REQUIRE(reply->destinationPort == 40000);
+        REQUIRE(reply->acknowledgement == 0x12345679);
+        REQUIRE(reply->syn);
+        REQUIRE(reply->ack);
+        REQUIRE_FALSE(reply->rst);
+    }
+
+    SECTION("RST flags") {
+        packet[33] = 0x14; // RST+ACK
+        auto reply = SynScanner::parseReply(packet.data(), packet.size());
+        REQUIRE(reply.has_value());
+        REQUIRE(reply->rst);
+        REQUIRE_FALSE(reply->syn);
+    }
+
+    SECTION("IP options shift the TCP header") {
+        std::vector<uint8_t> withOptions(packet.begin(), packet.begin() + 20);
+        withOptions[0] = 0x46;
+        withOptions.insert(withOptions.end(), {0x01, 0x01, 0x01, 0x00});
+        withOptions.insert(withOptions.end(), packet.begin() + 20, packet.end());
+
+        auto reply = SynScanner::parseReply(withOptions.data(), withOptions.size());
+        REQUIRE(reply.has_value());
+        REQUIRE(reply->sourcePort == 443);
+        REQUIRE(reply->acknowledgement == 0x12345679);
+    }
+
+    SECTION("Truncated or non-TCP packets are rejected") {
+        REQUIRE_FALSE(SynScanner::parseReply(packet.data(), 30).has_value());
+        packet[9] = 17; // UDP
+        REQUIRE_FALSE(SynScanner::parseReply(packet.data(), packet.size()).has_value());
+        packet[9] = 6;
+        packet[0] = 0x65; // IPv6 version nibble
+        REQUIRE_FALSE(SynScanner::parseReply(packet.data(), packet.size()).has_value());
+    }
+}
+
+TEST_CASE("SynScanner probes", "[SynScanner][integration]") {
+    AsioContext context(2);
+    context.start();
+    auto scanner = std::make_shared<SynScanner>(context);
+    if (!scanner->start()) {
+        return; // Raw sockets need CAP_NET_RAW
+    }
+
+    auto probe = [&scanner](const std::string& address, uint16_t port,
+                            std::chrono::milliseconds timeout) {
+        auto promise = std::make_shared<std::promise<PortScanResult>>();
+        auto future = promise->get_future();
+        scanner->probe(address, port, timeout,
+                       [promise](const PortScanResult& result) { promise->set_value(result); });
+        REQUIRE(future.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+        return future.get();
+    };
+
+    SECTION("Listening port is Open") {
+        asio::io_context io;
+        asio::ip::tcp::acceptor acceptor(io, {asio::ip::make_address("127.0.0.1"), 0});
+        auto port = acceptor.local_endpoint().port();
+
+        auto result = probe("127.0.0.1", port, std::chrono::milliseconds(1000));
+        REQUIRE(result.state == PortState::Open);
+        REQUIRE(result.targetAddress == "127.0.0.1");
+        REQUIRE(result.port == port);
+    }
+
+    SECTION("Port without a listener is Closed") {
+        uint16_t port = 0;
+        {
+            asio::io_context io;
+            asio::ip::tcp::acceptor acceptor(io, {asio::ip::make_address("127.0.0.1"), 0});
+            port = acceptor.local_endpoint().port();
+        }
+
+        auto result = probe("127.0.0.1", port, std::chrono::milliseconds(1000));
+        REQUIRE(result.state == PortState::Closed);
+    }
+
+    SECTION("Unanswered probe is Filtered after the timeout") {
+        auto start = std::chrono::steady_clock::now();
+        auto result = probe("10.255.255.1", 80, std::chrono::milliseconds(100));
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        REQUIRE((result.state == PortState::Filtered || result.state == PortState::Unknown));
+        REQUIRE(elapsed < std::chrono::seconds(2));
+        REQUIRE(scanner->outstandingCount() == 0);
+    }
+
+    SECTION("Non-IPv4 target reports Unknown") {
+        auto result = probe("not-an-address", 80, std::chrono::milliseconds(100));
+        REQUIRE(result.state == PortState::Unknown);
+    }
+
+    SECTION("Rate limit paces sends") {
+        scanner->setRateLimit(100);
+        constexpr int probeCount = 20;
+        std::vector<std::future<PortScanResult>> futures;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < probeCount; ++i) {
+            auto promise = std::make_shared<std::promise<PortScanResult>>();
+            futures.push_back(promise->get_future());
+            scanner->probe("127.0.0.1", static_cast<uint16_t>(1 + i),
+                           std::chrono::milliseconds(500),
+                           [promise](const PortScanResult& result) { promise->set_value(result); });
+        }
+        for (auto& future : futures) {
+            REQUIRE(future.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        // 100 packets/s with a burst of one: the last SYN leaves after ~190 ms
+        REQUIRE(elapsed >= std::chrono::milliseconds(150));
+        REQUIRE(scanner->outstandingCount() == 0);
+    }
+
+    scanner->shutdown();
+    context.stop();
+}
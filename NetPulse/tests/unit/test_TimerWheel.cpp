@@ -0,0 +1,149 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "infrastructure/network/AsioContext.hpp"
+#include "infrastructure/network/TimerWheel.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+
+using namespace netpulse::infra;
+using namespace std::chrono_literals;
+
+TEST_CASE("TimerWheel scheduling", "[TimerWheel]") {
+    AsioContext context(2);
+    context.start();
+    auto wheel = std::make_shared<TimerWheel>(context.getContext(), 1ms);
+
+    SECTION("One-shot job runs once after its delay") {
+        auto promise = std::make_shared<std::promise<std::chrono::steady_clock::time_point>>();
+        auto future = promise->get_future();
+        auto start = std::chrono::steady_clock::now();
+
+        auto id = wheel->scheduleAfter(
+            20ms, [promise]() { promise->set_value(std::chrono::steady_clock::now()); });
+
+        REQUIRE(id != 0);
+        REQUIRE(future.wait_for(2s) == std::future_status::ready);
+        REQUIRE(future.get() - start >= 20ms);
+        REQUIRE(wheel->size() == 0);
+    }
+
+    SECTION("Cancelled job never runs") {
+        std::atomic<int> runs{0};
+        auto id = wheel->scheduleAfter(30ms, [&runs]() { ++runs; });
+
+        REQUIRE(wheel->size() == 1);
+        REQUIRE(wheel->cancel(id));
+        REQUIRE_FALSE(wheel->cancel(id));
+        REQUIRE(wheel->size() == 0);
+
+        std::this_thread::sleep_for(80ms);
+        REQUIRE(runs == 0);
+    }
+
+    SECTION("Stale handle does not cancel a reused slot") {
+        auto first = wheel->scheduleAfter(10ms, []() {});
+        REQUIRE(wheel->cancel(first));
+
+        std::atomic<int> runs{0};
+        auto second = wheel->scheduleAfter(10ms, [&runs]() { ++runs; });
+
+        REQUIRE(second != first);
+        REQUIRE_FALSE(wheel->cancel(first));
+        std::this_thread::sleep_for(60ms);
+        REQUIRE(runs == 1);
+    }
+
+    SECTION("Recurring job keeps running until cancelled") {
+        std::atomic<int> runs{0};
+        auto id = wheel->scheduleEvery(10ms, [&runs]() { ++runs; }, 10ms);
+
+        std::this_thread::sleep_for(120ms);
+        REQUIRE(wheel->cancel(id));
+        int observed = runs.load();
+        REQUIRE(observed >= 5);
+
+        std::this_thread::sleep_for(50ms);
+        REQUIRE(runs.load() <= observed + 1);
+    }
+
+    SECTION("Recurring job can cancel itself") {
+        std::atomic<int> runs{0};
+        auto id = std::make_shared<std::atomic<TimerWheel::JobId>>(0);
+        id->store(wheel->scheduleEvery(
+            5ms,
+            [&runs, id, weak = std::weak_ptr<TimerWheel>(wheel)]() {
+                if (++runs == 3) {
+                    if (auto self = weak.lock()) {
+                        self->cancel(id->load());
+                    }
+                }
+            },
+            5ms));
+
+        std::this_thread::sleep_for(100ms);
+        REQUIRE(runs == 3);
+        REQUIRE(wheel->size() == 0);
+    }
+
+    SECTION("Jobs due in the same tick all run") {
+        constexpr int jobCount = 1000;
+        std::atomic<int> runs{0};
+        auto promise = std::make_shared<std::promise<void>>();
+        auto future = promise->get_future();
+
+        for (int i = 0; i < jobCount; ++i) {
+            wheel->scheduleAfter(15ms, [&runs, promise]() {
+                if (++runs == jobCount) {
+                    promise->set_value();
+                }
+            });
+        }
+
+        REQUIRE(wheel->size() == jobCount);
+        REQUIRE(future.wait_for(2s) == std::future_status::ready);
+        REQUIRE(wheel->size() == 0);
+    }
+
+    SECTION("Jobs beyond the first level cascade down and fire") {
+        // 300 ticks of 1 ms exceeds the 256-slot inner wheel
+        auto promise = std::make_shared<std::promise<std::chrono::steady_clock::time_point>>();
+        auto future = promise->get_future();
+        auto start = std::chrono::steady_clock::now();
+
+        wheel->scheduleAfter(300ms,
+                             [promise]() { promise->set_value(std::chrono::steady_clock::now()); });
+
+        REQUIRE(future.wait_for(3s) == std::future_status::ready);
+        REQUIRE(future.get() - start >= 300ms);
+    }
+
+    SECTION("Earlier job re-arms a wheel waiting on a later one") {
+        wheel->scheduleAfter(2000ms, []() {});
+
+        auto promise = std::make_shared<std::promise<void>>();
+        auto future = promise->get_future();
+        wheel->scheduleAfter(10ms, [promise]() { promise->set_value(); });
+
+        REQUIRE(future.wait_for(500ms) == std::future_status::ready);
+        REQUIRE(wheel->size() == 1);
+    }
+
+    SECTION("Clear drops all pending jobs") {
+        std::atomic<int> runs{0};
+        for (int i = 0; i < 10; ++i) {
+            wheel->scheduleAfter(20ms, [&runs]() { ++runs; });
+        }
+        wheel->clear();
+
+        REQUIRE(wheel->size() == 0);
+        std::this_thread::sleep_for(60ms);
+        REQUIRE(runs == 0);
+    }
+
+    wheel->clear();
+    context.stop();
+}
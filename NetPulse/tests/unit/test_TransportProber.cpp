@@ -0,0 +1,194 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "infrastructure/network/AsioContext.hpp"
+#include "infrastructure/network/TransportProber.hpp"
+
+#include <array>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+
+using namespace netpulse::core;
+using namespace netpulse::infra;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Runs one probe and waits for its result
+template <typename Start>
+PingResult runProbe(Start&& start) {
+    auto promise = std::make_shared<std::promise<PingResult>>();
+    auto future = promise->get_future();
+    start([promise](const PingResult& result) { promise->set_value(result); });
+    REQUIRE(future.wait_for(5s) == std::future_status::ready);
+    return future.get();
+}
+
+uint16_t unusedUdpPort(asio::io_context& ioContext) {
+    asio::ip::udp::socket socket(ioContext,
+                                 asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), 0));
+    return socket.local_endpoint().port();
+}
+
+} // namespace
+
+TEST_CASE("TransportProber DNS packets", "[TransportProber]") {
+    SECTION("Query asks for the root NS records") {
+        auto query = TransportProber::buildDnsQuery(0xBEEF);
+
+        REQUIRE(query.size() == 17);
+        REQUIRE(query[0] == 0xBE);
+        REQUIRE(query[1] == 0xEF);
+        REQUIRE((query[2] & 0x80) == 0); // A query, not a response
+        REQUIRE(query[5] == 1);          // One question
+        REQUIRE(query[12] == 0);         // Root name
+        REQUIRE(query[14] == 2);         // NS
+        REQUIRE(query[16] == 1);         // IN
+    }
+
+    SECTION("Responses must carry the query id and QR bit") {
+        auto packet = TransportProber::buildDnsQuery(0x1234);
+        REQUIRE_FALSE(TransportProber::isDnsResponse(packet.data(), packet.size(), 0x1234));
+
+        packet[2] |= 0x80;
+        REQUIRE(TransportProber::isDnsResponse(packet.data(), packet.size(), 0x1234));
+        REQUIRE_FALSE(TransportProber::isDnsResponse(packet.data(), packet.size(), 0x4321));
+        REQUIRE_FALSE(TransportProber::isDnsResponse(packet.data(), 4, 0x1234));
+    }
+}
+
+TEST_CASE("TransportProber probes", "[TransportProber][integration]") {
+    AsioContext context(2);
+    context.start();
+    auto prober = std::make_shared<TransportProber>(context);
+    asio::io_context local;
+
+    SECTION("TCP connect to a listening port succeeds") {
+        asio::ip::tcp::acceptor acceptor(
+            local, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+        auto port = acceptor.local_endpoint().port();
+
+        auto result = runProbe([&](auto callback) {
+            prober->probeTcp("127.0.0.1", port, 1000ms, callback);
+        });
+
+        REQUIRE(result.success);
+        REQUIRE(result.family == AddressFamily::IPv4);
+        REQUIRE(result.latency.count() >= 0);
+        REQUIRE(result.errorMessage.empty());
+    }
+
+    SECTION("TCP connect to a closed port is refused") {
+        uint16_t port;
+        {
+            asio::ip::tcp::acceptor acceptor(
+                local, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+            port = acceptor.local_endpoint().port();
+        }
+
+        auto result = runProbe([&](auto callback) {
+            prober->probeTcp("127.0.0.1", port, 1000ms, callback);
+        });
+
+        REQUIRE_FALSE(result.success);
+        REQUIRE(result.errorMessage == "Connection refused");
+    }
+
+    SECTION("UDP probe succeeds on any reply") {
+        asio::ip::udp::socket server(
+            local, asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), 0));
+        auto port = server.local_endpoint().port();
+        std::thread echo([&server]() {
+            std::array<uint8_t, 512> buffer{};
+            asio::ip::udp::endpoint peer;
+            auto length = server.receive_from(asio::buffer(buffer), peer);
+            server.send_to(asio::buffer(buffer.data(), length), peer);
+        });
+
+        auto result = runProbe([&](auto callback) {
+            prober->probeUdp("127.0.0.1", port, 1000ms, callback);
+        });
+        echo.join();
+
+        REQUIRE(result.success);
+    }
+
+    SECTION("UDP probe to a closed port reports port unreachable") {
+        auto port = unusedUdpPort(local);
+
+        auto result = runProbe([&](auto callback) {
+            prober->probeUdp("127.0.0.1", port, 1000ms, callback);
+        });
+
+        REQUIRE_FALSE(result.success);
+        REQUIRE(result.errorMessage == "Port unreachable");
+    }
+
+    SECTION("UDP probe times out without a reply") {
+        asio::ip::udp::socket silent(
+            local, asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), 0));
+
+        auto result = runProbe([&](auto callback) {
+            prober->probeUdp("127.0.0.1", silent.local_endpoint().port(), 100ms, callback);
+        });
+
+        REQUIRE_FALSE(result.success);
+        REQUIRE(result.errorMessage == "Request timed out");
+    }
+
+    SECTION("DNS probe ignores stray datagrams and accepts the matching response") {
+        asio::ip::udp::socket server(
+            local, asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), 0));
+        auto port = server.local_endpoint().port();
+        std::thread dns([&server]() {
+            std::array<uint8_t, 512> buffer{};
+            asio::ip::udp::endpoint peer;
+            auto length = server.receive_from(asio::buffer(buffer), peer);
+
+            // A response to some other query first, then the real one
+            auto stray = buffer;
+            stray[0] ^= 0xFF;
+            stray[2] |= 0x80;
+            server.send_to(asio::buffer(stray.data(), length), peer);
+
+            buffer[2] |= 0x80;
+            server.send_to(asio::buffer(buffer.data(), length), peer);
+        });
+
+        auto result = runProbe([&](auto callback) {
+            prober->probeDns("127.0.0.1", port, 1000ms, callback);
+        });
+        dns.join();
+
+        REQUIRE(result.success);
+    }
+
+    SECTION("Host probe type and port select the probe") {
+        asio::ip::tcp::acceptor acceptor(
+            local, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+
+        Host host;
+        host.address = "127.0.0.1";
+        host.probeType = ProbeType::Tcp;
+        host.probePort = acceptor.local_endpoint().port();
+
+        auto result = runProbe([&](auto callback) { prober->probe(host, 1000ms, callback); });
+        REQUIRE(result.success);
+
+        host.probeType = ProbeType::Icmp;
+        result = runProbe([&](auto callback) { prober->probe(host, 1000ms, callback); });
+        REQUIRE_FALSE(result.success);
+    }
+
+    SECTION("Unresolvable names fail") {
+        auto result = runProbe([&](auto callback) {
+            prober->probeTcp("nonexistent.invalid", 80, 2000ms, callback);
+        });
+
+        REQUIRE_FALSE(result.success);
+        REQUIRE_FALSE(result.errorMessage.empty());
+    }
+
+    context.stop();
+}